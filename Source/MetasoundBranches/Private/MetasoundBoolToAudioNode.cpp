@@ -5,9 +5,15 @@
 #include "MetasoundStandardNodesNames.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Public/Kernels/SlewKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundBoolToAudioNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(BoolToAudio, "Bool To Audio");
+
 namespace Metasound
 {
     namespace BoolToAudioNodeNames
@@ -30,8 +36,8 @@ namespace Metasound
             , InputRiseTime(InRiseTime)
             , InputFallTime(InFallTime)
             , OutputSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , PreviousOutputSample(0.0f)
             , SampleRate(InSettings.GetSampleRate())
+            , InstanceStats(TEXT("BoolToAudio"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -76,49 +82,39 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BoolToAudioNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBool), InputBool);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBool), InputBool);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BoolToAudioNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace BoolToAudioNodeNames;
 
-            const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<bool> InputBool = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(
-                InputInterface,
+            TDataReadReference<bool> InputBool = InputData.GetOrCreateDefaultDataReadReference<bool>(
                 METASOUND_GET_PARAM_NAME(InputBool),
                 InParams.OperatorSettings
             );
 
-            TDataReadReference<FTime> InputRiseTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface,
+            TDataReadReference<FTime> InputRiseTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(
                 METASOUND_GET_PARAM_NAME(InputRiseTime),
                 InParams.OperatorSettings
             );
 
-            TDataReadReference<FTime> InputFallTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface,
+            TDataReadReference<FTime> InputFallTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(
                 METASOUND_GET_PARAM_NAME(InputFallTime),
                 InParams.OperatorSettings
             );
@@ -126,50 +122,60 @@ namespace Metasound
             return MakeUnique<FBoolToAudioOperator>(InParams.OperatorSettings, InputBool, InputRiseTime, InputFallTime);
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear slew history and output
+            State = MetasoundBranches::Kernels::FSlewState();
+            OutputSignal->Zero();
+        }
+
         virtual void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(BoolToAudio);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const FScopedFlushDenormals FlushDenormals;
+
             int32 NumFrames = OutputSignal->Num();
             float* OutputDataPtr = OutputSignal->GetData();
 
             float TargetValue = *InputBool ? 1.0f : 0.0f;
 
-            float RiseTimeSeconds = InputRiseTime->GetSeconds();
-            float FallTimeSeconds = InputFallTime->GetSeconds();
+            const FSlewCoefficients Coefficients = MakeSlewCoefficients(InputRiseTime->GetSeconds(), InputFallTime->GetSeconds(), SampleRate);
 
-            float RiseAlpha = (RiseTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (RiseTimeSeconds * SampleRate)) : 0.0f;
-            float FallAlpha = (FallTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (FallTimeSeconds * SampleRate)) : 0.0f;
+            ProcessSlewToTarget(State, TargetValue, OutputDataPtr, NumFrames, Coefficients);
 
-            for (int32 i = 0; i < NumFrames; ++i)
+            // Output silence rather than NaN / infinity for the block in which the state was reset
+            if (!GuardSlewState(State))
             {
-                float OutputSample = PreviousOutputSample;
-
-                if (TargetValue > PreviousOutputSample)
-                {
-                    OutputSample = RiseAlpha * PreviousOutputSample + (1.0f - RiseAlpha) * TargetValue;
-                }
-                else if (TargetValue < PreviousOutputSample)
-                {
-                    OutputSample = FallAlpha * PreviousOutputSample + (1.0f - FallAlpha) * TargetValue;
-                }
-                else
-                {
-                    OutputSample = TargetValue;
-                }
-
-                OutputDataPtr[i] = OutputSample;
-                PreviousOutputSample = OutputSample;
+                FMemory::Memzero(OutputDataPtr, NumFrames * sizeof(float));
             }
         }
 
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace BoolToAudioNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputBool), *InputBool ? 1.0f : 0.0f);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime->GetSeconds());
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime->GetSeconds());
+        }
+
     private:
         FBoolReadRef InputBool;
         FTimeReadRef InputRiseTime;
         FTimeReadRef InputFallTime;
         FAudioBufferWriteRef OutputSignal;
-        float PreviousOutputSample;
+        MetasoundBranches::Kernels::FSlewState State;
         float SampleRate;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FBoolToAudioOperator);
+
     class FBoolToAudioNode : public FNodeFacade
     {
     public:
@@ -1,21 +1,99 @@
 // Copyright Charles Matthews. All Rights Reserved.
 
 #include "MetasoundBranches/Public/MetasoundBranches.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesRebuildWorker.h"
+#include "MetasoundBranches/Public/Kernels/AllPassKernel.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/QuarterSineTable.h"
+#include "MetasoundBranches/Public/Kernels/StateGuard.h"
+#include "HAL/IConsoleManager.h"
 #include "MetasoundFrontendRegistries.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 #include "Modules/ModuleManager.h"
 
 #define LOCTEXT_NAMESPACE "FMetasoundBranchesModule"
 
+DEFINE_LOG_CATEGORY(LogMetasoundBranches);
+
+namespace MetasoundBranchesModulePrivate
+{
+    using namespace MetasoundBranches::Kernels;
+
+    int32 SimdLevel = -1;
+
+    // Picks the vectorized kernels from au.Branches.Simd, or the scalar ones when -BranchesForceScalar is on the command line
+    void SelectKernels()
+    {
+        EKernelIsa RequestedIsa = EKernelIsa::AVX512;
+        if (FParse::Param(FCommandLine::Get(), TEXT("BranchesForceScalar")))
+        {
+            RequestedIsa = EKernelIsa::Scalar;
+        }
+        else if (SimdLevel >= 0)
+        {
+            RequestedIsa = static_cast<EKernelIsa>(FMath::Min(SimdLevel, static_cast<int32>(EKernelIsa::AVX512)));
+        }
+
+        const EKernelIsa SelectedIsa = SetKernelIsa(RequestedIsa);
+        UE_LOG(LogMetasoundBranches, Log, TEXT("Using %s kernels (CPU supports %s)."), ANSI_TO_TCHAR(GetKernelIsaName(SelectedIsa)), ANSI_TO_TCHAR(GetKernelIsaName(GetDetectedKernelIsa())));
+    }
+
+    FAutoConsoleVariableRef CVarSimd(
+        TEXT("au.Branches.Simd"),
+        SimdLevel,
+        TEXT("Instruction set used by the Branches kernels: -1 = best available (default), 0 = scalar, 1 = SSE2, 2 = SSE4.1, 3 = AVX2, 4 = AVX-512. Clamped to what the CPU supports."),
+        FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*) { SelectKernels(); }),
+        ECVF_Default);
+
+    // au.Branches.StateGuard [reset]
+    void PrintStateGuardCounters(const TArray<FString>& Args, FOutputDevice& Output)
+    {
+        if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+        {
+            StateGuardCounters.DenormalsFlushed = 0;
+            StateGuardCounters.NonFiniteResets = 0;
+            Output.Log(TEXT("Branches state guard counters reset."));
+            return;
+        }
+
+        Output.Logf(TEXT("Branches state guard: %llu subnormal state values flushed, %llu NaN / infinite state resets"),
+            static_cast<unsigned long long>(StateGuardCounters.DenormalsFlushed.load()),
+            static_cast<unsigned long long>(StateGuardCounters.NonFiniteResets.load()));
+    }
+
+    FAutoConsoleCommandWithArgsAndOutputDevice StateGuardCommand(
+        TEXT("au.Branches.StateGuard"),
+        TEXT("Prints how often Branches operators flushed subnormal state or reset NaN / infinite state. Usage: au.Branches.StateGuard [reset]"),
+        FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&PrintStateGuardCounters));
+}
+
 void FMetasoundBranchesModule::StartupModule()
 {
     // Initialization
     // UE_LOG(LogTemp, Log, TEXT("MetasoundBranches module started..."));
+
+    MetasoundBranchesModulePrivate::SelectKernels();
+
+    // Build the table behind the audio-rate balance and crossfade here rather than on the first audio thread to use it
+    MetasoundBranches::Kernels::GetQuarterSineTable();
+
+    // Likewise the Phase Disperser's impulse responses, which take a moment to build
+    MetasoundBranches::Kernels::GetAllPassResponseBank();
+
+    MetasoundBranches::StartInstanceStatsLogging();
 }
 
 void FMetasoundBranchesModule::ShutdownModule()
 {
     // Cleanup
     // UE_LOG(LogTemp, Log, TEXT("MetasoundBranches module shutting down..."));
+
+    MetasoundBranches::StopInstanceStatsLogging();
+
+    // Every operator is gone by now, so nothing is waiting on a rebuild
+    MetasoundBranches::StopRebuildWorker();
 }
 
 #undef LOCTEXT_NAMESPACE
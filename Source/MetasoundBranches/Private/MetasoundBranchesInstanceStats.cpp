@@ -0,0 +1,287 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranches.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+#if METASOUND_BRANCHES_INSTANCE_STATS
+
+namespace MetasoundBranches
+{
+    namespace InstanceStatsPrivate
+    {
+        bool bEnabled = false;
+        FAutoConsoleVariableRef CVarEnabled(
+            TEXT("au.Branches.Stats.Enabled"),
+            bEnabled,
+            TEXT("Tracks the cost of Branches operators built from now on for au.Branches.Stats and the overrun log (default 0)."),
+            ECVF_Default);
+
+        float OverrunShare = 0.25f;
+        FAutoConsoleVariableRef CVarOverrunShare(
+            TEXT("au.Branches.Stats.OverrunShare"),
+            OverrunShare,
+            TEXT("Share of the block duration above which one Branches operator instance counts as overrunning (default 0.25)."),
+            ECVF_Default);
+
+        float OverrunLogInterval = 1.0f;
+        FAutoConsoleVariableRef CVarOverrunLogInterval(
+            TEXT("au.Branches.Stats.OverrunLogInterval"),
+            OverrunLogInterval,
+            TEXT("Minimum number of seconds between two overrun log lines for the same instance; 0 disables overrun logging (default 1)."),
+            ECVF_Default);
+
+        using FStatsPtr = TSharedPtr<FInstanceStats, ESPMode::ThreadSafe>;
+
+        FCriticalSection InstancesLock;
+        TArray<FStatsPtr> Instances;
+        std::atomic<uint32> NextInstanceId { 1 };
+
+        // Bumped by "au.Branches.Stats reset"; each instance zeroes its own counters on the render thread when it sees
+        // a new value, so the reset never races the render thread's updates
+        std::atomic<uint32> ResetGeneration { 0 };
+
+        FTSTicker::FDelegateHandle TickerHandle;
+
+        double CyclesToMicroseconds(double Cycles)
+        {
+            return Cycles * FPlatformTime::GetSecondsPerCycle64() * 1.0e6;
+        }
+
+        TArray<FStatsPtr> GetInstances()
+        {
+            FScopeLock Lock(&InstancesLock);
+            return Instances;
+        }
+
+        FString DescribeInputs(const FInstanceInputSnapshot& Snapshot)
+        {
+            FString Description;
+            for (int32 Index = 0; Index < Snapshot.Num; ++Index)
+            {
+                if (Index > 0)
+                {
+                    Description += TEXT(", ");
+                }
+                Description += FString::Printf(TEXT("%s = %g%s"), Snapshot.Names[Index], Snapshot.Values[Index], Snapshot.bIsPeak[Index] ? TEXT(" (peak)") : TEXT(""));
+            }
+            if (Snapshot.NumOmitted > 0)
+            {
+                Description += FString::Printf(TEXT(" (%d more inputs not shown)"), Snapshot.NumOmitted);
+            }
+            return Description;
+        }
+
+        // Logs the overruns recorded by the render thread since the last tick
+        bool LogOverruns(float DeltaTime)
+        {
+            if (OverrunLogInterval <= 0.0f)
+            {
+                return true;
+            }
+
+            const double Now = FPlatformTime::Seconds();
+
+            for (const FStatsPtr& Stats : GetInstances())
+            {
+                if (!Stats->bOverrunPending.load(std::memory_order_acquire))
+                {
+                    continue;
+                }
+
+                if (Now - Stats->LastLogTime >= OverrunLogInterval)
+                {
+                    Stats->LastLogTime = Now;
+
+                    const double OverrunMicroseconds = CyclesToMicroseconds(static_cast<double>(Stats->OverrunCycles));
+                    UE_LOG(LogMetasoundBranches, Warning, TEXT("%s #%u took %.1f us of a %.1f us block (%.0f%%, %llu overruns so far). Inputs: %s"),
+                        Stats->NodeClass,
+                        Stats->InstanceId,
+                        OverrunMicroseconds,
+                        Stats->BlockSeconds * 1.0e6,
+                        100.0 * OverrunMicroseconds / (Stats->BlockSeconds * 1.0e6),
+                        Stats->NumOverruns.load(),
+                        *DescribeInputs(Stats->OverrunInputs));
+                }
+
+                Stats->bOverrunPending.store(false, std::memory_order_release);
+            }
+
+            return true;
+        }
+
+        // au.Branches.Stats [count] [peak] [reset]
+        void PrintStats(const TArray<FString>& Args, FOutputDevice& Output)
+        {
+            int32 MaxRows = 20;
+            bool bSortByPeak = false;
+
+            for (const FString& Arg : Args)
+            {
+                if (Arg.Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+                {
+                    ResetGeneration.fetch_add(1, std::memory_order_relaxed);
+                    Output.Log(TEXT("Branches instance stats reset; each instance starts over from its next block."));
+                    return;
+                }
+                else if (Arg.Equals(TEXT("peak"), ESearchCase::IgnoreCase))
+                {
+                    bSortByPeak = true;
+                }
+                else if (Arg.IsNumeric())
+                {
+                    MaxRows = FMath::Max(1, FCString::Atoi(*Arg));
+                }
+            }
+
+            struct FRow
+            {
+                FStatsPtr Stats;
+                double AverageMicroseconds;
+                double PeakMicroseconds;
+            };
+
+            TArray<FRow> Rows;
+            for (const FStatsPtr& Stats : GetInstances())
+            {
+                const uint64 NumBlocks = Stats->NumBlocks.load();
+                if (NumBlocks > 0)
+                {
+                    Rows.Add({ Stats, CyclesToMicroseconds(static_cast<double>(Stats->TotalCycles.load()) / NumBlocks), CyclesToMicroseconds(static_cast<double>(Stats->PeakCycles.load())) });
+                }
+            }
+
+            Rows.Sort([bSortByPeak](const FRow& A, const FRow& B)
+            {
+                return bSortByPeak ? A.PeakMicroseconds > B.PeakMicroseconds : A.AverageMicroseconds > B.AverageMicroseconds;
+            });
+
+            if (!bEnabled && Rows.Num() == 0)
+            {
+                Output.Log(TEXT("No Branches operator instances are tracked. Set au.Branches.Stats.Enabled 1, then rebuild the graphs to track."));
+                return;
+            }
+
+            Output.Logf(TEXT("Branches operator instances: %d live, sorted by %s us per block (overrun share %.2f)"), Rows.Num(), bSortByPeak ? TEXT("peak") : TEXT("average"), OverrunShare);
+            Output.Logf(TEXT("%-24s %8s %6s %10s %10s %8s %10s %10s"), TEXT("Node"), TEXT("Instance"), TEXT("Block"), TEXT("Avg us"), TEXT("Peak us"), TEXT("Load %"), TEXT("Overruns"), TEXT("Blocks"));
+
+            for (int32 Index = 0; Index < FMath::Min(MaxRows, Rows.Num()); ++Index)
+            {
+                const FRow& Row = Rows[Index];
+                Output.Logf(TEXT("%-24s %8u %6d %10.2f %10.2f %8.2f %10llu %10llu"),
+                    Row.Stats->NodeClass,
+                    Row.Stats->InstanceId,
+                    Row.Stats->BlockSize,
+                    Row.AverageMicroseconds,
+                    Row.PeakMicroseconds,
+                    100.0 * Row.AverageMicroseconds / (Row.Stats->BlockSeconds * 1.0e6),
+                    Row.Stats->NumOverruns.load(),
+                    Row.Stats->NumBlocks.load());
+            }
+        }
+
+        FAutoConsoleCommandWithArgsAndOutputDevice StatsCommand(
+            TEXT("au.Branches.Stats"),
+            TEXT("Lists the most expensive live Branches operator instances. Usage: au.Branches.Stats [count] [peak] [reset]"),
+            FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&PrintStats));
+    }
+
+    FInstanceStats::FInstanceStats(const TCHAR* InNodeClass, const Metasound::FOperatorSettings& InSettings, FCaptureInputsFunction&& InCaptureInputs)
+        : NodeClass(InNodeClass)
+        , InstanceId(InstanceStatsPrivate::NextInstanceId.fetch_add(1))
+        , BlockSize(InSettings.GetNumFramesPerBlock())
+        , BlockSeconds(static_cast<double>(InSettings.GetNumFramesPerBlock()) / InSettings.GetSampleRate())
+        , ResetGeneration(InstanceStatsPrivate::ResetGeneration.load(std::memory_order_relaxed))
+        , CaptureInputs(MoveTemp(InCaptureInputs))
+    {
+    }
+
+    void FInstanceStats::AddBlock(uint64 Cycles)
+    {
+        const uint32 RequestedReset = InstanceStatsPrivate::ResetGeneration.load(std::memory_order_relaxed);
+        if (RequestedReset != ResetGeneration)
+        {
+            ResetGeneration = RequestedReset;
+            NumBlocks.store(0, std::memory_order_relaxed);
+            TotalCycles.store(0, std::memory_order_relaxed);
+            PeakCycles.store(0, std::memory_order_relaxed);
+            NumOverruns.store(0, std::memory_order_relaxed);
+        }
+
+        // Only the render thread writes, so plain loads and stores are enough
+        NumBlocks.store(NumBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        TotalCycles.store(TotalCycles.load(std::memory_order_relaxed) + Cycles, std::memory_order_relaxed);
+
+        if (Cycles > PeakCycles.load(std::memory_order_relaxed))
+        {
+            PeakCycles.store(Cycles, std::memory_order_relaxed);
+        }
+
+        const double BudgetCycles = BlockSeconds * InstanceStatsPrivate::OverrunShare / FPlatformTime::GetSecondsPerCycle64();
+        if (static_cast<double>(Cycles) > BudgetCycles)
+        {
+            NumOverruns.store(NumOverruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+            // Keep the first overrun until the game thread has logged it
+            if (!bOverrunPending.load(std::memory_order_acquire))
+            {
+                OverrunCycles = Cycles;
+                OverrunInputs.Reset();
+                if (CaptureInputs)
+                {
+                    CaptureInputs(OverrunInputs);
+                }
+                bOverrunPending.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    bool AreInstanceStatsEnabled()
+    {
+        return InstanceStatsPrivate::bEnabled;
+    }
+
+    void FInstanceStatsHandle::Register(const TCHAR* NodeClass, const Metasound::FOperatorSettings& Settings, FCaptureInputsFunction&& CaptureInputs)
+    {
+        Stats = MakeShared<FInstanceStats, ESPMode::ThreadSafe>(NodeClass, Settings, MoveTemp(CaptureInputs));
+
+        FScopeLock Lock(&InstanceStatsPrivate::InstancesLock);
+        Stats->RegistryIndex = InstanceStatsPrivate::Instances.Add(Stats);
+    }
+
+    FInstanceStatsHandle::~FInstanceStatsHandle()
+    {
+        if (!Stats.IsValid())
+        {
+            return;
+        }
+
+        // Swap-and-pop by the stored index, so tearing down a graph of thousands of operators doesn't scan every
+        // live instance under the lock for each one
+        FScopeLock Lock(&InstanceStatsPrivate::InstancesLock);
+
+        TArray<InstanceStatsPrivate::FStatsPtr>& Instances = InstanceStatsPrivate::Instances;
+        const int32 Index = Stats->RegistryIndex;
+
+        Instances.RemoveAtSwap(Index);
+        if (Instances.IsValidIndex(Index))
+        {
+            Instances[Index]->RegistryIndex = Index;
+        }
+    }
+
+    void StartInstanceStatsLogging()
+    {
+        InstanceStatsPrivate::TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&InstanceStatsPrivate::LogOverruns), 0.25f);
+    }
+
+    void StopInstanceStatsLogging()
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(InstanceStatsPrivate::TickerHandle);
+        InstanceStatsPrivate::TickerHandle.Reset();
+    }
+}
+
+#endif
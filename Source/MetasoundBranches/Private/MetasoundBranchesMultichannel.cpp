@@ -0,0 +1,111 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundBranchesMultichannel.h"
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundAudioBuffer.h"            // FAudioBuffer
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT macro
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_Multichannel"
+
+namespace MetasoundBranches::Multichannel
+{
+    using namespace Metasound;
+
+    namespace MultichannelNodeNames
+    {
+        METASOUND_PARAM(InputSignal1, "In 1", "Input channel 1.");
+        METASOUND_PARAM(InputSignal2, "In 2", "Input channel 2.");
+        METASOUND_PARAM(InputSignal3, "In 3", "Input channel 3.");
+        METASOUND_PARAM(InputSignal4, "In 4", "Input channel 4.");
+        METASOUND_PARAM(InputSignal5, "In 5", "Input channel 5.");
+        METASOUND_PARAM(InputSignal6, "In 6", "Input channel 6.");
+        METASOUND_PARAM(InputSignal7, "In 7", "Input channel 7.");
+        METASOUND_PARAM(InputSignal8, "In 8", "Input channel 8.");
+
+        METASOUND_PARAM(OutputSignal1, "Out 1", "Output channel 1.");
+        METASOUND_PARAM(OutputSignal2, "Out 2", "Output channel 2.");
+        METASOUND_PARAM(OutputSignal3, "Out 3", "Output channel 3.");
+        METASOUND_PARAM(OutputSignal4, "Out 4", "Output channel 4.");
+        METASOUND_PARAM(OutputSignal5, "Out 5", "Output channel 5.");
+        METASOUND_PARAM(OutputSignal6, "Out 6", "Output channel 6.");
+        METASOUND_PARAM(OutputSignal7, "Out 7", "Output channel 7.");
+        METASOUND_PARAM(OutputSignal8, "Out 8", "Output channel 8.");
+    }
+
+    const TCHAR* GetInputName(int32 Channel)
+    {
+        using namespace MultichannelNodeNames;
+
+        static const TCHAR* const Names[MaxChannels] =
+        {
+            METASOUND_GET_PARAM_NAME(InputSignal1), METASOUND_GET_PARAM_NAME(InputSignal2),
+            METASOUND_GET_PARAM_NAME(InputSignal3), METASOUND_GET_PARAM_NAME(InputSignal4),
+            METASOUND_GET_PARAM_NAME(InputSignal5), METASOUND_GET_PARAM_NAME(InputSignal6),
+            METASOUND_GET_PARAM_NAME(InputSignal7), METASOUND_GET_PARAM_NAME(InputSignal8)
+        };
+
+        return Names[Channel];
+    }
+
+    const TCHAR* GetOutputName(int32 Channel)
+    {
+        using namespace MultichannelNodeNames;
+
+        static const TCHAR* const Names[MaxChannels] =
+        {
+            METASOUND_GET_PARAM_NAME(OutputSignal1), METASOUND_GET_PARAM_NAME(OutputSignal2),
+            METASOUND_GET_PARAM_NAME(OutputSignal3), METASOUND_GET_PARAM_NAME(OutputSignal4),
+            METASOUND_GET_PARAM_NAME(OutputSignal5), METASOUND_GET_PARAM_NAME(OutputSignal6),
+            METASOUND_GET_PARAM_NAME(OutputSignal7), METASOUND_GET_PARAM_NAME(OutputSignal8)
+        };
+
+        return Names[Channel];
+    }
+
+    void AddInputVertices(FInputVertexInterface& OutInterface, int32 NumChannels)
+    {
+        using namespace MultichannelNodeNames;
+
+        const TInputDataVertexModel<FAudioBuffer> Vertices[MaxChannels] =
+        {
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal1)),
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal2)),
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal3)),
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal4)),
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal5)),
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal6)),
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal7)),
+            TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal8))
+        };
+
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            OutInterface.Add(Vertices[Channel]);
+        }
+    }
+
+    void AddOutputVertices(FOutputVertexInterface& OutInterface, int32 NumChannels)
+    {
+        using namespace MultichannelNodeNames;
+
+        const TOutputDataVertexModel<FAudioBuffer> Vertices[MaxChannels] =
+        {
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal1)),
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal2)),
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal3)),
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal4)),
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal5)),
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal6)),
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal7)),
+            TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal8))
+        };
+
+        for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            OutInterface.Add(Vertices[Channel]);
+        }
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,183 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundBranchesRebuildWorker.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+namespace MetasoundBranches
+{
+    namespace RebuildWorkerPrivate
+    {
+        using Kernels::IRebuildTask;
+
+        // How often the worker checks for flagged work while any slot is registered
+        constexpr uint32 PollIntervalMs = 5;
+
+        class FRebuildWorker final : public Kernels::IRebuildScheduler, public FRunnable
+        {
+        public:
+            virtual void Register(IRebuildTask* Task) override
+            {
+                FScopeLock Lock(&TasksLock);
+                Tasks.Add(Task);
+
+                if (Thread == nullptr)
+                {
+                    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+                    bStopping = false;
+                    NextIndex = 0;
+                    Thread = FRunnableThread::Create(this, TEXT("BranchesRebuildWorker"), 0, TPri_BelowNormal);
+                }
+
+                // Off the audio thread, so the worker can be woken from its idle wait to start polling
+                WakeEvent->Trigger();
+            }
+
+            virtual void Unregister(IRebuildTask* Task) override
+            {
+                FScopeLock Lock(&TasksLock);
+
+                // In order, so the pass under way still reaches every task after this one
+                const int32 Index = Tasks.Find(Task);
+                if (Index != INDEX_NONE)
+                {
+                    Tasks.RemoveAt(Index);
+                    if (Index < NextIndex)
+                    {
+                        --NextIndex;
+                    }
+                }
+
+                // The worker holds BuildLock until the task's rebuild is done, and can't step to the next task while
+                // TasksLock is held here, so this only ever waits for this task's own rebuild
+                if (RunningTask == Task)
+                {
+                    FScopeLock Wait(&BuildLock);
+                }
+            }
+
+            virtual void FlagWork() override
+            {
+                bWorkPending.store(true, std::memory_order_release);
+            }
+
+            // Joins the thread. Every slot is gone by then, so no work is flagged afterwards.
+            void Shutdown()
+            {
+                FRunnableThread* StoppingThread = nullptr;
+                {
+                    FScopeLock Lock(&TasksLock);
+                    StoppingThread = Thread;
+                    Thread = nullptr;
+                }
+
+                if (StoppingThread != nullptr)
+                {
+                    // Calls Stop() and waits for Run() to return
+                    StoppingThread->Kill(true);
+                    delete StoppingThread;
+
+                    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+                    WakeEvent = nullptr;
+                }
+            }
+
+            virtual uint32 Run() override
+            {
+                while (!bStopping)
+                {
+                    // Sleeps until a slot registers while there are none, then polls for flagged work
+                    WakeEvent->Wait(HasTasks() ? PollIntervalMs : MAX_uint32);
+
+                    if (bWorkPending.exchange(false, std::memory_order_acq_rel))
+                    {
+                        RunTasks();
+                    }
+                }
+
+                return 0;
+            }
+
+            virtual void Stop() override
+            {
+                bStopping = true;
+                WakeEvent->Trigger();
+            }
+
+        private:
+            bool HasTasks()
+            {
+                FScopeLock Lock(&TasksLock);
+                return Tasks.Num() > 0;
+            }
+
+            // One pass over the tasks. TasksLock is only held to step from one task to the next, so operators can be
+            // built and destroyed meanwhile; work flagged during the pass is picked up by the next one.
+            void RunTasks()
+            {
+                while (!bStopping)
+                {
+                    IRebuildTask* Task = nullptr;
+                    {
+                        FScopeLock Lock(&TasksLock);
+
+                        RunningTask = nullptr;
+
+                        if (NextIndex >= Tasks.Num())
+                        {
+                            NextIndex = 0;
+                            return;
+                        }
+
+                        Task = Tasks[NextIndex++];
+                        RunningTask = Task;
+
+                        // Taken before TasksLock is released, so Unregister() can't miss the rebuild
+                        BuildLock.Lock();
+                    }
+
+                    Task->RunRebuild();
+                    BuildLock.Unlock();
+                }
+            }
+
+            // Both live as long as the thread
+            FEvent* WakeEvent = nullptr;
+            FRunnableThread* Thread = nullptr;
+
+            std::atomic<bool> bStopping { false };
+
+            // Set by the audio thread through FlagWork(), cleared by the worker before each pass
+            std::atomic<bool> bWorkPending { false };
+
+            // Guards Tasks, NextIndex, RunningTask and Thread
+            FCriticalSection TasksLock;
+            TArray<IRebuildTask*> Tasks;
+            int32 NextIndex = 0;
+            IRebuildTask* RunningTask = nullptr;
+
+            // Held by the worker while RunningTask rebuilds
+            FCriticalSection BuildLock;
+        };
+
+        FRebuildWorker& GetWorker()
+        {
+            static FRebuildWorker Worker;
+            return Worker;
+        }
+    }
+
+    Kernels::IRebuildScheduler& GetRebuildWorker()
+    {
+        return RebuildWorkerPrivate::GetWorker();
+    }
+
+    void StopRebuildWorker()
+    {
+        RebuildWorkerPrivate::GetWorker().Shutdown();
+    }
+}
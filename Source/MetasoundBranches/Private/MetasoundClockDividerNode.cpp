@@ -7,9 +7,15 @@
 #include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/ClockKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ClockDividerNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(ClockDivider, "Clock Divider");
+
 namespace Metasound
 {
     namespace ClockDividerNodeNames
@@ -44,7 +50,7 @@ namespace Metasound
             , OutputTrigger6(FTriggerWriteRef::CreateNew(InSettings))
             , OutputTrigger7(FTriggerWriteRef::CreateNew(InSettings))
             , OutputTrigger8(FTriggerWriteRef::CreateNew(InSettings))
-            , Counter(0)
+            , InstanceStats(TEXT("ClockDivider"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -98,45 +104,36 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ClockDividerNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputReset), InputReset);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputReset), InputReset);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ClockDividerNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger1), OutputTrigger1);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger2), OutputTrigger2);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger3), OutputTrigger3);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger4), OutputTrigger4);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger5), OutputTrigger5);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger6), OutputTrigger6);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger7), OutputTrigger7);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger8), OutputTrigger8);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger1), OutputTrigger1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger2), OutputTrigger2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger3), OutputTrigger3);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger4), OutputTrigger4);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger5), OutputTrigger5);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger6), OutputTrigger6);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger7), OutputTrigger7);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger8), OutputTrigger8);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace ClockDividerNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FTrigger> InputTrigger = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
-            TDataReadReference<FTrigger> InputReset = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InputReset), InParams.OperatorSettings);
+            TDataReadReference<FTrigger> InputTrigger = InputData.GetOrCreateDefaultDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
+            TDataReadReference<FTrigger> InputReset = InputData.GetOrCreateDefaultDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputReset), InParams.OperatorSettings);
 
             return MakeUnique<FClockDividerOperator>(
                 InParams.OperatorSettings,
@@ -145,8 +142,40 @@ namespace Metasound
             );
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear the counter and any pending output triggers
+            State.Reset();
+
+            OutputTrigger1->Reset();
+            OutputTrigger2->Reset();
+            OutputTrigger3->Reset();
+            OutputTrigger4->Reset();
+            OutputTrigger5->Reset();
+            OutputTrigger6->Reset();
+            OutputTrigger7->Reset();
+            OutputTrigger8->Reset();
+        }
+
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(ClockDivider);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            FTrigger* const OutputTriggers[ClockDividerNumOutputs] =
+            {
+                &*OutputTrigger1,
+                &*OutputTrigger2,
+                &*OutputTrigger3,
+                &*OutputTrigger4,
+                &*OutputTrigger5,
+                &*OutputTrigger6,
+                &*OutputTrigger7,
+                &*OutputTrigger8
+            };
+
             // Handle reset
             InputReset->ExecuteBlock(
                 // Pre-trigger lambda
@@ -158,19 +187,15 @@ namespace Metasound
                 // On-trigger lambda
                 [&](int32 StartFrame, int32 EndFrame)
                 {
-                    Counter = 0;
+                    State.Reset();
                 }
             );
 
             // Initialize output triggers
-            OutputTrigger1->AdvanceBlock();
-            OutputTrigger2->AdvanceBlock();
-            OutputTrigger3->AdvanceBlock();
-            OutputTrigger4->AdvanceBlock();
-            OutputTrigger5->AdvanceBlock();
-            OutputTrigger6->AdvanceBlock();
-            OutputTrigger7->AdvanceBlock();
-            OutputTrigger8->AdvanceBlock();
+            for (FTrigger* OutputTrigger : OutputTriggers)
+            {
+                OutputTrigger->AdvanceBlock();
+            }
 
             // Handle input trigger
             InputTrigger->ExecuteBlock(
@@ -183,61 +208,27 @@ namespace Metasound
                 // On-trigger lambda
                 [&](int32 StartFrame, int32 EndFrame)
                 {
-                    Counter = (Counter + 1) % 8;
+                    const uint32 OutputMask = AdvanceClockDivider(State);
 
-                    switch (Counter)
+                    for (int32 OutputIndex = 0; OutputIndex < ClockDividerNumOutputs; ++OutputIndex)
                     {
-                        case 0:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            break;
-
-                        case 1:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            break;
-
-                        case 2:
-                            OutputTrigger1->TriggerFrame(StartFrame); 
-                            OutputTrigger3->TriggerFrame(StartFrame);
-                            break;
-
-                        case 3:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            OutputTrigger4->TriggerFrame(StartFrame);
-                            break;
-
-                        case 4:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger5->TriggerFrame(StartFrame);
-                            break;
-
-                        case 5:
-                            OutputTrigger1->TriggerFrame(StartFrame);  
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            OutputTrigger3->TriggerFrame(StartFrame);
-                            OutputTrigger6->TriggerFrame(StartFrame);
-                            break;
-
-                        case 6:
-                            OutputTrigger1->TriggerFrame(StartFrame);
-                            OutputTrigger7->TriggerFrame(StartFrame);
-                            break;
-
-                        case 7:
-                            OutputTrigger1->TriggerFrame(StartFrame);
-                            OutputTrigger2->TriggerFrame(StartFrame);
-                            OutputTrigger4->TriggerFrame(StartFrame);
-                            OutputTrigger8->TriggerFrame(StartFrame);
-                            break;
-
-                        default:
-                            break;
+                        if (OutputMask & (1u << OutputIndex))
+                        {
+                            OutputTriggers[OutputIndex]->TriggerFrame(StartFrame);
+                        }
                     }
                 }
             );
         }
 
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace ClockDividerNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTrigger), *InputTrigger);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputReset), *InputReset);
+        }
+
     private:
         FTriggerReadRef InputTrigger;
         FTriggerReadRef InputReset;
@@ -251,9 +242,13 @@ namespace Metasound
         FTriggerWriteRef OutputTrigger7;
         FTriggerWriteRef OutputTrigger8;
 
-        int32 Counter;
+        MetasoundBranches::Kernels::FClockDividerState State;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FClockDividerOperator);
+
     class FClockDividerNode : public FNodeFacade
     {
     public:
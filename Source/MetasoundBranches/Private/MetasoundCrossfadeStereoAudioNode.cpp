@@ -0,0 +1,245 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundCrossfadeStereoAudioNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "Misc/Optional.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_CrossfadeStereoAudioNode"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoCrossfadeAudio, "Stereo Crossfade (Audio)");
+
+namespace Metasound
+{
+    namespace CrossfadeStereoAudioNodeNames
+    {
+        METASOUND_PARAM(InputLeftSignal1, "In1 L", "Left channel of first input.");
+        METASOUND_PARAM(InputRightSignal1, "In1 R", "Right channel of first input.");
+        METASOUND_PARAM(InputLeftSignal2, "In2 L", "Left channel of second input.");
+        METASOUND_PARAM(InputRightSignal2, "In2 R", "Right channel of second input.");
+        METASOUND_PARAM(InputCrossfade, "Crossfade", "Audio-rate crossfade between the two inputs (0.0 to 1.0), applied per sample.");
+
+        METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel of the output signal.");
+        METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel of the output signal.");
+    }
+
+    class FCrossfadeStereoAudioOperator : public TExecutableOperator<FCrossfadeStereoAudioOperator>
+    {
+    public:
+        FCrossfadeStereoAudioOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InLeftSignal1,
+            const FAudioBufferReadRef& InRightSignal1,
+            const FAudioBufferReadRef& InLeftSignal2,
+            const FAudioBufferReadRef& InRightSignal2,
+            const FAudioBufferReadRef& InCrossfade,
+            bool bInPassthrough)
+            : InputLeftSignal1(InLeftSignal1)
+            , InputRightSignal1(InRightSignal1)
+            , InputLeftSignal2(InLeftSignal2)
+            , InputRightSignal2(InRightSignal2)
+            , InputCrossfade(InCrossfade)
+            , bPassthrough(bInPassthrough)
+            , InstanceStats(TEXT("StereoCrossfadeAudio"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                OutputLeftSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+                OutputRightSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+            }
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace CrossfadeStereoAudioNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal1)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal1)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal2)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal2)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputCrossfade))
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, TEXT("Stereo Crossfade (Audio)"), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = METASOUND_LOCTEXT("CrossfadeStereoAudioNodeDisplayName", "Stereo Crossfade (Audio)");
+                    Metadata.Description = METASOUND_LOCTEXT("CrossfadeStereoAudioNodeDesc", "Crossfades between two stereo signals with audio-rate modulation.");
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>(); // Keywords for searching
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace CrossfadeStereoAudioNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal1), InputLeftSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal1), InputRightSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InputLeftSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal2), InputRightSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCrossfade), InputCrossfade);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace CrossfadeStereoAudioNodeNames;
+
+            if (IsPassthrough())
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal1);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal1);
+            }
+            else
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), *OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), *OutputRightSignal);
+            }
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace CrossfadeStereoAudioNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal1 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal1), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal1 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal1), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputLeftSignal2 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal2 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal2), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputCrossfade = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputCrossfade), InParams.OperatorSettings);
+
+            // An unconnected crossfade is silence, i.e. the first input throughout, so that input passes through
+            const bool bPassthrough = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputCrossfade));
+
+            return MakeUnique<FCrossfadeStereoAudioOperator>(InParams.OperatorSettings, InputLeftSignal1, InputRightSignal1, InputLeftSignal2, InputRightSignal2, InputCrossfade, bPassthrough);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            (*OutputLeftSignal)->Zero();
+            (*OutputRightSignal)->Zero();
+        }
+
+        void Execute()
+        {
+            // The outputs are bound to the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoCrossfadeAudio);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = InputLeftSignal1->Num();
+
+            const float* LeftData1 = InputLeftSignal1->GetData();
+            const float* RightData1 = InputRightSignal1->GetData();
+            const float* LeftData2 = InputLeftSignal2->GetData();
+            const float* RightData2 = InputRightSignal2->GetData();
+            const float* CrossfadeData = InputCrossfade->GetData();
+
+            float* OutputLeftData = (*OutputLeftSignal)->GetData();
+            float* OutputRightData = (*OutputRightSignal)->GetData();
+
+            // Equal-power mix of the first and second inputs with gains for every frame, read from the shared
+            // quarter-sine table
+            ProcessStereoCrossfadeAudio(
+                LeftData1, RightData1,
+                LeftData2, RightData2,
+                CrossfadeData, OutputLeftData, OutputRightData, NumFrames);
+        }
+
+        bool IsPassthrough() const
+        {
+            return bPassthrough;
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace CrossfadeStereoAudioNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal1), *InputLeftSignal1);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal1), *InputRightSignal1);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal2), *InputLeftSignal2);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal2), *InputRightSignal2);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputCrossfade), *InputCrossfade);
+        }
+
+    private:
+
+        // Inputs
+        FAudioBufferReadRef InputLeftSignal1;
+        FAudioBufferReadRef InputRightSignal1;
+        FAudioBufferReadRef InputLeftSignal2;
+        FAudioBufferReadRef InputRightSignal2;
+        FAudioBufferReadRef InputCrossfade;
+
+        // Outputs, unset in passthrough
+        TOptional<FAudioBufferWriteRef> OutputLeftSignal;
+        TOptional<FAudioBufferWriteRef> OutputRightSignal;
+
+        // Outputs bound to the first input, decided at build time
+        bool bPassthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(FCrossfadeStereoAudioOperator);
+
+    class FCrossfadeStereoAudioNode : public FNodeFacade
+    {
+    public:
+        FCrossfadeStereoAudioNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FCrossfadeStereoAudioOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FCrossfadeStereoAudioNode);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,344 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundCrossfadeStereoMultiNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "Misc/Optional.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_CrossfadeStereoMultiNode"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoCrossfadeMulti, "Stereo Crossfade (Multi)");
+
+namespace Metasound
+{
+    namespace CrossfadeStereoMultiNodeNames
+    {
+        // The variants use the first NumInputs pairs
+        METASOUND_PARAM(InputLeftSignal1, "In1 L", "Left channel of input 1.");
+        METASOUND_PARAM(InputRightSignal1, "In1 R", "Right channel of input 1.");
+        METASOUND_PARAM(InputLeftSignal2, "In2 L", "Left channel of input 2.");
+        METASOUND_PARAM(InputRightSignal2, "In2 R", "Right channel of input 2.");
+        METASOUND_PARAM(InputLeftSignal3, "In3 L", "Left channel of input 3.");
+        METASOUND_PARAM(InputRightSignal3, "In3 R", "Right channel of input 3.");
+        METASOUND_PARAM(InputLeftSignal4, "In4 L", "Left channel of input 4.");
+        METASOUND_PARAM(InputRightSignal4, "In4 R", "Right channel of input 4.");
+        METASOUND_PARAM(InputLeftSignal5, "In5 L", "Left channel of input 5.");
+        METASOUND_PARAM(InputRightSignal5, "In5 R", "Right channel of input 5.");
+        METASOUND_PARAM(InputLeftSignal6, "In6 L", "Left channel of input 6.");
+        METASOUND_PARAM(InputRightSignal6, "In6 R", "Right channel of input 6.");
+        METASOUND_PARAM(InputLeftSignal7, "In7 L", "Left channel of input 7.");
+        METASOUND_PARAM(InputRightSignal7, "In7 R", "Right channel of input 7.");
+        METASOUND_PARAM(InputLeftSignal8, "In8 L", "Left channel of input 8.");
+        METASOUND_PARAM(InputRightSignal8, "In8 R", "Right channel of input 8.");
+        METASOUND_PARAM(InputPosition, "Position", "Position across the inputs, from 0.0 (In1) to the number of inputs minus one. Between two whole numbers the adjacent inputs are crossfaded with equal power. Changes ramp over one block.");
+
+        METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel of the output signal.");
+        METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel of the output signal.");
+
+        constexpr int32 MaxInputs = 8;
+
+        const TCHAR* GetInputLeftName(int32 Index)
+        {
+            static const TCHAR* const Names[MaxInputs] =
+            {
+                METASOUND_GET_PARAM_NAME(InputLeftSignal1), METASOUND_GET_PARAM_NAME(InputLeftSignal2),
+                METASOUND_GET_PARAM_NAME(InputLeftSignal3), METASOUND_GET_PARAM_NAME(InputLeftSignal4),
+                METASOUND_GET_PARAM_NAME(InputLeftSignal5), METASOUND_GET_PARAM_NAME(InputLeftSignal6),
+                METASOUND_GET_PARAM_NAME(InputLeftSignal7), METASOUND_GET_PARAM_NAME(InputLeftSignal8)
+            };
+
+            return Names[Index];
+        }
+
+        const TCHAR* GetInputRightName(int32 Index)
+        {
+            static const TCHAR* const Names[MaxInputs] =
+            {
+                METASOUND_GET_PARAM_NAME(InputRightSignal1), METASOUND_GET_PARAM_NAME(InputRightSignal2),
+                METASOUND_GET_PARAM_NAME(InputRightSignal3), METASOUND_GET_PARAM_NAME(InputRightSignal4),
+                METASOUND_GET_PARAM_NAME(InputRightSignal5), METASOUND_GET_PARAM_NAME(InputRightSignal6),
+                METASOUND_GET_PARAM_NAME(InputRightSignal7), METASOUND_GET_PARAM_NAME(InputRightSignal8)
+            };
+
+            return Names[Index];
+        }
+
+        // Audio input vertices of the first NumInputs inputs, left then right for each
+        FInputVertexInterface MakeInputInterface(int32 NumInputs)
+        {
+            const TInputDataVertexModel<FAudioBuffer> Vertices[MaxInputs * 2] =
+            {
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal1)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal1)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal2)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal2)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal3)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal3)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal4)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal4)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal5)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal5)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal6)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal6)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal7)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal7)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal8)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal8))
+            };
+
+            FInputVertexInterface Interface;
+            for (int32 Index = 0; Index < NumInputs * 2; ++Index)
+            {
+                Interface.Add(Vertices[Index]);
+            }
+
+            Interface.Add(TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputPosition), 0.0f));
+            return Interface;
+        }
+    }
+
+    // Crossfades across NumInputs stereo inputs. Only the pair around the position is processed, so the cost doesn't
+    // grow with the number of inputs the way a cascade of Stereo Crossfade nodes does.
+    template<int32 NumInputs>
+    class TCrossfadeStereoMultiOperator : public TExecutableOperator<TCrossfadeStereoMultiOperator<NumInputs>>
+    {
+        static_assert(NumInputs >= 2 && NumInputs <= CrossfadeStereoMultiNodeNames::MaxInputs, "Unsupported number of inputs");
+
+    public:
+        TCrossfadeStereoMultiOperator(
+            const FOperatorSettings& InSettings,
+            TArray<FAudioBufferReadRef>&& InLeftSignals,
+            TArray<FAudioBufferReadRef>&& InRightSignals,
+            const FFloatReadRef& InPosition,
+            int32 InPassthroughInput)
+            : InputLeftSignals(MoveTemp(InLeftSignals))
+            , InputRightSignals(MoveTemp(InRightSignals))
+            , InputPosition(InPosition)
+            , Position(GetClampedPosition())
+            , PassthroughInput(InPassthroughInput)
+            , InstanceStats(TEXT("StereoCrossfadeMulti"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                OutputLeftSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+                OutputRightSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+            }
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace CrossfadeStereoMultiNodeNames;
+
+            static const FVertexInterface Interface(
+                MakeInputInterface(NumInputs),
+                FOutputVertexInterface(
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    const FString NodeName = FString::Printf(TEXT("Stereo Crossfade (%d)"), NumInputs);
+
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, FName(*NodeName), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = FText::Format(METASOUND_LOCTEXT("CrossfadeStereoMultiNodeDisplayName", "Stereo Crossfade ({0})"), NumInputs);
+                    Metadata.Description = FText::Format(METASOUND_LOCTEXT("CrossfadeStereoMultiNodeDesc", "Crossfades across {0} stereo signals, processing only the two either side of the position."), NumInputs);
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>(); // Keywords for searching
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace CrossfadeStereoMultiNodeNames;
+
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                InOutVertexData.BindReadVertex(GetInputLeftName(Index), InputLeftSignals[Index]);
+                InOutVertexData.BindReadVertex(GetInputRightName(Index), InputRightSignals[Index]);
+            }
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputPosition), InputPosition);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace CrossfadeStereoMultiNodeNames;
+
+            if (IsPassthrough())
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignals[PassthroughInput]);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignals[PassthroughInput]);
+            }
+            else
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), *OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), *OutputRightSignal);
+            }
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace CrossfadeStereoMultiNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TArray<FAudioBufferReadRef> InputLeftSignals;
+            TArray<FAudioBufferReadRef> InputRightSignals;
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                InputLeftSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(GetInputLeftName(Index), InParams.OperatorSettings));
+                InputRightSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(GetInputRightName(Index), InParams.OperatorSettings));
+            }
+
+            TDataReadReference<float> InputPosition = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputPosition), InParams.OperatorSettings);
+
+            // A position that can't change and sits on a whole number passes that input through
+            int32 PassthroughInput = INDEX_NONE;
+            if (MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputPosition)))
+            {
+                const float ClampedPosition = FMath::Clamp(*InputPosition, 0.0f, static_cast<float>(NumInputs - 1));
+                if (ClampedPosition == FMath::FloorToFloat(ClampedPosition))
+                {
+                    PassthroughInput = static_cast<int32>(ClampedPosition);
+                }
+            }
+
+            return MakeUnique<TCrossfadeStereoMultiOperator<NumInputs>>(InParams.OperatorSettings, MoveTemp(InputLeftSignals), MoveTemp(InputRightSignals), InputPosition, PassthroughInput);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            // Start from the current position rather than ramping into the first block
+            Position = GetClampedPosition();
+
+            (*OutputLeftSignal)->Zero();
+            (*OutputRightSignal)->Zero();
+        }
+
+        void Execute()
+        {
+            // The outputs are bound to one of the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoCrossfadeMulti);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = (*OutputLeftSignal)->Num();
+
+            const float* LeftData[NumInputs];
+            const float* RightData[NumInputs];
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                LeftData[Index] = InputLeftSignals[Index]->GetData();
+                RightData[Index] = InputRightSignals[Index]->GetData();
+            }
+
+            // Equal-power mix of the pair either side of the position; a change of position ramps the gains across
+            // the block
+            ProcessStereoCrossfadeN(Position, LeftData, RightData, NumInputs, *InputPosition, (*OutputLeftSignal)->GetData(), (*OutputRightSignal)->GetData(), NumFrames);
+        }
+
+        bool IsPassthrough() const
+        {
+            return PassthroughInput != INDEX_NONE;
+        }
+
+        float GetClampedPosition() const
+        {
+            return MetasoundBranches::Kernels::Clamp(*InputPosition, 0.0f, static_cast<float>(NumInputs - 1));
+        }
+
+        // The position goes first, as the inputs of the eight-way variant fill the snapshot
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace CrossfadeStereoMultiNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputPosition), *InputPosition);
+
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                OutInputs.Add(GetInputLeftName(Index), *InputLeftSignals[Index]);
+                OutInputs.Add(GetInputRightName(Index), *InputRightSignals[Index]);
+            }
+        }
+
+    private:
+
+        // Inputs
+        TArray<FAudioBufferReadRef> InputLeftSignals;
+        TArray<FAudioBufferReadRef> InputRightSignals;
+        FFloatReadRef InputPosition;
+
+        // Outputs, unset in passthrough
+        TOptional<FAudioBufferWriteRef> OutputLeftSignal;
+        TOptional<FAudioBufferWriteRef> OutputRightSignal;
+
+        // Clamped position applied at the end of the last block
+        float Position;
+
+        // Input the outputs are bound to, decided at build time, or INDEX_NONE
+        int32 PassthroughInput;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(TCrossfadeStereoMultiOperator<4>);
+
+    template<int32 NumInputs>
+    class TCrossfadeStereoMultiNode : public FNodeFacade
+    {
+    public:
+        TCrossfadeStereoMultiNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<TCrossfadeStereoMultiOperator<NumInputs>>())
+        {
+        }
+    };
+
+    using FCrossfadeStereo4Node = TCrossfadeStereoMultiNode<4>;
+    using FCrossfadeStereo8Node = TCrossfadeStereoMultiNode<8>;
+
+    METASOUND_REGISTER_NODE(FCrossfadeStereo4Node);
+    METASOUND_REGISTER_NODE(FCrossfadeStereo8Node);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -7,9 +7,17 @@
 #include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "Misc/Optional.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_CrossfadeStereoNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoCrossfade, "Stereo Crossfade");
+
 namespace Metasound
 {
     namespace CrossfadeStereoNodeNames
@@ -18,7 +26,7 @@ namespace Metasound
         METASOUND_PARAM(InputRightSignal1, "In1 R", "Right channel of first input.");
         METASOUND_PARAM(InputLeftSignal2, "In2 L", "Left channel of second input.");
         METASOUND_PARAM(InputRightSignal2, "In2 R", "Right channel of second input.");
-        METASOUND_PARAM(InputCrossfade, "Crossfade", "Crossfade between the two inputs (0.0 to 1.0).");
+        METASOUND_PARAM(InputCrossfade, "Crossfade", "Crossfade between the two inputs (0.0 to 1.0). Changes ramp over one block.");
 
         METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel of the output signal.");
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel of the output signal.");
@@ -27,21 +35,37 @@ namespace Metasound
     class FCrossfadeStereoOperator : public TExecutableOperator<FCrossfadeStereoOperator>
     {
     public:
+        // Input the outputs are bound to, decided at build time
+        enum class EPassthrough : uint8
+        {
+            None,
+            Input1,
+            Input2
+        };
+
         FCrossfadeStereoOperator(
             const FOperatorSettings& InSettings,
             const FAudioBufferReadRef& InLeftSignal1,
             const FAudioBufferReadRef& InRightSignal1,
             const FAudioBufferReadRef& InLeftSignal2,
             const FAudioBufferReadRef& InRightSignal2,
-            const FFloatReadRef& InCrossfade)
+            const FFloatReadRef& InCrossfade,
+            EPassthrough InPassthrough)
             : InputLeftSignal1(InLeftSignal1)
             , InputRightSignal1(InRightSignal1)
             , InputLeftSignal2(InLeftSignal2)
             , InputRightSignal2(InRightSignal2)
             , InputCrossfade(InCrossfade)
-            , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , Gains(MetasoundBranches::Kernels::MakeCrossfadeGains(*InCrossfade))
+            , Passthrough(InPassthrough)
+            , InstanceStats(TEXT("StereoCrossfade"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                OutputLeftSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+                OutputRightSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+            }
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -91,51 +115,96 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace CrossfadeStereoNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal1), InputLeftSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal1), InputRightSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InputLeftSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal2), InputRightSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputCrossfade), InputCrossfade);
+        }
 
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal1), InputLeftSignal1);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal1), InputRightSignal1);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InputLeftSignal2);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal2), InputRightSignal2);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputCrossfade), InputCrossfade);
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace CrossfadeStereoNodeNames;
 
-            return InputDataReferences;
+            if (Passthrough == EPassthrough::Input1)
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal1);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal1);
+            }
+            else if (Passthrough == EPassthrough::Input2)
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal2);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal2);
+            }
+            else
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), *OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), *OutputRightSignal);
+            }
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace CrossfadeStereoNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal1 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal1), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal1 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal1), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputLeftSignal2 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal2), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal2 = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal2), InParams.OperatorSettings);
+            TDataReadReference<float> InputCrossfade = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputCrossfade), InParams.OperatorSettings);
 
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+            // A crossfade that can't change and sits at either end passes that input through
+            EPassthrough Passthrough = EPassthrough::None;
+            if (MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputCrossfade)))
+            {
+                const float CrossfadeFactor = FMath::Clamp(*InputCrossfade, 0.0f, 1.0f);
+                if (CrossfadeFactor == 0.0f)
+                {
+                    Passthrough = EPassthrough::Input1;
+                }
+                else if (CrossfadeFactor == 1.0f)
+                {
+                    Passthrough = EPassthrough::Input2;
+                }
+            }
 
-            return OutputDataReferences;
+            return MakeUnique<FCrossfadeStereoOperator>(InParams.OperatorSettings, InputLeftSignal1, InputRightSignal1, InputLeftSignal2, InputRightSignal2, InputCrossfade, Passthrough);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        void Reset(const IOperator::FResetParams& InParams)
         {
-            using namespace CrossfadeStereoNodeNames;
-
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
 
-            TDataReadReference<FAudioBuffer> InputLeftSignal1 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputLeftSignal1), InParams.OperatorSettings);
-            TDataReadReference<FAudioBuffer> InputRightSignal1 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputRightSignal1), InParams.OperatorSettings);
-            TDataReadReference<FAudioBuffer> InputLeftSignal2 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputLeftSignal2), InParams.OperatorSettings);
-            TDataReadReference<FAudioBuffer> InputRightSignal2 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputRightSignal2), InParams.OperatorSettings);
-            TDataReadReference<float> InputCrossfade = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputCrossfade), InParams.OperatorSettings);
+            // Start from the current crossfade rather than ramping into the first block
+            Gains = MetasoundBranches::Kernels::MakeCrossfadeGains(*InputCrossfade);
 
-            return MakeUnique<FCrossfadeStereoOperator>(InParams.OperatorSettings, InputLeftSignal1, InputRightSignal1, InputLeftSignal2, InputRightSignal2, InputCrossfade);
+            (*OutputLeftSignal)->Zero();
+            (*OutputRightSignal)->Zero();
         }
 
         void Execute()
         {
+            // The outputs are bound to the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoCrossfade);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             int32 NumFrames = InputLeftSignal1->Num();
 
             const float* LeftData1 = InputLeftSignal1->GetData();
@@ -143,19 +212,31 @@ namespace Metasound
             const float* LeftData2 = InputLeftSignal2->GetData();
             const float* RightData2 = InputRightSignal2->GetData();
 
-            float* OutputLeftData = OutputLeftSignal->GetData();
-            float* OutputRightData = OutputRightSignal->GetData();
+            float* OutputLeftData = (*OutputLeftSignal)->GetData();
+            float* OutputRightData = (*OutputRightSignal)->GetData();
+
+            // Equal-power mix of the first and second inputs; a change of crossfade ramps the gains across the block
+            ProcessStereoCrossfadeRamped(
+                Gains,
+                LeftData1, RightData1,
+                LeftData2, RightData2,
+                *InputCrossfade, OutputLeftData, OutputRightData, NumFrames);
+        }
 
-            float CrossfadeFactor = FMath::Clamp(*InputCrossfade, 0.0f, 1.0f);
+        bool IsPassthrough() const
+        {
+            return Passthrough != EPassthrough::None;
+        }
 
-            float Gain1 = FMath::Cos(CrossfadeFactor * HALF_PI); // HALF_PI = PI / 2
-            float Gain2 = FMath::Sin(CrossfadeFactor * HALF_PI);
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace CrossfadeStereoNodeNames;
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                OutputLeftData[i] = Gain1 * LeftData1[i] + Gain2 * LeftData2[i];
-                OutputRightData[i] = Gain1 * RightData1[i] + Gain2 * RightData2[i];
-            }
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal1), *InputLeftSignal1);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal1), *InputRightSignal1);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal2), *InputLeftSignal2);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal2), *InputRightSignal2);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputCrossfade), *InputCrossfade);
         }
 
     private:
@@ -167,11 +248,21 @@ namespace Metasound
         FAudioBufferReadRef InputRightSignal2;
         FFloatReadRef InputCrossfade;
 
-        // Outputs
-        FAudioBufferWriteRef OutputLeftSignal;
-        FAudioBufferWriteRef OutputRightSignal;
+        // Outputs, unset in passthrough
+        TOptional<FAudioBufferWriteRef> OutputLeftSignal;
+        TOptional<FAudioBufferWriteRef> OutputRightSignal;
+
+        // Gains of the two inputs applied at the end of the last block
+        MetasoundBranches::Kernels::FStereoGains Gains;
+
+        // Outputs bound to one of the inputs, decided at build time
+        EPassthrough Passthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FCrossfadeStereoOperator);
+
     class FCrossfadeStereoNode : public FNodeFacade
     {
     public:
@@ -9,10 +9,16 @@
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "Math/UnrealMathUtility.h"          // For FMath functions
 #include "Misc/DateTime.h"                   // For FDateTime::UtcNow()
+#include "MetasoundBranches/Public/Kernels/DustKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 // Required for ensuring the node is supported by all languages in engine. Must be unique per MetaSound.
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_DustNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Dust, "Dust");
+
 namespace Metasound
 {
     // Vertex Names - define the node's inputs and outputs here
@@ -41,9 +47,9 @@ namespace Metasound
             , InputEnabled(InEnabled)
             , InputBiPolar(InBiPolar)
             , OutputImpulse(FAudioBufferWriteRef::CreateNew(InSettings))
-            , RNGStream(InitialSeed())
-            , SignalIsPositive(true)
+            , InstanceStats(TEXT("Dust"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
+            State.Random.Initialize(InitialSeed());
         }
 
         // Helper function for constructing vertex interface
@@ -94,88 +100,71 @@ namespace Metasound
         }
 
         // Allows MetaSound graph to interact with the node's inputs
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustNodeNames;
-            FDataReferenceCollection Inputs;
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
-            return Inputs;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
         }
 
         // Allows MetaSound graph to interact with the node's outputs
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
         }
 
         // Used to instantiate a new runtime instance of the node
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace DustNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FAudioBuffer> InputDensity = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputDensity), InParams.OperatorSettings);
-            TDataReadReference<float> InputDensityOffset = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputDensityOffset), InParams.OperatorSettings);
-            TDataReadReference<bool> InputEnabled = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InputEnabled), InParams.OperatorSettings);
-            TDataReadReference<bool> InputBiPolar = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InputBiPolar), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputDensity = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputDensity), InParams.OperatorSettings);
+            TDataReadReference<float> InputDensityOffset = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputDensityOffset), InParams.OperatorSettings);
+            TDataReadReference<bool> InputEnabled = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputEnabled), InParams.OperatorSettings);
+            TDataReadReference<bool> InputBiPolar = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputBiPolar), InParams.OperatorSettings);
 
             return MakeUnique<FDustOperator>(InParams.OperatorSettings, InputDensity, InputDensityOffset, InputEnabled, InputBiPolar);
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Reseed in place and restart the polarity toggle
+            State = MetasoundBranches::Kernels::FDustState();
+            State.Random.Initialize(InitialSeed());
+
+            OutputImpulse->Zero();
+        }
+
         // Primary node functionality
         void Execute()
         {
-        const float* DensityData = InputDensity->GetData();
-        float* OutputDataPtr = OutputImpulse->GetData();
-        int32 NumFrames = InputDensity->Num();
-        float InputDensityOffsetValue = *InputDensityOffset;
-        bool bEnabled = *InputEnabled;
-        bool bBiPolar = *InputBiPolar;
-
-        for (int32 i = 0; i < NumFrames; ++i)
-        {
-            if (bEnabled)
-            {
-                float Density = DensityData[i];
-                float AbsDensity = FMath::Abs(Density) + InputDensityOffsetValue;
-                float Threshold = 1.0f - AbsDensity * 0.0009f;
+            METASOUND_BRANCHES_EXECUTE_SCOPE(Dust);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
 
-                float RandomValue = RNGStream.GetFraction();
+            using namespace MetasoundBranches::Kernels;
 
-                if (RandomValue > Threshold)
-                {
-                    if (bBiPolar)
-                    {
-                        OutputDataPtr[i] = SignalIsPositive ? 1.0f : -1.0f;
-                        SignalIsPositive = !SignalIsPositive; 
-                    }
-                    else
-                    {
-                        OutputDataPtr[i] = 1.0f;
-                    }
-                }
-                else
-                {
-                    OutputDataPtr[i] = 0.0f;
-                }
-            }
-            else
-            {
-                OutputDataPtr[i] = 0.0f; // Output zero when disabled
-            }
+            const float* DensityData = InputDensity->GetData();
+            float* OutputDataPtr = OutputImpulse->GetData();
+            int32 NumFrames = InputDensity->Num();
+
+            ProcessDust(State, DensityData, *InputDensityOffset, *InputEnabled, *InputBiPolar, OutputDataPtr, NumFrames);
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace DustNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputDensity), *InputDensity);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputDensityOffset), *InputDensityOffset);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputEnabled), *InputEnabled ? 1.0f : 0.0f);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputBiPolar), *InputBiPolar ? 1.0f : 0.0f);
         }
-    }
 
     private:
 
@@ -188,19 +177,20 @@ namespace Metasound
         // Outputs
         FAudioBufferWriteRef OutputImpulse;
 
-        // Random number generator
-        FRandomStream RNGStream;
-        
-        // Toggle flag for polarity
-        bool SignalIsPositive;
+        // Random number generator and polarity toggle
+        MetasoundBranches::Kernels::FDustState State;
 
-        // Generate an initial seed for FRandomStream
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+
+        // Generate an initial seed for the random stream
         static int32 InitialSeed()
         {
             return FDateTime::UtcNow().GetTicks();
         }
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FDustOperator);
+
     // Node Class - Inheriting from FNodeFacade is recommended for nodes that have a static FVertexInterface
     class FDustNode : public FNodeFacade
     {
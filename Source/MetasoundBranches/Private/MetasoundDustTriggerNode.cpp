@@ -10,10 +10,16 @@
 #include "Math/UnrealMathUtility.h"          // For FMath functions
 #include "Misc/DateTime.h"                   // For FDateTime::UtcNow()
 #include "MetasoundTrigger.h"                // For FTrigger classes
+#include "MetasoundBranches/Public/Kernels/DustKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 // Required for ensuring the node is supported by all languages in engine. Must be unique per MetaSound.
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_DustTriggerNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(DustTrigger, "Dust (Trigger)");
+
 namespace Metasound
 {
     // Vertex Names - define the node's inputs and outputs here
@@ -39,8 +45,9 @@ namespace Metasound
             , InputDensityOffset(InDensityOffset)
             , InputEnabled(InEnabled)
             , OutputTrigger(FTriggerWriteRef::CreateNew(InSettings))
-            , RNGStream(InitialSeed())
+            , InstanceStats(TEXT("DustTrigger"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
+            Random.Initialize(InitialSeed());
         }
 
         // Helper function for constructing vertex interface
@@ -90,68 +97,71 @@ namespace Metasound
         }
 
         // Allows MetaSound graph to interact with the node's inputs
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustTriggerNodeNames;
-            FDataReferenceCollection Inputs;
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
-            return Inputs;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensity), InputDensity);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDensityOffset), InputDensityOffset);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputEnabled), InputEnabled);
         }
 
         // Allows MetaSound graph to interact with the node's outputs
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace DustTriggerNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTrigger), OutputTrigger);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTrigger), OutputTrigger);
         }
 
         // Used to instantiate a new runtime instance of the node
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace DustTriggerNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FAudioBuffer> InputDensity = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputDensity), InParams.OperatorSettings);
-            TDataReadReference<float> InputDensityOffset = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputDensityOffset), InParams.OperatorSettings);
-            TDataReadReference<bool> InputEnabled = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InputEnabled), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputDensity = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputDensity), InParams.OperatorSettings);
+            TDataReadReference<float> InputDensityOffset = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputDensityOffset), InParams.OperatorSettings);
+            TDataReadReference<bool> InputEnabled = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputEnabled), InParams.OperatorSettings);
 
             return MakeUnique<FDustTriggerOperator>(InParams.OperatorSettings, InputDensity, InputDensityOffset, InputEnabled);
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Reseed in place
+            Random.Initialize(InitialSeed());
+
+            OutputTrigger->Reset();
+        }
+
         // Primary node functionality
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(DustTrigger);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             OutputTrigger->AdvanceBlock();
             const float* DensityData = InputDensity->GetData();
             int32 NumFrames = InputDensity->Num();
-            float InputDensityOffsetValue = *InputDensityOffset;
-            bool bEnabled = *InputEnabled;
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                if (bEnabled)
+            ProcessDustTrigger(Random, DensityData, *InputDensityOffset, *InputEnabled, NumFrames,
+                [this](int32 Frame)
                 {
-                    float Density = DensityData[i];
-                    float AbsDensity = FMath::Abs(Density) + InputDensityOffsetValue;
-                    float Threshold = 1.0f - AbsDensity * 0.0009f;
+                    OutputTrigger->TriggerFrame(Frame);
+                }
+            );
+        }
 
-                    float RandomValue = RNGStream.GetFraction();
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace DustTriggerNodeNames;
 
-                    if (RandomValue > Threshold)
-                    {
-                        OutputTrigger->TriggerFrame(i);
-                    }
-                }
-            }
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputDensity), *InputDensity);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputDensityOffset), *InputDensityOffset);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputEnabled), *InputEnabled ? 1.0f : 0.0f);
         }
 
     private:
@@ -165,15 +175,19 @@ namespace Metasound
         FTriggerWriteRef OutputTrigger;
 
         // Random number generator
-        FRandomStream RNGStream;
+        MetasoundBranches::Kernels::FRandomStreamState Random;
 
-        // Generate an initial seed for FRandomStream
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+
+        // Generate an initial seed for the random stream
         static int32 InitialSeed()
         {
             return FDateTime::UtcNow().GetTicks();
         }
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FDustTriggerOperator);
+
     // Node Class - Inheriting from FNodeFacade is recommended for nodes that have a static FVertexInterface
     class FDustTriggerNode : public FNodeFacade
     {
@@ -8,9 +8,15 @@
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "MetasoundTrigger.h"                // For FTriggerWriteRef and FTrigger
+#include "MetasoundBranches/Public/Kernels/EdgeKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_Edge"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Edge, "Edge");
+
 namespace Metasound
 {
     namespace EdgeNames
@@ -35,10 +41,9 @@ namespace Metasound
             , InputDebounce(InDebounce)
             , OutputTriggerRise(FTriggerWriteRef::CreateNew(InSettings))
             , OutputTriggerFall(FTriggerWriteRef::CreateNew(InSettings))
-            , PreviousSignalValue(0.0f)
             , DebounceSamples(0)
-            , DebounceCounter(0)
             , SampleRate(InSampleRate)
+            , InstanceStats(TEXT("Edge"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -86,70 +91,62 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdgeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdgeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTriggerRise), OutputTriggerRise);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTriggerFall), OutputTriggerFall);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTriggerRise), OutputTriggerRise);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTriggerFall), OutputTriggerFall);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace EdgeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FAudioBuffer> InputSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(
-                InputInterface, METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(
+                METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
 
-            TDataReadReference<FTime> InputDebounce = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface, METASOUND_GET_PARAM_NAME(InputDebounce), InParams.OperatorSettings);
+            TDataReadReference<FTime> InputDebounce = InputData.GetOrCreateDefaultDataReadReference<FTime>(
+                METASOUND_GET_PARAM_NAME(InputDebounce), InParams.OperatorSettings);
 
             float SampleRate = InParams.OperatorSettings.GetSampleRate();
 
             return MakeUnique<FEdgeOperator>(InputSignal, InputDebounce, SampleRate, InParams.OperatorSettings);
         }
         
-        virtual void Reset(const IOperator::FResetParams& InParams)
+        void Reset(const IOperator::FResetParams& InParams)
         {
             // Reset triggers
             OutputTriggerRise->Reset();
             OutputTriggerFall->Reset();
 
+            // Clear direction and debounce counter
+            State = MetasoundBranches::Kernels::FEdgeState();
+
             // Initialize PreviousSignalValue to the first sample of the incoming signal to prevent false triggers
             if (InputSignal->Num() > 0)
             {
-                PreviousSignalValue = InputSignal->GetData()[0];
+                State.PreviousSignalValue = InputSignal->GetData()[0];
             }
-            else
-            {
-                PreviousSignalValue = 0.0f;
-            }
-
-            // Reset debounce counter
-            DebounceCounter = 0;
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(Edge);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             OutputTriggerRise->AdvanceBlock();
             OutputTriggerFall->AdvanceBlock();
 
@@ -160,41 +157,29 @@ namespace Metasound
             // Recalculate debounce samples if debounce time or sample rate has changed
             if (LastDebounceTime != DebounceTime || LastSampleRate != SampleRate)
             {
-                DebounceSamples = FMath::RoundToInt(FMath::Clamp(DebounceTime, 0.001f, 5.0f) * SampleRate);
+                DebounceSamples = DebounceSamplesFromSeconds(DebounceTime, SampleRate);
                 LastDebounceTime = DebounceTime;
                 LastSampleRate = SampleRate;
             }
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                float CurrentSignal = SignalData[i];
-
-                // Decrement debounce counter
-                if (DebounceCounter > 0)
+            ProcessEdge(State, SignalData, NumFrames, DebounceSamples,
+                [this](int32 Frame)
                 {
-                    DebounceCounter--;
-                }
-
-                // Detect rising edge
-                if (CurrentSignal > PreviousSignalValue && !PreviousIsRising && DebounceCounter <= 0)
-                {
-                    // Rising edge detected
-                    OutputTriggerRise->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                    PreviousIsRising = true;
-                }
-                // Detect falling edge
-                else if (CurrentSignal < PreviousSignalValue && PreviousIsRising && DebounceCounter <= 0)
+                    OutputTriggerRise->TriggerFrame(Frame);
+                },
+                [this](int32 Frame)
                 {
-                    // Falling edge detected
-                    OutputTriggerFall->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                    PreviousIsRising = false;
+                    OutputTriggerFall->TriggerFrame(Frame);
                 }
+            );
+        }
 
-                // Update previous signal value
-                PreviousSignalValue = CurrentSignal;
-            }
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace EdgeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSignal), *InputSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce->GetSeconds());
         }
 
     private:
@@ -207,17 +192,19 @@ namespace Metasound
         FTriggerWriteRef OutputTriggerFall;
 
         // Internal variables
-        float PreviousSignalValue;
-        bool PreviousIsRising = false;
+        MetasoundBranches::Kernels::FEdgeState State;
         int32 DebounceSamples;
-        int32 DebounceCounter;
         float SampleRate;
         
         // Variables to track changes in debounce time and sample rate
         float LastDebounceTime = -1.0f;
         float LastSampleRate = -1.0f;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FEdgeOperator);
+
     class FEdgeNode : public FNodeFacade
     {
     public:
@@ -7,9 +7,15 @@
 #include "MetasoundStandardNodesNames.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Public/Kernels/TuningKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_EdoNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Edo, "EDO");
+
 namespace Metasound
 {
     namespace EdoNodeNames
@@ -35,6 +41,7 @@ namespace Metasound
             , ReferenceMIDINote(InReferenceMIDINote)
             , Divisions(InDivisions)
             , OutputFrequency(FFloatWriteRef::CreateNew(0.0f))
+            , InstanceStats(TEXT("Edo"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -83,42 +90,33 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdoNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputNoteNumber), NoteNumber);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputReferenceFrequency), ReferenceFrequency);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), ReferenceMIDINote);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDivisions), Divisions);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputNoteNumber), NoteNumber);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputReferenceFrequency), ReferenceFrequency);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), ReferenceMIDINote);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDivisions), Divisions);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace EdoNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace EdoNodeNames;
 
-            const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<int32> NoteNumber = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<int32>(InputInterface, METASOUND_GET_PARAM_NAME(InputNoteNumber), InParams.OperatorSettings);
-            TDataReadReference<float> ReferenceFrequency = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputReferenceFrequency), InParams.OperatorSettings);
-            TDataReadReference<int32> ReferenceMIDINote = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<int32>(InputInterface, METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), InParams.OperatorSettings);
-            TDataReadReference<int32> Divisions = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<int32>(InputInterface, METASOUND_GET_PARAM_NAME(InputDivisions), InParams.OperatorSettings);
+            TDataReadReference<int32> NoteNumber = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputNoteNumber), InParams.OperatorSettings);
+            TDataReadReference<float> ReferenceFrequency = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputReferenceFrequency), InParams.OperatorSettings);
+            TDataReadReference<int32> ReferenceMIDINote = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), InParams.OperatorSettings);
+            TDataReadReference<int32> Divisions = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputDivisions), InParams.OperatorSettings);
 
             return MakeUnique<FEdoNodeOperator>(
                 InParams.OperatorSettings,
@@ -129,22 +127,27 @@ namespace Metasound
             );
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            *OutputFrequency = 0.0f;
+        }
+
         void Execute()
         {
-            int32 noteNumber = *NoteNumber;
-            float refFreq = *ReferenceFrequency;
-            int32 refMIDINote = *ReferenceMIDINote;
-            int32 divisions = *Divisions;
+            METASOUND_BRANCHES_EXECUTE_SCOPE(Edo);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
 
-            if (divisions == 0)
-            {
-                divisions = 1;
-            }
+            *OutputFrequency = MetasoundBranches::Kernels::EdoFrequency(*NoteNumber, *ReferenceFrequency, *ReferenceMIDINote, *Divisions);
+        }
 
-            float exponent = static_cast<float>(noteNumber - refMIDINote) / static_cast<float>(divisions);
-            float frequency = refFreq * powf(2.0f, exponent);
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace EdoNodeNames;
 
-            *OutputFrequency = frequency;
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputNoteNumber), static_cast<float>(*NoteNumber));
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputReferenceFrequency), *ReferenceFrequency);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputReferenceMIDINote), static_cast<float>(*ReferenceMIDINote));
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputDivisions), static_cast<float>(*Divisions));
         }
 
     private:
@@ -154,8 +157,12 @@ namespace Metasound
         FInt32ReadRef Divisions;
 
         FFloatWriteRef OutputFrequency;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FEdoNodeOperator);
+
     class FEdoNode : public FNodeFacade
     {
     public:
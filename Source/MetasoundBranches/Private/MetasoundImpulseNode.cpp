@@ -7,10 +7,16 @@
 #include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/ImpulseKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 // Required for ensuring the node is supported by all languages in engine. Must be unique per MetaSound.
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ImpulseNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Impulse, "Impulse");
+
 namespace Metasound
 {
     // Vertex Names - define the node's inputs and outputs here
@@ -35,7 +41,7 @@ namespace Metasound
             , InputBiPolar(InBiPolar)
             , OnTrigger(FTriggerWriteRef::CreateNew(InSettings))
             , OutputImpulse(FAudioBufferWriteRef::CreateNew(InSettings))
-            , SignalIsPositive(true)
+            , InstanceStats(TEXT("Impulse"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -86,38 +92,31 @@ namespace Metasound
         }
 
         // Allows MetaSound graph to interact with the node's inputs
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ImpulseNodeNames;
-            FDataReferenceCollection Inputs;
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
-            Inputs.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
-            return Inputs;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBiPolar), InputBiPolar);
         }
 
         // Allows MetaSound graph to interact with the node's outputs
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ImpulseNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputOnTrigger), OnTrigger);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputOnTrigger), OnTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputImpulse), OutputImpulse);
         }
 
         // Used to instantiate a new runtime instance of the node
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace ImpulseNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FTrigger> InputTrigger = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
-            TDataReadReference<bool> InputBiPolar = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InputBiPolar), InParams.OperatorSettings);
+            TDataReadReference<FTrigger> InputTrigger = InputData.GetOrCreateDefaultDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
+            TDataReadReference<bool> InputBiPolar = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputBiPolar), InParams.OperatorSettings);
 
             return MakeUnique<FImpulseOperator>(
                 InParams.OperatorSettings,
@@ -126,9 +125,23 @@ namespace Metasound
             );
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Restart the polarity toggle
+            State = MetasoundBranches::Kernels::FImpulseState();
+
+            OnTrigger->Reset();
+            OutputImpulse->Zero();
+        }
+
         // Primary node functionality
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(Impulse);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             OnTrigger->AdvanceBlock();
             OutputImpulse->Zero(); // Ensure the output buffer is cleared
             
@@ -151,20 +164,20 @@ namespace Metasound
                     if (TriggerFrame < NumFrames)
                     {
                         OnTrigger->TriggerFrame(TriggerFrame);
-                        if (*InputBiPolar)
-                        {
-                            OutputDataPtr[TriggerFrame] = SignalIsPositive ? 1.0f : -1.0f;
-                            SignalIsPositive = !SignalIsPositive;
-                        }
-                        else
-                        {
-                            OutputDataPtr[TriggerFrame] = 1.0f;
-                        }
+                        OutputDataPtr[TriggerFrame] = NextImpulseValue(State, *InputBiPolar);
                     }
                 }
             );
         }
 
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace ImpulseNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTrigger), *InputTrigger);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputBiPolar), *InputBiPolar ? 1.0f : 0.0f);
+        }
+
     private:
 
         // Inputs
@@ -175,10 +188,15 @@ namespace Metasound
         FTriggerWriteRef OnTrigger;
         FAudioBufferWriteRef OutputImpulse;
 
-        bool SignalIsPositive;
+        // Toggle flag for polarity
+        MetasoundBranches::Kernels::FImpulseState State;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
 
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FImpulseOperator);
+
     // Node Class - Inheriting from FNodeFacade is recommended for nodes that have a static FVertexInterface
     class FImpulseNode : public FNodeFacade
     {
@@ -0,0 +1,250 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundMultichannelGainNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/MultichannelKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesMultichannel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_MultichannelGain"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(MultichannelGain, "Multichannel Gain");
+
+namespace Metasound
+{
+    namespace MultichannelGainNodeNames
+    {
+        METASOUND_PARAM(InputGain, "Gain (Lin)", "Gain applied to every channel (0.0 to 1.0). Changes ramp over one block.");
+    }
+
+    // Stereo Gain for NumChannels channels
+    template<int32 NumChannels>
+    class TMultichannelGainOperator : public TExecutableOperator<TMultichannelGainOperator<NumChannels>>
+    {
+        static_assert(NumChannels >= 2 && NumChannels <= MetasoundBranches::Multichannel::MaxChannels, "Unsupported number of channels");
+
+    public:
+        TMultichannelGainOperator(
+            const FOperatorSettings& InSettings,
+            TArray<FAudioBufferReadRef>&& InSignals,
+            const FFloatReadRef& InGain,
+            bool bInPassthrough)
+            : InputSignals(MoveTemp(InSignals))
+            , InputGain(InGain)
+            , Gain(*InGain)
+            , bPassthrough(bInPassthrough)
+            , InstanceStats(TEXT("MultichannelGain"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    OutputSignals.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+                }
+            }
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace MultichannelGainNodeNames;
+
+            auto CreateVertexInterface = []() -> FVertexInterface
+                {
+                    FInputVertexInterface Inputs;
+                    MetasoundBranches::Multichannel::AddInputVertices(Inputs, NumChannels);
+                    Inputs.Add(TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain), 1.0f));
+
+                    FOutputVertexInterface Outputs;
+                    MetasoundBranches::Multichannel::AddOutputVertices(Outputs, NumChannels);
+
+                    return FVertexInterface(Inputs, Outputs);
+                };
+
+            static const FVertexInterface Interface = CreateVertexInterface();
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    const FString NodeName = FString::Printf(TEXT("Multichannel Gain (%d)"), NumChannels);
+
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, FName(*NodeName), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = FText::Format(METASOUND_LOCTEXT("MultichannelGainNodeDisplayName", "Multichannel Gain ({0})"), NumChannels);
+                    Metadata.Description = FText::Format(METASOUND_LOCTEXT("MultichannelGainNodeDesc", "Scale a {0}-channel input to a gain value."), NumChannels);
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>();
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace MultichannelGainNodeNames;
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InOutVertexData.BindReadVertex(MetasoundBranches::Multichannel::GetInputName(Channel), InputSignals[Channel]);
+            }
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGain), InputGain);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const TCHAR* OutputName = MetasoundBranches::Multichannel::GetOutputName(Channel);
+
+                if (IsPassthrough())
+                {
+                    InOutVertexData.BindReadVertex(OutputName, InputSignals[Channel]);
+                }
+                else
+                {
+                    InOutVertexData.BindReadVertex(OutputName, OutputSignals[Channel]);
+                }
+            }
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace MultichannelGainNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TArray<FAudioBufferReadRef> InputSignals;
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(MetasoundBranches::Multichannel::GetInputName(Channel), InParams.OperatorSettings));
+            }
+
+            TDataReadReference<float> InputGain = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputGain), InParams.OperatorSettings);
+
+            // Unity gain that can't change passes the inputs through
+            const bool bPassthrough = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputGain)) && *InputGain == 1.0f;
+
+            return MakeUnique<TMultichannelGainOperator<NumChannels>>(InParams.OperatorSettings, MoveTemp(InputSignals), InputGain, bPassthrough);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            // Start from the current gain rather than ramping into the first block
+            Gain = *InputGain;
+
+            for (FAudioBufferWriteRef& OutputSignal : OutputSignals)
+            {
+                OutputSignal->Zero();
+            }
+        }
+
+        void Execute()
+        {
+            // The outputs are bound to the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(MultichannelGain);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = OutputSignals[0]->Num();
+
+            const float* InputData[NumChannels];
+            float* OutputData[NumChannels];
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputData[Channel] = InputSignals[Channel]->GetData();
+                OutputData[Channel] = OutputSignals[Channel]->GetData();
+            }
+
+            // A change of gain ramps across the block rather than stepping at its start
+            ProcessMultichannelGainRamped(Gain, *InputGain, InputData, OutputData, NumChannels, NumFrames);
+        }
+
+        bool IsPassthrough() const
+        {
+            return bPassthrough;
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace MultichannelGainNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputGain), *InputGain);
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutInputs.Add(MetasoundBranches::Multichannel::GetInputName(Channel), *InputSignals[Channel]);
+            }
+        }
+
+    private:
+        // Inputs
+        TArray<FAudioBufferReadRef> InputSignals;
+        FFloatReadRef InputGain;
+
+        // Outputs, empty in passthrough
+        TArray<FAudioBufferWriteRef> OutputSignals;
+
+        // Gain applied at the end of the last block
+        float Gain;
+
+        // Outputs bound to the inputs, decided at build time
+        bool bPassthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(TMultichannelGainOperator<4>);
+
+    template<int32 NumChannels>
+    class TMultichannelGainNode : public FNodeFacade
+    {
+    public:
+        TMultichannelGainNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<TMultichannelGainOperator<NumChannels>>())
+        {
+        }
+    };
+
+    using FMultichannelGain4Node = TMultichannelGainNode<4>;
+    using FMultichannelGain6Node = TMultichannelGainNode<6>;
+    using FMultichannelGain8Node = TMultichannelGainNode<8>;
+
+    METASOUND_REGISTER_NODE(FMultichannelGain4Node);
+    METASOUND_REGISTER_NODE(FMultichannelGain6Node);
+    METASOUND_REGISTER_NODE(FMultichannelGain8Node);
+}
+
+#undef LOCTEXT_NAMESPACE
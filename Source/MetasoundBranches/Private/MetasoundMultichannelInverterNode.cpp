@@ -0,0 +1,324 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundMultichannelInverterNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/MultichannelKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesMultichannel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_MultichannelInverter"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(MultichannelInverter, "Multichannel Inverter");
+
+namespace Metasound
+{
+    namespace MultichannelInverterNodeNames
+    {
+        METASOUND_PARAM(InputInvertMask, "Invert Mask", "Polarity mask: bit 0 inverts Out 1, bit 1 inverts Out 2, and so on.");
+        METASOUND_PARAM(InputSource1, "Source 1", "Input channel (1 to the number of channels) routed to Out 1.");
+        METASOUND_PARAM(InputSource2, "Source 2", "Input channel (1 to the number of channels) routed to Out 2.");
+        METASOUND_PARAM(InputSource3, "Source 3", "Input channel (1 to the number of channels) routed to Out 3.");
+        METASOUND_PARAM(InputSource4, "Source 4", "Input channel (1 to the number of channels) routed to Out 4.");
+        METASOUND_PARAM(InputSource5, "Source 5", "Input channel (1 to the number of channels) routed to Out 5.");
+        METASOUND_PARAM(InputSource6, "Source 6", "Input channel (1 to the number of channels) routed to Out 6.");
+        METASOUND_PARAM(InputSource7, "Source 7", "Input channel (1 to the number of channels) routed to Out 7.");
+        METASOUND_PARAM(InputSource8, "Source 8", "Input channel (1 to the number of channels) routed to Out 8.");
+
+        const TCHAR* GetSourceName(int32 Channel)
+        {
+            static const TCHAR* const Names[MetasoundBranches::Multichannel::MaxChannels] =
+            {
+                METASOUND_GET_PARAM_NAME(InputSource1), METASOUND_GET_PARAM_NAME(InputSource2),
+                METASOUND_GET_PARAM_NAME(InputSource3), METASOUND_GET_PARAM_NAME(InputSource4),
+                METASOUND_GET_PARAM_NAME(InputSource5), METASOUND_GET_PARAM_NAME(InputSource6),
+                METASOUND_GET_PARAM_NAME(InputSource7), METASOUND_GET_PARAM_NAME(InputSource8)
+            };
+
+            return Names[Channel];
+        }
+
+        // Source vertices of the first NumChannels outputs, each defaulting to its own channel
+        void AddSourceVertices(FInputVertexInterface& OutInterface, int32 NumChannels)
+        {
+            const TInputDataVertexModel<int32> Vertices[MetasoundBranches::Multichannel::MaxChannels] =
+            {
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource1), 1),
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource2), 2),
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource3), 3),
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource4), 4),
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource5), 5),
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource6), 6),
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource7), 7),
+                TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSource8), 8)
+            };
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutInterface.Add(Vertices[Channel]);
+            }
+        }
+    }
+
+    // Stereo Inverter for NumChannels channels: each output takes any input channel, with its polarity set by one bit
+    // of the mask. Swapping generalizes to a permutation (or any mapping, as sources may repeat).
+    template<int32 NumChannels>
+    class TMultichannelInverterOperator : public TExecutableOperator<TMultichannelInverterOperator<NumChannels>>
+    {
+        static_assert(NumChannels >= 2 && NumChannels <= MetasoundBranches::Multichannel::MaxChannels, "Unsupported number of channels");
+
+    public:
+        TMultichannelInverterOperator(
+            const FOperatorSettings& InSettings,
+            TArray<FAudioBufferReadRef>&& InSignals,
+            const FInt32ReadRef& InInvertMask,
+            TArray<FInt32ReadRef>&& InSources,
+            bool bInPassthrough)
+            : InputSignals(MoveTemp(InSignals))
+            , InputInvertMask(InInvertMask)
+            , InputSources(MoveTemp(InSources))
+            , bPassthrough(bInPassthrough)
+            , InstanceStats(TEXT("MultichannelInverter"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    OutputSignals.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+                }
+            }
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace MultichannelInverterNodeNames;
+
+            auto CreateVertexInterface = []() -> FVertexInterface
+                {
+                    FInputVertexInterface Inputs;
+                    MetasoundBranches::Multichannel::AddInputVertices(Inputs, NumChannels);
+                    Inputs.Add(TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputInvertMask), 0));
+                    AddSourceVertices(Inputs, NumChannels);
+
+                    FOutputVertexInterface Outputs;
+                    MetasoundBranches::Multichannel::AddOutputVertices(Outputs, NumChannels);
+
+                    return FVertexInterface(Inputs, Outputs);
+                };
+
+            static const FVertexInterface Interface = CreateVertexInterface();
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    const FString NodeName = FString::Printf(TEXT("Multichannel Inverter (%d)"), NumChannels);
+
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, FName(*NodeName), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = FText::Format(METASOUND_LOCTEXT("MultichannelInverterNodeDisplayName", "Multichannel Inverter ({0})"), NumChannels);
+                    Metadata.Description = FText::Format(METASOUND_LOCTEXT("MultichannelInverterNodeDesc", "Inverts and/or reorders the channels of a {0}-channel signal."), NumChannels);
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>();
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace MultichannelInverterNodeNames;
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InOutVertexData.BindReadVertex(MetasoundBranches::Multichannel::GetInputName(Channel), InputSignals[Channel]);
+            }
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertMask), InputInvertMask);
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InOutVertexData.BindReadVertex(GetSourceName(Channel), InputSources[Channel]);
+            }
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const TCHAR* OutputName = MetasoundBranches::Multichannel::GetOutputName(Channel);
+
+                if (IsPassthrough())
+                {
+                    // The sources can't change either, so they are just a choice of which input each output is
+                    // bound to
+                    InOutVertexData.BindReadVertex(OutputName, InputSignals[GetSource(Channel)]);
+                }
+                else
+                {
+                    InOutVertexData.BindReadVertex(OutputName, OutputSignals[Channel]);
+                }
+            }
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace MultichannelInverterNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TArray<FAudioBufferReadRef> InputSignals;
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(MetasoundBranches::Multichannel::GetInputName(Channel), InParams.OperatorSettings));
+            }
+
+            TDataReadReference<int32> InvertMask = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputInvertMask), InParams.OperatorSettings);
+
+            // Without inversion, and with settings that can't change, the inputs pass through (reordered or not)
+            bool bPassthrough = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputInvertMask))
+                && (GetChannelMask(*InvertMask) == 0);
+
+            TArray<FInt32ReadRef> InputSources;
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputSources.Add(InputData.GetOrCreateDefaultDataReadReference<int32>(GetSourceName(Channel), InParams.OperatorSettings));
+                bPassthrough = bPassthrough && MetasoundBranches::IsConstantInput(InputData, GetSourceName(Channel));
+            }
+
+            return MakeUnique<TMultichannelInverterOperator<NumChannels>>(InParams.OperatorSettings, MoveTemp(InputSignals), InvertMask, MoveTemp(InputSources), bPassthrough);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            for (FAudioBufferWriteRef& OutputSignal : OutputSignals)
+            {
+                OutputSignal->Zero();
+            }
+        }
+
+        void Execute()
+        {
+            // The outputs are bound to the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(MultichannelInverter);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = OutputSignals[0]->Num();
+
+            const float* InputData[NumChannels];
+            float* OutputData[NumChannels];
+            int32 Sources[NumChannels];
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputData[Channel] = InputSignals[Channel]->GetData();
+                OutputData[Channel] = OutputSignals[Channel]->GetData();
+                Sources[Channel] = GetSource(Channel);
+            }
+
+            ProcessMultichannelInverter(InputData, Sources, GetChannelMask(*InputInvertMask), OutputData, NumChannels, NumFrames);
+        }
+
+        bool IsPassthrough() const
+        {
+            return bPassthrough;
+        }
+
+        // Zero-based input channel routed to the output channel
+        int32 GetSource(int32 Channel) const
+        {
+            return FMath::Clamp(*InputSources[Channel], 1, NumChannels) - 1;
+        }
+
+        // The bits of the mask that have a channel
+        static uint32 GetChannelMask(int32 InvertMask)
+        {
+            return static_cast<uint32>(InvertMask) & ((1u << NumChannels) - 1u);
+        }
+
+        // The controls go first, as the inputs of the eight-channel variant fill the snapshot
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace MultichannelInverterNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputInvertMask), static_cast<float>(*InputInvertMask));
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutInputs.Add(GetSourceName(Channel), static_cast<float>(*InputSources[Channel]));
+            }
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutInputs.Add(MetasoundBranches::Multichannel::GetInputName(Channel), *InputSignals[Channel]);
+            }
+        }
+
+    private:
+        // Inputs
+        TArray<FAudioBufferReadRef> InputSignals;
+        FInt32ReadRef InputInvertMask;
+        TArray<FInt32ReadRef> InputSources;
+
+        // Outputs, empty in passthrough
+        TArray<FAudioBufferWriteRef> OutputSignals;
+
+        // Outputs bound to the inputs, decided at build time
+        bool bPassthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(TMultichannelInverterOperator<4>);
+
+    template<int32 NumChannels>
+    class TMultichannelInverterNode : public FNodeFacade
+    {
+    public:
+        TMultichannelInverterNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<TMultichannelInverterOperator<NumChannels>>())
+        {
+        }
+    };
+
+    using FMultichannelInverter4Node = TMultichannelInverterNode<4>;
+    using FMultichannelInverter6Node = TMultichannelInverterNode<6>;
+    using FMultichannelInverter8Node = TMultichannelInverterNode<8>;
+
+    METASOUND_REGISTER_NODE(FMultichannelInverter4Node);
+    METASOUND_REGISTER_NODE(FMultichannelInverter6Node);
+    METASOUND_REGISTER_NODE(FMultichannelInverter8Node);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,244 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundMultichannelPhaseDisperserNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "Math/UnrealMathUtility.h"
+#include "MetasoundBranches/Public/Kernels/AllPassKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesMultichannel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_MultichannelPhaseDisperser"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(MultichannelPhaseDisperser, "Multichannel Phase Disperser");
+
+namespace Metasound
+{
+    namespace MultichannelPhaseDisperserNodeNames
+    {
+        METASOUND_PARAM(NumFilters, "Stages", "Number of allpass filter stages to apply (1-128).");
+        METASOUND_PARAM(Spread, "Spread", "Spreads the channels' feedback apart to decorrelate them (0-1). At 0 every channel uses 0.5; at 1 the first and last reach 0.1 and 0.9, the others evenly between. Changes step at the next block.");
+    }
+
+    // Phase Disperser's recursive cascade for NumChannels channels at once. Every stage keeps its channels side by
+    // side, so the vector kernels carry all of them through a stage together and a wide source costs little more
+    // than a mono one. At zero spread each channel comes out exactly as Phase Disperser's recursive mode renders it.
+    template<int32 NumChannels>
+    class TMultichannelPhaseDisperserOperator : public TExecutableOperator<TMultichannelPhaseDisperserOperator<NumChannels>>
+    {
+        static_assert(NumChannels >= 2 && NumChannels <= MetasoundBranches::Kernels::MaxAllPassChannels, "Unsupported number of channels");
+
+    public:
+        // Maximum number of allowed allpass filters
+        static constexpr int32 MaxAllowedFilters = MetasoundBranches::Kernels::MaxAllPassStages;
+
+        TMultichannelPhaseDisperserOperator(
+            const FOperatorSettings& InSettings,
+            TArray<FAudioBufferReadRef>&& InSignals,
+            const FInt32ReadRef& InNumFilters,
+            const FFloatReadRef& InSpread)
+            : InputSignals(MoveTemp(InSignals))
+            , NumFilters(InNumFilters)
+            , Spread(InSpread)
+            , InstanceStats(TEXT("MultichannelPhaseDisperser"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutputSignals.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+            }
+
+            CascadeState.Init(NumChannels, *InSpread);
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace MultichannelPhaseDisperserNodeNames;
+
+            auto CreateVertexInterface = []() -> FVertexInterface
+                {
+                    FInputVertexInterface Inputs;
+                    MetasoundBranches::Multichannel::AddInputVertices(Inputs, NumChannels);
+                    Inputs.Add(TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(NumFilters)));
+                    Inputs.Add(TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(Spread), 0.0f));
+
+                    FOutputVertexInterface Outputs;
+                    MetasoundBranches::Multichannel::AddOutputVertices(Outputs, NumChannels);
+
+                    return FVertexInterface(Inputs, Outputs);
+                };
+
+            static const FVertexInterface Interface = CreateVertexInterface();
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    const FString NodeName = FString::Printf(TEXT("Multichannel Phase Disperser (%d)"), NumChannels);
+
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, FName(*NodeName), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = FText::Format(METASOUND_LOCTEXT("MultichannelPhaseDisperserNodeDisplayName", "Multichannel Phase Disperser ({0})"), NumChannels);
+                    Metadata.Description = FText::Format(METASOUND_LOCTEXT("MultichannelPhaseDisperserNodeDesc", "Applies phase dispersion to a {0}-channel signal through a chain of allpass filters, all channels at once."), NumChannels);
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>();
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace MultichannelPhaseDisperserNodeNames;
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InOutVertexData.BindReadVertex(MetasoundBranches::Multichannel::GetInputName(Channel), InputSignals[Channel]);
+            }
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(NumFilters), NumFilters);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(Spread), Spread);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InOutVertexData.BindReadVertex(MetasoundBranches::Multichannel::GetOutputName(Channel), OutputSignals[Channel]);
+            }
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace MultichannelPhaseDisperserNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TArray<FAudioBufferReadRef> InputSignals;
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(MetasoundBranches::Multichannel::GetInputName(Channel), InParams.OperatorSettings));
+            }
+
+            TDataReadReference<int32> NumFiltersRef = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(NumFilters), InParams.OperatorSettings);
+            TDataReadReference<float> SpreadRef = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(Spread), InParams.OperatorSettings);
+
+            return MakeUnique<TMultichannelPhaseDisperserOperator<NumChannels>>(InParams.OperatorSettings, MoveTemp(InputSignals), NumFiltersRef, SpreadRef);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear the delay lines of every stage and channel, starting from the current spread
+            CascadeState.Init(NumChannels, *Spread);
+
+            for (FAudioBufferWriteRef& OutputSignal : OutputSignals)
+            {
+                OutputSignal->Zero();
+            }
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(MultichannelPhaseDisperser);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const FScopedFlushDenormals FlushDenormals;
+
+            const int32 NumFrames = OutputSignals[0]->Num();
+
+            // The cascade runs in place on the output buffers, so nothing is allocated on the render thread
+            float* OutputData[NumChannels];
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const float* InputData = InputSignals[Channel]->GetData();
+                OutputData[Channel] = OutputSignals[Channel]->GetData();
+
+                if (OutputData[Channel] != InputData)
+                {
+                    FMemory::Memcpy(OutputData[Channel], InputData, NumFrames * sizeof(float));
+                }
+            }
+
+            const int32 CurrentNumFilters = FMath::Clamp(*NumFilters, 1, MaxAllowedFilters);
+
+            SetAllPassChannelSpread(CascadeState, *Spread);
+            ProcessAllPassChannelCascade(CascadeState, CurrentNumFilters, OutputData, NumFrames);
+
+            // Output silence rather than NaN / infinity for the block in which the state was reset
+            if (!GuardAllPassChannelCascadeState(CascadeState, CurrentNumFilters))
+            {
+                for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    FMemory::Memzero(OutputData[Channel], NumFrames * sizeof(float));
+                }
+            }
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace MultichannelPhaseDisperserNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(NumFilters), static_cast<float>(*NumFilters));
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(Spread), *Spread);
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutInputs.Add(MetasoundBranches::Multichannel::GetInputName(Channel), *InputSignals[Channel]);
+            }
+        }
+
+    private:
+        // Inputs
+        TArray<FAudioBufferReadRef> InputSignals;
+        FInt32ReadRef NumFilters;
+        FFloatReadRef Spread;
+
+        // Outputs
+        TArray<FAudioBufferWriteRef> OutputSignals;
+
+        // Delay lines and feedback of every stage, the channels of each stage side by side
+        MetasoundBranches::Kernels::FAllPassChannelCascadeState CascadeState;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(TMultichannelPhaseDisperserOperator<2>);
+
+    template<int32 NumChannels>
+    class TMultichannelPhaseDisperserNode : public FNodeFacade
+    {
+    public:
+        TMultichannelPhaseDisperserNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<TMultichannelPhaseDisperserOperator<NumChannels>>())
+        {
+        }
+    };
+
+    using FMultichannelPhaseDisperser2Node = TMultichannelPhaseDisperserNode<2>;
+    using FMultichannelPhaseDisperser4Node = TMultichannelPhaseDisperserNode<4>;
+    using FMultichannelPhaseDisperser8Node = TMultichannelPhaseDisperserNode<8>;
+
+    METASOUND_REGISTER_NODE(FMultichannelPhaseDisperser2Node);
+    METASOUND_REGISTER_NODE(FMultichannelPhaseDisperser4Node);
+    METASOUND_REGISTER_NODE(FMultichannelPhaseDisperser8Node);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,251 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundMultichannelWidthNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/MultichannelKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesMultichannel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_MultichannelWidth"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(MultichannelWidth, "Multichannel Width");
+
+namespace Metasound
+{
+    namespace MultichannelWidthNodeNames
+    {
+        METASOUND_PARAM(InputWidth, "Width", "Width factor ranging from 0 to 200% (0 - 2). At 0 every channel is the mean of all of them; above 1 each moves further from it. Changes ramp over one block.");
+    }
+
+    // Stereo Width for NumChannels channels. The mean of all the channels takes the place of mid, and each channel's
+    // difference from it the place of side, so two channels behave as Stereo Width.
+    template<int32 NumChannels>
+    class TMultichannelWidthOperator : public TExecutableOperator<TMultichannelWidthOperator<NumChannels>>
+    {
+        static_assert(NumChannels >= 2 && NumChannels <= MetasoundBranches::Multichannel::MaxChannels, "Unsupported number of channels");
+
+    public:
+        TMultichannelWidthOperator(
+            const FOperatorSettings& InSettings,
+            TArray<FAudioBufferReadRef>&& InSignals,
+            const FFloatReadRef& InWidth,
+            bool bInPassthrough)
+            : InputSignals(MoveTemp(InSignals))
+            , InputWidth(InWidth)
+            , WidthFactor(MetasoundBranches::Kernels::Clamp(*InWidth, 0.0f, 2.0f))
+            , bPassthrough(bInPassthrough)
+            , InstanceStats(TEXT("MultichannelWidth"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    OutputSignals.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+                }
+            }
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace MultichannelWidthNodeNames;
+
+            auto CreateVertexInterface = []() -> FVertexInterface
+                {
+                    FInputVertexInterface Inputs;
+                    MetasoundBranches::Multichannel::AddInputVertices(Inputs, NumChannels);
+                    Inputs.Add(TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWidth), 1.0f));
+
+                    FOutputVertexInterface Outputs;
+                    MetasoundBranches::Multichannel::AddOutputVertices(Outputs, NumChannels);
+
+                    return FVertexInterface(Inputs, Outputs);
+                };
+
+            static const FVertexInterface Interface = CreateVertexInterface();
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    const FString NodeName = FString::Printf(TEXT("Multichannel Width (%d)"), NumChannels);
+
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, FName(*NodeName), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = FText::Format(METASOUND_LOCTEXT("MultichannelWidthNodeDisplayName", "Multichannel Width ({0})"), NumChannels);
+                    Metadata.Description = FText::Format(METASOUND_LOCTEXT("MultichannelWidthNodeDesc", "Adjusts the width of a {0}-channel signal around the mean of its channels."), NumChannels);
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>();
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace MultichannelWidthNodeNames;
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InOutVertexData.BindReadVertex(MetasoundBranches::Multichannel::GetInputName(Channel), InputSignals[Channel]);
+            }
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputWidth), InputWidth);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const TCHAR* OutputName = MetasoundBranches::Multichannel::GetOutputName(Channel);
+
+                if (IsPassthrough())
+                {
+                    InOutVertexData.BindReadVertex(OutputName, InputSignals[Channel]);
+                }
+                else
+                {
+                    InOutVertexData.BindReadVertex(OutputName, OutputSignals[Channel]);
+                }
+            }
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace MultichannelWidthNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TArray<FAudioBufferReadRef> InputSignals;
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(MetasoundBranches::Multichannel::GetInputName(Channel), InParams.OperatorSettings));
+            }
+
+            TDataReadReference<float> InputWidth = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputWidth), InParams.OperatorSettings);
+
+            // A width of one that can't change passes the inputs through
+            const bool bPassthrough = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputWidth)) && *InputWidth == 1.0f;
+
+            return MakeUnique<TMultichannelWidthOperator<NumChannels>>(InParams.OperatorSettings, MoveTemp(InputSignals), InputWidth, bPassthrough);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            // Start from the current width rather than ramping into the first block
+            WidthFactor = MetasoundBranches::Kernels::Clamp(*InputWidth, 0.0f, 2.0f);
+
+            for (FAudioBufferWriteRef& OutputSignal : OutputSignals)
+            {
+                OutputSignal->Zero();
+            }
+        }
+
+        void Execute()
+        {
+            // The outputs are bound to the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(MultichannelWidth);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = OutputSignals[0]->Num();
+
+            const float* InputData[NumChannels];
+            float* OutputData[NumChannels];
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                InputData[Channel] = InputSignals[Channel]->GetData();
+                OutputData[Channel] = OutputSignals[Channel]->GetData();
+            }
+
+            // A change of width ramps across the block rather than stepping at its start
+            ProcessMultichannelWidthRamped(WidthFactor, *InputWidth, InputData, OutputData, NumChannels, NumFrames);
+        }
+
+        bool IsPassthrough() const
+        {
+            return bPassthrough;
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace MultichannelWidthNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputWidth), *InputWidth);
+
+            for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutInputs.Add(MetasoundBranches::Multichannel::GetInputName(Channel), *InputSignals[Channel]);
+            }
+        }
+
+    private:
+        // Inputs
+        TArray<FAudioBufferReadRef> InputSignals;
+        FFloatReadRef InputWidth;
+
+        // Outputs, empty in passthrough
+        TArray<FAudioBufferWriteRef> OutputSignals;
+
+        // Clamped width applied at the end of the last block
+        float WidthFactor;
+
+        // Outputs bound to the inputs, decided at build time
+        bool bPassthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(TMultichannelWidthOperator<4>);
+
+    template<int32 NumChannels>
+    class TMultichannelWidthNode : public FNodeFacade
+    {
+    public:
+        TMultichannelWidthNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<TMultichannelWidthOperator<NumChannels>>())
+        {
+        }
+    };
+
+    using FMultichannelWidth4Node = TMultichannelWidthNode<4>;
+    using FMultichannelWidth6Node = TMultichannelWidthNode<6>;
+    using FMultichannelWidth8Node = TMultichannelWidthNode<8>;
+
+    METASOUND_REGISTER_NODE(FMultichannelWidth4Node);
+    METASOUND_REGISTER_NODE(FMultichannelWidth6Node);
+    METASOUND_REGISTER_NODE(FMultichannelWidth8Node);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -8,9 +8,17 @@
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
 #include "Math/UnrealMathUtility.h"
+#include "MetasoundBranches/Public/Kernels/AllPassKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesRebuildWorker.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_PhaseDisperserNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(PhaseDisperser, "Phase Disperser");
+
 namespace Metasound
 {
     namespace PhaseDisperserNodeNames
@@ -19,24 +27,43 @@ namespace Metasound
         METASOUND_PARAM(OutputSignal, "Out", "Phase-dispersed audio.");
 
         METASOUND_PARAM(NumFilters, "Stages", "Number of allpass filter stages to apply (1-128).");
+        METASOUND_PARAM(Mode, "Mode", "0: automatic, chosen from Stages when the node starts or resets, 1: recursive stages (default), 2: convolution with the stages' impulse response, 3: designed dispersion (ignores Stages).");
+        METASOUND_PARAM(Dispersion, "Dispersion", "Designed mode: delay of the low frequency over the high frequency in milliseconds (negative delays the high frequency).");
+        METASOUND_PARAM(LowFrequency, "Low Frequency", "Designed mode: low end of the dispersed range in Hz.");
+        METASOUND_PARAM(HighFrequency, "High Frequency", "Designed mode: high end of the dispersed range in Hz.");
     }
 
     class FPhaseDisperserOperator : public TExecutableOperator<FPhaseDisperserOperator>
     {
     public:
         // Maximum number of allowed allpass filters
-        static constexpr int32 MaxAllowedFilters = 128;
+        static constexpr int32 MaxAllowedFilters = MetasoundBranches::Kernels::MaxAllPassStages;
 
-        FPhaseDisperserOperator(const FAudioBufferReadRef& InSignal, const TDataReadReference<int32>& InNumFilters)
+        FPhaseDisperserOperator(const FOperatorSettings& InSettings, const FAudioBufferReadRef& InSignal, const TDataReadReference<int32>& InNumFilters, const TDataReadReference<int32>& InMode,
+            const FFloatReadRef& InDispersion, const FFloatReadRef& InLowFrequency, const FFloatReadRef& InHighFrequency, bool bInMayConvolve, bool bInMayDesign)
             : InputSignal(InSignal)
             , NumFilters(InNumFilters)
+            , Mode(InMode)
+            , Dispersion(InDispersion)
+            , LowFrequency(InLowFrequency)
+            , HighFrequency(InHighFrequency)
             , OutputSignal(FAudioBufferWriteRef::CreateNew(InSignal->Num()))
+            , SampleRate(InSettings.GetSampleRate())
+            , RequestedParams(GetDispersionParams())
+            , InstanceStats(TEXT("PhaseDisperser"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
-            AllPassFilters.SetNum(MaxAllowedFilters);
-            for (int32 i = 0; i < MaxAllowedFilters; ++i)
+            // The convolver and the sections are only allocated for nodes whose mode can reach them
+            MetasoundBranches::Kernels::AllocateAllPassDisperserModes(DisperserState, bInMayConvolve, bInMayDesign);
+            MetasoundBranches::Kernels::ResetAllPassDisperser(DisperserState, FMath::Clamp(*NumFilters, 1, MaxAllowedFilters));
+
+            // Only nodes that can reach the designed mode design a table and register with the rebuild worker
+            if (bInMayDesign)
             {
-                AllPassFilters[i].Init();
+                DesignSlot = MakeUnique<FDesignSlot>(MetasoundBranches::GetRebuildWorker(), &MetasoundBranches::Kernels::MakeDispersionDesign, RequestedParams);
             }
+
+            // Built at module startup already; this only makes sure the audio thread never builds it
+            MetasoundBranches::Kernels::GetAllPassResponseBank();
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -46,7 +73,11 @@ namespace Metasound
             static const FVertexInterface Interface(
                 FInputVertexInterface(
                     TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSignal)),
-                    TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(NumFilters)) 
+                    TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(NumFilters)),
+                    TInputDataVertexModel<int32>(METASOUND_GET_PARAM_NAME_AND_METADATA(Mode), 1),
+                    TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(Dispersion), 10.0f),
+                    TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(LowFrequency), 100.0f),
+                    TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(HighFrequency), 4000.0f)
                 ),
                 FOutputVertexInterface(
                     TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputSignal))
@@ -65,7 +96,8 @@ namespace Metasound
                 FNodeClassMetadata Metadata;
                 Metadata.ClassName = { StandardNodes::Namespace, TEXT("PhaseDisperser"), StandardNodes::AudioVariant };
                 Metadata.MajorVersion = 1;
-                Metadata.MinorVersion = 0;
+                // 1.1 added the Mode, Dispersion, Low Frequency and High Frequency inputs
+                Metadata.MinorVersion = 1;
                 Metadata.DisplayName = METASOUND_LOCTEXT("PhaseDisperserNodeDisplayName", "Phase Disperser");
                 Metadata.Description = METASOUND_LOCTEXT("PhaseDisperserNodeDesc", "Applies phase dispersion through a chain of allpass filters.");
                 Metadata.Author = "Charles Matthews";
@@ -81,114 +113,168 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace PhaseDisperserNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(NumFilters), NumFilters);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(NumFilters), NumFilters);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(Mode), Mode);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(Dispersion), Dispersion);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(LowFrequency), LowFrequency);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(HighFrequency), HighFrequency);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace PhaseDisperserNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace PhaseDisperserNodeNames;
 
-            const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(
+                METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
 
-            TDataReadReference<FAudioBuffer> InputSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(
-                InputInterface, METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
+            TDataReadReference<int32> NumFiltersRef = InputData.GetOrCreateDefaultDataReadReference<int32>(
+                METASOUND_GET_PARAM_NAME(NumFilters), InParams.OperatorSettings);
 
-            TDataReadReference<int32> NumFiltersRef = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<int32>(
-                InputInterface, METASOUND_GET_PARAM_NAME(NumFilters), InParams.OperatorSettings);
+            TDataReadReference<int32> ModeRef = InputData.GetOrCreateDefaultDataReadReference<int32>(
+                METASOUND_GET_PARAM_NAME(Mode), InParams.OperatorSettings);
+
+            TDataReadReference<float> DispersionRef = InputData.GetOrCreateDefaultDataReadReference<float>(
+                METASOUND_GET_PARAM_NAME(Dispersion), InParams.OperatorSettings);
+
+            TDataReadReference<float> LowFrequencyRef = InputData.GetOrCreateDefaultDataReadReference<float>(
+                METASOUND_GET_PARAM_NAME(LowFrequency), InParams.OperatorSettings);
+
+            TDataReadReference<float> HighFrequencyRef = InputData.GetOrCreateDefaultDataReadReference<float>(
+                METASOUND_GET_PARAM_NAME(HighFrequency), InParams.OperatorSettings);
 
             int32 ClampedNumFilters = FMath::Clamp(*NumFiltersRef, 1, MaxAllowedFilters);
-          
-            return MakeUnique<FPhaseDisperserOperator>(InputSignal, NumFiltersRef);
+
+            // A constant mode only ever needs its own state: automatic may convolve, and only designed needs the design
+            // slot and the sections
+            using MetasoundBranches::Kernels::EAllPassMode;
+            const bool bModeMayChange = !MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(Mode));
+            const EAllPassMode ConstantMode = static_cast<EAllPassMode>(FMath::Clamp(*ModeRef, 0, static_cast<int32>(EAllPassMode::Count) - 1));
+            const bool bMayConvolve = bModeMayChange || ConstantMode == EAllPassMode::Convolution || ConstantMode == EAllPassMode::Auto;
+            const bool bMayDesign = bModeMayChange || ConstantMode == EAllPassMode::Designed;
+
+            return MakeUnique<FPhaseDisperserOperator>(InParams.OperatorSettings, InputSignal, NumFiltersRef, ModeRef, DispersionRef, LowFrequencyRef, HighFrequencyRef, bMayConvolve, bMayDesign);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear the delay lines of every stage in place, and choose the automatic mode afresh
+            MetasoundBranches::Kernels::ResetAllPassDisperser(DisperserState, FMath::Clamp(*NumFilters, 1, MaxAllowedFilters));
+
+            OutputSignal->Zero();
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(PhaseDisperser);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const FScopedFlushDenormals FlushDenormals;
+
             int32 NumFrames = InputSignal->Num();
             const float* InputData = InputSignal->GetData();
             float* OutputData = OutputSignal->GetData();
 
-            // Temporary buffer to hold intermediate results
-            TArray<float> TempBuffer;
-            TempBuffer.SetNumZeroed(NumFrames);
-
-            // Initial copy of input to temp buffer
-            FMemory::Memcpy(TempBuffer.GetData(), InputData, NumFrames * sizeof(float));
+            // The cascade runs in place on the output buffer, so nothing is allocated on the render thread
+            if (OutputData != InputData)
+            {
+                FMemory::Memcpy(OutputData, InputData, NumFrames * sizeof(float));
+            }
 
             int32 CurrentNumFilters = FMath::Clamp(*NumFilters, 1, MaxAllowedFilters);
+            const EAllPassMode CurrentMode = static_cast<EAllPassMode>(FMath::Clamp(*Mode, 0, static_cast<int32>(EAllPassMode::Count) - 1));
 
-            for (int32 i = 0; i < CurrentNumFilters; ++i)
+            // Designs are rebuilt on the plugin's worker; the sections keep the design they have until the new one
+            // is ready, then fade over to it across one block
+            if (CurrentMode == EAllPassMode::Designed && DesignSlot.IsValid())
             {
-                AllPassFilters[i].ProcessBuffer(TempBuffer.GetData(), NumFrames);
+                const FDispersionParams Params = GetDispersionParams();
+                if (Params != RequestedParams)
+                {
+                    DesignSlot->Request(Params);
+                    RequestedParams = Params;
+                }
+
+                DesignSlot->Acquire();
+                SetAllPassDispersionDesign(DisperserState, &DesignSlot->Get(), true);
             }
 
-            FMemory::Memcpy(OutputData, TempBuffer.GetData(), NumFrames * sizeof(float));
-        }
+            // Long cascades convolve with their precomputed impulse response instead of running every stage
+            ProcessAllPassDisperser(DisperserState, CurrentMode, CurrentNumFilters, OutputData, NumFrames);
 
-    private:
-        class FAllPassFilter
-        {
-        public:
-            void Init(float InFeedback = 0.5f)
+            // Output silence rather than NaN / infinity for the block in which the state was reset
+            if (!GuardAllPassDisperserState(DisperserState, CurrentNumFilters))
             {
-                DelayBuffer.SetNumZeroed(2); // For D = 1
-                WriteIndex = 0;
-                Feedback = InFeedback;
+                FMemory::Memzero(OutputData, NumFrames * sizeof(float));
             }
+        }
 
-            void ProcessBuffer(float* InOutBuffer, int32 NumSamples)
-            {
-                for (int32 i = 0; i < NumSamples; ++i)
-                {
-                    float InSample = InOutBuffer[i];
-                    float DelayedSample = DelayBuffer[WriteIndex];
-
-                    // Allpass difference equation: y[n] = -a * x[n] + x[n-D] + a * y[n-D]
-                    float OutSample = -Feedback * InSample + DelayedSample;
-                    DelayBuffer[WriteIndex] = InSample + Feedback * OutSample;
-
-                    InOutBuffer[i] = OutSample;
+        MetasoundBranches::Kernels::FDispersionParams GetDispersionParams() const
+        {
+            MetasoundBranches::Kernels::FDispersionParams Params;
+            Params.DispersionSeconds = *Dispersion * 0.001f;
+            Params.LowFrequency = *LowFrequency;
+            Params.HighFrequency = *HighFrequency;
+            Params.SampleRate = SampleRate;
+            return Params;
+        }
 
-                    // Update write index for D = 1
-                    WriteIndex = (WriteIndex + 1) % 2;
-                }
-            }
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace PhaseDisperserNodeNames;
 
-        private:
-            TArray<float> DelayBuffer;
-            int32 WriteIndex;
-            float Feedback;
-        };
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSignal), *InputSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(NumFilters), static_cast<float>(*NumFilters));
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(Mode), static_cast<float>(*Mode));
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(Dispersion), *Dispersion);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(LowFrequency), *LowFrequency);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(HighFrequency), *HighFrequency);
+        }
 
+    private:
         // Inputs
         FAudioBufferReadRef InputSignal;
         FInt32ReadRef NumFilters;
+        FInt32ReadRef Mode;
+        FFloatReadRef Dispersion;
+        FFloatReadRef LowFrequency;
+        FFloatReadRef HighFrequency;
 
         // Outputs
         FAudioBufferWriteRef OutputSignal;
 
-        // Allpass filters
-        TArray<FAllPassFilter> AllPassFilters;
+        // Delay lines and feedback of every allpass stage, stored contiguously, and the convolver and sections used in
+        // their place when the mode can reach them
+        MetasoundBranches::Kernels::FAllPassDisperserState DisperserState;
+
+        float SampleRate;
+
+        // Designed sections, rebuilt off the audio thread from the last parameters requested; only created when the
+        // mode can be designed
+        using FDesignSlot = MetasoundBranches::Kernels::TRebuildSlot<MetasoundBranches::Kernels::FDispersionParams, MetasoundBranches::Kernels::FDispersionDesign>;
+        MetasoundBranches::Kernels::FDispersionParams RequestedParams;
+        TUniquePtr<FDesignSlot> DesignSlot;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FPhaseDisperserOperator);
+
     class FPhaseDisperserNode : public FNodeFacade
     {
     public:
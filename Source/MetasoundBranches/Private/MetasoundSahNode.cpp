@@ -7,9 +7,15 @@
 #include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/SahKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_SahNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Sah, "Sample And Hold (Audio Trigger)");
+
 namespace Metasound
 {
     namespace SahNodeNames
@@ -33,8 +39,7 @@ namespace Metasound
             , InputTrigger(InTrigger)
             , InputThreshold(InThreshold)
             , OutputSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , SampledValue(0.0f)
-            , PreviousTriggerValue(0.0f)
+            , InstanceStats(TEXT("Sah"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -82,71 +87,65 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SahNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputThreshold), InputThreshold);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputThreshold), InputThreshold);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SahNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace SahNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FAudioBuffer> InputSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
-            TDataReadReference<FAudioBuffer> InputTrigger = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
-            TDataReadReference<float> InputThreshold = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputThreshold), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputTrigger = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
+            TDataReadReference<float> InputThreshold = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputThreshold), InParams.OperatorSettings);
 
             return MakeUnique<FSahOperator>(InParams.OperatorSettings, InputSignal, InputTrigger, InputThreshold);
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear the held value and trigger history
+            State = MetasoundBranches::Kernels::FSahState();
+            OutputSignal->Zero();
+        }
+
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(Sah);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             int32 NumFrames = InputSignal->Num();
 
             const float* SignalData = InputSignal->GetData();
             const float* TriggerData = InputTrigger->GetData();
             float* OutputData = OutputSignal->GetData();
 
-            float Threshold = *InputThreshold;
-
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                float CurrentTriggerValue = TriggerData[i];
-
-                // Detect rising edge
-                if (PreviousTriggerValue < Threshold && CurrentTriggerValue >= Threshold)
-                {
-                    // Sample the input signal
-                    SampledValue = SignalData[i];
-                }
+            ProcessSah(State, SignalData, TriggerData, *InputThreshold, OutputData, NumFrames);
+        }
 
-                // Output the sampled value
-                OutputData[i] = SampledValue;
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace SahNodeNames;
 
-                // Update previous trigger value
-                PreviousTriggerValue = CurrentTriggerValue;
-            }
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSignal), *InputSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTrigger), *InputTrigger);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputThreshold), *InputThreshold);
         }
 
     private:
@@ -159,11 +158,14 @@ namespace Metasound
         // Outputs
         FAudioBufferWriteRef OutputSignal;
 
-        // Internal variables
-        float SampledValue;
-        float PreviousTriggerValue;
+        // Sampled value and trigger history
+        MetasoundBranches::Kernels::FSahState State;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FSahOperator);
+
     class FSahNode : public FNodeFacade
     {
     public:
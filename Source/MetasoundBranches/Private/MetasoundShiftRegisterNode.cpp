@@ -7,9 +7,15 @@
 #include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/ClockKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ShiftRegisterNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(ShiftRegister, "Shift Register");
+
 namespace Metasound
 {
     namespace ShiftRegisterNodeNames
@@ -44,14 +50,7 @@ namespace Metasound
             , OutputSignal6(FFloatWriteRef::CreateNew(0.0f))
             , OutputSignal7(FFloatWriteRef::CreateNew(0.0f))
             , OutputSignal8(FFloatWriteRef::CreateNew(0.0f))
-            , ShiftedValue1(0.0f)
-            , ShiftedValue2(0.0f)
-            , ShiftedValue3(0.0f)
-            , ShiftedValue4(0.0f)
-            , ShiftedValue5(0.0f)
-            , ShiftedValue6(0.0f)
-            , ShiftedValue7(0.0f)
-            , ShiftedValue8(0.0f)
+            , InstanceStats(TEXT("ShiftRegister"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -105,45 +104,36 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ShiftRegisterNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTrigger), InputTrigger);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ShiftRegisterNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal1), OutputSignal1);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal2), OutputSignal2);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal3), OutputSignal3);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal4), OutputSignal4);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal5), OutputSignal5);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal6), OutputSignal6);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal7), OutputSignal7);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal8), OutputSignal8);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal1), OutputSignal1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal2), OutputSignal2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal3), OutputSignal3);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal4), OutputSignal4);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal5), OutputSignal5);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal6), OutputSignal6);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal7), OutputSignal7);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal8), OutputSignal8);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace ShiftRegisterNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<float> InputSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
-            TDataReadReference<FTrigger> InputTrigger = InputCollection.GetDataReadReferenceOrConstruct<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
+            TDataReadReference<float> InputSignal = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
+            TDataReadReference<FTrigger> InputTrigger = InputData.GetOrCreateDefaultDataReadReference<FTrigger>(METASOUND_GET_PARAM_NAME(InputTrigger), InParams.OperatorSettings);
 
             return MakeUnique<FShiftRegisterOperator>(
                 InParams.OperatorSettings,
@@ -152,8 +142,26 @@ namespace Metasound
             );
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear the register contents
+            State = MetasoundBranches::Kernels::FShiftRegisterState();
+
+            *OutputSignal1 = 0.0f;
+            *OutputSignal2 = 0.0f;
+            *OutputSignal3 = 0.0f;
+            *OutputSignal4 = 0.0f;
+            *OutputSignal5 = 0.0f;
+            *OutputSignal6 = 0.0f;
+            *OutputSignal7 = 0.0f;
+            *OutputSignal8 = 0.0f;
+        }
+
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(ShiftRegister);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
             InputTrigger->ExecuteBlock(
                 // Pre-trigger lambda (called before any triggers in the block)
                 [](int32 StartFrame, int32 EndFrame)
@@ -164,26 +172,27 @@ namespace Metasound
                 // On-trigger lambda (called for each trigger event)
                 [&](int32 StartFrame, int32 EndFrame)
                 {
-                    ShiftedValue8 = ShiftedValue7;
-                    ShiftedValue7 = ShiftedValue6;
-                    ShiftedValue6 = ShiftedValue5;
-                    ShiftedValue5 = ShiftedValue4;
-                    ShiftedValue4 = ShiftedValue3;
-                    ShiftedValue3 = ShiftedValue2;
-                    ShiftedValue2 = ShiftedValue1;
-                    ShiftedValue1 = *InputSignal;
+                    MetasoundBranches::Kernels::ShiftRegister(State, *InputSignal);
                 }
             );
 
             // Update outputs
-            *OutputSignal1 = ShiftedValue1;
-            *OutputSignal2 = ShiftedValue2;
-            *OutputSignal3 = ShiftedValue3;
-            *OutputSignal4 = ShiftedValue4;
-            *OutputSignal5 = ShiftedValue5;
-            *OutputSignal6 = ShiftedValue6;
-            *OutputSignal7 = ShiftedValue7;
-            *OutputSignal8 = ShiftedValue8;
+            *OutputSignal1 = State.Values[0];
+            *OutputSignal2 = State.Values[1];
+            *OutputSignal3 = State.Values[2];
+            *OutputSignal4 = State.Values[3];
+            *OutputSignal5 = State.Values[4];
+            *OutputSignal6 = State.Values[5];
+            *OutputSignal7 = State.Values[6];
+            *OutputSignal8 = State.Values[7];
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace ShiftRegisterNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSignal), *InputSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTrigger), *InputTrigger);
         }
 
     private:
@@ -199,16 +208,13 @@ namespace Metasound
         FFloatWriteRef OutputSignal7;
         FFloatWriteRef OutputSignal8;
 
-        float ShiftedValue1;
-        float ShiftedValue2;
-        float ShiftedValue3;
-        float ShiftedValue4;
-        float ShiftedValue5;
-        float ShiftedValue6;
-        float ShiftedValue7;
-        float ShiftedValue8;
+        MetasoundBranches::Kernels::FShiftRegisterState State;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FShiftRegisterOperator);
+
     class FShiftRegisterNode : public FNodeFacade
     {
     public:
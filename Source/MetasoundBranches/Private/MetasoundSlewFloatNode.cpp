@@ -7,9 +7,15 @@
 #include "MetasoundStandardNodesNames.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Public/Kernels/SlewKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundSlewNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(SlewFloat, "Slew (Float)");
+
 namespace Metasound
 {
     // Vertex Names - define the node's inputs and outputs here
@@ -37,8 +43,8 @@ namespace Metasound
             , InputRiseTime(InRiseTime)
             , InputFallTime(InFallTime)
             , OutputSignal(FFloatWriteRef::CreateNew(0.0f))
-            , PreviousOutputSample(0.0f)
             , SampleRate(InSampleRate)
+            , InstanceStats(TEXT("SlewFloat"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -86,52 +92,42 @@ namespace Metasound
         }
 
         // Input Data References
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewFloatNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
         }
 
         // Output Data References
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewFloatNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
         }
 
         // Operator Factory Method
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace SlewFloatNodeNames;
 
-            const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
             // Retrieve input references or use default values
-            TDataReadReference<float> InputSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(
-                InputInterface,
+            TDataReadReference<float> InputSignal = InputData.GetOrCreateDefaultDataReadReference<float>(
                 METASOUND_GET_PARAM_NAME(InputSignal),
                 InParams.OperatorSettings
             );
 
-            TDataReadReference<FTime> InputRiseTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface,
+            TDataReadReference<FTime> InputRiseTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(
                 METASOUND_GET_PARAM_NAME(InputRiseTime),
                 InParams.OperatorSettings
             );
 
-            TDataReadReference<FTime> InputFallTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface,
+            TDataReadReference<FTime> InputFallTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(
                 METASOUND_GET_PARAM_NAME(InputFallTime),
                 InParams.OperatorSettings
             );
@@ -141,36 +137,36 @@ namespace Metasound
             return MakeUnique<FSlewFloatOperator>(InParams.OperatorSettings, InputSignal, InputRiseTime, InputFallTime, SampleRate);
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear slew history and output
+            State = MetasoundBranches::Kernels::FSlewState();
+            *OutputSignal = 0.0f;
+        }
+
         // Primary node functionality
         virtual void Execute()
         {
-            float SignalSample = *InputSignal;
+            METASOUND_BRANCHES_EXECUTE_SCOPE(SlewFloat);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
 
-            float RiseTimeSeconds = InputRiseTime->GetSeconds();
-            float FallTimeSeconds = InputFallTime->GetSeconds();
+            using namespace MetasoundBranches::Kernels;
 
-            // Calculate alpha values based on rise and fall times
-            // Alpha = exp(-1 / (time * sample rate))
-            float RiseAlpha = (RiseTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (RiseTimeSeconds * SampleRate)) : 0.0f;
-            float FallAlpha = (FallTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (FallTimeSeconds * SampleRate)) : 0.0f;
+            const FSlewCoefficients Coefficients = MakeSlewCoefficients(InputRiseTime->GetSeconds(), InputFallTime->GetSeconds(), static_cast<float>(SampleRate));
 
-            float OutputSample = PreviousOutputSample;
+            // One sample per block, so the state is guarded without switching the float mode
+            State.PreviousOutput = SlewSample(State.PreviousOutput, *InputSignal, Coefficients);
+            GuardSlewState(State);
+            *OutputSignal = State.PreviousOutput;
+        }
 
-            if (SignalSample > PreviousOutputSample)
-            {
-                OutputSample = RiseAlpha * PreviousOutputSample + (1.0f - RiseAlpha) * SignalSample;
-            }
-            else if (SignalSample < PreviousOutputSample)
-            {
-                OutputSample = FallAlpha * PreviousOutputSample + (1.0f - FallAlpha) * SignalSample;
-            }
-            else
-            {
-                OutputSample = SignalSample;
-            }
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace SlewFloatNodeNames;
 
-            *OutputSignal = OutputSample;
-            PreviousOutputSample = OutputSample;
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSignal), *InputSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime->GetSeconds());
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime->GetSeconds());
         }
 
     private:
@@ -183,12 +179,16 @@ namespace Metasound
         FFloatWriteRef OutputSignal;
 
         // State Variable
-        float PreviousOutputSample;
+        MetasoundBranches::Kernels::FSlewState State;
 
         // Sample Rate
         int32 SampleRate;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FSlewFloatOperator);
+
     // Node Facade Class
     class FSlewFloatNode : public FNodeFacade
     {
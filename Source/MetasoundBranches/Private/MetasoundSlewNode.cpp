@@ -7,9 +7,15 @@
 #include "MetasoundStandardNodesNames.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Public/Kernels/SlewKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundSlewNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Slew, "Slew (Audio)");
+
 namespace Metasound
 {
     // Vertex Names - define the node's inputs and outputs here
@@ -37,8 +43,8 @@ namespace Metasound
             , InputRiseTime(InRiseTime)
             , InputFallTime(InFallTime)
             , OutputSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , PreviousOutputSample(0.0f)
             , SampleRate(InSampleRate)
+            , InstanceStats(TEXT("Slew"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -86,52 +92,42 @@ namespace Metasound
         }
 
         // Input Data References
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime);
         }
 
         // Output Data References
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace SlewNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputSignal), OutputSignal);
         }
 
         // Operator Factory Method
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace SlewNodeNames;
 
-            const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
             // Retrieve input references or use default values
-            TDataReadReference<FAudioBuffer> InputSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(
-                InputInterface,
+            TDataReadReference<FAudioBuffer> InputSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(
                 METASOUND_GET_PARAM_NAME(InputSignal),
                 InParams.OperatorSettings
             );
 
-            TDataReadReference<FTime> InputRiseTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface,
+            TDataReadReference<FTime> InputRiseTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(
                 METASOUND_GET_PARAM_NAME(InputRiseTime),
                 InParams.OperatorSettings
             );
 
-            TDataReadReference<FTime> InputFallTime = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface,
+            TDataReadReference<FTime> InputFallTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(
                 METASOUND_GET_PARAM_NAME(InputFallTime),
                 InParams.OperatorSettings
             );
@@ -141,45 +137,48 @@ namespace Metasound
             return MakeUnique<FSlewOperator>(InParams.OperatorSettings, InputSignal, InputRiseTime, InputFallTime, SampleRate);
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Clear slew history and output
+            State = MetasoundBranches::Kernels::FSlewState();
+            OutputSignal->Zero();
+        }
+
         // Primary node functionality
         virtual void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(Slew);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const FScopedFlushDenormals FlushDenormals;
+
             int32 NumFrames = InputSignal->Num();
 
             const float* SignalData = InputSignal->GetData();
             float* OutputDataPtr = OutputSignal->GetData();
 
-            float RiseTimeSeconds = InputRiseTime->GetSeconds();
-            float FallTimeSeconds = InputFallTime->GetSeconds();
+            const FSlewCoefficients Coefficients = MakeSlewCoefficients(InputRiseTime->GetSeconds(), InputFallTime->GetSeconds(), static_cast<float>(SampleRate));
 
-            // Calculate alpha values based on rise and fall times
-            // Alpha = exp(-1 / (time * sample rate))
-            float RiseAlpha = (RiseTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (RiseTimeSeconds * SampleRate)) : 0.0f;
-            float FallAlpha = (FallTimeSeconds > 0.0f) ? FMath::Exp(-1.0f / (FallTimeSeconds * SampleRate)) : 0.0f;
+            ProcessSlew(State, SignalData, OutputDataPtr, NumFrames, Coefficients);
 
-            for (int32 i = 0; i < NumFrames; ++i)
+            // Output silence rather than NaN / infinity for the block in which the state was reset
+            if (!GuardSlewState(State))
             {
-                float SignalSample = SignalData[i];
-                float OutputSample = PreviousOutputSample;
-
-                if (SignalSample > PreviousOutputSample)
-                {
-                    OutputSample = RiseAlpha * PreviousOutputSample + (1.0f - RiseAlpha) * SignalSample;
-                }
-                else if (SignalSample < PreviousOutputSample)
-                {
-                    OutputSample = FallAlpha * PreviousOutputSample + (1.0f - FallAlpha) * SignalSample;
-                }
-                else
-                {
-                    OutputSample = SignalSample;
-                }
-
-                OutputDataPtr[i] = OutputSample;
-                PreviousOutputSample = OutputSample;
+                FMemory::Memzero(OutputDataPtr, NumFrames * sizeof(float));
             }
         }
 
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace SlewNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSignal), *InputSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRiseTime), InputRiseTime->GetSeconds());
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputFallTime), InputFallTime->GetSeconds());
+        }
+
     private:
         // Input References
         FAudioBufferReadRef InputSignal;
@@ -190,12 +189,16 @@ namespace Metasound
         FAudioBufferWriteRef OutputSignal;
 
         // State Variable
-        float PreviousOutputSample;
+        MetasoundBranches::Kernels::FSlewState State;
 
         // Sample Rate
         int32 SampleRate;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FSlewOperator);
+
     // Node Facade Class
     class FSlewNode : public FNodeFacade
     {
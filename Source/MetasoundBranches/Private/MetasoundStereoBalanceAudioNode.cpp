@@ -0,0 +1,183 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundStereoBalanceAudioNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_BalanceAudioNode"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoBalanceAudio, "Stereo Balance (Audio)");
+
+namespace Metasound
+{
+    namespace BalanceAudioNodeNames
+    {
+        METASOUND_PARAM(InputLeftSignal, "In L", "Left channel of the stereo input signal.");
+        METASOUND_PARAM(InputRightSignal, "In R", "Right channel of the stereo input signal.");
+        METASOUND_PARAM(InputBalance, "Balance", "Audio-rate balance ranging from -1.0 (full left) to 1.0 (full right), applied per sample.");
+
+        METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel of the adjusted stereo output signal.");
+        METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel of the adjusted stereo output signal.");
+    }
+
+    class FBalanceAudioOperator : public TExecutableOperator<FBalanceAudioOperator>
+    {
+    public:
+        FBalanceAudioOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InLeftSignal,
+            const FAudioBufferReadRef& InRightSignal,
+            const FAudioBufferReadRef& InBalance)
+            : InputLeftSignal(InLeftSignal)
+            , InputRightSignal(InRightSignal)
+            , InputBalance(InBalance)
+            , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , InstanceStats(TEXT("StereoBalanceAudio"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace BalanceAudioNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBalance))
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, TEXT("Stereo Balance (Audio)"), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = METASOUND_LOCTEXT("StereoBalanceAudioNodeDisplayName", "Stereo Balance (Audio)");
+                    Metadata.Description = METASOUND_LOCTEXT("StereoBalanceAudioNodeDesc", "Adjusts the balance of a stereo signal with audio-rate modulation.");
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>();
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace BalanceAudioNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBalance), InputBalance);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace BalanceAudioNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace BalanceAudioNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputBalance = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputBalance), InParams.OperatorSettings);
+
+            return MakeUnique<FBalanceAudioOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InputBalance);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoBalanceAudio);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = InputLeftSignal->Num();
+
+            const float* LeftData = InputLeftSignal->GetData();
+            const float* RightData = InputRightSignal->GetData();
+            const float* BalanceData = InputBalance->GetData();
+            float* OutputLeftData = OutputLeftSignal->GetData();
+            float* OutputRightData = OutputRightSignal->GetData();
+
+            // Equal-power gains for every frame, read from the shared quarter-sine table
+            ProcessStereoBalanceAudio(LeftData, RightData, BalanceData, OutputLeftData, OutputRightData, NumFrames);
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace BalanceAudioNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal), *InputLeftSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal), *InputRightSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputBalance), *InputBalance);
+        }
+
+    private:
+
+        // Inputs
+        FAudioBufferReadRef InputLeftSignal;
+        FAudioBufferReadRef InputRightSignal;
+        FAudioBufferReadRef InputBalance;
+
+        // Outputs
+        FAudioBufferWriteRef OutputLeftSignal;
+        FAudioBufferWriteRef OutputRightSignal;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(FBalanceAudioOperator);
+
+    class FBalanceAudioNode : public FNodeFacade
+    {
+    public:
+        FBalanceAudioNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FBalanceAudioOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FBalanceAudioNode);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -8,16 +8,22 @@
 #include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "Math/UnrealMathUtility.h"          // For FMath functions
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_BalanceNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoBalance, "Stereo Balance");
+
 namespace Metasound
 {
     namespace BalanceNodeNames
     {
         METASOUND_PARAM(InputLeftSignal, "In L", "Left channel of the stereo input signal.");
         METASOUND_PARAM(InputRightSignal, "In R", "Right channel of the stereo input signal.");
-        METASOUND_PARAM(InputBalance, "Balance", "Balance control ranging from -1.0 (full left) to 1.0 (full right).");
+        METASOUND_PARAM(InputBalance, "Balance", "Balance control ranging from -1.0 (full left) to 1.0 (full right). Changes ramp over one block.");
 
         METASOUND_PARAM(OutputLeftSignal, "Out L", "Left channel of the adjusted stereo output signal.");
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right channel of the adjusted stereo output signal.");
@@ -36,6 +42,8 @@ namespace Metasound
             , InputBalance(InBalance)
             , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
             , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , Gains(MetasoundBranches::Kernels::MakeBalanceGains(*InBalance))
+            , InstanceStats(TEXT("StereoBalance"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -84,47 +92,52 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BalanceNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputBalance), InputBalance);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBalance), InputBalance);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace BalanceNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace BalanceNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FAudioBuffer> InputLeftSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
-            TDataReadReference<FAudioBuffer> InputRightSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
-            TDataReadReference<float> InputBalance = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputBalance), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<float> InputBalance = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputBalance), InParams.OperatorSettings);
 
             return MakeUnique<FBalanceOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InputBalance);
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Start from the current balance rather than ramping into the first block
+            Gains = MetasoundBranches::Kernels::MakeBalanceGains(*InputBalance);
+
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
+        }
+
     void Execute()
     {
+        METASOUND_BRANCHES_EXECUTE_SCOPE(StereoBalance);
+        METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+        using namespace MetasoundBranches::Kernels;
+
         int32 NumFrames = InputLeftSignal->Num();
 
         const float* LeftData = InputLeftSignal->GetData();
@@ -132,19 +145,18 @@ namespace Metasound
         float* OutputLeftData = OutputLeftSignal->GetData();
         float* OutputRightData = OutputRightSignal->GetData();
 
-        float Balance = FMath::Clamp(*InputBalance, -1.0f, 1.0f);
-
-        float Angle = (Balance + 1.0f) * (PI / 4.0f);
-
-        float LeftGain = FMath::Cos(Angle);
-        float RightGain = FMath::Sin(Angle);
+        // A change of balance ramps the gains across the block rather than stepping at its start
+        ProcessStereoGainsRamped(Gains, MakeBalanceGains(*InputBalance), LeftData, RightData, OutputLeftData, OutputRightData, NumFrames);
+    }
 
-        for (int32 i = 0; i < NumFrames; ++i)
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
         {
-            OutputLeftData[i] = LeftData[i] * LeftGain;
-            OutputRightData[i] = RightData[i] * RightGain;
+            using namespace BalanceNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal), *InputLeftSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal), *InputRightSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputBalance), *InputBalance);
         }
-    }
 
     private:
 
@@ -156,8 +168,15 @@ namespace Metasound
         // Outputs
         FAudioBufferWriteRef OutputLeftSignal;
         FAudioBufferWriteRef OutputRightSignal;
+
+        // Gains applied at the end of the last block
+        MetasoundBranches::Kernels::FStereoGains Gains;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FBalanceOperator);
+
     class FBalanceNode : public FNodeFacade
     {
     public:
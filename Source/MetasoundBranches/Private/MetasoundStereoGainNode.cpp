@@ -7,16 +7,24 @@
 #include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
 #include "MetasoundFacade.h"                 // FNodeFacade class
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "Misc/Optional.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoGain"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoGain, "Stereo Gain");
+
 namespace Metasound
 {
     namespace StereoGainNodeNames
     {
         METASOUND_PARAM(InputLeftSignal, "In L", "Left channel audio input.");
         METASOUND_PARAM(InputRightSignal, "In R", "Right channel audio input.");
-        METASOUND_PARAM(InputGain, "Gain (Lin)", "Gain control (0.0 to 1.0).");
+        METASOUND_PARAM(InputGain, "Gain (Lin)", "Gain control (0.0 to 1.0). Changes ramp over one block.");
 
         METASOUND_PARAM(OutputLeftSignal, "Out L", "Left output channel.");
         METASOUND_PARAM(OutputRightSignal, "Out R", "Right output channel.");
@@ -29,13 +37,21 @@ namespace Metasound
             const FOperatorSettings& InSettings,
             const FAudioBufferReadRef& InLeftSignal,
             const FAudioBufferReadRef& InRightSignal,
-            const FFloatReadRef& InGain)
+            const FFloatReadRef& InGain,
+            bool bInPassthrough)
             : InputLeftSignal(InLeftSignal)
             , InputRightSignal(InRightSignal)
             , InputGain(InGain)
-            , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , Gains{ *InGain, *InGain }
+            , bPassthrough(bInPassthrough)
+            , InstanceStats(TEXT("StereoGain"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                OutputLeftSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+                OutputRightSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+            }
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -82,58 +98,100 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoGainNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputGain), InputGain);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGain), InputGain);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoGainNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-            return OutputDataReferences;
+            if (IsPassthrough())
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), InputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), InputRightSignal);
+            }
+            else
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), *OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), *OutputRightSignal);
+            }
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace StereoGainNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<float> Gain = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputGain), InParams.OperatorSettings);
 
-            TDataReadReference<FAudioBuffer> InputLeftSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
-            TDataReadReference<FAudioBuffer> InputRightSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
-            TDataReadReference<float> Gain = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputGain), InParams.OperatorSettings);
+            // A unity gain that can't change passes the inputs through
+            const bool bPassthrough = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputGain)) && *Gain == 1.0f;
 
-            return MakeUnique<FStereoGainOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, Gain);
+            return MakeUnique<FStereoGainOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, Gain, bPassthrough);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            // Start from the current gain rather than ramping into the first block
+            Gains = MetasoundBranches::Kernels::FStereoGains{ *InputGain, *InputGain };
+
+            (*OutputLeftSignal)->Zero();
+            (*OutputRightSignal)->Zero();
         }
 
         void Execute()
         {
+            // The outputs are bound to the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoGain);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             const int32 NumFrames = InputLeftSignal->Num();
 
             const float* LeftData = InputLeftSignal->GetData();
             const float* RightData = InputRightSignal->GetData();
-            float* OutputLeftData = OutputLeftSignal->GetData();
-            float* OutputRightData = OutputRightSignal->GetData();
+            float* OutputLeftData = (*OutputLeftSignal)->GetData();
+            float* OutputRightData = (*OutputRightSignal)->GetData();
 
             const float GainVal = *InputGain;
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                OutputLeftData[i] = LeftData[i] * GainVal;
-                OutputRightData[i] = RightData[i] * GainVal;
-            }
+            // A change of gain ramps across the block rather than stepping at its start
+            ProcessStereoGainsRamped(Gains, FStereoGains{ GainVal, GainVal }, LeftData, RightData, OutputLeftData, OutputRightData, NumFrames);
+        }
+
+        bool IsPassthrough() const
+        {
+            return bPassthrough;
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace StereoGainNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal), *InputLeftSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal), *InputRightSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputGain), *InputGain);
         }
 
     private:
@@ -142,11 +200,21 @@ namespace Metasound
         FAudioBufferReadRef InputRightSignal;
         FFloatReadRef InputGain;
 
-        // Outputs
-        FAudioBufferWriteRef OutputLeftSignal;
-        FAudioBufferWriteRef OutputRightSignal;
+        // Outputs, unset in passthrough
+        TOptional<FAudioBufferWriteRef> OutputLeftSignal;
+        TOptional<FAudioBufferWriteRef> OutputRightSignal;
+
+        // Gains applied at the end of the last block
+        MetasoundBranches::Kernels::FStereoGains Gains;
+
+        // Outputs bound to the inputs, decided at build time
+        bool bPassthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FStereoGainOperator);
+
     class FStereoGainNode : public FNodeFacade
     {
     public:
@@ -7,9 +7,17 @@
 #include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
 #include "MetasoundFacade.h"                 // FNodeFacade class
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "Misc/Optional.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoInverter"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoInverter, "Stereo Inverter");
+
 namespace Metasound
 {
     namespace StereoInverterNodeNames
@@ -33,15 +41,22 @@ namespace Metasound
             const FAudioBufferReadRef& InRightSignal,
             const FBoolReadRef& InInvertLeft,
             const FBoolReadRef& InInvertRight,
-            const FBoolReadRef& InSwapChannels)
+            const FBoolReadRef& InSwapChannels,
+            bool bInPassthrough)
             : InputLeftSignal(InLeftSignal)
             , InputRightSignal(InRightSignal)
             , InputInvertLeft(InInvertLeft)
             , InputInvertRight(InInvertRight)
             , InputSwapChannels(InSwapChannels)
-            , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
-            , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , bPassthrough(bInPassthrough)
+            , InstanceStats(TEXT("StereoInverter"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
+            // In passthrough the outputs are bound to the inputs, so only the other configurations need buffers
+            if (!IsPassthrough())
+            {
+                OutputLeftSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+                OutputRightSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+            }
         }
 
         static const FVertexInterface& DeclareVertexInterface()
@@ -90,79 +105,110 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoInverterNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputInvertLeft), InputInvertLeft);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputInvertRight), InputInvertRight);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSwapChannels), InputSwapChannels);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertLeft), InputInvertLeft);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertRight), InputInvertRight);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSwapChannels), InputSwapChannels);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace StereoInverterNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
-            return OutputDataReferences;
+            if (IsPassthrough())
+            {
+                // The swap can't change either, so it is just a choice of which input each output is bound to
+                const bool bSwap = *InputSwapChannels;
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), bSwap ? InputRightSignal : InputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), bSwap ? InputLeftSignal : InputRightSignal);
+            }
+            else
+            {
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), *OutputLeftSignal);
+                InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), *OutputRightSignal);
+            }
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace StereoInverterNodeNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FAudioBuffer> InputLeftSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
-            TDataReadReference<FAudioBuffer> InputRightSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(InputInterface, METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
 
-            TDataReadReference<bool> InvertLeft = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InputInvertLeft), InParams.OperatorSettings);
-            TDataReadReference<bool> InvertRight = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InputInvertRight), InParams.OperatorSettings);
-            TDataReadReference<bool> SwapChannels = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<bool>(InputInterface, METASOUND_GET_PARAM_NAME(InputSwapChannels), InParams.OperatorSettings);
+            TDataReadReference<bool> InvertLeft = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputInvertLeft), InParams.OperatorSettings);
+            TDataReadReference<bool> InvertRight = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputInvertRight), InParams.OperatorSettings);
+            TDataReadReference<bool> SwapChannels = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputSwapChannels), InParams.OperatorSettings);
 
-            return MakeUnique<FStereoInverterOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InvertLeft, InvertRight, SwapChannels);
+            // Without inversion, and with settings that can't change, the inputs pass through (swapped or not)
+            const bool bPassthrough = MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputInvertLeft))
+                && MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputInvertRight))
+                && MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputSwapChannels))
+                && !*InvertLeft && !*InvertRight;
+
+            return MakeUnique<FStereoInverterOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InvertLeft, InvertRight, SwapChannels, bPassthrough);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // In passthrough the outputs are the inputs, which aren't ours to clear
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            (*OutputLeftSignal)->Zero();
+            (*OutputRightSignal)->Zero();
         }
 
         void Execute()
         {
+            // The outputs are bound to the inputs, see BindOutputs()
+            if (IsPassthrough())
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoInverter);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             const int32 NumFrames = InputLeftSignal->Num();
 
             const float* LeftData = InputLeftSignal->GetData();
             const float* RightData = InputRightSignal->GetData();
-            float* OutputLeftData = OutputLeftSignal->GetData();
-            float* OutputRightData = OutputRightSignal->GetData();
+            float* OutputLeftData = (*OutputLeftSignal)->GetData();
+            float* OutputRightData = (*OutputRightSignal)->GetData();
 
             const bool bInvertL = *InputInvertLeft;
             const bool bInvertR = *InputInvertRight;
             const bool bSwap = *InputSwapChannels;
 
-            const float LMult = bInvertL ? -1.0f : 1.0f;
-            const float RMult = bInvertR ? -1.0f : 1.0f;
+            ProcessStereoInverter(LeftData, RightData, bInvertL, bInvertR, bSwap, OutputLeftData, OutputRightData, NumFrames);
+        }
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                const float LIn = LeftData[i];
-                const float RIn = RightData[i];
-
-                if (bSwap)
-                {
-                    OutputLeftData[i] = RIn * LMult;
-                    OutputRightData[i] = LIn * RMult;
-                }
-                else
-                {
-                    OutputLeftData[i] = LIn * LMult;
-                    OutputRightData[i] = RIn * RMult;
-                }
-            }
+        bool IsPassthrough() const
+        {
+            return bPassthrough;
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace StereoInverterNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal), *InputLeftSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal), *InputRightSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputInvertLeft), *InputInvertLeft ? 1.0f : 0.0f);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputInvertRight), *InputInvertRight ? 1.0f : 0.0f);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSwapChannels), *InputSwapChannels ? 1.0f : 0.0f);
         }
 
     private:
@@ -173,11 +219,18 @@ namespace Metasound
         FBoolReadRef InputInvertRight;
         FBoolReadRef InputSwapChannels;
 
-        // Outputs
-        FAudioBufferWriteRef OutputLeftSignal;
-        FAudioBufferWriteRef OutputRightSignal;
+        // Outputs, unset in passthrough
+        TOptional<FAudioBufferWriteRef> OutputLeftSignal;
+        TOptional<FAudioBufferWriteRef> OutputRightSignal;
+
+        // Outputs bound to the inputs, decided at build time
+        bool bPassthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FStereoInverterOperator);
+
     class FStereoInverterNode : public FNodeFacade
     {
     public:
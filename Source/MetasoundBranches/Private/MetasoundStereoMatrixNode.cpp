@@ -0,0 +1,243 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundStereoMatrixNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoMatrix"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoMatrix, "Stereo Matrix");
+
+namespace Metasound
+{
+    namespace StereoMatrixNodeNames
+    {
+        METASOUND_PARAM(InputLeftSignal, "In L", "Left channel audio input.");
+        METASOUND_PARAM(InputRightSignal, "In R", "Right channel audio input.");
+        METASOUND_PARAM(InputWidth, "Width", "Stereo width factor ranging from 0 to 200% (0 - 2). Changes ramp over one block.");
+        METASOUND_PARAM(InputBalance, "Balance", "Balance control ranging from -1.0 (full left) to 1.0 (full right). Changes ramp over one block.");
+        METASOUND_PARAM(InputInvertLeft, "Invert L", "Invert the polarity of the left channel.");
+        METASOUND_PARAM(InputInvertRight, "Invert R", "Invert the polarity of the right channel.");
+        METASOUND_PARAM(InputSwapChannels, "Swap L/R", "Swap the left and right channels.");
+        METASOUND_PARAM(InputGain, "Gain (Lin)", "Gain control (0.0 to 1.0). Changes ramp over one block.");
+
+        METASOUND_PARAM(OutputLeftSignal, "Out L", "Left output channel.");
+        METASOUND_PARAM(OutputRightSignal, "Out R", "Right output channel.");
+    }
+
+    // Stereo Width -> Stereo Balance -> Stereo Inverter -> Stereo Gain in a single pass, with the same output
+    class FStereoMatrixOperator : public TExecutableOperator<FStereoMatrixOperator>
+    {
+    public:
+        FStereoMatrixOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InLeftSignal,
+            const FAudioBufferReadRef& InRightSignal,
+            const FFloatReadRef& InWidth,
+            const FFloatReadRef& InBalance,
+            const FBoolReadRef& InInvertLeft,
+            const FBoolReadRef& InInvertRight,
+            const FBoolReadRef& InSwapChannels,
+            const FFloatReadRef& InGain,
+            bool bInMidSide)
+            : InputLeftSignal(InLeftSignal)
+            , InputRightSignal(InRightSignal)
+            , InputWidth(InWidth)
+            , InputBalance(InBalance)
+            , InputInvertLeft(InInvertLeft)
+            , InputInvertRight(InInvertRight)
+            , InputSwapChannels(InSwapChannels)
+            , InputGain(InGain)
+            , OutputLeftSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , OutputRightSignal(FAudioBufferWriteRef::CreateNew(InSettings))
+            , State(MetasoundBranches::Kernels::MakeStereoMatrixState(*InWidth, *InBalance, *InGain))
+            , bMidSide(bInMidSide)
+            , InstanceStats(TEXT("StereoMatrix"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace StereoMatrixNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal)),
+                    TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputWidth), 1.0f),
+                    TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputBalance), 0.0f),
+                    TInputDataVertexModel<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputInvertLeft), false),
+                    TInputDataVertexModel<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputInvertRight), false),
+                    TInputDataVertexModel<bool>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputSwapChannels), false),
+                    TInputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGain), 1.0f)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal)),
+                    TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+            {
+                FVertexInterface NodeInterface = DeclareVertexInterface();
+
+                FNodeClassMetadata Metadata;
+                Metadata.ClassName = { StandardNodes::Namespace, TEXT("Stereo Matrix"), StandardNodes::AudioVariant };
+                Metadata.MajorVersion = 1;
+                Metadata.MinorVersion = 0;
+                Metadata.DisplayName = METASOUND_LOCTEXT("StereoMatrixNodeDisplayName", "Stereo Matrix");
+                Metadata.Description = METASOUND_LOCTEXT("StereoMatrixNodeDesc", "Width, balance, polarity, swap and gain for a stereo signal in one node, matching Stereo Width, Stereo Balance, Stereo Inverter and Stereo Gain in series.");
+                Metadata.Author = "Charles Matthews";
+                Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                Metadata.DefaultInterface = NodeInterface;
+                Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                Metadata.Keywords = TArray<FText>();
+
+                return Metadata;
+            };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoMatrixNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputWidth), InputWidth);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputBalance), InputBalance);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertLeft), InputInvertLeft);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputInvertRight), InputInvertRight);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSwapChannels), InputSwapChannels);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGain), InputGain);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoMatrixNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftSignal), OutputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightSignal), OutputRightSignal);
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace StereoMatrixNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<float> Width = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputWidth), InParams.OperatorSettings);
+            TDataReadReference<float> Balance = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputBalance), InParams.OperatorSettings);
+            TDataReadReference<bool> InvertLeft = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputInvertLeft), InParams.OperatorSettings);
+            TDataReadReference<bool> InvertRight = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputInvertRight), InParams.OperatorSettings);
+            TDataReadReference<bool> SwapChannels = InputData.GetOrCreateDefaultDataReadReference<bool>(METASOUND_GET_PARAM_NAME(InputSwapChannels), InParams.OperatorSettings);
+            TDataReadReference<float> Gain = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputGain), InParams.OperatorSettings);
+
+            // Skip the mid/side stage where the Width node would pass its inputs through, so the output still matches
+            const bool bMidSide = !(MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputWidth)) && *Width == 1.0f);
+
+            return MakeUnique<FStereoMatrixOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, Width, Balance, InvertLeft, InvertRight, SwapChannels, Gain, bMidSide);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            // Start from the current settings rather than ramping into the first block
+            State = MetasoundBranches::Kernels::MakeStereoMatrixState(*InputWidth, *InputBalance, *InputGain);
+
+            OutputLeftSignal->Zero();
+            OutputRightSignal->Zero();
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoMatrix);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = InputLeftSignal->Num();
+
+            const float* LeftData = InputLeftSignal->GetData();
+            const float* RightData = InputRightSignal->GetData();
+            float* OutputLeftData = OutputLeftSignal->GetData();
+            float* OutputRightData = OutputRightSignal->GetData();
+
+            // Settings are folded into per-channel gain ramps once per block, then applied in one pass
+            ProcessStereoMatrix(
+                State,
+                LeftData, RightData,
+                bMidSide, *InputWidth, *InputBalance, *InputInvertLeft, *InputInvertRight, *InputSwapChannels, *InputGain,
+                OutputLeftData, OutputRightData, NumFrames);
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace StereoMatrixNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal), *InputLeftSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal), *InputRightSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputWidth), *InputWidth);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputBalance), *InputBalance);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputInvertLeft), *InputInvertLeft ? 1.0f : 0.0f);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputInvertRight), *InputInvertRight ? 1.0f : 0.0f);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSwapChannels), *InputSwapChannels ? 1.0f : 0.0f);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputGain), *InputGain);
+        }
+
+    private:
+        // Inputs
+        FAudioBufferReadRef InputLeftSignal;
+        FAudioBufferReadRef InputRightSignal;
+        FFloatReadRef InputWidth;
+        FFloatReadRef InputBalance;
+        FBoolReadRef InputInvertLeft;
+        FBoolReadRef InputInvertRight;
+        FBoolReadRef InputSwapChannels;
+        FFloatReadRef InputGain;
+
+        // Outputs
+        FAudioBufferWriteRef OutputLeftSignal;
+        FAudioBufferWriteRef OutputRightSignal;
+
+        // Settings applied at the end of the last block
+        MetasoundBranches::Kernels::FStereoMatrixState State;
+
+        // False when the width is fixed at one, decided at build time
+        bool bMidSide;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(FStereoMatrixOperator);
+
+    class FStereoMatrixNode : public FNodeFacade
+    {
+    public:
+        FStereoMatrixNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FStereoMatrixOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FStereoMatrixNode);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,208 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundStereoMeterNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "MetasoundBranches/Public/Kernels/StereoMeterKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoMeterNode"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoMeter, "Stereo Meter");
+
+namespace Metasound
+{
+    namespace StereoMeterNodeNames
+    {
+        METASOUND_PARAM(InputLeftSignal, "In L", "Left channel.");
+        METASOUND_PARAM(InputRightSignal, "In R", "Right channel.");
+        METASOUND_PARAM(InputIntegrationTime, "Integration Time", "Time constant of the readings in seconds. Zero measures each block on its own.");
+
+        METASOUND_PARAM(OutputCorrelation, "Correlation", "Phase correlation from -1.0 (out of phase) through 0.0 (uncorrelated) to 1.0 (mono). 0.0 while either channel is silent.");
+        METASOUND_PARAM(OutputBalance, "Balance", "Energy balance from -1.0 (left only) to 1.0 (right only).");
+        METASOUND_PARAM(OutputLeftPeak, "Peak L", "Peak magnitude of the left channel, falling over the integration time.");
+        METASOUND_PARAM(OutputRightPeak, "Peak R", "Peak magnitude of the right channel, falling over the integration time.");
+    }
+
+    // Companion to Stereo Width for automatic mono compatibility: one pass over the block accumulates the sums the
+    // readings need, and everything else happens once per block
+    class FStereoMeterOperator : public TExecutableOperator<FStereoMeterOperator>
+    {
+    public:
+        FStereoMeterOperator(
+            const FOperatorSettings& InSettings,
+            const FAudioBufferReadRef& InLeftSignal,
+            const FAudioBufferReadRef& InRightSignal,
+            const FTimeReadRef& InIntegrationTime)
+            : InputLeftSignal(InLeftSignal)
+            , InputRightSignal(InRightSignal)
+            , InputIntegrationTime(InIntegrationTime)
+            , OutputCorrelation(FFloatWriteRef::CreateNew(0.0f))
+            , OutputBalance(FFloatWriteRef::CreateNew(0.0f))
+            , OutputLeftPeak(FFloatWriteRef::CreateNew(0.0f))
+            , OutputRightPeak(FFloatWriteRef::CreateNew(0.0f))
+            , SampleRate(InSettings.GetSampleRate())
+            , InstanceStats(TEXT("StereoMeter"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace StereoMeterNodeNames;
+
+            static const FVertexInterface Interface(
+                FInputVertexInterface(
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal)),
+                    TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal)),
+                    TInputDataVertexModel<FTime>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputIntegrationTime), 0.3f)
+                ),
+                FOutputVertexInterface(
+                    TOutputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputCorrelation)),
+                    TOutputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputBalance)),
+                    TOutputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftPeak)),
+                    TOutputDataVertexModel<float>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightPeak))
+                )
+            );
+
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, TEXT("Stereo Meter"), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = METASOUND_LOCTEXT("StereoMeterNodeDisplayName", "Stereo Meter");
+                    Metadata.Description = METASOUND_LOCTEXT("StereoMeterNodeDesc", "Measures the phase correlation, balance and peaks of a stereo signal once per block.");
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>();
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoMeterNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputLeftSignal), InputLeftSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputRightSignal), InputRightSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputIntegrationTime), InputIntegrationTime);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoMeterNodeNames;
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputCorrelation), OutputCorrelation);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputBalance), OutputBalance);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputLeftPeak), OutputLeftPeak);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputRightPeak), OutputRightPeak);
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace StereoMeterNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TDataReadReference<FAudioBuffer> InputLeftSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputLeftSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputRightSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(METASOUND_GET_PARAM_NAME(InputRightSignal), InParams.OperatorSettings);
+            TDataReadReference<FTime> InputIntegrationTime = InputData.GetOrCreateDefaultDataReadReference<FTime>(METASOUND_GET_PARAM_NAME(InputIntegrationTime), InParams.OperatorSettings);
+
+            return MakeUnique<FStereoMeterOperator>(InParams.OperatorSettings, InputLeftSignal, InputRightSignal, InputIntegrationTime);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            State = MetasoundBranches::Kernels::FStereoMeterState();
+
+            *OutputCorrelation = 0.0f;
+            *OutputBalance = 0.0f;
+            *OutputLeftPeak = 0.0f;
+            *OutputRightPeak = 0.0f;
+        }
+
+        void Execute()
+        {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoMeter);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = InputLeftSignal->Num();
+            const float Decay = MakeMeterDecay(InputIntegrationTime->GetSeconds(), SampleRate, NumFrames);
+
+            ProcessStereoMeter(State, InputLeftSignal->GetData(), InputRightSignal->GetData(), Decay, NumFrames);
+
+            // A NaN or infinite input resets the integrators, so the readings restart from silence
+            GuardStereoMeterState(State);
+
+            const FStereoMeterReadings Readings = GetStereoMeterReadings(State);
+            *OutputCorrelation = Readings.Correlation;
+            *OutputBalance = Readings.Balance;
+            *OutputLeftPeak = Readings.LeftPeak;
+            *OutputRightPeak = Readings.RightPeak;
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace StereoMeterNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputLeftSignal), *InputLeftSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputRightSignal), *InputRightSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputIntegrationTime), InputIntegrationTime->GetSeconds());
+        }
+
+    private:
+
+        // Inputs
+        FAudioBufferReadRef InputLeftSignal;
+        FAudioBufferReadRef InputRightSignal;
+        FTimeReadRef InputIntegrationTime;
+
+        // Outputs
+        FFloatWriteRef OutputCorrelation;
+        FFloatWriteRef OutputBalance;
+        FFloatWriteRef OutputLeftPeak;
+        FFloatWriteRef OutputRightPeak;
+
+        // Leaky integrators, updated once per block
+        MetasoundBranches::Kernels::FStereoMeterState State;
+
+        float SampleRate;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(FStereoMeterOperator);
+
+    class FStereoMeterNode : public FNodeFacade
+    {
+    public:
+        FStereoMeterNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<FStereoMeterOperator>())
+        {
+        }
+    };
+
+    METASOUND_REGISTER_NODE(FStereoMeterNode);
+}
+
+#undef LOCTEXT_NAMESPACE
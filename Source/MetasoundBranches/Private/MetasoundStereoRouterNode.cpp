@@ -0,0 +1,474 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "MetasoundBranches/Public/MetasoundStereoRouterNode.h"
+#include "MetasoundExecutableOperator.h"     // TExecutableOperator class
+#include "MetasoundPrimitives.h"             // ReadRef and WriteRef descriptions for bool, int32, float, and string
+#include "MetasoundNodeRegistrationMacro.h"  // METASOUND_LOCTEXT and METASOUND_REGISTER_NODE macros
+#include "MetasoundStandardNodesNames.h"     // StandardNodes namespace
+#include "MetasoundFacade.h"                 // FNodeFacade class, eliminates the need for a fair amount of boilerplate code
+#include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
+#include "Misc/Optional.h"
+#include "MetasoundBranches/Public/Kernels/RouterKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesPassthrough.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
+
+#define LOCTEXT_NAMESPACE "MetasoundStandardNodes_StereoRouterNode"
+
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(StereoRouter, "Stereo Router");
+
+namespace Metasound
+{
+    namespace StereoRouterNodeNames
+    {
+        // The variants use the first NumInputs and NumOutputs pairs
+        METASOUND_PARAM(InputLeftSignal1, "In1 L", "Left channel of input 1.");
+        METASOUND_PARAM(InputRightSignal1, "In1 R", "Right channel of input 1.");
+        METASOUND_PARAM(InputLeftSignal2, "In2 L", "Left channel of input 2.");
+        METASOUND_PARAM(InputRightSignal2, "In2 R", "Right channel of input 2.");
+        METASOUND_PARAM(InputLeftSignal3, "In3 L", "Left channel of input 3.");
+        METASOUND_PARAM(InputRightSignal3, "In3 R", "Right channel of input 3.");
+        METASOUND_PARAM(InputLeftSignal4, "In4 L", "Left channel of input 4.");
+        METASOUND_PARAM(InputRightSignal4, "In4 R", "Right channel of input 4.");
+        METASOUND_PARAM(InputLeftSignal5, "In5 L", "Left channel of input 5.");
+        METASOUND_PARAM(InputRightSignal5, "In5 R", "Right channel of input 5.");
+        METASOUND_PARAM(InputLeftSignal6, "In6 L", "Left channel of input 6.");
+        METASOUND_PARAM(InputRightSignal6, "In6 R", "Right channel of input 6.");
+        METASOUND_PARAM(InputLeftSignal7, "In7 L", "Left channel of input 7.");
+        METASOUND_PARAM(InputRightSignal7, "In7 R", "Right channel of input 7.");
+        METASOUND_PARAM(InputLeftSignal8, "In8 L", "Left channel of input 8.");
+        METASOUND_PARAM(InputRightSignal8, "In8 R", "Right channel of input 8.");
+        METASOUND_PARAM(InputGains, "Gains", "Gain matrix, one row per output: entry (Output - 1) * Inputs + (Input - 1) is the gain from that input to that output. Missing entries are 0.0, and only nonzero entries cost anything. Changes ramp over one block.");
+
+        METASOUND_PARAM(OutputLeftSignal1, "Out1 L", "Left channel of output 1.");
+        METASOUND_PARAM(OutputRightSignal1, "Out1 R", "Right channel of output 1.");
+        METASOUND_PARAM(OutputLeftSignal2, "Out2 L", "Left channel of output 2.");
+        METASOUND_PARAM(OutputRightSignal2, "Out2 R", "Right channel of output 2.");
+        METASOUND_PARAM(OutputLeftSignal3, "Out3 L", "Left channel of output 3.");
+        METASOUND_PARAM(OutputRightSignal3, "Out3 R", "Right channel of output 3.");
+        METASOUND_PARAM(OutputLeftSignal4, "Out4 L", "Left channel of output 4.");
+        METASOUND_PARAM(OutputRightSignal4, "Out4 R", "Right channel of output 4.");
+        METASOUND_PARAM(OutputLeftSignal5, "Out5 L", "Left channel of output 5.");
+        METASOUND_PARAM(OutputRightSignal5, "Out5 R", "Right channel of output 5.");
+        METASOUND_PARAM(OutputLeftSignal6, "Out6 L", "Left channel of output 6.");
+        METASOUND_PARAM(OutputRightSignal6, "Out6 R", "Right channel of output 6.");
+        METASOUND_PARAM(OutputLeftSignal7, "Out7 L", "Left channel of output 7.");
+        METASOUND_PARAM(OutputRightSignal7, "Out7 R", "Right channel of output 7.");
+        METASOUND_PARAM(OutputLeftSignal8, "Out8 L", "Left channel of output 8.");
+        METASOUND_PARAM(OutputRightSignal8, "Out8 R", "Right channel of output 8.");
+
+        constexpr int32 MaxChannels = MetasoundBranches::Kernels::MaxRouterChannels;
+
+        const TCHAR* GetInputLeftName(int32 Index)
+        {
+            static const TCHAR* const Names[MaxChannels] =
+            {
+                METASOUND_GET_PARAM_NAME(InputLeftSignal1), METASOUND_GET_PARAM_NAME(InputLeftSignal2),
+                METASOUND_GET_PARAM_NAME(InputLeftSignal3), METASOUND_GET_PARAM_NAME(InputLeftSignal4),
+                METASOUND_GET_PARAM_NAME(InputLeftSignal5), METASOUND_GET_PARAM_NAME(InputLeftSignal6),
+                METASOUND_GET_PARAM_NAME(InputLeftSignal7), METASOUND_GET_PARAM_NAME(InputLeftSignal8)
+            };
+
+            return Names[Index];
+        }
+
+        const TCHAR* GetInputRightName(int32 Index)
+        {
+            static const TCHAR* const Names[MaxChannels] =
+            {
+                METASOUND_GET_PARAM_NAME(InputRightSignal1), METASOUND_GET_PARAM_NAME(InputRightSignal2),
+                METASOUND_GET_PARAM_NAME(InputRightSignal3), METASOUND_GET_PARAM_NAME(InputRightSignal4),
+                METASOUND_GET_PARAM_NAME(InputRightSignal5), METASOUND_GET_PARAM_NAME(InputRightSignal6),
+                METASOUND_GET_PARAM_NAME(InputRightSignal7), METASOUND_GET_PARAM_NAME(InputRightSignal8)
+            };
+
+            return Names[Index];
+        }
+
+        const TCHAR* GetOutputLeftName(int32 Index)
+        {
+            static const TCHAR* const Names[MaxChannels] =
+            {
+                METASOUND_GET_PARAM_NAME(OutputLeftSignal1), METASOUND_GET_PARAM_NAME(OutputLeftSignal2),
+                METASOUND_GET_PARAM_NAME(OutputLeftSignal3), METASOUND_GET_PARAM_NAME(OutputLeftSignal4),
+                METASOUND_GET_PARAM_NAME(OutputLeftSignal5), METASOUND_GET_PARAM_NAME(OutputLeftSignal6),
+                METASOUND_GET_PARAM_NAME(OutputLeftSignal7), METASOUND_GET_PARAM_NAME(OutputLeftSignal8)
+            };
+
+            return Names[Index];
+        }
+
+        const TCHAR* GetOutputRightName(int32 Index)
+        {
+            static const TCHAR* const Names[MaxChannels] =
+            {
+                METASOUND_GET_PARAM_NAME(OutputRightSignal1), METASOUND_GET_PARAM_NAME(OutputRightSignal2),
+                METASOUND_GET_PARAM_NAME(OutputRightSignal3), METASOUND_GET_PARAM_NAME(OutputRightSignal4),
+                METASOUND_GET_PARAM_NAME(OutputRightSignal5), METASOUND_GET_PARAM_NAME(OutputRightSignal6),
+                METASOUND_GET_PARAM_NAME(OutputRightSignal7), METASOUND_GET_PARAM_NAME(OutputRightSignal8)
+            };
+
+            return Names[Index];
+        }
+
+        // Audio input vertices of the first NumInputs inputs, left then right for each, then the gain matrix
+        FInputVertexInterface MakeInputInterface(int32 NumInputs)
+        {
+            const TInputDataVertexModel<FAudioBuffer> Vertices[MaxChannels * 2] =
+            {
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal1)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal1)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal2)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal2)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal3)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal3)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal4)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal4)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal5)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal5)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal6)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal6)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal7)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal7)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputLeftSignal8)),
+                TInputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputRightSignal8))
+            };
+
+            FInputVertexInterface Interface;
+            for (int32 Index = 0; Index < NumInputs * 2; ++Index)
+            {
+                Interface.Add(Vertices[Index]);
+            }
+
+            Interface.Add(TInputDataVertexModel<TArray<float>>(METASOUND_GET_PARAM_NAME_AND_METADATA(InputGains)));
+            return Interface;
+        }
+
+        // Audio output vertices of the first NumOutputs outputs, left then right for each
+        FOutputVertexInterface MakeOutputInterface(int32 NumOutputs)
+        {
+            const TOutputDataVertexModel<FAudioBuffer> Vertices[MaxChannels * 2] =
+            {
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal1)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal1)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal2)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal2)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal3)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal3)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal4)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal4)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal5)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal5)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal6)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal6)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal7)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal7)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputLeftSignal8)),
+                TOutputDataVertexModel<FAudioBuffer>(METASOUND_GET_PARAM_NAME_AND_METADATA(OutputRightSignal8))
+            };
+
+            FOutputVertexInterface Interface;
+            for (int32 Index = 0; Index < NumOutputs * 2; ++Index)
+            {
+                Interface.Add(Vertices[Index]);
+            }
+
+            return Interface;
+        }
+    }
+
+    // Routes NumInputs stereo inputs to NumOutputs stereo outputs through a gain matrix. Only the nonzero entries are
+    // processed, so a sparse matrix costs what its routes cost rather than a full network of Stereo Gain and mixer
+    // nodes.
+    template<int32 NumInputs, int32 NumOutputs>
+    class TStereoRouterOperator : public TExecutableOperator<TStereoRouterOperator<NumInputs, NumOutputs>>
+    {
+        static_assert(NumInputs >= 1 && NumInputs <= StereoRouterNodeNames::MaxChannels, "Unsupported number of inputs");
+        static_assert(NumOutputs >= 1 && NumOutputs <= StereoRouterNodeNames::MaxChannels, "Unsupported number of outputs");
+
+    public:
+        TStereoRouterOperator(
+            const FOperatorSettings& InSettings,
+            TArray<FAudioBufferReadRef>&& InLeftSignals,
+            TArray<FAudioBufferReadRef>&& InRightSignals,
+            const FFloatArrayReadRef& InGains,
+            bool bInPassthrough)
+            : InputLeftSignals(MoveTemp(InLeftSignals))
+            , InputRightSignals(MoveTemp(InRightSignals))
+            , InputGains(InGains)
+            , bPassthrough(bInPassthrough)
+            , InstanceStats(TEXT("StereoRouter"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
+        {
+            // In passthrough the routed outputs are bound to their inputs, and the others all share one silent buffer
+            for (int32 Index = 0; Index < NumOutputs; ++Index)
+            {
+                if (!bPassthrough)
+                {
+                    OutputLeftSignals.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+                    OutputRightSignals.Add(FAudioBufferWriteRef::CreateNew(InSettings));
+                }
+                else if (!SilentSignal.IsSet() && GetPassthroughInput(*InputGains, Index) == INDEX_NONE)
+                {
+                    SilentSignal.Emplace(FAudioBufferWriteRef::CreateNew(InSettings));
+                }
+            }
+
+            // Start at the current matrix rather than ramping into the first block
+            MetasoundBranches::Kernels::ResetStereoRouter(RouterState, InputGains->GetData(), InputGains->Num(), NumInputs, NumOutputs);
+        }
+
+        static const FVertexInterface& DeclareVertexInterface()
+        {
+            using namespace StereoRouterNodeNames;
+
+            static const FVertexInterface Interface(MakeInputInterface(NumInputs), MakeOutputInterface(NumOutputs));
+            return Interface;
+        }
+
+        static const FNodeClassMetadata& GetNodeInfo()
+        {
+            auto CreateNodeClassMetadata = []() -> FNodeClassMetadata
+                {
+                    const FString NodeName = FString::Printf(TEXT("Stereo Router (%dx%d)"), NumInputs, NumOutputs);
+
+                    FNodeClassMetadata Metadata;
+
+                    Metadata.ClassName = { StandardNodes::Namespace, FName(*NodeName), StandardNodes::AudioVariant };
+                    Metadata.MajorVersion = 1;
+                    Metadata.MinorVersion = 0;
+                    Metadata.DisplayName = FText::Format(METASOUND_LOCTEXT("StereoRouterNodeDisplayName", "Stereo Router ({0}x{1})"), NumInputs, NumOutputs);
+                    Metadata.Description = FText::Format(METASOUND_LOCTEXT("StereoRouterNodeDesc", "Routes {0} stereo signals to {1} stereo outputs through a gain matrix, processing only the nonzero routes."), NumInputs, NumOutputs);
+                    Metadata.Author = "Charles Matthews";
+                    Metadata.PromptIfMissing = PluginNodeMissingPrompt;
+                    Metadata.DefaultInterface = DeclareVertexInterface();
+                    Metadata.CategoryHierarchy = { METASOUND_LOCTEXT("Custom", "Branches") };
+                    Metadata.Keywords = TArray<FText>(); // Keywords for searching
+
+                    return Metadata;
+                };
+
+            static const FNodeClassMetadata Metadata = CreateNodeClassMetadata();
+            return Metadata;
+        }
+
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoRouterNodeNames;
+
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                InOutVertexData.BindReadVertex(GetInputLeftName(Index), InputLeftSignals[Index]);
+                InOutVertexData.BindReadVertex(GetInputRightName(Index), InputRightSignals[Index]);
+            }
+
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputGains), InputGains);
+        }
+
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
+        {
+            using namespace StereoRouterNodeNames;
+
+            for (int32 Index = 0; Index < NumOutputs; ++Index)
+            {
+                // In passthrough an output with a route is bound to its input, and one without to the silent buffer
+                const int32 Input = bPassthrough ? GetPassthroughInput(*InputGains, Index) : INDEX_NONE;
+                if (Input != INDEX_NONE)
+                {
+                    InOutVertexData.BindReadVertex(GetOutputLeftName(Index), InputLeftSignals[Input]);
+                    InOutVertexData.BindReadVertex(GetOutputRightName(Index), InputRightSignals[Input]);
+                }
+                else if (bPassthrough)
+                {
+                    InOutVertexData.BindReadVertex(GetOutputLeftName(Index), *SilentSignal);
+                    InOutVertexData.BindReadVertex(GetOutputRightName(Index), *SilentSignal);
+                }
+                else
+                {
+                    InOutVertexData.BindReadVertex(GetOutputLeftName(Index), OutputLeftSignals[Index]);
+                    InOutVertexData.BindReadVertex(GetOutputRightName(Index), OutputRightSignals[Index]);
+                }
+            }
+        }
+
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
+        {
+            using namespace StereoRouterNodeNames;
+
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
+
+            TArray<FAudioBufferReadRef> InputLeftSignals;
+            TArray<FAudioBufferReadRef> InputRightSignals;
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                InputLeftSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(GetInputLeftName(Index), InParams.OperatorSettings));
+                InputRightSignals.Add(InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(GetInputRightName(Index), InParams.OperatorSettings));
+            }
+
+            TDataReadReference<TArray<float>> InputGains = InputData.GetOrCreateDefaultDataReadReference<TArray<float>>(METASOUND_GET_PARAM_NAME(InputGains), InParams.OperatorSettings);
+
+            // A matrix that can't change, where every output takes one input at unity or nothing at all, is just wiring
+            bool bPassthrough = false;
+            if (MetasoundBranches::IsConstantInput(InputData, METASOUND_GET_PARAM_NAME(InputGains)))
+            {
+                bPassthrough = true;
+                for (int32 Index = 0; Index < NumOutputs && bPassthrough; ++Index)
+                {
+                    bPassthrough = GetPassthroughInput(*InputGains, Index) != INDEX_NONE || CountRoutes(*InputGains, Index) == 0;
+                }
+            }
+
+            return MakeUnique<TStereoRouterOperator<NumInputs, NumOutputs>>(InParams.OperatorSettings, MoveTemp(InputLeftSignals), MoveTemp(InputRightSignals), InputGains, bPassthrough);
+        }
+
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            MetasoundBranches::Kernels::ResetStereoRouter(RouterState, InputGains->GetData(), InputGains->Num(), NumInputs, NumOutputs);
+
+            // None in passthrough: the routed outputs are inputs, which aren't ours to clear, and the silent buffer is
+            // never written
+            for (int32 Index = 0; Index < OutputLeftSignals.Num(); ++Index)
+            {
+                OutputLeftSignals[Index]->Zero();
+                OutputRightSignals[Index]->Zero();
+            }
+        }
+
+        void Execute()
+        {
+            // The outputs are bound to the inputs or stay silent, see BindOutputs()
+            if (bPassthrough)
+            {
+                return;
+            }
+
+            METASOUND_BRANCHES_EXECUTE_SCOPE(StereoRouter);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
+            const int32 NumFrames = OutputLeftSignals[0]->Num();
+
+            const float* LeftData[NumInputs];
+            const float* RightData[NumInputs];
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                LeftData[Index] = InputLeftSignals[Index]->GetData();
+                RightData[Index] = InputRightSignals[Index]->GetData();
+            }
+
+            float* OutputLeftData[NumOutputs];
+            float* OutputRightData[NumOutputs];
+            for (int32 Index = 0; Index < NumOutputs; ++Index)
+            {
+                OutputLeftData[Index] = OutputLeftSignals[Index]->GetData();
+                OutputRightData[Index] = OutputRightSignals[Index]->GetData();
+            }
+
+            // The route lists are only rebuilt when the matrix changes or a ramp finishes
+            const TArray<float>& Gains = *InputGains;
+            UpdateStereoRoutes(RouterState, Gains.GetData(), Gains.Num(), NumInputs, NumOutputs, NumFrames);
+            ProcessStereoRouter(RouterState, LeftData, RightData, OutputLeftData, OutputRightData, NumOutputs, NumFrames);
+        }
+
+        // Gain from Input to Output, zero where the matrix is short
+        static float GetGain(const TArray<float>& Gains, int32 Input, int32 Output)
+        {
+            const int32 Index = MetasoundBranches::Kernels::GetRouterGainIndex(Input, Output, NumInputs);
+            return Gains.IsValidIndex(Index) ? Gains[Index] : 0.0f;
+        }
+
+        static int32 CountRoutes(const TArray<float>& Gains, int32 Output)
+        {
+            int32 NumRoutes = 0;
+            for (int32 Input = 0; Input < NumInputs; ++Input)
+            {
+                NumRoutes += GetGain(Gains, Input, Output) != 0.0f ? 1 : 0;
+            }
+
+            return NumRoutes;
+        }
+
+        // The one input Output takes at unity, or INDEX_NONE if it takes anything else
+        static int32 GetPassthroughInput(const TArray<float>& Gains, int32 Output)
+        {
+            if (CountRoutes(Gains, Output) != 1)
+            {
+                return INDEX_NONE;
+            }
+
+            for (int32 Input = 0; Input < NumInputs; ++Input)
+            {
+                if (GetGain(Gains, Input, Output) == 1.0f)
+                {
+                    return Input;
+                }
+            }
+
+            return INDEX_NONE;
+        }
+
+        // The route count goes first, as the inputs of the larger variants don't all fit in the snapshot and the last
+        // ones are only counted
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace StereoRouterNodeNames;
+
+            int32 NumRoutes = 0;
+            for (int32 Index = 0; Index < NumOutputs; ++Index)
+            {
+                NumRoutes += RouterState.NumRoutes[Index];
+            }
+
+            OutInputs.Add(TEXT("Active Routes"), static_cast<float>(NumRoutes));
+
+            for (int32 Index = 0; Index < NumInputs; ++Index)
+            {
+                OutInputs.Add(GetInputLeftName(Index), *InputLeftSignals[Index]);
+                OutInputs.Add(GetInputRightName(Index), *InputRightSignals[Index]);
+            }
+        }
+
+    private:
+
+        // Inputs
+        TArray<FAudioBufferReadRef> InputLeftSignals;
+        TArray<FAudioBufferReadRef> InputRightSignals;
+        FFloatArrayReadRef InputGains;
+
+        // Outputs, empty in passthrough
+        TArray<FAudioBufferWriteRef> OutputLeftSignals;
+        TArray<FAudioBufferWriteRef> OutputRightSignals;
+
+        // Bound to the unrouted outputs in passthrough, if there are any
+        TOptional<FAudioBufferWriteRef> SilentSignal;
+
+        // Routes and gains carried between blocks
+        MetasoundBranches::Kernels::FStereoRouterState RouterState;
+
+        // The outputs are bound to the inputs at build time, see CreateOperator()
+        bool bPassthrough;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
+    };
+
+    METASOUND_BRANCHES_CHECK_RESET(TStereoRouterOperator<4, 4>);
+
+    template<int32 NumInputs, int32 NumOutputs>
+    class TStereoRouterNode : public FNodeFacade
+    {
+    public:
+        TStereoRouterNode(const FNodeInitData& InitData)
+            : FNodeFacade(InitData.InstanceName, InitData.InstanceID, TFacadeOperatorClass<TStereoRouterOperator<NumInputs, NumOutputs>>())
+        {
+        }
+    };
+
+    using FStereoRouter4x4Node = TStereoRouterNode<4, 4>;
+    using FStereoRouter8x8Node = TStereoRouterNode<8, 8>;
+
+    METASOUND_REGISTER_NODE(FStereoRouter4x4Node);
+    METASOUND_REGISTER_NODE(FStereoRouter8x8Node);
+}
+
+#undef LOCTEXT_NAMESPACE
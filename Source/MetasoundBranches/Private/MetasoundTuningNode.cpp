@@ -7,9 +7,15 @@
 #include "MetasoundStandardNodesNames.h"
 #include "MetasoundFacade.h"
 #include "MetasoundParamHelper.h"
+#include "MetasoundBranches/Public/Kernels/TuningKernels.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_TuningNode"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Tuning, "Tuning");
+
 namespace Metasound
 {
     namespace TuningNodeNames
@@ -62,6 +68,7 @@ namespace Metasound
             , TuningCents10(InTuningCents10)
             , TuningCents11(InTuningCents11)
             , OutputFrequency(FFloatWriteRef::CreateNew(0.0f))
+            , InstanceStats(TEXT("Tuning"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -119,61 +126,52 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace TuningNodeNames;
 
-            FDataReferenceCollection InputDataReferences;
-
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), MIDINoteNumber);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents0), TuningCents0);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents1), TuningCents1);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents2), TuningCents2);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents3), TuningCents3);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents4), TuningCents4);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents5), TuningCents5);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents6), TuningCents6);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents7), TuningCents7);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents8), TuningCents8);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents9), TuningCents9);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents10), TuningCents10);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputTuningCents11), TuningCents11);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), MIDINoteNumber);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents0), TuningCents0);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents1), TuningCents1);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents2), TuningCents2);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents3), TuningCents3);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents4), TuningCents4);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents5), TuningCents5);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents6), TuningCents6);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents7), TuningCents7);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents8), TuningCents8);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents9), TuningCents9);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents10), TuningCents10);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputTuningCents11), TuningCents11);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace TuningNodeNames;
 
-            FDataReferenceCollection OutputDataReferences;
-
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputFrequency), OutputFrequency);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace TuningNodeNames;
 
-            const FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<int32> MIDINoteNumber = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<int32>(InputInterface, METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), InParams.OperatorSettings);
+            TDataReadReference<int32> MIDINoteNumber = InputData.GetOrCreateDefaultDataReadReference<int32>(METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), InParams.OperatorSettings);
 
-            TDataReadReference<float> TuningCents0 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents0), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents1 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents1), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents2 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents2), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents3 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents3), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents4 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents4), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents5 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents5), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents6 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents6), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents7 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents7), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents8 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents8), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents9 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents9), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents10 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents10), InParams.OperatorSettings);
-            TDataReadReference<float> TuningCents11 = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<float>(InputInterface, METASOUND_GET_PARAM_NAME(InputTuningCents11), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents0 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents0), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents1 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents1), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents2 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents2), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents3 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents3), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents4 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents4), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents5 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents5), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents6 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents6), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents7 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents7), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents8 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents8), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents9 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents9), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents10 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents10), InParams.OperatorSettings);
+            TDataReadReference<float> TuningCents11 = InputData.GetOrCreateDefaultDataReadReference<float>(METASOUND_GET_PARAM_NAME(InputTuningCents11), InParams.OperatorSettings);
 
             return MakeUnique<FTuningNodeOperator>(
                 InParams.OperatorSettings,
@@ -193,12 +191,17 @@ namespace Metasound
             );
         }
 
+        void Reset(const IOperator::FResetParams& InParams)
+        {
+            *OutputFrequency = 0.0f;
+        }
+
         void Execute()
         {
-            int32 midiNote = *MIDINoteNumber;
-            int32 noteInOctave = midiNote % 12;
+            METASOUND_BRANCHES_EXECUTE_SCOPE(Tuning);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
 
-            float tuningCentsArray[12] = {
+            float tuningCentsArray[MetasoundBranches::Kernels::NotesPerOctave] = {
                 *TuningCents0,
                 *TuningCents1,
                 *TuningCents2,
@@ -213,11 +216,26 @@ namespace Metasound
                 *TuningCents11
             };
 
-            float tuningAdjustmentCents = tuningCentsArray[noteInOctave];
-            float tuningAdjustmentSemitones = tuningAdjustmentCents / 100.0f;
-            float adjustedNote = midiNote + tuningAdjustmentSemitones;
-            float frequency = 440.0f * powf(2.0f, (adjustedNote - 69.0f) / 12.0f);
-            *OutputFrequency = frequency;
+            *OutputFrequency = MetasoundBranches::Kernels::TunedFrequency(*MIDINoteNumber, tuningCentsArray);
+        }
+
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace TuningNodeNames;
+
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputMIDINoteNumber), static_cast<float>(*MIDINoteNumber));
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents0), *TuningCents0);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents1), *TuningCents1);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents2), *TuningCents2);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents3), *TuningCents3);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents4), *TuningCents4);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents5), *TuningCents5);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents6), *TuningCents6);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents7), *TuningCents7);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents8), *TuningCents8);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents9), *TuningCents9);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents10), *TuningCents10);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputTuningCents11), *TuningCents11);
         }
 
     private:
@@ -235,8 +253,12 @@ namespace Metasound
         FFloatReadRef TuningCents10;
         FFloatReadRef TuningCents11;
         FFloatWriteRef OutputFrequency;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FTuningNodeOperator);
+
     class FTuningNode : public FNodeFacade
     {
     public:
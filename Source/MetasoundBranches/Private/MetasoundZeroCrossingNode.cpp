@@ -8,9 +8,15 @@
 #include "MetasoundFacade.h"                 // FNodeFacade class
 #include "MetasoundParamHelper.h"            // METASOUND_PARAM and METASOUND_GET_PARAM family of macros
 #include "MetasoundTrigger.h"                // For FTriggerWriteRef and FTrigger
+#include "MetasoundBranches/Public/Kernels/EdgeKernel.h"
+#include "MetasoundBranches/Public/MetasoundBranchesInstanceStats.h"
+#include "MetasoundBranches/Public/MetasoundBranchesOperator.h"
+#include "MetasoundBranches/Public/MetasoundBranchesStats.h"
 
 #define LOCTEXT_NAMESPACE "MetasoundStandardNodes_ZeroCrossing"
 
+METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(ZeroCrossing, "Zero Crossing");
+
 namespace Metasound
 {
     namespace ZeroCrossingNames
@@ -32,10 +38,9 @@ namespace Metasound
             : InputSignal(InSignal)
             , InputDebounce(InDebounce)
             , OutputTriggerZeroCrossing(FTriggerWriteRef::CreateNew(InSettings))
-            , PreviousSignalValue(0.0f)
             , DebounceSamples(0)
-            , DebounceCounter(0)
             , SampleRate(InSampleRate)
+            , InstanceStats(TEXT("ZeroCrossing"), InSettings, [this](MetasoundBranches::FInstanceInputSnapshot& OutInputs) { CaptureInputs(OutInputs); })
         {
         }
 
@@ -82,66 +87,60 @@ namespace Metasound
             return Metadata;
         }
 
-        virtual FDataReferenceCollection GetInputs() const override
+        virtual void BindInputs(FInputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ZeroCrossingNames;
 
-            FDataReferenceCollection InputDataReferences;
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
-            InputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
-
-            return InputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputSignal), InputSignal);
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce);
         }
 
-        virtual FDataReferenceCollection GetOutputs() const override
+        virtual void BindOutputs(FOutputVertexInterfaceData& InOutVertexData) override
         {
             using namespace ZeroCrossingNames;
 
-            FDataReferenceCollection OutputDataReferences;
-            OutputDataReferences.AddDataReadReference(METASOUND_GET_PARAM_NAME(OutputTriggerZeroCrossing), OutputTriggerZeroCrossing);
-
-            return OutputDataReferences;
+            InOutVertexData.BindReadVertex(METASOUND_GET_PARAM_NAME(OutputTriggerZeroCrossing), OutputTriggerZeroCrossing);
         }
 
-        static TUniquePtr<IOperator> CreateOperator(const FCreateOperatorParams& InParams, FBuildErrorArray& OutErrors)
+        static TUniquePtr<IOperator> CreateOperator(const FBuildOperatorParams& InParams, FBuildResults& OutResults)
         {
             using namespace ZeroCrossingNames;
 
-            const Metasound::FDataReferenceCollection& InputCollection = InParams.InputDataReferences;
-            const Metasound::FInputVertexInterface& InputInterface = DeclareVertexInterface().GetInputInterface();
+            const FInputVertexInterfaceData& InputData = InParams.InputData;
 
-            TDataReadReference<FAudioBuffer> InputSignal = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FAudioBuffer>(
-                InputInterface, METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
+            TDataReadReference<FAudioBuffer> InputSignal = InputData.GetOrCreateDefaultDataReadReference<FAudioBuffer>(
+                METASOUND_GET_PARAM_NAME(InputSignal), InParams.OperatorSettings);
 
-            TDataReadReference<FTime> InputDebounce = InputCollection.GetDataReadReferenceOrConstructWithVertexDefault<FTime>(
-                InputInterface, METASOUND_GET_PARAM_NAME(InputDebounce), InParams.OperatorSettings);
+            TDataReadReference<FTime> InputDebounce = InputData.GetOrCreateDefaultDataReadReference<FTime>(
+                METASOUND_GET_PARAM_NAME(InputDebounce), InParams.OperatorSettings);
 
             float SampleRate = InParams.OperatorSettings.GetSampleRate();
 
             return MakeUnique<FZeroCrossingOperator>(InputSignal, InputDebounce, SampleRate, InParams.OperatorSettings);
         }
 
-        virtual void Reset(const IOperator::FResetParams& InParams)
+        void Reset(const IOperator::FResetParams& InParams)
         {
             // Reset trigger
             OutputTriggerZeroCrossing->Reset();
 
+            // Clear debounce counter
+            State = MetasoundBranches::Kernels::FZeroCrossingState();
+
             // Initialize PreviousSignalValue
             if (InputSignal->Num() > 0)
             {
-                PreviousSignalValue = InputSignal->GetData()[0];
-            }
-            else
-            {
-                PreviousSignalValue = 0.0f;
+                State.PreviousSignalValue = InputSignal->GetData()[0];
             }
-
-            // Reset debounce counter
-            DebounceCounter = 0;
         }
 
         void Execute()
         {
+            METASOUND_BRANCHES_EXECUTE_SCOPE(ZeroCrossing);
+            METASOUND_BRANCHES_INSTANCE_SCOPE(InstanceStats);
+
+            using namespace MetasoundBranches::Kernels;
+
             OutputTriggerZeroCrossing->AdvanceBlock();
 
             const float* SignalData = InputSignal->GetData();
@@ -151,40 +150,25 @@ namespace Metasound
             // Recalculate debounce samples if debounce time or sample rate has changed
             if (LastDebounceTime != DebounceTime || LastSampleRate != SampleRate)
             {
-                DebounceSamples = FMath::RoundToInt(FMath::Clamp(DebounceTime, 0.001f, 5.0f) * SampleRate);
+                DebounceSamples = DebounceSamplesFromSeconds(DebounceTime, SampleRate);
                 LastDebounceTime = DebounceTime;
                 LastSampleRate = SampleRate;
             }
 
-            for (int32 i = 0; i < NumFrames; ++i)
-            {
-                float CurrentSignal = SignalData[i];
-
-                if (DebounceCounter > 0)
+            ProcessZeroCrossing(State, SignalData, NumFrames, DebounceSamples,
+                [this](int32 Frame)
                 {
-                    DebounceCounter--;
+                    OutputTriggerZeroCrossing->TriggerFrame(Frame);
                 }
+            );
+        }
 
-                bool PreviousNonPositive = (PreviousSignalValue <= 0.0f);
-                bool CurrentPositive = (CurrentSignal > 0.0f);
-                bool PreviousNonNegative = (PreviousSignalValue >= 0.0f);
-                bool CurrentNegative = (CurrentSignal < 0.0f);
-
-                // Crossing from negative or zero to positive
-                if (PreviousNonPositive && CurrentPositive && DebounceCounter <= 0)
-                {
-                    OutputTriggerZeroCrossing->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                }
-                // Crossing from positive or zero to negative
-                else if (PreviousNonNegative && CurrentNegative && DebounceCounter <= 0)
-                {
-                    OutputTriggerZeroCrossing->TriggerFrame(i);
-                    DebounceCounter = DebounceSamples;
-                }
+        void CaptureInputs(MetasoundBranches::FInstanceInputSnapshot& OutInputs) const
+        {
+            using namespace ZeroCrossingNames;
 
-                PreviousSignalValue = CurrentSignal;
-            }
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputSignal), *InputSignal);
+            OutInputs.Add(METASOUND_GET_PARAM_NAME(InputDebounce), InputDebounce->GetSeconds());
         }
 
     private:
@@ -196,16 +180,19 @@ namespace Metasound
         FTriggerWriteRef OutputTriggerZeroCrossing;
 
         // Internal variables
-        float PreviousSignalValue;
+        MetasoundBranches::Kernels::FZeroCrossingState State;
         int32 DebounceSamples;
-        int32 DebounceCounter;
         float SampleRate;
 
         // Variables to track changes in debounce time and sample rate
         float LastDebounceTime = -1.0f;
         float LastSampleRate = -1.0f;
+
+        MetasoundBranches::FInstanceStatsHandle InstanceStats;
     };
 
+    METASOUND_BRANCHES_CHECK_RESET(FZeroCrossingOperator);
+
     class FZeroCrossingNode : public FNodeFacade
     {
     public:
@@ -0,0 +1,493 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/BlockAnalysis.h"
+#include "MetasoundBranches/Public/Kernels/ConvolutionKernel.h"
+#include "MetasoundBranches/Public/Kernels/DispersionKernel.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/StateGuard.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace MetasoundBranches::Kernels
+{
+    constexpr int32_t MaxAllPassStages = 128;
+
+    // Feedback of every stage unless set otherwise
+    constexpr float DefaultAllPassFeedback = 0.5f;
+
+    // The Phase Disperser's allpass stages, stored field by field so the vector kernels load a run of stages at
+    // once. Each stage has a two-sample delay line: Recent and Older are what it wrote one and two frames ago.
+    struct FAllPassCascadeState
+    {
+        float Recent[MaxAllPassStages];
+        float Older[MaxAllPassStages];
+        float Feedback[MaxAllPassStages];
+
+        FAllPassCascadeState()
+        {
+            Init();
+        }
+
+        void Init(float InFeedback = DefaultAllPassFeedback)
+        {
+            for (int32_t Stage = 0; Stage < MaxAllPassStages; ++Stage)
+            {
+                Recent[Stage] = 0.0f;
+                Older[Stage] = 0.0f;
+                Feedback[Stage] = InFeedback;
+            }
+        }
+    };
+
+    // True if every delay line of the first NumStages stages is zero, so silence in gives silence out
+    inline bool IsAllPassCascadeSettled(const FAllPassCascadeState& State, int32_t NumStages)
+    {
+        for (int32_t Stage = 0; Stage < NumStages; ++Stage)
+        {
+            if (State.Recent[Stage] != 0.0f || State.Older[Stage] != 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Runs the first NumStages stages over the buffer in place; allpass difference equation per stage:
+    // y[n] = -a * x[n] + x[n-2] + a * y[n-2]. A silent block through a settled cascade is just zeroed.
+    inline void ProcessAllPassCascade(FAllPassCascadeState& State, int32_t NumStages, float* InOutBuffer, int32_t NumFrames)
+    {
+        if (IsSilentBlock(InOutBuffer, NumFrames) && IsAllPassCascadeSettled(State, NumStages))
+        {
+            std::memset(InOutBuffer, 0, sizeof(float) * NumFrames);
+            return;
+        }
+
+        GetKernelTable().ProcessAllPassStages(State.Recent, State.Older, State.Feedback, NumStages, InOutBuffer, NumFrames);
+    }
+
+    // Block-boundary guard for the first NumStages stages (see StateGuard.h): flushes subnormal delay lines to
+    // zero, and clears every one of them and returns false if any holds NaN or infinity
+    inline bool GuardAllPassCascadeState(FAllPassCascadeState& State, int32_t NumStages)
+    {
+        bool bFinite = SanitizeState(State.Recent, NumStages);
+        bFinite &= SanitizeState(State.Older, NumStages);
+
+        if (bFinite)
+        {
+            return true;
+        }
+
+        std::memset(State.Recent, 0, sizeof(float) * NumStages);
+        std::memset(State.Older, 0, sizeof(float) * NumStages);
+
+        RecordNonFiniteReset();
+        return false;
+    }
+
+    // Feedback offset of the outermost channels at full spread; the channels in between are spaced evenly
+    constexpr float MaxAllPassFeedbackSpread = 0.4f;
+
+    // Feedback of Channel's stages at the given spread (0-1): DefaultAllPassFeedback offset from -Spread to +Spread
+    // across the channels, scaled by MaxAllPassFeedbackSpread
+    inline float GetAllPassChannelFeedback(int32_t Channel, int32_t NumChannels, float Spread)
+    {
+        if (NumChannels < 2)
+        {
+            return DefaultAllPassFeedback;
+        }
+
+        const float Position = static_cast<float>(2 * Channel - (NumChannels - 1)) / static_cast<float>(NumChannels - 1);
+        return DefaultAllPassFeedback + Clamp(Spread, 0.0f, 1.0f) * MaxAllPassFeedbackSpread * Position;
+    }
+
+    // The stages of FAllPassCascadeState for up to MaxAllPassChannels channels. A stage keeps its channels side by
+    // side, channel c of stage s at [s * NumChannels + c], so the vector kernels carry every channel through a stage
+    // at once, and the first NumStages stages are one contiguous run of each field.
+    struct FAllPassChannelCascadeState
+    {
+        float Recent[MaxAllPassStages * MaxAllPassChannels];
+        float Older[MaxAllPassStages * MaxAllPassChannels];
+        float Feedback[MaxAllPassStages * MaxAllPassChannels];
+
+        int32_t NumChannels = 1;
+
+        // Spread the feedback was set for, clamped to 0-1
+        float Spread = 0.0f;
+
+        FAllPassChannelCascadeState()
+        {
+            Init(1);
+        }
+
+        void Init(int32_t InNumChannels, float InSpread = 0.0f)
+        {
+            NumChannels = Clamp(InNumChannels, 1, MaxAllPassChannels);
+            std::fill(std::begin(Recent), std::end(Recent), 0.0f);
+            std::fill(std::begin(Older), std::end(Older), 0.0f);
+            SetSpread(InSpread);
+        }
+
+        void SetSpread(float InSpread)
+        {
+            Spread = Clamp(InSpread, 0.0f, 1.0f);
+
+            for (int32_t Stage = 0; Stage < MaxAllPassStages; ++Stage)
+            {
+                for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    Feedback[Stage * NumChannels + Channel] = GetAllPassChannelFeedback(Channel, NumChannels, Spread);
+                }
+            }
+        }
+    };
+
+    // Sets the spread of the channels' feedback, stepping to it at the next block; does nothing if it hasn't changed
+    inline void SetAllPassChannelSpread(FAllPassChannelCascadeState& State, float Spread)
+    {
+        if (Clamp(Spread, 0.0f, 1.0f) != State.Spread)
+        {
+            State.SetSpread(Spread);
+        }
+    }
+
+    // True if every channel's delay lines in the first NumStages stages are zero
+    inline bool IsAllPassChannelCascadeSettled(const FAllPassChannelCascadeState& State, int32_t NumStages)
+    {
+        const int32_t NumValues = NumStages * State.NumChannels;
+        for (int32_t Index = 0; Index < NumValues; ++Index)
+        {
+            if (State.Recent[Index] != 0.0f || State.Older[Index] != 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Runs the first NumStages stages over every channel's buffer in place, the channels in the lanes of the vector
+    // kernels. Silent blocks on every channel through a settled cascade are just zeroed.
+    inline void ProcessAllPassChannelCascade(FAllPassChannelCascadeState& State, int32_t NumStages, float* const* InOutData, int32_t NumFrames)
+    {
+        bool bSilent = true;
+        for (int32_t Channel = 0; Channel < State.NumChannels && bSilent; ++Channel)
+        {
+            bSilent = IsSilentBlock(InOutData[Channel], NumFrames);
+        }
+
+        if (bSilent && IsAllPassChannelCascadeSettled(State, NumStages))
+        {
+            for (int32_t Channel = 0; Channel < State.NumChannels; ++Channel)
+            {
+                std::memset(InOutData[Channel], 0, sizeof(float) * NumFrames);
+            }
+            return;
+        }
+
+        GetKernelTable().ProcessMultichannelAllPassStages(State.Recent, State.Older, State.Feedback, NumStages, State.NumChannels, InOutData, NumFrames);
+    }
+
+    // GuardAllPassCascadeState() for every channel of the first NumStages stages
+    inline bool GuardAllPassChannelCascadeState(FAllPassChannelCascadeState& State, int32_t NumStages)
+    {
+        const int32_t NumValues = NumStages * State.NumChannels;
+        bool bFinite = SanitizeState(State.Recent, NumValues);
+        bFinite &= SanitizeState(State.Older, NumValues);
+
+        if (bFinite)
+        {
+            return true;
+        }
+
+        std::memset(State.Recent, 0, sizeof(float) * NumValues);
+        std::memset(State.Older, 0, sizeof(float) * NumValues);
+
+        RecordNonFiniteReset();
+        return false;
+    }
+
+    // How the Phase Disperser runs its cascade
+    enum class EAllPassMode : int32_t
+    {
+        // Convolution from GetAllPassConvolutionCrossover() stages, recursive below, chosen once by
+        // ResetAllPassDisperser() so that changing the stage count or the kernel level never switches it mid-stream
+        Auto,
+        Recursive,
+        Convolution,
+        // The sections of FAllPassDisperserState::Design in place of the stages (see DispersionKernel.h)
+        Designed,
+        Count
+    };
+
+    // Stage count from which convolving with the cascade's response costs less than running the stages at the given
+    // kernel level. Measured with BranchesBenchmark --filter PhaseDisperser (see Tools/README.md); the convolution
+    // costs about the same at every level, its head FIR dominating, so the faster stages push the crossover up.
+    inline int32_t GetAllPassConvolutionCrossover(EKernelIsa Isa)
+    {
+        switch (Isa)
+        {
+        case EKernelIsa::Scalar:
+            return 16;
+        case EKernelIsa::SSE2:
+        case EKernelIsa::SSE41:
+            return 48;
+        case EKernelIsa::AVX2:
+            return 80;
+        default:
+            return 112;
+        }
+    }
+
+    // Responses of the cascade at the default feedback for every stage count, as partitioned impulse responses.
+    // The stages' coefficients don't depend on the sample rate, so neither do the responses: one bank serves every
+    // instance at any rate.
+    struct FAllPassResponseBank
+    {
+        // Indexed by stage count - 1
+        FPartitionedResponse Responses[MaxAllPassStages];
+    };
+
+    // Relative energy left off each end of the truncated responses (-120 dB)
+    constexpr double AllPassResponseTolerance = 1.0e-12;
+
+    inline FAllPassResponseBank MakeAllPassResponseBank()
+    {
+        constexpr int32_t NumTaps = ConvolutionPartitionSize * (MaxConvolutionPartitions + 1);
+
+        FAllPassResponseBank Bank;
+
+        // Run in double an impulse through the stages one at a time, so after each stage the buffer holds the
+        // response of that many
+        std::vector<double> Response(NumTaps, 0.0);
+        std::vector<float> Taps(NumTaps, 0.0f);
+        Response[0] = 1.0;
+
+        for (int32_t NumStages = 1; NumStages <= MaxAllPassStages; ++NumStages)
+        {
+            double Recent = 0.0;
+            double Older = 0.0;
+            for (double& Value : Response)
+            {
+                const double Output = -DefaultAllPassFeedback * Value + Older;
+                Older = Recent;
+                Recent = Value + DefaultAllPassFeedback * Output;
+                Value = Output;
+            }
+
+            double TotalEnergy = 0.0;
+            for (double Value : Response)
+            {
+                TotalEnergy += Value * Value;
+            }
+
+            // Drop the negligible onset and tail
+            int32_t FirstTap = 0;
+            for (double Energy = 0.0; FirstTap < NumTaps; ++FirstTap)
+            {
+                Energy += Response[FirstTap] * Response[FirstTap];
+                if (Energy > AllPassResponseTolerance * TotalEnergy)
+                {
+                    break;
+                }
+            }
+
+            int32_t EndTap = NumTaps;
+            for (double Energy = 0.0; EndTap > FirstTap; --EndTap)
+            {
+                Energy += Response[EndTap - 1] * Response[EndTap - 1];
+                if (Energy > AllPassResponseTolerance * TotalEnergy)
+                {
+                    break;
+                }
+            }
+
+            std::fill(Taps.begin(), Taps.end(), 0.0f);
+            for (int32_t Tap = FirstTap; Tap < EndTap; ++Tap)
+            {
+                Taps[Tap] = static_cast<float>(Response[Tap]);
+            }
+
+            Bank.Responses[NumStages - 1] = MakePartitionedResponse(Taps.data(), EndTap);
+        }
+
+        return Bank;
+    }
+
+    // Built on first use; the module calls this at startup
+    inline const FAllPassResponseBank& GetAllPassResponseBank()
+    {
+        static const FAllPassResponseBank Bank = MakeAllPassResponseBank();
+        return Bank;
+    }
+
+    // The designed sections' state, and that of the design being faded out
+    struct FAllPassDesignedState
+    {
+        FAllPassSectionState Sections;
+        FAllPassSectionState FadeSections;
+    };
+
+    // The Phase Disperser's state in every mode. Only the running mode's state is kept up to date; the others are
+    // cleared on switching, so changing modes restarts the cascade. The convolver and the sections are several
+    // kilobytes, so they are only allocated by AllocateAllPassDisperserModes() for nodes that can reach their mode.
+    struct FAllPassDisperserState
+    {
+        FAllPassCascadeState Cascade;
+        std::unique_ptr<FPartitionedConvolutionState> Convolution;
+        std::unique_ptr<FAllPassDesignedState> Designed;
+
+        // Sections for EAllPassMode::Designed (none while null), set by SetAllPassDispersionDesign()
+        const FDispersionDesign* Design = nullptr;
+
+        // The design being faded out over the next block
+        const FDispersionDesign* FadeFrom = nullptr;
+
+        // Recursive, Convolution or Designed
+        EAllPassMode Running = EAllPassMode::Recursive;
+
+        // Recursive or Convolution, what EAllPassMode::Auto runs in until the next ResetAllPassDisperser()
+        EAllPassMode AutoMode = EAllPassMode::Recursive;
+    };
+
+    // Allocates the state of the convolution and designed modes, for nodes that can reach them; call it when the node
+    // is built, before ResetAllPassDisperser(), never on the audio thread
+    inline void AllocateAllPassDisperserModes(FAllPassDisperserState& State, bool bConvolution, bool bDesigned)
+    {
+        if (bConvolution && !State.Convolution)
+        {
+            State.Convolution = std::make_unique<FPartitionedConvolutionState>();
+        }
+        if (bDesigned && !State.Designed)
+        {
+            State.Designed = std::make_unique<FAllPassDesignedState>();
+        }
+    }
+
+    // The mode Mode runs in: Auto resolves to the mode latched in the state, and a mode whose state wasn't allocated
+    // runs recursively
+    inline EAllPassMode GetRunningAllPassMode(const FAllPassDisperserState& State, EAllPassMode Mode)
+    {
+        switch (Mode)
+        {
+        case EAllPassMode::Recursive:
+            return Mode;
+        case EAllPassMode::Convolution:
+            return State.Convolution ? Mode : EAllPassMode::Recursive;
+        case EAllPassMode::Designed:
+            return State.Designed ? Mode : EAllPassMode::Recursive;
+        default:
+            return State.AutoMode;
+        }
+    }
+
+    inline int32_t GetNumDispersionSections(const FDispersionDesign* Design)
+    {
+        return Design != nullptr ? Design->NumSections : 0;
+    }
+
+    // Switches to Design for EAllPassMode::Designed; the caller keeps it alive while it is in use. With bCrossfade,
+    // the next block fades over from the design in use, which must then stay alive for that block too.
+    inline void SetAllPassDispersionDesign(FAllPassDisperserState& State, const FDispersionDesign* Design, bool bCrossfade)
+    {
+        State.FadeFrom = nullptr;
+        if (Design == State.Design)
+        {
+            return;
+        }
+
+        if (State.Designed)
+        {
+            if (bCrossfade && State.Design != nullptr && State.Running == EAllPassMode::Designed)
+            {
+                State.FadeFrom = State.Design;
+                State.Designed->FadeSections = State.Designed->Sections;
+            }
+
+            ResizeAllPassSections(State.Designed->Sections, GetNumDispersionSections(State.Design), GetNumDispersionSections(Design));
+        }
+        State.Design = Design;
+    }
+
+    // Back to silence in recursive mode, with EAllPassMode::Auto resolved for NumStages stages at the current kernel
+    // level (recursive without a convolver). The other modes' state is cleared when they next run, so voices that
+    // never switch don't touch it; the design is kept.
+    inline void ResetAllPassDisperser(FAllPassDisperserState& State, int32_t NumStages)
+    {
+        State.Cascade.Init();
+        State.Running = EAllPassMode::Recursive;
+        State.AutoMode = State.Convolution && NumStages >= GetAllPassConvolutionCrossover(GetKernelTable().Isa) ? EAllPassMode::Convolution : EAllPassMode::Recursive;
+    }
+
+    // Runs the first NumStages stages over the buffer in place, recursively or by convolving with the response
+    // from GetAllPassResponseBank() as Mode decides, or the designed sections instead of the stages. Within about
+    // -120 dB recursion and convolution give the same output; the convolution keeps the delay line of its input
+    // when the stage count changes, and only swaps the response.
+    inline void ProcessAllPassDisperser(FAllPassDisperserState& State, EAllPassMode Mode, int32_t NumStages, float* InOutBuffer, int32_t NumFrames)
+    {
+        const EAllPassMode Running = GetRunningAllPassMode(State, Mode);
+
+        if (Running != State.Running)
+        {
+            switch (Running)
+            {
+            case EAllPassMode::Convolution:
+                State.Convolution->Init();
+                break;
+            case EAllPassMode::Designed:
+                State.Designed->Sections.Init();
+                State.FadeFrom = nullptr;
+                break;
+            default:
+                State.Cascade.Init();
+                break;
+            }
+            State.Running = Running;
+        }
+
+        switch (Running)
+        {
+        case EAllPassMode::Convolution:
+            ProcessPartitionedConvolution(*State.Convolution, GetAllPassResponseBank().Responses[NumStages - 1], InOutBuffer, InOutBuffer, NumFrames);
+            break;
+        case EAllPassMode::Designed:
+            if (State.Design == nullptr)
+            {
+                break;
+            }
+            if (State.FadeFrom != nullptr)
+            {
+                ProcessDispersionSectionsCrossfade(State.Designed->Sections, *State.Design, State.Designed->FadeSections, *State.FadeFrom, InOutBuffer, NumFrames);
+                State.FadeFrom = nullptr;
+            }
+            else
+            {
+                ProcessDispersionSections(State.Designed->Sections, *State.Design, InOutBuffer, NumFrames);
+            }
+            break;
+        default:
+            ProcessAllPassCascade(State.Cascade, NumStages, InOutBuffer, NumFrames);
+            break;
+        }
+    }
+
+    // Block-boundary guard (see StateGuard.h) for whichever of the cascade and the sections is running. The
+    // convolution doesn't need one: it has no feedback, so anything non-finite leaves its state within
+    // MaxConvolutionPartitions + 2 partitions.
+    inline bool GuardAllPassDisperserState(FAllPassDisperserState& State, int32_t NumStages)
+    {
+        switch (State.Running)
+        {
+        case EAllPassMode::Convolution:
+            return true;
+        case EAllPassMode::Designed:
+            return GuardAllPassSectionState(State.Designed->Sections, GetNumDispersionSections(State.Design));
+        default:
+            return GuardAllPassCascadeState(State.Cascade, NumStages);
+        }
+    }
+}
@@ -0,0 +1,40 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Detection of silent and constant input blocks, for the kernels' fast paths.
+//
+// Most voices spend most of their time fed with silence or a DC value. The checks stop at the first vector that
+// differs, so on a live signal they cost a few nanoseconds per block.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+
+#include <algorithm>
+
+namespace MetasoundBranches::Kernels
+{
+    // True if every frame compares equal to the first one, which is returned in OutValue. Blocks containing NaN
+    // are never constant.
+    inline bool IsConstantBlock(const float* Data, int32_t NumFrames, float& OutValue)
+    {
+        if (NumFrames <= 0)
+        {
+            return false;
+        }
+
+        OutValue = Data[0];
+        return GetKernelTable().FindNotEqual(Data, 1, NumFrames, OutValue) == NumFrames;
+    }
+
+    // True if every frame is zero (of either sign)
+    inline bool IsSilentBlock(const float* Data, int32_t NumFrames)
+    {
+        return GetKernelTable().FindNotEqual(Data, 0, NumFrames, 0.0f) == NumFrames;
+    }
+
+    inline void FillBlock(float* OutputData, int32_t NumFrames, float Value)
+    {
+        std::fill(OutputData, OutputData + NumFrames, Value);
+    }
+}
@@ -0,0 +1,81 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Shared definitions for the Branches DSP kernels.
+//
+// Everything under Kernels/ is engine-independent: plain float pointers, small state structs and
+// the C++ standard library only. The operators in Private/ own the MetaSound plumbing (vertex
+// interfaces, data references, triggers) and call into these functions from Execute(), so the same
+// sample loops can be built, profiled and tested outside of Unreal (see Tools/).
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace MetasoundBranches::Kernels
+{
+    // Matches the engine's PI / HALF_PI so gains are bit-identical with the original operators
+    constexpr float Pi = 3.1415926535897932f;
+    constexpr float HalfPi = 1.57079632679489661923f;
+
+    // A value ramping linearly across a block, Start + Step * i at frame i; a Step of zero holds it
+    struct FRamp
+    {
+        float Start = 0.0f;
+        float Step = 0.0f;
+    };
+
+    // Sums over a block of a stereo signal, for metering
+    struct FStereoSums
+    {
+        float LeftRight = 0.0f;
+        float LeftSquared = 0.0f;
+        float RightSquared = 0.0f;
+        float LeftPeak = 0.0f;
+        float RightPeak = 0.0f;
+    };
+
+    // FStereoSums are accumulated in this many interleaved partial sums, frame i going to lane i % SumLanes, and
+    // the lanes are then combined pairwise. The order of the additions is therefore the same at every vector width.
+    constexpr int32_t SumLanes = 16;
+
+    struct FStereoSumLanes
+    {
+        float LeftRight[SumLanes] = {};
+        float LeftSquared[SumLanes] = {};
+        float RightSquared[SumLanes] = {};
+        float LeftPeak[SumLanes] = {};
+        float RightPeak[SumLanes] = {};
+    };
+
+    // The vector allpass kernels run the cascade in groups of this many vectors of stages, one pass over the block
+    // per group: enough independent vectors per step to hide the latency of the recurrence, few enough that the
+    // group's state stays in registers
+    constexpr int32_t AllPassWaveVectors = 4;
+
+    // Below this many stages, filling and draining the pipeline costs more than running the stages one at a time
+    constexpr int32_t AllPassWaveMinStages = 4;
+
+    // The multichannel allpass kernels take up to this many channels in the lanes of a vector, interleaving them
+    // this many frames at a time
+    constexpr int32_t MaxAllPassChannels = 8;
+    constexpr int32_t AllPassChannelChunkFrames = 64;
+
+    // Same semantics as FMath::Clamp
+    inline float Clamp(float Value, float Min, float Max)
+    {
+        return Value < Min ? Min : (Value < Max ? Value : Max);
+    }
+
+    inline int32_t Clamp(int32_t Value, int32_t Min, int32_t Max)
+    {
+        return Value < Min ? Min : (Value < Max ? Value : Max);
+    }
+
+    // Same semantics as FMath::RoundToInt
+    inline int32_t RoundToInt(float Value)
+    {
+        return static_cast<int32_t>(std::floor(Value + 0.5f));
+    }
+}
@@ -0,0 +1,24 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Convenience header pulling in every Branches DSP kernel
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/AllPassKernel.h"
+#include "MetasoundBranches/Public/Kernels/BlockAnalysis.h"
+#include "MetasoundBranches/Public/Kernels/ClockKernels.h"
+#include "MetasoundBranches/Public/Kernels/DustKernel.h"
+#include "MetasoundBranches/Public/Kernels/EdgeKernel.h"
+#include "MetasoundBranches/Public/Kernels/ImpulseKernel.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/MultichannelKernels.h"
+#include "MetasoundBranches/Public/Kernels/QuarterSineTable.h"
+#include "MetasoundBranches/Public/Kernels/RebuildSlot.h"
+#include "MetasoundBranches/Public/Kernels/RouterKernels.h"
+#include "MetasoundBranches/Public/Kernels/SahKernel.h"
+#include "MetasoundBranches/Public/Kernels/SlewKernel.h"
+#include "MetasoundBranches/Public/Kernels/StateGuard.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+#include "MetasoundBranches/Public/Kernels/StereoMeterKernel.h"
+#include "MetasoundBranches/Public/Kernels/TuningKernels.h"
@@ -0,0 +1,57 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+namespace MetasoundBranches::Kernels
+{
+    constexpr int32_t ClockDividerNumOutputs = 8;
+    constexpr int32_t ShiftRegisterNumStages = 8;
+
+    struct FClockDividerState
+    {
+        int32_t Counter = 0;
+
+        void Reset()
+        {
+            Counter = 0;
+        }
+    };
+
+    // Advances the divider by one input trigger and returns a mask of the outputs to fire (bit N = output N + 1)
+    inline uint32_t AdvanceClockDivider(FClockDividerState& State)
+    {
+        // Counter value -> outputs fired, e.g. counter 5 fires 1, 2, 3 and 6
+        static constexpr uint8_t OutputMasks[ClockDividerNumOutputs] =
+        {
+            0b00000001,
+            0b00000011,
+            0b00000101,
+            0b00001011,
+            0b00010001,
+            0b00100111,
+            0b01000001,
+            0b10001011
+        };
+
+        State.Counter = (State.Counter + 1) % ClockDividerNumOutputs;
+        return OutputMasks[State.Counter];
+    }
+
+    struct FShiftRegisterState
+    {
+        float Values[ShiftRegisterNumStages] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    };
+
+    // Shifts every stage down by one and loads the new value into the first stage
+    inline void ShiftRegister(FShiftRegisterState& State, float InValue)
+    {
+        for (int32_t Stage = ShiftRegisterNumStages - 1; Stage > 0; --Stage)
+        {
+            State.Values[Stage] = State.Values[Stage - 1];
+        }
+
+        State.Values[0] = InValue;
+    }
+}
@@ -0,0 +1,259 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Zero-latency uniformly partitioned convolution with a fixed impulse response.
+//
+// The response is split into a head, its first ConvolutionPartitionSize taps, and a tail of equal partitions. The
+// head is applied directly, as an FIR filter over the input of the last two partitions. The tail
+// runs in the frequency domain by overlap-save: at each partition boundary the last two input partitions are
+// transformed, the spectrum joins a delay line of earlier ones, and the delay line is multiplied by the tail's
+// partition spectra and summed, giving the tail's output for the whole next partition. Because the tail starts a
+// full partition into the response, its output is always ready in time and nothing is delayed.
+//
+// Responses are built once (MakePartitionedResponse()) and can be shared by any number of convolvers. The delay
+// line holds input spectra only, so a convolver can switch to another response between blocks and carry on.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/BlockAnalysis.h"
+#include "MetasoundBranches/Public/Kernels/FftKernel.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+
+#include <vector>
+
+namespace MetasoundBranches::Kernels
+{
+    constexpr int32_t ConvolutionPartitionSize = 64;
+    constexpr int32_t ConvolutionFftSize = 2 * ConvolutionPartitionSize;
+    constexpr int32_t ConvolutionBins = ConvolutionFftSize / 2 + 1;
+
+    // Longest tail, in partitions; longer responses are truncated
+    constexpr int32_t MaxConvolutionPartitions = 16;
+
+    using FConvolutionFft = TRealFft<ConvolutionFftSize>;
+
+    // The transform shared by every convolver
+    inline const FConvolutionFft& GetConvolutionFft()
+    {
+        static const FConvolutionFft Fft;
+        return Fft;
+    }
+
+    struct FPartitionedResponse
+    {
+        // Taps before HeadStart are zero and skipped
+        int32_t HeadStart = 0;
+        float Head[ConvolutionPartitionSize] = {};
+
+        // Spectra of the tail partitions, NumPartitions runs of ConvolutionBins, scaled by 1 / ConvolutionFftSize
+        // so the inverse transform comes out at unity gain
+        int32_t NumPartitions = 0;
+        std::vector<float> SpectraReal;
+        std::vector<float> SpectraImag;
+    };
+
+    // Splits NumTaps taps of a response into head and tail partitions. Leading zero taps are skipped by the head,
+    // so responses that start late cost less.
+    inline FPartitionedResponse MakePartitionedResponse(const float* Taps, int32_t NumTaps)
+    {
+        const FConvolutionFft& Fft = GetConvolutionFft();
+        FPartitionedResponse Response;
+
+        const int32_t MaxTaps = ConvolutionPartitionSize * (MaxConvolutionPartitions + 1);
+        NumTaps = NumTaps < MaxTaps ? NumTaps : MaxTaps;
+
+        const int32_t NumHeadTaps = NumTaps < ConvolutionPartitionSize ? NumTaps : ConvolutionPartitionSize;
+        while (Response.HeadStart < NumHeadTaps && Taps[Response.HeadStart] == 0.0f)
+        {
+            ++Response.HeadStart;
+        }
+        for (int32_t Tap = Response.HeadStart; Tap < NumHeadTaps; ++Tap)
+        {
+            Response.Head[Tap] = Taps[Tap];
+        }
+
+        Response.NumPartitions = (NumTaps - NumHeadTaps + ConvolutionPartitionSize - 1) / ConvolutionPartitionSize;
+        Response.SpectraReal.assign(static_cast<size_t>(Response.NumPartitions) * ConvolutionBins, 0.0f);
+        Response.SpectraImag.assign(static_cast<size_t>(Response.NumPartitions) * ConvolutionBins, 0.0f);
+
+        for (int32_t Partition = 0; Partition < Response.NumPartitions; ++Partition)
+        {
+            // Partition taps followed by zeros, so overlap-save keeps the linear part of the circular convolution
+            float Padded[ConvolutionFftSize] = {};
+            const int32_t FirstTap = ConvolutionPartitionSize * (Partition + 1);
+            for (int32_t Tap = 0; Tap < ConvolutionPartitionSize && FirstTap + Tap < NumTaps; ++Tap)
+            {
+                Padded[Tap] = Taps[FirstTap + Tap] * (1.0f / ConvolutionFftSize);
+            }
+
+            Fft.Forward(Padded, &Response.SpectraReal[Partition * ConvolutionBins], &Response.SpectraImag[Partition * ConvolutionBins]);
+        }
+
+        return Response;
+    }
+
+    // Silent partitions in a row after which a convolver's state is all zeros: both input partitions and every
+    // spectrum it can read
+    constexpr int32_t ConvolutionSettledPartitions = MaxConvolutionPartitions + 1;
+
+    struct FPartitionedConvolutionState
+    {
+        // The previous input partition followed by the current one, filled up to Position; the head reads its
+        // past input from here
+        float Input[ConvolutionFftSize] = {};
+
+        // Tail output for the current partition
+        float TailOutput[ConvolutionPartitionSize] = {};
+
+        // Spectra of the latest input pairs, Newest first going backwards around the ring
+        float SpectraReal[MaxConvolutionPartitions][ConvolutionBins] = {};
+        float SpectraImag[MaxConvolutionPartitions][ConvolutionBins] = {};
+        int32_t Newest = 0;
+
+        // Frames into the current partition
+        int32_t Position = 0;
+
+        // Partitions of silent input in a row, up to ConvolutionSettledPartitions
+        int32_t NumSilentPartitions = ConvolutionSettledPartitions;
+
+        // Back to silence in place
+        void Init()
+        {
+            std::memset(Input, 0, sizeof(Input));
+            std::memset(TailOutput, 0, sizeof(TailOutput));
+            std::memset(SpectraReal, 0, sizeof(SpectraReal));
+            std::memset(SpectraImag, 0, sizeof(SpectraImag));
+            Newest = 0;
+            Position = 0;
+            NumSilentPartitions = ConvolutionSettledPartitions;
+        }
+    };
+
+    // True once silence in gives silence out
+    inline bool IsConvolutionSettled(const FPartitionedConvolutionState& State)
+    {
+        return State.NumSilentPartitions >= ConvolutionSettledPartitions;
+    }
+
+    namespace ConvolutionPrivate
+    {
+        // Head taps applied to NumFrames frames of Input, whose past frames precede it, added to the tail's output.
+        // Every frame sums in the same order whatever the chunking, so the output doesn't depend on the block size.
+        inline void ProcessHead(const FPartitionedResponse& Response, const float* Input, const float* TailOutput, float* OutputData, int32_t NumFrames)
+        {
+            std::memcpy(OutputData, TailOutput, sizeof(float) * NumFrames);
+
+            // Tap by tap, so the inner loop runs over the frames
+            for (int32_t Tap = Response.HeadStart; Tap < ConvolutionPartitionSize; ++Tap)
+            {
+                const float Gain = Response.Head[Tap];
+                const float* Past = Input - Tap;
+
+                for (int32_t Frame = 0; Frame < NumFrames; ++Frame)
+                {
+                    OutputData[Frame] += Gain * Past[Frame];
+                }
+            }
+        }
+
+        // Runs at a partition boundary: transforms the last two input partitions and computes the tail's output
+        // for the partition that starts now
+        inline void ProcessPartitionBoundary(FPartitionedConvolutionState& State, const FPartitionedResponse& Response)
+        {
+            constexpr int32_t Size = ConvolutionPartitionSize;
+
+            const bool bSilentPartition = IsSilentBlock(State.Input + Size, Size);
+            if (!bSilentPartition)
+            {
+                State.NumSilentPartitions = 0;
+            }
+            else if (State.NumSilentPartitions < ConvolutionSettledPartitions)
+            {
+                ++State.NumSilentPartitions;
+            }
+            else
+            {
+                // Already all zeros, and they stay that way
+                return;
+            }
+
+            const FConvolutionFft& Fft = GetConvolutionFft();
+
+            State.Newest = (State.Newest + 1) % MaxConvolutionPartitions;
+            Fft.Forward(State.Input, State.SpectraReal[State.Newest], State.SpectraImag[State.Newest]);
+
+            std::memcpy(State.Input, State.Input + Size, sizeof(float) * Size);
+
+            if (Response.NumPartitions == 0)
+            {
+                // The delay line is still kept up to date, in case the next response has a tail
+                std::memset(State.TailOutput, 0, sizeof(float) * Size);
+                return;
+            }
+
+            // The delay line's spectra, newest first, against the response's partitions in order
+            const float* InputReal[MaxConvolutionPartitions];
+            const float* InputImag[MaxConvolutionPartitions];
+            for (int32_t Partition = 0; Partition < Response.NumPartitions; ++Partition)
+            {
+                const int32_t Slot = (State.Newest - Partition + MaxConvolutionPartitions) % MaxConvolutionPartitions;
+                InputReal[Partition] = State.SpectraReal[Slot];
+                InputImag[Partition] = State.SpectraImag[Slot];
+            }
+
+            float SumReal[ConvolutionBins];
+            float SumImag[ConvolutionBins];
+            GetKernelTable().SumSpectrumProducts(
+                InputReal, InputImag, Response.SpectraReal.data(), Response.SpectraImag.data(), Response.NumPartitions, ConvolutionBins, SumReal, SumImag, 0, ConvolutionBins);
+
+            // Overlap-save keeps the second half, the part not wrapped around by the circular convolution
+            float Output[ConvolutionFftSize];
+            Fft.Inverse(SumReal, SumImag, Output);
+            std::memcpy(State.TailOutput, Output + Size, sizeof(float) * Size);
+        }
+    }
+
+    // Convolves NumFrames frames with Response into OutputData, which may be InputData
+    inline void ProcessPartitionedConvolution(FPartitionedConvolutionState& State, const FPartitionedResponse& Response, const float* InputData, float* OutputData, int32_t NumFrames)
+    {
+        constexpr int32_t Size = ConvolutionPartitionSize;
+
+        if (IsSilentBlock(InputData, NumFrames))
+        {
+            if (IsConvolutionSettled(State))
+            {
+                // The input buffer only ever holds zeros meanwhile, so only the position needs to move on
+                State.Position = (State.Position + NumFrames) % Size;
+                std::memset(OutputData, 0, sizeof(float) * NumFrames);
+                return;
+            }
+        }
+        else
+        {
+            // Not settled from here on, even before the partition is complete
+            State.NumSilentPartitions = 0;
+        }
+
+        int32_t Frame = 0;
+        while (Frame < NumFrames)
+        {
+            const int32_t Position = State.Position;
+            const int32_t NumChunkFrames = (Size - Position) < (NumFrames - Frame) ? (Size - Position) : (NumFrames - Frame);
+
+            // Copied in first, as OutputData may be InputData
+            float* ChunkInput = State.Input + Size + Position;
+            std::memcpy(ChunkInput, InputData + Frame, sizeof(float) * NumChunkFrames);
+
+            ConvolutionPrivate::ProcessHead(Response, ChunkInput, State.TailOutput + Position, OutputData + Frame, NumChunkFrames);
+
+            Frame += NumChunkFrames;
+            State.Position += NumChunkFrames;
+
+            if (State.Position == Size)
+            {
+                State.Position = 0;
+                ConvolutionPrivate::ProcessPartitionBoundary(State, Response);
+            }
+        }
+    }
+}
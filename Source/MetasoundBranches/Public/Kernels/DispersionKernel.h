@@ -0,0 +1,202 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Designed dispersion for the Phase Disperser: second-order allpass sections whose group delay falls linearly across
+// a frequency range, so the low edge of the range comes out a set time after the high edge.
+//
+// The target group delay is integrated into a phase curve, which is cut into one equal slice per section. Each
+// section puts its pole pair at the centre of its slice, with a radius set by the slice's width so that neighbouring
+// sections blend into a smooth curve. A section turns the phase through 2 pi in all, so a delay difference of D
+// seconds across B Hz takes about D * B / 2 sections; the identical stages of the recursive cascade spread theirs
+// over the whole spectrum instead. For a linear target the slices have closed-form centres, so a design costs a few
+// transcendental functions per section and allocates nothing.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/BlockAnalysis.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/StateGuard.h"
+
+#include <cmath>
+
+namespace MetasoundBranches::Kernels
+{
+    // Longest design; larger delay differences are scaled back to what this many sections reach
+    constexpr int32_t MaxDispersionSections = 64;
+
+    // Half-width of each section's delay peak, relative to the spacing of the sections. Wider peaks smooth out the
+    // ripple between sections (about 4% of the delay difference at this setting) but soften the ends of the range.
+    constexpr double DispersionPeakWidth = 0.7;
+
+    struct FDispersionParams
+    {
+        // Group delay of the low edge of the range over the high edge; negative values delay the high edge instead
+        float DispersionSeconds = 0.0f;
+        float LowFrequency = 100.0f;
+        float HighFrequency = 4000.0f;
+        float SampleRate = 48000.0f;
+
+        bool operator==(const FDispersionParams& Other) const
+        {
+            return DispersionSeconds == Other.DispersionSeconds && LowFrequency == Other.LowFrequency && HighFrequency == Other.HighFrequency && SampleRate == Other.SampleRate;
+        }
+
+        bool operator!=(const FDispersionParams& Other) const
+        {
+            return !(*this == Other);
+        }
+    };
+
+    // Coefficients of the sections in the form taken by ProcessAllPassSections(), with the parameters they were
+    // designed from
+    struct FDispersionDesign
+    {
+        FDispersionParams Params;
+        int32_t NumSections = 0;
+        float A1[MaxDispersionSections] = {};
+        float A2[MaxDispersionSections] = {};
+    };
+
+    // Designs the sections for Params; no dispersion, or a range with no width, gives no sections at all
+    inline FDispersionDesign MakeDispersionDesign(const FDispersionParams& Params)
+    {
+        constexpr double Pi64 = 3.14159265358979323846;
+
+        FDispersionDesign Design;
+        Design.Params = Params;
+
+        if (!(Params.SampleRate > 0.0f) || !(Params.DispersionSeconds != 0.0f) || !std::isfinite(Params.DispersionSeconds))
+        {
+            return Design;
+        }
+
+        // Within (0, 0.45) of the sample rate, so every pole stays clear of DC and Nyquist
+        const double SampleRate = Params.SampleRate;
+        const double MaxFrequency = 0.45 * SampleRate;
+        const double LowFrequency = Clamp(Params.LowFrequency < Params.HighFrequency ? Params.LowFrequency : Params.HighFrequency, 1.0f, static_cast<float>(MaxFrequency));
+        const double HighFrequency = Clamp(Params.LowFrequency < Params.HighFrequency ? Params.HighFrequency : Params.LowFrequency, 1.0f, static_cast<float>(MaxFrequency));
+        if (HighFrequency - LowFrequency < 1.0)
+        {
+            return Design;
+        }
+
+        // The target phase, integrated over the range, is D * B * pi; each section takes 2 pi of it
+        const double Sections = std::fabs(Params.DispersionSeconds) * (HighFrequency - LowFrequency) * 0.5;
+        Design.NumSections = Clamp(static_cast<int32_t>(std::lround(Sections)), 1, MaxDispersionSections);
+
+        const double LowOmega = 2.0 * Pi64 * LowFrequency / SampleRate;
+        const double RangeOmega = 2.0 * Pi64 * (HighFrequency - LowFrequency) / SampleRate;
+        const bool bDelayLows = Params.DispersionSeconds > 0.0f;
+
+        for (int32_t Section = 0; Section < Design.NumSections; ++Section)
+        {
+            // With the delay falling linearly to zero across the range, the phase is quadratic in frequency, and
+            // the centre of slice k lies where it reaches (k + 1/2) / NumSections of the total. The spacing of
+            // the sections there is inversely proportional to the target delay.
+            const double Fraction = (Section + 0.5) / Design.NumSections;
+            const double Root = std::sqrt(bDelayLows ? 1.0 - Fraction : Fraction);
+            const double Omega = bDelayLows ? LowOmega + RangeOmega * (1.0 - Root) : LowOmega + RangeOmega * Root;
+            const double Spacing = RangeOmega / (2.0 * Design.NumSections * Root);
+
+            const double Radius = std::exp(-DispersionPeakWidth * Spacing);
+            Design.A1[Section] = static_cast<float>(-2.0 * Radius * std::cos(Omega));
+            Design.A2[Section] = static_cast<float>(Radius * Radius);
+        }
+
+        return Design;
+    }
+
+    // The two state variables of every section, stored field by field like FAllPassCascadeState
+    struct FAllPassSectionState
+    {
+        float State1[MaxDispersionSections] = {};
+        float State2[MaxDispersionSections] = {};
+
+        // Back to silence in place
+        void Init()
+        {
+            std::memset(State1, 0, sizeof(State1));
+            std::memset(State2, 0, sizeof(State2));
+        }
+    };
+
+    // True if the first NumSections sections hold no signal, so silence in gives silence out
+    inline bool IsAllPassSectionsSettled(const FAllPassSectionState& State, int32_t NumSections)
+    {
+        for (int32_t Section = 0; Section < NumSections; ++Section)
+        {
+            if (State.State1[Section] != 0.0f || State.State2[Section] != 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Readies the state for a change of design from one with NumPreviousSections sections: sections the new design
+    // keeps carry their state over, and sections it adds start from silence
+    inline void ResizeAllPassSections(FAllPassSectionState& State, int32_t NumPreviousSections, int32_t NumSections)
+    {
+        for (int32_t Section = NumPreviousSections; Section < NumSections; ++Section)
+        {
+            State.State1[Section] = 0.0f;
+            State.State2[Section] = 0.0f;
+        }
+    }
+
+    // Runs the designed sections over the buffer in place. A silent block through settled sections is just zeroed.
+    inline void ProcessDispersionSections(FAllPassSectionState& State, const FDispersionDesign& Design, float* InOutBuffer, int32_t NumFrames)
+    {
+        if (IsSilentBlock(InOutBuffer, NumFrames) && IsAllPassSectionsSettled(State, Design.NumSections))
+        {
+            std::memset(InOutBuffer, 0, sizeof(float) * NumFrames);
+            return;
+        }
+
+        GetKernelTable().ProcessAllPassSections(State.State1, State.State2, Design.A1, Design.A2, Design.NumSections, InOutBuffer, NumFrames);
+    }
+
+    // Fades linearly across the block from the buffer through From, run with FromState, to the buffer through To, run
+    // with State
+    inline void ProcessDispersionSectionsCrossfade(
+        FAllPassSectionState& State, const FDispersionDesign& To, FAllPassSectionState& FromState, const FDispersionDesign& From, float* InOutBuffer, int32_t NumFrames)
+    {
+        constexpr int32_t ChunkFrames = 256;
+        float FromOutput[ChunkFrames];
+
+        for (int32_t Start = 0; Start < NumFrames; Start += ChunkFrames)
+        {
+            const int32_t Count = NumFrames - Start < ChunkFrames ? NumFrames - Start : ChunkFrames;
+            float* ToOutput = InOutBuffer + Start;
+
+            std::memcpy(FromOutput, ToOutput, sizeof(float) * Count);
+            ProcessDispersionSections(FromState, From, FromOutput, Count);
+            ProcessDispersionSections(State, To, ToOutput, Count);
+
+            for (int32_t i = 0; i < Count; ++i)
+            {
+                const float Gain = static_cast<float>(Start + i + 1) / static_cast<float>(NumFrames);
+                ToOutput[i] = FromOutput[i] + Gain * (ToOutput[i] - FromOutput[i]);
+            }
+        }
+    }
+
+    // Block-boundary guard for the first NumSections sections (see StateGuard.h): flushes subnormal state to zero,
+    // and clears all of it and returns false if any is NaN or infinite
+    inline bool GuardAllPassSectionState(FAllPassSectionState& State, int32_t NumSections)
+    {
+        bool bFinite = SanitizeState(State.State1, NumSections);
+        bFinite &= SanitizeState(State.State2, NumSections);
+
+        if (bFinite)
+        {
+            return true;
+        }
+
+        std::memset(State.State1, 0, sizeof(float) * NumSections);
+        std::memset(State.State2, 0, sizeof(float) * NumSections);
+
+        RecordNonFiniteReset();
+        return false;
+    }
+}
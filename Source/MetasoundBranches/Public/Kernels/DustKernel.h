@@ -0,0 +1,98 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+namespace MetasoundBranches::Kernels
+{
+    // Linear congruential generator producing the same sequence as FRandomStream for a given seed
+    struct FRandomStreamState
+    {
+        uint32_t Seed = 0;
+
+        void Initialize(int32_t InSeed)
+        {
+            Seed = static_cast<uint32_t>(InSeed);
+        }
+
+        // Uniform value in [0, 1)
+        float GetFraction()
+        {
+            Seed = (Seed * 196314165U) + 907633515U;
+
+            const uint32_t Bits = 0x3F800000U | (Seed >> 9);
+            float Result;
+            std::memcpy(&Result, &Bits, sizeof(float));
+            return Result - 1.0f;
+        }
+    };
+
+    struct FDustState
+    {
+        FRandomStreamState Random;
+
+        // Toggle flag for polarity
+        bool bSignalIsPositive = true;
+    };
+
+    // Probability threshold for a single sample; an impulse fires when a uniform random value exceeds it
+    inline float DustThreshold(float Density, float DensityOffset)
+    {
+        const float AbsDensity = std::fabs(Density) + DensityOffset;
+        return 1.0f - AbsDensity * 0.0009f;
+    }
+
+    // Dust (Audio): writes unipolar or alternating impulses into OutputData
+    inline void ProcessDust(FDustState& State, const float* DensityData, float DensityOffset, bool bEnabled, bool bBiPolar, float* OutputData, int32_t NumFrames)
+    {
+        if (!bEnabled)
+        {
+            // Output zero when disabled
+            std::memset(OutputData, 0, sizeof(float) * NumFrames);
+            return;
+        }
+
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            const float Threshold = DustThreshold(DensityData[i], DensityOffset);
+
+            if (State.Random.GetFraction() > Threshold)
+            {
+                if (bBiPolar)
+                {
+                    OutputData[i] = State.bSignalIsPositive ? 1.0f : -1.0f;
+                    State.bSignalIsPositive = !State.bSignalIsPositive;
+                }
+                else
+                {
+                    OutputData[i] = 1.0f;
+                }
+            }
+            else
+            {
+                OutputData[i] = 0.0f;
+            }
+        }
+    }
+
+    // Dust (Trigger): calls OnTrigger(FrameIndex) for every frame that fires
+    template<typename OnTriggerType>
+    inline void ProcessDustTrigger(FRandomStreamState& Random, const float* DensityData, float DensityOffset, bool bEnabled, int32_t NumFrames, OnTriggerType&& OnTrigger)
+    {
+        if (!bEnabled)
+        {
+            return;
+        }
+
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            const float Threshold = DustThreshold(DensityData[i], DensityOffset);
+
+            if (Random.GetFraction() > Threshold)
+            {
+                OnTrigger(i);
+            }
+        }
+    }
+}
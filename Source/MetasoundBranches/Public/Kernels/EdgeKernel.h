@@ -0,0 +1,107 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+
+#include <algorithm>
+
+namespace MetasoundBranches::Kernels
+{
+    // Debounce length in samples, with the debounce time clamped to 1 ms - 5 s
+    inline int32_t DebounceSamplesFromSeconds(float DebounceTime, float SampleRate)
+    {
+        return RoundToInt(Clamp(DebounceTime, 0.001f, 5.0f) * SampleRate);
+    }
+
+    struct FEdgeState
+    {
+        float PreviousSignalValue = 0.0f;
+        bool bPreviousIsRising = false;
+        int32_t DebounceCounter = 0;
+    };
+
+    // Edge: calls OnRise(FrameIndex) / OnFall(FrameIndex) on changes of direction, ignoring changes inside the debounce window.
+    // The debounce window is skipped outright and the next change of direction is found with the dispatched search.
+    template<typename OnRiseType, typename OnFallType>
+    inline void ProcessEdge(FEdgeState& State, const float* SignalData, int32_t NumFrames, int32_t DebounceSamples, OnRiseType&& OnRise, OnFallType&& OnFall)
+    {
+        const FKernelTable& Kernels = GetKernelTable();
+
+        int32_t i = 0;
+        while (i < NumFrames)
+        {
+            // Nothing can fire until the counter has been decremented to zero
+            if (State.DebounceCounter > 1)
+            {
+                const int32_t SkipFrames = std::min(State.DebounceCounter - 1, NumFrames - i);
+                State.DebounceCounter -= SkipFrames;
+                i += SkipFrames;
+                State.PreviousSignalValue = SignalData[i - 1];
+                continue;
+            }
+
+            const int32_t ChangeFrame = Kernels.FindDirectionChange(SignalData, i, NumFrames, State.PreviousSignalValue, State.bPreviousIsRising);
+            if (ChangeFrame == NumFrames)
+            {
+                State.DebounceCounter = 0;
+                State.PreviousSignalValue = SignalData[NumFrames - 1];
+                break;
+            }
+
+            if (State.bPreviousIsRising)
+            {
+                OnFall(ChangeFrame);
+            }
+            else
+            {
+                OnRise(ChangeFrame);
+            }
+
+            State.DebounceCounter = DebounceSamples;
+            State.bPreviousIsRising = !State.bPreviousIsRising;
+            State.PreviousSignalValue = SignalData[ChangeFrame];
+            i = ChangeFrame + 1;
+        }
+    }
+
+    struct FZeroCrossingState
+    {
+        float PreviousSignalValue = 0.0f;
+        int32_t DebounceCounter = 0;
+    };
+
+    // Zero Crossing: calls OnCrossing(FrameIndex) when the signal moves from <= 0 to > 0 or from >= 0 to < 0
+    template<typename OnCrossingType>
+    inline void ProcessZeroCrossing(FZeroCrossingState& State, const float* SignalData, int32_t NumFrames, int32_t DebounceSamples, OnCrossingType&& OnCrossing)
+    {
+        const FKernelTable& Kernels = GetKernelTable();
+
+        int32_t i = 0;
+        while (i < NumFrames)
+        {
+            if (State.DebounceCounter > 1)
+            {
+                const int32_t SkipFrames = std::min(State.DebounceCounter - 1, NumFrames - i);
+                State.DebounceCounter -= SkipFrames;
+                i += SkipFrames;
+                State.PreviousSignalValue = SignalData[i - 1];
+                continue;
+            }
+
+            const int32_t CrossingFrame = Kernels.FindZeroCrossing(SignalData, i, NumFrames, State.PreviousSignalValue);
+            if (CrossingFrame == NumFrames)
+            {
+                State.DebounceCounter = 0;
+                State.PreviousSignalValue = SignalData[NumFrames - 1];
+                break;
+            }
+
+            OnCrossing(CrossingFrame);
+            State.DebounceCounter = DebounceSamples;
+            State.PreviousSignalValue = SignalData[CrossingFrame];
+            i = CrossingFrame + 1;
+        }
+    }
+}
@@ -0,0 +1,186 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Real-input FFT of a fixed power-of-two size, for the partitioned convolution in ConvolutionKernel.h.
+//
+// A real sequence of Size samples is packed into Size / 2 complex values (even samples real, odd samples imaginary),
+// run through an iterative radix-2 complex FFT and then split into the Size / 2 + 1 bins of the real spectrum.
+// Spectra are stored as separate real and imaginary arrays so the butterflies and the convolution's complex
+// multiply-adds run over contiguous floats. The tables are built once by the constructor; transforms allocate
+// nothing and keep their working buffers on the stack.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+namespace MetasoundBranches::Kernels
+{
+    template<int32_t Size>
+    class TRealFft
+    {
+        static_assert(Size >= 8 && (Size & (Size - 1)) == 0, "The FFT size must be a power of two of at least 8");
+
+    public:
+        static constexpr int32_t NumBins = Size / 2 + 1;
+
+        TRealFft()
+        {
+            for (int32_t Index = 0; Index < HalfSize; ++Index)
+            {
+                int32_t Reversed = 0;
+                for (int32_t Bit = 1, ReversedBit = HalfSize >> 1; Bit < HalfSize; Bit <<= 1, ReversedBit >>= 1)
+                {
+                    Reversed |= (Index & Bit) ? ReversedBit : 0;
+                }
+                BitReverse[Index] = Reversed;
+            }
+
+            // Stage with butterflies Half apart uses exp(-2 pi i j / (2 * Half)) for j < Half, stored at [Half - 1 + j]
+            // (the first two stages don't read theirs)
+            for (int32_t Half = 1; Half < HalfSize; Half <<= 1)
+            {
+                for (int32_t j = 0; j < Half; ++j)
+                {
+                    const double Angle = -Pi64 * j / Half;
+                    TwiddleReal[Half - 1 + j] = static_cast<float>(std::cos(Angle));
+                    TwiddleImag[Half - 1 + j] = static_cast<float>(std::sin(Angle));
+                }
+            }
+
+            // exp(-2 pi i k / Size), which recombines the even and odd halves
+            for (int32_t k = 0; k < HalfSize; ++k)
+            {
+                const double Angle = -2.0 * Pi64 * k / Size;
+                SplitReal[k] = static_cast<float>(std::cos(Angle));
+                SplitImag[k] = static_cast<float>(std::sin(Angle));
+            }
+        }
+
+        // Spectrum of Size real samples into NumBins bins, unscaled
+        void Forward(const float* InputData, float* OutReal, float* OutImag) const
+        {
+            float Real[HalfSize];
+            float Imag[HalfSize];
+
+            for (int32_t n = 0; n < HalfSize; ++n)
+            {
+                Real[BitReverse[n]] = InputData[2 * n];
+                Imag[BitReverse[n]] = InputData[2 * n + 1];
+            }
+
+            Transform(Real, Imag);
+
+            OutReal[0] = Real[0] + Imag[0];
+            OutImag[0] = 0.0f;
+            OutReal[HalfSize] = Real[0] - Imag[0];
+            OutImag[HalfSize] = 0.0f;
+
+            // X[k] = E[k] + W^k O[k], with E and O the spectra of the even and odd samples:
+            // E[k] = (Z[k] + conj(Z[H - k])) / 2, O[k] = (Z[k] - conj(Z[H - k])) / 2i
+            for (int32_t k = 1; k < HalfSize; ++k)
+            {
+                const float EvenReal = 0.5f * (Real[k] + Real[HalfSize - k]);
+                const float EvenImag = 0.5f * (Imag[k] - Imag[HalfSize - k]);
+                const float OddReal = 0.5f * (Imag[k] + Imag[HalfSize - k]);
+                const float OddImag = 0.5f * (Real[HalfSize - k] - Real[k]);
+
+                OutReal[k] = EvenReal + (SplitReal[k] * OddReal - SplitImag[k] * OddImag);
+                OutImag[k] = EvenImag + (SplitReal[k] * OddImag + SplitImag[k] * OddReal);
+            }
+        }
+
+        // Size real samples from NumBins bins of a real signal's spectrum, scaled up by Size (no 1 / Size)
+        void Inverse(const float* InReal, const float* InImag, float* OutputData) const
+        {
+            float Real[HalfSize];
+            float Imag[HalfSize];
+
+            // Z[k] = 2 E[k] + 2i O[k] with E[k] = (X[k] + conj(X[H - k])) / 2 and O[k] = (X[k] - conj(X[H - k])) / 2W^k,
+            // loaded conjugated and bit reversed so the forward transform computes the inverse
+            for (int32_t k = 0; k < HalfSize; ++k)
+            {
+                const float SumReal = InReal[k] + InReal[HalfSize - k];
+                const float SumImag = InImag[k] - InImag[HalfSize - k];
+                const float DiffReal = InReal[k] - InReal[HalfSize - k];
+                const float DiffImag = InImag[k] + InImag[HalfSize - k];
+
+                // (Diff / W^k) = Diff * conj(W^k)
+                const float OddReal = DiffReal * SplitReal[k] + DiffImag * SplitImag[k];
+                const float OddImag = DiffImag * SplitReal[k] - DiffReal * SplitImag[k];
+
+                Real[BitReverse[k]] = SumReal - OddImag;
+                Imag[BitReverse[k]] = -(SumImag + OddReal);
+            }
+
+            Transform(Real, Imag);
+
+            for (int32_t n = 0; n < HalfSize; ++n)
+            {
+                OutputData[2 * n] = Real[n];
+                OutputData[2 * n + 1] = -Imag[n];
+            }
+        }
+
+    private:
+        static constexpr int32_t HalfSize = Size / 2;
+        static constexpr double Pi64 = 3.14159265358979323846;
+
+        // In-place forward complex FFT of bit-reversed input
+        void Transform(float* Real, float* Imag) const
+        {
+            // The first two stages together, as radix-4 butterflies whose twiddles are 1 and -i
+            for (int32_t Start = 0; Start < HalfSize; Start += 4)
+            {
+                float* R = Real + Start;
+                float* I = Imag + Start;
+
+                const float SumReal01 = R[0] + R[1], SumImag01 = I[0] + I[1];
+                const float DiffReal01 = R[0] - R[1], DiffImag01 = I[0] - I[1];
+                const float SumReal23 = R[2] + R[3], SumImag23 = I[2] + I[3];
+                const float DiffReal23 = R[2] - R[3], DiffImag23 = I[2] - I[3];
+
+                R[0] = SumReal01 + SumReal23;
+                I[0] = SumImag01 + SumImag23;
+                R[2] = SumReal01 - SumReal23;
+                I[2] = SumImag01 - SumImag23;
+
+                // -i * (DiffReal23 + i DiffImag23) = DiffImag23 - i DiffReal23
+                R[1] = DiffReal01 + DiffImag23;
+                I[1] = DiffImag01 - DiffReal23;
+                R[3] = DiffReal01 - DiffImag23;
+                I[3] = DiffImag01 + DiffReal23;
+            }
+
+            // The rest have at least four butterflies per group, which the compiler vectorizes
+            for (int32_t Half = 4; Half < HalfSize; Half <<= 1)
+            {
+                const float* StageReal = TwiddleReal + Half - 1;
+                const float* StageImag = TwiddleImag + Half - 1;
+
+                for (int32_t Start = 0; Start < HalfSize; Start += 2 * Half)
+                {
+                    float* TopReal = Real + Start;
+                    float* TopImag = Imag + Start;
+                    float* BottomReal = TopReal + Half;
+                    float* BottomImag = TopImag + Half;
+
+                    for (int32_t j = 0; j < Half; ++j)
+                    {
+                        const float ProductReal = BottomReal[j] * StageReal[j] - BottomImag[j] * StageImag[j];
+                        const float ProductImag = BottomReal[j] * StageImag[j] + BottomImag[j] * StageReal[j];
+
+                        BottomReal[j] = TopReal[j] - ProductReal;
+                        BottomImag[j] = TopImag[j] - ProductImag;
+                        TopReal[j] = TopReal[j] + ProductReal;
+                        TopImag[j] = TopImag[j] + ProductImag;
+                    }
+                }
+            }
+        }
+
+        int32_t BitReverse[HalfSize];
+        float TwiddleReal[HalfSize];
+        float TwiddleImag[HalfSize];
+        float SplitReal[HalfSize];
+        float SplitImag[HalfSize];
+    };
+}
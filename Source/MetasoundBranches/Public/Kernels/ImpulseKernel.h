@@ -0,0 +1,27 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+namespace MetasoundBranches::Kernels
+{
+    struct FImpulseState
+    {
+        // Toggle flag for polarity
+        bool bSignalIsPositive = true;
+    };
+
+    // Value of the next impulse; alternates sign on each call in bipolar mode
+    inline float NextImpulseValue(FImpulseState& State, bool bBiPolar)
+    {
+        if (!bBiPolar)
+        {
+            return 1.0f;
+        }
+
+        const float Value = State.bSignalIsPositive ? 1.0f : -1.0f;
+        State.bSignalIsPositive = !State.bSignalIsPositive;
+        return Value;
+    }
+}
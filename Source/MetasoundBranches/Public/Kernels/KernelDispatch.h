@@ -0,0 +1,133 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Runtime selection of the vectorized kernels.
+//
+// InitializeKernelDispatch() picks the most capable implementation once at module startup; the kernels in
+// StereoKernels.h, MultichannelKernels.h, StereoMeterKernel.h, RouterKernels.h, AllPassKernel.h, ConvolutionKernel.h,
+// DispersionKernel.h, SahKernel.h, EdgeKernel.h and BlockAnalysis.h then call through GetKernelTable(). Every
+// implementation is bit-identical with the Scalar one, so switching at runtime (au.Branches.Simd) only changes the
+// cost of running nodes. The one choice made from the kernel level is the Phase Disperser's automatic mode, which
+// picks recursion or convolution by their cost when a node starts or resets (ResetAllPassDisperser()). Running
+// nodes keep the mode they have; nodes started after a switch, or on another CPU, may pick the other one, which
+// agrees with it to within about -120 dB but not bit for bit.
+
+#include "MetasoundBranches/Public/Kernels/KernelIsa.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsScalar.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsSse2.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsAvx2.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsAvx512.h"
+
+#include <atomic>
+
+namespace MetasoundBranches::Kernels
+{
+    struct FKernelTable
+    {
+        EKernelIsa Isa;
+
+        void (*ProcessStereoGains)(const float*, const float*, float, float, float*, float*, int32_t);
+        void (*ProcessStereoSwapGains)(const float*, const float*, float, float, float*, float*, int32_t);
+        void (*ProcessStereoWidth)(const float*, const float*, float, float*, float*, int32_t);
+        void (*ProcessStereoMix)(const float*, const float*, float, const float*, const float*, float, float*, float*, int32_t);
+        void (*ProcessStereoAccumulate)(const float*, const float*, float*, float*, int32_t);
+
+        void (*ProcessStereoGainsRamp)(const float*, const float*, float, float, float, float, float*, float*, int32_t, int32_t);
+        void (*ProcessStereoWidthRamp)(const float*, const float*, float, float, float*, float*, int32_t, int32_t);
+        void (*ProcessStereoMixRamp)(const float*, const float*, float, float, const float*, const float*, float, float, float*, float*, int32_t, int32_t);
+        void (*ProcessStereoMatrix)(const float*, const float*, bool, FRamp, FRamp, FRamp, FRamp, float*, float*, int32_t, int32_t);
+
+        void (*ProcessStereoBalanceAudio)(const float*, const float*, const float*, const float*, float*, float*, int32_t);
+        void (*ProcessStereoCrossfadeAudio)(const float*, const float*, const float*, const float*, const float*, const float*, float*, float*, int32_t);
+
+        void (*ProcessMultichannelWidthRamp)(const float* const*, float* const*, int32_t, float, float, int32_t, int32_t);
+
+        FStereoSums (*AccumulateStereoSums)(const float*, const float*, int32_t);
+
+        void (*ProcessAllPassStages)(float*, float*, const float*, int32_t, float*, int32_t);
+        void (*ProcessMultichannelAllPassStages)(float*, float*, const float*, int32_t, int32_t, float* const*, int32_t);
+        void (*ProcessAllPassSections)(float*, float*, const float*, const float*, int32_t, float*, int32_t);
+        void (*SumSpectrumProducts)(const float* const*, const float* const*, const float*, const float*, int32_t, int32_t, float*, float*, int32_t, int32_t);
+
+        int32_t (*FindRisingCrossing)(const float*, int32_t, int32_t, float, float);
+        int32_t (*FindDirectionChange)(const float*, int32_t, int32_t, float, bool);
+        int32_t (*FindZeroCrossing)(const float*, int32_t, int32_t, float);
+        int32_t (*FindNotEqual)(const float*, int32_t, int32_t, float);
+    };
+
+    namespace DispatchPrivate
+    {
+#define BRANCHES_KERNEL_TABLE(IsaName, Namespace) \
+        FKernelTable { EKernelIsa::IsaName, &Namespace::ProcessStereoGains, &Namespace::ProcessStereoSwapGains, &Namespace::ProcessStereoWidth, &Namespace::ProcessStereoMix, &Namespace::ProcessStereoAccumulate, \
+            &Namespace::ProcessStereoGainsRamp, &Namespace::ProcessStereoWidthRamp, &Namespace::ProcessStereoMixRamp, &Namespace::ProcessStereoMatrix, \
+            &Namespace::ProcessStereoBalanceAudio, &Namespace::ProcessStereoCrossfadeAudio, &Namespace::ProcessMultichannelWidthRamp, \
+            &Namespace::AccumulateStereoSums, &Namespace::ProcessAllPassStages, &Namespace::ProcessMultichannelAllPassStages, \
+            &Namespace::ProcessAllPassSections, &Namespace::SumSpectrumProducts, \
+            &Namespace::FindRisingCrossing, &Namespace::FindDirectionChange, &Namespace::FindZeroCrossing, &Namespace::FindNotEqual }
+
+        inline constexpr FKernelTable ScalarTable = BRANCHES_KERNEL_TABLE(Scalar, Scalar);
+#if BRANCHES_KERNELS_X86
+        inline constexpr FKernelTable Sse2Table = BRANCHES_KERNEL_TABLE(SSE2, Sse2);
+        // Nothing in these kernels benefits from SSE4.1 over SSE2, so that level shares the SSE2 implementations
+        inline constexpr FKernelTable Sse41Table = BRANCHES_KERNEL_TABLE(SSE41, Sse2);
+        inline constexpr FKernelTable Avx2Table = BRANCHES_KERNEL_TABLE(AVX2, Avx2);
+        inline constexpr FKernelTable Avx512Table = BRANCHES_KERNEL_TABLE(AVX512, Avx512);
+#endif
+
+#undef BRANCHES_KERNEL_TABLE
+
+        inline std::atomic<const FKernelTable*> ActiveTable { &ScalarTable };
+
+        inline const FKernelTable& GetTable(EKernelIsa Isa)
+        {
+            switch (Isa)
+            {
+#if BRANCHES_KERNELS_X86
+            case EKernelIsa::SSE2:
+                return Sse2Table;
+            case EKernelIsa::SSE41:
+                return Sse41Table;
+            case EKernelIsa::AVX2:
+                return Avx2Table;
+            case EKernelIsa::AVX512:
+                return Avx512Table;
+#endif
+            default:
+                return ScalarTable;
+            }
+        }
+    }
+
+    inline const FKernelTable& GetKernelTable()
+    {
+        return *DispatchPrivate::ActiveTable.load(std::memory_order_relaxed);
+    }
+
+    inline EKernelIsa GetActiveKernelIsa()
+    {
+        return GetKernelTable().Isa;
+    }
+
+    // DetectKernelIsa(), run once
+    inline EKernelIsa GetDetectedKernelIsa()
+    {
+        static const EKernelIsa DetectedIsa = DetectKernelIsa();
+        return DetectedIsa;
+    }
+
+    // Selects the kernels for Isa, clamped to what this machine supports; returns the level actually selected
+    inline EKernelIsa SetKernelIsa(EKernelIsa Isa)
+    {
+        const EKernelIsa DetectedIsa = GetDetectedKernelIsa();
+        const EKernelIsa SelectedIsa = static_cast<int32_t>(Isa) < static_cast<int32_t>(DetectedIsa) ? Isa : DetectedIsa;
+        DispatchPrivate::ActiveTable.store(&DispatchPrivate::GetTable(SelectedIsa), std::memory_order_relaxed);
+        return SelectedIsa;
+    }
+
+    // Selects the most capable kernels, or the scalar ones when bForceScalar is set
+    inline EKernelIsa InitializeKernelDispatch(bool bForceScalar = false)
+    {
+        return SetKernelIsa(bForceScalar ? EKernelIsa::Scalar : EKernelIsa::AVX512);
+    }
+}
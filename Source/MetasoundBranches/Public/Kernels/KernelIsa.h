@@ -0,0 +1,168 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Instruction set detection for the vectorized kernels.
+//
+// The plugin is compiled for the baseline ISA of each platform, so the SSE4.1 / AVX2 / AVX-512 kernels are
+// compiled per function with target attributes and only called after DetectKernelIsa() has confirmed that both
+// the CPU and the OS support them.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BRANCHES_KERNELS_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#else
+#define BRANCHES_KERNELS_X86 0
+#endif
+
+// MSVC allows any intrinsic in any function; GCC and Clang need the target enabled per function
+#if BRANCHES_KERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+#define BRANCHES_KERNELS_TARGET_SSE2 __attribute__((target("sse2")))
+#define BRANCHES_KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#define BRANCHES_KERNELS_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define BRANCHES_KERNELS_TARGET_SSE2
+#define BRANCHES_KERNELS_TARGET_AVX2
+#define BRANCHES_KERNELS_TARGET_AVX512
+#endif
+
+namespace MetasoundBranches::Kernels
+{
+    // Ordered from least to most capable
+    enum class EKernelIsa : int32_t
+    {
+        Scalar,
+        SSE2,
+        SSE41,
+        AVX2,
+        AVX512,
+        Count
+    };
+
+    inline const char* GetKernelIsaName(EKernelIsa Isa)
+    {
+        switch (Isa)
+        {
+        case EKernelIsa::SSE2:
+            return "SSE2";
+        case EKernelIsa::SSE41:
+            return "SSE4.1";
+        case EKernelIsa::AVX2:
+            return "AVX2";
+        case EKernelIsa::AVX512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+        }
+    }
+
+    // Most capable instruction set usable on this machine
+    inline EKernelIsa DetectKernelIsa()
+    {
+#if BRANCHES_KERNELS_X86
+        uint32_t Leaf1[4] = {};
+        uint32_t Leaf7[4] = {};
+        uint32_t MaxLeaf = 0;
+
+#if defined(_MSC_VER) && !defined(__clang__)
+        int Registers[4];
+        __cpuid(Registers, 0);
+        MaxLeaf = static_cast<uint32_t>(Registers[0]);
+        __cpuid(Registers, 1);
+        for (int32_t Index = 0; Index < 4; ++Index)
+        {
+            Leaf1[Index] = static_cast<uint32_t>(Registers[Index]);
+        }
+        if (MaxLeaf >= 7)
+        {
+            __cpuidex(Registers, 7, 0);
+            for (int32_t Index = 0; Index < 4; ++Index)
+            {
+                Leaf7[Index] = static_cast<uint32_t>(Registers[Index]);
+            }
+        }
+#else
+        MaxLeaf = __get_cpuid_max(0, nullptr);
+        __cpuid(1, Leaf1[0], Leaf1[1], Leaf1[2], Leaf1[3]);
+        if (MaxLeaf >= 7)
+        {
+            __cpuid_count(7, 0, Leaf7[0], Leaf7[1], Leaf7[2], Leaf7[3]);
+        }
+#endif
+
+        const bool bSse2 = (Leaf1[3] & (1u << 26)) != 0;
+        const bool bSse41 = (Leaf1[2] & (1u << 19)) != 0;
+        const bool bOsxsave = (Leaf1[2] & (1u << 27)) != 0;
+        const bool bAvx = (Leaf1[2] & (1u << 28)) != 0;
+        const bool bAvx2 = (Leaf7[1] & (1u << 5)) != 0;
+        const bool bAvx512F = (Leaf7[1] & (1u << 16)) != 0;
+
+        // The OS has to save the YMM / ZMM registers on context switches as well
+        uint64_t EnabledState = 0;
+        if (bOsxsave)
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            EnabledState = _xgetbv(0);
+#else
+            uint32_t Low = 0;
+            uint32_t High = 0;
+            __asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+            EnabledState = (static_cast<uint64_t>(High) << 32) | Low;
+#endif
+        }
+
+        const bool bOsAvx = (EnabledState & 0x6) == 0x6;
+        const bool bOsAvx512 = (EnabledState & 0xE6) == 0xE6;
+
+        if (bAvx512F && bAvx2 && bOsAvx512)
+        {
+            return EKernelIsa::AVX512;
+        }
+        if (bAvx && bAvx2 && bOsAvx)
+        {
+            return EKernelIsa::AVX2;
+        }
+        if (bSse41)
+        {
+            return EKernelIsa::SSE41;
+        }
+        if (bSse2)
+        {
+            return EKernelIsa::SSE2;
+        }
+#endif
+        return EKernelIsa::Scalar;
+    }
+
+    // Index of the lowest set bit; Mask must not be zero
+    inline int32_t CountTrailingZeros(uint32_t Mask)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long Index = 0;
+        _BitScanForward(&Index, Mask);
+        return static_cast<int32_t>(Index);
+#else
+        return __builtin_ctz(Mask);
+#endif
+    }
+
+    // Number of leading frames to process one at a time so that Output reaches the given byte alignment
+    inline int32_t GetPeelFrames(const float* Output, int32_t NumFrames, uintptr_t Alignment)
+    {
+        const uintptr_t Misalignment = reinterpret_cast<uintptr_t>(Output) & (Alignment - 1);
+        if (Misalignment == 0 || (Misalignment % sizeof(float)) != 0)
+        {
+            return 0;
+        }
+
+        const int32_t PeelFrames = static_cast<int32_t>((Alignment - Misalignment) / sizeof(float));
+        return PeelFrames < NumFrames ? PeelFrames : NumFrames;
+    }
+}
@@ -0,0 +1,68 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Multichannel versions of Stereo Gain, Stereo Inverter and Stereo Width, for any number of channels. Channels are
+// passed as arrays of buffer pointers. Gain and the inverter run the stereo kernels over consecutive pairs of
+// channels, with an odd last channel paired with itself; width mixes every channel, so it has its own kernel.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+
+namespace MetasoundBranches::Kernels
+{
+    // Second channel of the pair starting at Channel
+    inline int32_t GetPairedChannel(int32_t Channel, int32_t NumChannels)
+    {
+        return Channel + 1 < NumChannels ? Channel + 1 : Channel;
+    }
+
+    // One gain for every channel, ramped from InOutGain as by ProcessStereoGainsRamped()
+    inline void ProcessMultichannelGainRamped(float& InOutGain, float Gain, const float* const* InputData, float* const* OutputData, int32_t NumChannels, int32_t NumFrames)
+    {
+        const FKernelTable& Kernels = GetKernelTable();
+        const bool bRamp = ShouldRamp(InOutGain, Gain);
+        const float GainStep = bRamp ? GetRampStep(InOutGain, Gain, NumFrames) : 0.0f;
+
+        for (int32_t Channel = 0; Channel < NumChannels; Channel += 2)
+        {
+            const int32_t Paired = GetPairedChannel(Channel, NumChannels);
+
+            if (bRamp)
+            {
+                Kernels.ProcessStereoGainsRamp(InputData[Channel], InputData[Paired], InOutGain, GainStep, InOutGain, GainStep, OutputData[Channel], OutputData[Paired], 0, NumFrames);
+            }
+            else
+            {
+                Kernels.ProcessStereoGains(InputData[Channel], InputData[Paired], Gain, Gain, OutputData[Channel], OutputData[Paired], NumFrames);
+            }
+        }
+
+        InOutGain = Gain;
+    }
+
+    // Output channel c takes input channel Sources[c] (already in range), inverted where bit c of InvertMask is set.
+    // Sources may repeat channels. The outputs must not be the inputs.
+    inline void ProcessMultichannelInverter(const float* const* InputData, const int32_t* Sources, uint32_t InvertMask, float* const* OutputData, int32_t NumChannels, int32_t NumFrames)
+    {
+        for (int32_t Channel = 0; Channel < NumChannels; Channel += 2)
+        {
+            const int32_t Paired = GetPairedChannel(Channel, NumChannels);
+            const float Multiplier = (InvertMask >> Channel) & 1u ? -1.0f : 1.0f;
+            const float PairedMultiplier = (InvertMask >> Paired) & 1u ? -1.0f : 1.0f;
+
+            ProcessStereoGains(InputData[Sources[Channel]], InputData[Sources[Paired]], Multiplier, PairedMultiplier, OutputData[Channel], OutputData[Paired], NumFrames);
+        }
+    }
+
+    // Width across all channels, Width in [0, 2]; ramped from InOutWidth as by ProcessStereoWidthRamped(). With two
+    // channels this is Stereo Width up to rounding.
+    inline void ProcessMultichannelWidthRamped(float& InOutWidth, float Width, const float* const* InputData, float* const* OutputData, int32_t NumChannels, int32_t NumFrames)
+    {
+        const float WidthFactor = Clamp(Width, 0.0f, 2.0f);
+        const FRamp WidthRamp = MakeRamp(InOutWidth, WidthFactor, NumFrames);
+
+        GetKernelTable().ProcessMultichannelWidthRamp(InputData, OutputData, NumChannels, WidthRamp.Start, WidthRamp.Step, 0, NumFrames);
+    }
+}
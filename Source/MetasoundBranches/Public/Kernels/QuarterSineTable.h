@@ -0,0 +1,43 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Shared table for audio-rate equal-power gains.
+//
+// sin(x * pi / 2) for x in [0, 1], so the pair of equal-power gains at position x is the table read at 1 - x and at x.
+// The table is immutable once built and shared by every instance; the module builds it at startup so no audio thread
+// pays for it. Interpolating linearly between 1024 intervals keeps the gains within about 4e-7 of the trigonometric
+// ones (-127 dB), and both ends are exact.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+namespace MetasoundBranches::Kernels
+{
+    constexpr int32_t QuarterSineTableSize = 1024;
+
+    struct FQuarterSineTable
+    {
+        // QuarterSineTableSize + 1 points, plus a copy of the last so interpolating at x = 1 reads in bounds
+        float Values[QuarterSineTableSize + 2];
+    };
+
+    inline FQuarterSineTable MakeQuarterSineTable()
+    {
+        FQuarterSineTable Table;
+        for (int32_t i = 0; i < QuarterSineTableSize; ++i)
+        {
+            Table.Values[i] = static_cast<float>(std::sin(static_cast<double>(i) / QuarterSineTableSize * 1.57079632679489661923));
+        }
+
+        Table.Values[QuarterSineTableSize] = 1.0f;
+        Table.Values[QuarterSineTableSize + 1] = 1.0f;
+        return Table;
+    }
+
+    // Built on first use; the module calls this at startup
+    inline const FQuarterSineTable& GetQuarterSineTable()
+    {
+        static const FQuarterSineTable Table = MakeQuarterSineTable();
+        return Table;
+    }
+}
@@ -0,0 +1,172 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Table rebuilds off the audio thread.
+//
+// A node whose tables depend on its inputs keeps them in a TRebuildSlot. The audio thread posts new parameters with
+// Request() and calls Acquire() at the start of every block. It keeps rendering with the table it has until a
+// rebuilt one is ready, so Execute() never builds, allocates or frees a table. The rebuilds run on a worker thread
+// behind IRebuildScheduler, which checks every few milliseconds whether a slot has flagged work: the plugin's is an
+// FRunnable shared by every node (MetasoundBranchesRebuildWorker.h), and the standalone tools have a std::thread one
+// of their own.
+//
+// The audio thread never waits for the worker, takes a lock or signals an event: it only touches atomics.
+// Parameters reach the worker through a triple buffer, and tables come back through two atomic pointers: Pending,
+// built but not yet picked up, and Retired, no longer in use. Tables are freed only by the worker or the slot's
+// destructor. The audio thread retires a table only once the worker has freed the one retired before it, so a slot
+// never holds more than four tables.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+#include <atomic>
+
+namespace MetasoundBranches::Kernels
+{
+    // Work the rebuild worker runs whenever a slot has flagged some
+    class IRebuildTask
+    {
+    public:
+        virtual ~IRebuildTask() = default;
+
+        // Called on the worker thread only
+        virtual void RunRebuild() = 0;
+    };
+
+    // Runs the registered tasks on a worker thread once work is flagged. Tasks are run without holding the lock
+    // Register() and Unregister() take, so those only ever wait for the rebuild of the task they are given.
+    class IRebuildScheduler
+    {
+    public:
+        virtual ~IRebuildScheduler() = default;
+
+        virtual void Register(IRebuildTask* Task) = 0;
+
+        // Waits for the task's rebuild if one is running, so the task can be destroyed as soon as this returns
+        virtual void Unregister(IRebuildTask* Task) = 0;
+
+        // Audio thread: has the worker run the registered tasks on its next poll. Only sets an atomic flag.
+        virtual void FlagWork() = 0;
+    };
+
+    // Tables of type TTable built from parameters of type TParams by Build, which runs on the worker. TParams is
+    // copied between threads, so it should be a small plain struct. Construction and destruction take the scheduler's
+    // lock and aren't for the audio thread's Execute(); Request(), Acquire() and the getters are.
+    template<typename TParams, typename TTable>
+    class TRebuildSlot final : private IRebuildTask
+    {
+    public:
+        using FBuildFunction = TTable (*)(const TParams&);
+
+        // Builds the first table here, so Get() is valid from the start. Scheduler must outlive the slot.
+        TRebuildSlot(IRebuildScheduler& InScheduler, FBuildFunction InBuild, const TParams& InitialParams)
+            : Scheduler(InScheduler)
+            , Build(InBuild)
+            , Current(new TTable(InBuild(InitialParams)))
+        {
+            Scheduler.Register(this);
+        }
+
+        ~TRebuildSlot()
+        {
+            Scheduler.Unregister(this);
+
+            delete Current;
+            delete Replaced;
+            delete Pending.load();
+            delete Retired.load();
+        }
+
+        TRebuildSlot(const TRebuildSlot&) = delete;
+        TRebuildSlot& operator=(const TRebuildSlot&) = delete;
+
+        // Audio thread: asks for a table built from Params. Only the latest request counts; ones the worker hasn't
+        // reached yet are dropped.
+        void Request(const TParams& Params)
+        {
+            Buffers[BackIndex] = Params;
+            BackIndex = Middle.exchange(BackIndex | FreshFlag, std::memory_order_acq_rel) & IndexMask;
+            Scheduler.FlagWork();
+        }
+
+        // Audio thread, at the start of a block: picks up the latest rebuilt table, if there is one. When it returns
+        // true, GetReplaced() is the table Get() was until now, still valid for this block (to crossfade from).
+        bool Acquire()
+        {
+            if (Replaced != nullptr)
+            {
+                if (Retired.load(std::memory_order_acquire) != nullptr)
+                {
+                    // The worker hasn't freed the last retired table yet; try again next block
+                    return false;
+                }
+
+                Retired.store(Replaced, std::memory_order_release);
+                Replaced = nullptr;
+
+                // So the worker frees it
+                Scheduler.FlagWork();
+            }
+
+            TTable* Rebuilt = Pending.exchange(nullptr, std::memory_order_acq_rel);
+            if (Rebuilt == nullptr)
+            {
+                return false;
+            }
+
+            Replaced = Current;
+            Current = Rebuilt;
+            return true;
+        }
+
+        // Audio thread: the table in use
+        const TTable& Get() const
+        {
+            return *Current;
+        }
+
+        // Audio thread: the table the last successful Acquire() replaced, until the next Acquire()
+        const TTable* GetReplaced() const
+        {
+            return Replaced;
+        }
+
+    private:
+        static constexpr uint32_t IndexMask = 3u;
+        static constexpr uint32_t FreshFlag = 4u;
+
+        virtual void RunRebuild() override
+        {
+            delete Retired.exchange(nullptr, std::memory_order_acq_rel);
+
+            if ((Middle.load(std::memory_order_acquire) & FreshFlag) == 0)
+            {
+                return;
+            }
+
+            FrontIndex = Middle.exchange(FrontIndex, std::memory_order_acq_rel) & IndexMask;
+            TTable* Rebuilt = new TTable(Build(Buffers[FrontIndex]));
+
+            // A table the audio thread never picked up was never used, so it can go straight away
+            delete Pending.exchange(Rebuilt, std::memory_order_acq_rel);
+        }
+
+        IRebuildScheduler& Scheduler;
+        FBuildFunction Build;
+
+        // Triple buffer of requested parameters: the audio thread writes Buffers[BackIndex], the worker reads
+        // Buffers[FrontIndex], and Middle holds the third index, flagged when it is newer than the worker's
+        TParams Buffers[3] = {};
+        uint32_t BackIndex = 0;
+        uint32_t FrontIndex = 1;
+        std::atomic<uint32_t> Middle { 2 };
+
+        // Owned by the audio thread
+        TTable* Current = nullptr;
+        TTable* Replaced = nullptr;
+
+        // Handed from the worker to the audio thread, and back
+        std::atomic<TTable*> Pending { nullptr };
+        std::atomic<TTable*> Retired { nullptr };
+    };
+}
@@ -0,0 +1,187 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Sparse stereo routing: N stereo inputs to M stereo outputs through a gain matrix.
+//
+// The matrix is turned into a list of nonzero routes per output whenever it changes, so a block costs one pass per
+// active route whatever the size of the matrix. The first route into an output writes it and the rest add on top;
+// unity routes take a plain copy or add, and outputs with no routes are cleared once and then left alone.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/StereoKernels.h"
+
+#include <cstring>
+
+namespace MetasoundBranches::Kernels
+{
+    constexpr int32_t MaxRouterChannels = 8;
+    constexpr int32_t MaxRouterGains = MaxRouterChannels * MaxRouterChannels;
+
+    // One input feeding an output, with its gain across the block
+    struct FStereoRoute
+    {
+        int32_t Input = 0;
+        FRamp Gain;
+    };
+
+    struct FStereoRouterState
+    {
+        // Gain matrix as last requested, to spot changes without rebuilding the routes
+        float Requested[MaxRouterGains] = {};
+        int32_t NumRequested = 0;
+
+        // Gains reached at the end of the last block, by output then input
+        float Gains[MaxRouterChannels][MaxRouterChannels] = {};
+
+        // Routes into each output in input order
+        FStereoRoute Routes[MaxRouterChannels][MaxRouterChannels];
+        int32_t NumRoutes[MaxRouterChannels] = {};
+
+        // Some route ramps this block, so the routes are rebuilt as held gains for the next one
+        bool bRamping = false;
+
+        // The routes haven't been built yet
+        bool bDirty = true;
+
+        // The output holds silence from an earlier block
+        bool bOutputSilent[MaxRouterChannels] = {};
+    };
+
+    // Gain matrix entry for Input into Output; the matrix is stored by output, so each row lists what one output
+    // takes from every input
+    inline int32_t GetRouterGainIndex(int32_t Input, int32_t Output, int32_t NumInputs)
+    {
+        return Output * NumInputs + Input;
+    }
+
+    // Brings the routes up to date with Gains (NumGains entries, missing entries taken as zero). Changed gains ramp
+    // across the block, a route fading out staying active until it reaches zero. Does nothing while the matrix and
+    // the routes are settled.
+    inline void UpdateStereoRoutes(FStereoRouterState& State, const float* Gains, int32_t NumGains, int32_t NumInputs, int32_t NumOutputs, int32_t NumFrames)
+    {
+        NumGains = NumGains < NumInputs * NumOutputs ? NumGains : NumInputs * NumOutputs;
+
+        // Compared bitwise, so a NaN gain that stays put doesn't count as a change
+        const bool bUnchanged = NumGains == State.NumRequested && (NumGains == 0 || std::memcmp(Gains, State.Requested, sizeof(float) * NumGains) == 0);
+        if (bUnchanged && !State.bRamping && !State.bDirty)
+        {
+            return;
+        }
+
+        if (NumGains > 0)
+        {
+            std::memcpy(State.Requested, Gains, sizeof(float) * NumGains);
+        }
+        State.NumRequested = NumGains;
+        State.bRamping = false;
+        State.bDirty = false;
+
+        for (int32_t Output = 0; Output < NumOutputs; ++Output)
+        {
+            int32_t NumRoutes = 0;
+
+            for (int32_t Input = 0; Input < NumInputs; ++Input)
+            {
+                const int32_t Index = GetRouterGainIndex(Input, Output, NumInputs);
+                const float Target = Index < NumGains ? Gains[Index] : 0.0f;
+                const FRamp Ramp = MakeRamp(State.Gains[Output][Input], Target, NumFrames);
+
+                if (Ramp.Start != 0.0f || Ramp.Step != 0.0f)
+                {
+                    State.Routes[Output][NumRoutes++] = { Input, Ramp };
+                    State.bRamping |= Ramp.Step != 0.0f;
+                }
+            }
+
+            State.NumRoutes[Output] = NumRoutes;
+        }
+    }
+
+    // Runs the routes built by UpdateStereoRoutes(). The outputs must not be any of the inputs.
+    inline void ProcessStereoRouter(
+        FStereoRouterState& State,
+        const float* const* LeftData, const float* const* RightData,
+        float* const* OutputLeftData, float* const* OutputRightData, int32_t NumOutputs, int32_t NumFrames)
+    {
+        const FKernelTable& Kernels = GetKernelTable();
+
+        for (int32_t Output = 0; Output < NumOutputs; ++Output)
+        {
+            float* OutLeft = OutputLeftData[Output];
+            float* OutRight = OutputRightData[Output];
+            const int32_t NumRoutes = State.NumRoutes[Output];
+
+            if (NumRoutes == 0)
+            {
+                if (!State.bOutputSilent[Output])
+                {
+                    std::memset(OutLeft, 0, sizeof(float) * NumFrames);
+                    std::memset(OutRight, 0, sizeof(float) * NumFrames);
+                    State.bOutputSilent[Output] = true;
+                }
+
+                continue;
+            }
+
+            State.bOutputSilent[Output] = false;
+
+            for (int32_t RouteIndex = 0; RouteIndex < NumRoutes; ++RouteIndex)
+            {
+                const FStereoRoute& Route = State.Routes[Output][RouteIndex];
+                const float* InLeft = LeftData[Route.Input];
+                const float* InRight = RightData[Route.Input];
+                const FRamp& Gain = Route.Gain;
+                const bool bUnity = Gain.Start == 1.0f && Gain.Step == 0.0f;
+
+                if (RouteIndex == 0)
+                {
+                    if (bUnity)
+                    {
+                        std::memcpy(OutLeft, InLeft, sizeof(float) * NumFrames);
+                        std::memcpy(OutRight, InRight, sizeof(float) * NumFrames);
+                    }
+                    else if (Gain.Step == 0.0f)
+                    {
+                        Kernels.ProcessStereoGains(InLeft, InRight, Gain.Start, Gain.Start, OutLeft, OutRight, NumFrames);
+                    }
+                    else
+                    {
+                        Kernels.ProcessStereoGainsRamp(InLeft, InRight, Gain.Start, Gain.Step, Gain.Start, Gain.Step, OutLeft, OutRight, 0, NumFrames);
+                    }
+                }
+                else if (bUnity)
+                {
+                    Kernels.ProcessStereoAccumulate(InLeft, InRight, OutLeft, OutRight, NumFrames);
+                }
+                else if (Gain.Step == 0.0f)
+                {
+                    // The output takes a unity gain, which leaves it exact
+                    Kernels.ProcessStereoMix(OutLeft, OutRight, 1.0f, InLeft, InRight, Gain.Start, OutLeft, OutRight, NumFrames);
+                }
+                else
+                {
+                    Kernels.ProcessStereoMixRamp(OutLeft, OutRight, 1.0f, 0.0f, InLeft, InRight, Gain.Start, Gain.Step, OutLeft, OutRight, 0, NumFrames);
+                }
+            }
+        }
+    }
+
+    // Returns to silence with the routes rebuilt from the current matrix on the next block, stepping to it rather
+    // than ramping
+    inline void ResetStereoRouter(FStereoRouterState& State, const float* Gains, int32_t NumGains, int32_t NumInputs, int32_t NumOutputs)
+    {
+        State = FStereoRouterState();
+
+        NumGains = NumGains < NumInputs * NumOutputs ? NumGains : NumInputs * NumOutputs;
+        for (int32_t Output = 0; Output < NumOutputs; ++Output)
+        {
+            for (int32_t Input = 0; Input < NumInputs; ++Input)
+            {
+                const int32_t Index = GetRouterGainIndex(Input, Output, NumInputs);
+                State.Gains[Output][Input] = Index < NumGains ? Gains[Index] : 0.0f;
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+
+#include <algorithm>
+
+namespace MetasoundBranches::Kernels
+{
+    struct FSahState
+    {
+        float SampledValue = 0.0f;
+        float PreviousTriggerValue = 0.0f;
+    };
+
+    // Sample and hold with an audio-rate trigger: the signal is sampled whenever the trigger crosses the threshold upwards
+    inline void ProcessSah(FSahState& State, const float* SignalData, const float* TriggerData, float Threshold, float* OutputData, int32_t NumFrames)
+    {
+        if (NumFrames <= 0)
+        {
+            return;
+        }
+
+        const FKernelTable& Kernels = GetKernelTable();
+
+        // Read before OutputData is written, in case it aliases the trigger
+        const float LastTriggerValue = TriggerData[NumFrames - 1];
+
+        float SampledValue = State.SampledValue;
+        float PreviousTriggerValue = State.PreviousTriggerValue;
+
+        int32_t i = 0;
+        while (i < NumFrames)
+        {
+            // Hold until the next rising edge
+            const int32_t EdgeFrame = Kernels.FindRisingCrossing(TriggerData, i, NumFrames, PreviousTriggerValue, Threshold);
+            std::fill(OutputData + i, OutputData + EdgeFrame, SampledValue);
+
+            if (EdgeFrame == NumFrames)
+            {
+                break;
+            }
+
+            PreviousTriggerValue = TriggerData[EdgeFrame];
+            SampledValue = SignalData[EdgeFrame];
+            OutputData[EdgeFrame] = SampledValue;
+            i = EdgeFrame + 1;
+        }
+
+        State.SampledValue = SampledValue;
+        State.PreviousTriggerValue = LastTriggerValue;
+    }
+}
@@ -0,0 +1,110 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/BlockAnalysis.h"
+#include "MetasoundBranches/Public/Kernels/StateGuard.h"
+
+namespace MetasoundBranches::Kernels
+{
+    struct FSlewCoefficients
+    {
+        float RiseAlpha = 0.0f;
+        float FallAlpha = 0.0f;
+    };
+
+    struct FSlewState
+    {
+        float PreviousOutput = 0.0f;
+    };
+
+    // Alpha = exp(-1 / (time * sample rate)), or zero (no smoothing) for non-positive times
+    inline float MakeSlewAlpha(float TimeSeconds, float SampleRate)
+    {
+        return (TimeSeconds > 0.0f) ? std::exp(-1.0f / (TimeSeconds * SampleRate)) : 0.0f;
+    }
+
+    inline FSlewCoefficients MakeSlewCoefficients(float RiseTimeSeconds, float FallTimeSeconds, float SampleRate)
+    {
+        FSlewCoefficients Coefficients;
+        Coefficients.RiseAlpha = MakeSlewAlpha(RiseTimeSeconds, SampleRate);
+        Coefficients.FallAlpha = MakeSlewAlpha(FallTimeSeconds, SampleRate);
+        return Coefficients;
+    }
+
+    // One step of the slew limiter, using the rise or fall coefficient depending on the direction of travel
+    inline float SlewSample(float Previous, float Target, const FSlewCoefficients& Coefficients)
+    {
+        if (Target > Previous)
+        {
+            return Coefficients.RiseAlpha * Previous + (1.0f - Coefficients.RiseAlpha) * Target;
+        }
+        else if (Target < Previous)
+        {
+            return Coefficients.FallAlpha * Previous + (1.0f - Coefficients.FallAlpha) * Target;
+        }
+
+        return Target;
+    }
+
+    // Slew towards a value that is constant for the whole block (Bool To Audio, or a constant input block).
+    // Once a step leaves the output unchanged it has reached a fixed point (the target, or a value the rounding
+    // can no longer move), so the rest of the block is filled without the recursion.
+    inline void ProcessSlewToTarget(FSlewState& State, float Target, float* OutputData, int32_t NumFrames, const FSlewCoefficients& Coefficients)
+    {
+        float Previous = State.PreviousOutput;
+
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            const float Next = SlewSample(Previous, Target, Coefficients);
+            OutputData[i] = Next;
+
+            if (Next == Previous)
+            {
+                FillBlock(OutputData + i + 1, NumFrames - i - 1, Next);
+                Previous = Next;
+                break;
+            }
+
+            Previous = Next;
+        }
+
+        State.PreviousOutput = Previous;
+    }
+
+    inline void ProcessSlew(FSlewState& State, const float* InputData, float* OutputData, int32_t NumFrames, const FSlewCoefficients& Coefficients)
+    {
+        // Silent and DC inputs take the constant-target path, which stops iterating once the output has settled
+        float Target = 0.0f;
+        if (IsConstantBlock(InputData, NumFrames, Target))
+        {
+            ProcessSlewToTarget(State, Target, OutputData, NumFrames, Coefficients);
+            return;
+        }
+
+        float Previous = State.PreviousOutput;
+
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            Previous = SlewSample(Previous, InputData[i], Coefficients);
+            OutputData[i] = Previous;
+        }
+
+        State.PreviousOutput = Previous;
+    }
+
+    // Block-boundary guard (see StateGuard.h): flushes a subnormal output to zero, and resets the state and
+    // returns false if it is NaN or infinite
+    inline bool GuardSlewState(FSlewState& State)
+    {
+        if (SanitizeState(&State.PreviousOutput, 1))
+        {
+            return true;
+        }
+
+        State = FSlewState();
+        RecordNonFiniteReset();
+        return false;
+    }
+}
@@ -0,0 +1,106 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Denormal and NaN containment for kernels with recursive state (slew limiters, allpass cascades).
+//
+// Decaying feedback state drifts into subnormal floats once the input goes quiet, which is very slow on CPUs
+// without flush-to-zero, and a single NaN or infinity in the state never decays at all. Operators with
+// recursive state therefore:
+//     - run Execute() inside an FScopedFlushDenormals, where the platform allows it,
+//     - call the kernel's Guard*State() at the end of every block, which flushes subnormal state to zero and
+//       reports NaN / infinite state, in which case the operator resets it and outputs silence for the block.
+// Both events are counted in StateGuardCounters (au.Branches.StateGuard in the engine).
+
+#include "MetasoundBranches/Public/Kernels/KernelIsa.h"
+
+#include <atomic>
+#include <limits>
+
+namespace MetasoundBranches::Kernels
+{
+    struct FStateGuardCounters
+    {
+        // State values flushed from subnormal to zero at block boundaries
+        std::atomic<uint64_t> DenormalsFlushed { 0 };
+
+        // Blocks where NaN or infinite state was reset
+        std::atomic<uint64_t> NonFiniteResets { 0 };
+    };
+
+    inline FStateGuardCounters StateGuardCounters;
+
+    // Enables flush-to-zero and denormals-are-zero for the current thread until the end of the scope
+    class FScopedFlushDenormals
+    {
+    public:
+        FScopedFlushDenormals()
+        {
+#if BRANCHES_KERNELS_X86
+            PreviousMode = _mm_getcsr();
+            _mm_setcsr(PreviousMode | FlushMode);
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+            __asm__ __volatile__("mrs %0, fpcr" : "=r"(PreviousMode));
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(PreviousMode | FlushMode));
+#endif
+        }
+
+        ~FScopedFlushDenormals()
+        {
+#if BRANCHES_KERNELS_X86
+            _mm_setcsr(PreviousMode);
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(PreviousMode));
+#endif
+        }
+
+        FScopedFlushDenormals(const FScopedFlushDenormals&) = delete;
+        FScopedFlushDenormals& operator=(const FScopedFlushDenormals&) = delete;
+
+    private:
+#if BRANCHES_KERNELS_X86
+        // MXCSR FTZ (bit 15) and DAZ (bit 6)
+        static constexpr unsigned int FlushMode = 0x8040;
+        unsigned int PreviousMode = 0;
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+        // FPCR FZ (bit 24), which covers both inputs and results
+        static constexpr uint64_t FlushMode = uint64_t(1) << 24;
+        uint64_t PreviousMode = 0;
+#endif
+    };
+
+    // Flushes subnormal values to zero; returns false if any value is NaN or infinite
+    inline bool SanitizeState(float* Values, int32_t NumValues)
+    {
+        bool bFinite = true;
+        uint64_t NumFlushed = 0;
+
+        for (int32_t Index = 0; Index < NumValues; ++Index)
+        {
+            const float Magnitude = std::fabs(Values[Index]);
+
+            // NaN fails every comparison, so test for the finite range rather than for NaN / infinity
+            if (!(Magnitude <= std::numeric_limits<float>::max()))
+            {
+                bFinite = false;
+            }
+            else if (Magnitude < std::numeric_limits<float>::min() && Magnitude != 0.0f)
+            {
+                Values[Index] = 0.0f;
+                ++NumFlushed;
+            }
+        }
+
+        if (NumFlushed > 0)
+        {
+            StateGuardCounters.DenormalsFlushed.fetch_add(NumFlushed, std::memory_order_relaxed);
+        }
+
+        return bFinite;
+    }
+
+    inline void RecordNonFiniteReset()
+    {
+        StateGuardCounters.NonFiniteResets.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,353 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/QuarterSineTable.h"
+
+#include <algorithm>
+
+namespace MetasoundBranches::Kernels
+{
+    struct FStereoGains
+    {
+        float Left = 1.0f;
+        float Right = 1.0f;
+    };
+
+    // Equal-power balance, Balance in [-1, 1]
+    inline FStereoGains MakeBalanceGains(float Balance)
+    {
+        const float Angle = (Clamp(Balance, -1.0f, 1.0f) + 1.0f) * (Pi / 4.0f);
+
+        FStereoGains Gains;
+        Gains.Left = std::cos(Angle);
+        Gains.Right = std::sin(Angle);
+        return Gains;
+    }
+
+    // Equal-power crossfade, Crossfade in [0, 1]; Left is the gain of the first input and Right of the second. The end
+    // points are exact, since cos(pi / 2) is not quite zero in single precision.
+    inline FStereoGains MakeCrossfadeGains(float Crossfade)
+    {
+        const float CrossfadeFactor = Clamp(Crossfade, 0.0f, 1.0f);
+
+        FStereoGains Gains;
+        Gains.Left = CrossfadeFactor == 1.0f ? 0.0f : std::cos(CrossfadeFactor * HalfPi);
+        Gains.Right = std::sin(CrossfadeFactor * HalfPi);
+        return Gains;
+    }
+
+    // Per-frame step of a linear ramp from Start that reaches Target at the start of the next block
+    inline float GetRampStep(float Start, float Target, int32_t NumFrames)
+    {
+        return NumFrames > 0 ? (Target - Start) / static_cast<float>(NumFrames) : 0.0f;
+    }
+
+    // Ramps only between finite values; a gain recovering from NaN or infinity steps instead
+    inline bool ShouldRamp(float Previous, float Target)
+    {
+        return Previous != Target && std::isfinite(Previous) && std::isfinite(Target);
+    }
+
+    inline void ProcessStereoGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        GetKernelTable().ProcessStereoGains(LeftData, RightData, LeftGain, RightGain, OutputLeftData, OutputRightData, NumFrames);
+    }
+
+    inline void ProcessStereoInverter(const float* LeftData, const float* RightData, bool bInvertLeft, bool bInvertRight, bool bSwap, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const float LeftMultiplier = bInvertLeft ? -1.0f : 1.0f;
+        const float RightMultiplier = bInvertRight ? -1.0f : 1.0f;
+
+        // SwapGains reads both channels before writing either, so a swap can run in place
+        if (bSwap)
+        {
+            GetKernelTable().ProcessStereoSwapGains(LeftData, RightData, LeftMultiplier, RightMultiplier, OutputLeftData, OutputRightData, NumFrames);
+        }
+        else
+        {
+            ProcessStereoGains(LeftData, RightData, LeftMultiplier, RightMultiplier, OutputLeftData, OutputRightData, NumFrames);
+        }
+    }
+
+    // Mid-side width, Width in [0, 2]
+    inline void ProcessStereoWidth(const float* LeftData, const float* RightData, float Width, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        GetKernelTable().ProcessStereoWidth(LeftData, RightData, Clamp(Width, 0.0f, 2.0f), OutputLeftData, OutputRightData, NumFrames);
+    }
+
+    // Weighted sum of two stereo inputs
+    inline void ProcessStereoMix(
+        const float* LeftData1, const float* RightData1, float Gain1,
+        const float* LeftData2, const float* RightData2, float Gain2,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        GetKernelTable().ProcessStereoMix(LeftData1, RightData1, Gain1, LeftData2, RightData2, Gain2, OutputLeftData, OutputRightData, NumFrames);
+    }
+
+    // Equal-power crossfade between two stereo inputs, Crossfade in [0, 1]. The end points pass one input through at
+    // unity gain rather than mixing in the other at zero; that goes through the vector gain kernel, which is cheaper
+    // than two memcpy calls at block sizes.
+    inline void ProcessStereoCrossfade(
+        const float* LeftData1, const float* RightData1,
+        const float* LeftData2, const float* RightData2,
+        float Crossfade, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const float CrossfadeFactor = Clamp(Crossfade, 0.0f, 1.0f);
+
+        if (CrossfadeFactor == 0.0f)
+        {
+            ProcessStereoGains(LeftData1, RightData1, 1.0f, 1.0f, OutputLeftData, OutputRightData, NumFrames);
+        }
+        else if (CrossfadeFactor == 1.0f)
+        {
+            ProcessStereoGains(LeftData2, RightData2, 1.0f, 1.0f, OutputLeftData, OutputRightData, NumFrames);
+        }
+        else
+        {
+            const FStereoGains Gains = MakeCrossfadeGains(CrossfadeFactor);
+            ProcessStereoMix(LeftData1, RightData1, Gains.Left, LeftData2, RightData2, Gains.Right, OutputLeftData, OutputRightData, NumFrames);
+        }
+    }
+
+    // Ramped versions of the above for control-rate parameters. InOut holds the value applied at the end of the
+    // previous block: when the new value differs, the block ramps linearly from one to the other instead of stepping
+    // at the boundary, and InOut is updated. An unchanged value takes the constant path.
+    inline void ProcessStereoGainsRamped(FStereoGains& InOutGains, const FStereoGains& Gains, const float* LeftData, const float* RightData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        if (ShouldRamp(InOutGains.Left, Gains.Left) || ShouldRamp(InOutGains.Right, Gains.Right))
+        {
+            const float LeftStep = GetRampStep(InOutGains.Left, Gains.Left, NumFrames);
+            const float RightStep = GetRampStep(InOutGains.Right, Gains.Right, NumFrames);
+            GetKernelTable().ProcessStereoGainsRamp(LeftData, RightData, InOutGains.Left, LeftStep, InOutGains.Right, RightStep, OutputLeftData, OutputRightData, 0, NumFrames);
+        }
+        else
+        {
+            ProcessStereoGains(LeftData, RightData, Gains.Left, Gains.Right, OutputLeftData, OutputRightData, NumFrames);
+        }
+
+        InOutGains = Gains;
+    }
+
+    inline void ProcessStereoWidthRamped(float& InOutWidth, float Width, const float* LeftData, const float* RightData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const float WidthFactor = Clamp(Width, 0.0f, 2.0f);
+
+        if (ShouldRamp(InOutWidth, WidthFactor))
+        {
+            const float WidthStep = GetRampStep(InOutWidth, WidthFactor, NumFrames);
+            GetKernelTable().ProcessStereoWidthRamp(LeftData, RightData, InOutWidth, WidthStep, OutputLeftData, OutputRightData, 0, NumFrames);
+        }
+        else
+        {
+            ProcessStereoWidth(LeftData, RightData, WidthFactor, OutputLeftData, OutputRightData, NumFrames);
+        }
+
+        InOutWidth = WidthFactor;
+    }
+
+    // Ramps the two equal-power gains linearly, which dips slightly below equal power mid-block but never overshoots
+    inline void ProcessStereoCrossfadeRamped(
+        FStereoGains& InOutGains,
+        const float* LeftData1, const float* RightData1,
+        const float* LeftData2, const float* RightData2,
+        float Crossfade, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const FStereoGains Gains = MakeCrossfadeGains(Crossfade);
+
+        if (ShouldRamp(InOutGains.Left, Gains.Left) || ShouldRamp(InOutGains.Right, Gains.Right))
+        {
+            const float Gain1Step = GetRampStep(InOutGains.Left, Gains.Left, NumFrames);
+            const float Gain2Step = GetRampStep(InOutGains.Right, Gains.Right, NumFrames);
+            GetKernelTable().ProcessStereoMixRamp(LeftData1, RightData1, InOutGains.Left, Gain1Step, LeftData2, RightData2, InOutGains.Right, Gain2Step, OutputLeftData, OutputRightData, 0, NumFrames);
+        }
+        else
+        {
+            ProcessStereoCrossfade(LeftData1, RightData1, LeftData2, RightData2, Crossfade, OutputLeftData, OutputRightData, NumFrames);
+        }
+
+        InOutGains = Gains;
+    }
+
+    // N-way crossfade across NumInputs (>= 2) stereo inputs, Position in [0, NumInputs - 1]: between two whole numbers
+    // the adjacent pair is crossfaded as by ProcessStereoCrossfade(), and the other inputs are silent.
+
+    // Lower input of the pair that Position (already clamped) falls between
+    inline int32_t GetCrossfadePair(float Position, int32_t NumInputs)
+    {
+        const int32_t Lower = static_cast<int32_t>(Position);
+        return Lower < NumInputs - 2 ? Lower : NumInputs - 2;
+    }
+
+    // Gain of input Index at Position (already clamped)
+    inline float GetCrossfadeGain(float Position, int32_t Index, int32_t NumInputs)
+    {
+        const int32_t Pair = GetCrossfadePair(Position, NumInputs);
+        const FStereoGains Gains = MakeCrossfadeGains(Position - static_cast<float>(Pair));
+        return Index == Pair ? Gains.Left : (Index == Pair + 1 ? Gains.Right : 0.0f);
+    }
+
+    // Only the inputs audible in this block are read: the active pair, or when the position ramps across pairs, the
+    // inputs of both pairs. InOutPosition holds the clamped position applied at the end of the previous block, and
+    // is ramped from as in ProcessStereoCrossfadeRamped(); within one pair the output is identical to it.
+    inline void ProcessStereoCrossfadeN(
+        float& InOutPosition,
+        const float* const* LeftData, const float* const* RightData, int32_t NumInputs,
+        float Position, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const float Target = Clamp(Position, 0.0f, static_cast<float>(NumInputs - 1));
+        const int32_t Pair = GetCrossfadePair(Target, NumInputs);
+
+        if (!ShouldRamp(InOutPosition, Target))
+        {
+            // A whole-number position copies that input through the unity-gain kernel
+            ProcessStereoCrossfade(
+                LeftData[Pair], RightData[Pair],
+                LeftData[Pair + 1], RightData[Pair + 1],
+                Target - static_cast<float>(Pair), OutputLeftData, OutputRightData, NumFrames);
+
+            InOutPosition = Target;
+            return;
+        }
+
+        // Inputs with a gain at either end of the block, in order of first appearance
+        const int32_t StartPair = GetCrossfadePair(InOutPosition, NumInputs);
+        const int32_t Candidates[4] = { StartPair, StartPair + 1, Pair, Pair + 1 };
+
+        int32_t Inputs[4];
+        int32_t NumActive = 0;
+        for (const int32_t Candidate : Candidates)
+        {
+            if (std::find(Inputs, Inputs + NumActive, Candidate) == Inputs + NumActive)
+            {
+                Inputs[NumActive++] = Candidate;
+            }
+        }
+
+        FRamp Ramps[4];
+        for (int32_t i = 0; i < NumActive; ++i)
+        {
+            const float Start = GetCrossfadeGain(InOutPosition, Inputs[i], NumInputs);
+            Ramps[i] = { Start, GetRampStep(Start, GetCrossfadeGain(Target, Inputs[i], NumInputs), NumFrames) };
+        }
+
+        // The first two inputs are mixed into the output and any others added on top, the output taking a unity gain
+        const FKernelTable& Kernels = GetKernelTable();
+        Kernels.ProcessStereoMixRamp(
+            LeftData[Inputs[0]], RightData[Inputs[0]], Ramps[0].Start, Ramps[0].Step,
+            LeftData[Inputs[1]], RightData[Inputs[1]], Ramps[1].Start, Ramps[1].Step,
+            OutputLeftData, OutputRightData, 0, NumFrames);
+
+        for (int32_t i = 2; i < NumActive; ++i)
+        {
+            Kernels.ProcessStereoMixRamp(
+                OutputLeftData, OutputRightData, 1.0f, 0.0f,
+                LeftData[Inputs[i]], RightData[Inputs[i]], Ramps[i].Start, Ramps[i].Step,
+                OutputLeftData, OutputRightData, 0, NumFrames);
+        }
+
+        InOutPosition = Target;
+    }
+
+    // Audio-rate versions of Balance and Crossfade, taking one position per frame. The equal-power gains are read from
+    // the shared quarter-sine table rather than computed with cos / sin, so they are within about 4e-7 of the control-rate
+    // gains.
+    inline void ProcessStereoBalanceAudio(const float* LeftData, const float* RightData, const float* BalanceData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        GetKernelTable().ProcessStereoBalanceAudio(LeftData, RightData, BalanceData, GetQuarterSineTable().Values, OutputLeftData, OutputRightData, NumFrames);
+    }
+
+    inline void ProcessStereoCrossfadeAudio(
+        const float* LeftData1, const float* RightData1,
+        const float* LeftData2, const float* RightData2,
+        const float* CrossfadeData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        GetKernelTable().ProcessStereoCrossfadeAudio(LeftData1, RightData1, LeftData2, RightData2, CrossfadeData, GetQuarterSineTable().Values, OutputLeftData, OutputRightData, NumFrames);
+    }
+
+    // Ramp from InOutValue to Target across the block, or Target held when ShouldRamp() says not to; InOutValue is
+    // updated to Target
+    inline FRamp MakeRamp(float& InOutValue, float Target, int32_t NumFrames)
+    {
+        const bool bRamp = ShouldRamp(InOutValue, Target);
+
+        FRamp Ramp;
+        Ramp.Start = bRamp ? InOutValue : Target;
+        Ramp.Step = bRamp ? GetRampStep(InOutValue, Target, NumFrames) : 0.0f;
+
+        InOutValue = Target;
+        return Ramp;
+    }
+
+    // State of the Stereo Matrix node, which runs the Width -> Balance -> Inverter -> Gain chain in one pass
+    struct FStereoMatrixState
+    {
+        // Values applied at the end of the last block, ramped from as in the separate nodes
+        float WidthFactor = 1.0f;
+        FStereoGains BalanceGains = MakeBalanceGains(0.0f);
+        float Gain = 1.0f;
+
+        // Balance input the target gains were computed for, so the trigonometry only runs when it changes
+        float Balance = 0.0f;
+        FStereoGains BalanceTarget = MakeBalanceGains(0.0f);
+    };
+
+    // State that starts on the given settings without ramping into the first block
+    inline FStereoMatrixState MakeStereoMatrixState(float Width, float Balance, float Gain)
+    {
+        FStereoMatrixState State;
+        State.WidthFactor = Clamp(Width, 0.0f, 2.0f);
+        State.Balance = Balance;
+        State.BalanceTarget = MakeBalanceGains(Balance);
+        State.BalanceGains = State.BalanceTarget;
+        State.Gain = Gain;
+        return State;
+    }
+
+    // Bit-identical with Stereo Width, Stereo Balance, Stereo Inverter and Stereo Gain in series, ramps included (up
+    // to the sign of zero outputs for a gain of -0 held while another setting ramps). bMidSide is false where the Width node would pass its inputs
+    // through, i.e. for a width that is fixed at 1 when the graph is built.
+    inline void ProcessStereoMatrix(
+        FStereoMatrixState& State,
+        const float* LeftData, const float* RightData,
+        bool bMidSide, float Width, float Balance, bool bInvertLeft, bool bInvertRight, bool bSwap, float Gain,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        if (Balance != State.Balance)
+        {
+            State.Balance = Balance;
+            State.BalanceTarget = MakeBalanceGains(Balance);
+        }
+
+        const FRamp WidthRamp = MakeRamp(State.WidthFactor, Clamp(Width, 0.0f, 2.0f), NumFrames);
+        const FRamp GainRamp = MakeRamp(State.Gain, Gain, NumFrames);
+
+        // The Balance node ramps both gains when either changes
+        FRamp LeftRamp;
+        FRamp RightRamp;
+        if (ShouldRamp(State.BalanceGains.Left, State.BalanceTarget.Left) || ShouldRamp(State.BalanceGains.Right, State.BalanceTarget.Right))
+        {
+            LeftRamp = { State.BalanceGains.Left, GetRampStep(State.BalanceGains.Left, State.BalanceTarget.Left, NumFrames) };
+            RightRamp = { State.BalanceGains.Right, GetRampStep(State.BalanceGains.Right, State.BalanceTarget.Right, NumFrames) };
+        }
+        else
+        {
+            LeftRamp = { State.BalanceTarget.Left, 0.0f };
+            RightRamp = { State.BalanceTarget.Right, 0.0f };
+        }
+        State.BalanceGains = State.BalanceTarget;
+
+        // The inverter's polarity applies to the output channel, so after a swap the left input's path takes the right
+        // output's sign. Negating a gain ramp is exact.
+        const float LeftSign = (bSwap ? bInvertRight : bInvertLeft) ? -1.0f : 1.0f;
+        const float RightSign = (bSwap ? bInvertLeft : bInvertRight) ? -1.0f : 1.0f;
+        LeftRamp = { LeftRamp.Start * LeftSign, LeftRamp.Step * LeftSign };
+        RightRamp = { RightRamp.Start * RightSign, RightRamp.Step * RightSign };
+
+        GetKernelTable().ProcessStereoMatrix(
+            LeftData, RightData, bMidSide, WidthRamp, LeftRamp, RightRamp, GainRamp,
+            bSwap ? OutputRightData : OutputLeftData, bSwap ? OutputLeftData : OutputRightData, 0, NumFrames);
+    }
+}
@@ -0,0 +1,98 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Block-rate stereo metering: phase correlation, energy balance and peaks.
+//
+// Each block adds its sums of L * R, L * L and R * R (one vectorized pass, see AccumulateStereoSums()) to leaky
+// integrators that decay by a fixed factor per block, so the readings follow the signal over the integration time
+// without any per-sample state.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+#include "MetasoundBranches/Public/Kernels/StateGuard.h"
+
+#include <algorithm>
+
+namespace MetasoundBranches::Kernels
+{
+    struct FStereoMeterState
+    {
+        FStereoSums Integrated;
+    };
+
+    struct FStereoMeterReadings
+    {
+        // -1 (out of phase) to 1 (mono), 0 when either channel is silent
+        float Correlation = 0.0f;
+
+        // -1 (all energy on the left) to 1 (all on the right), 0 when both are silent
+        float Balance = 0.0f;
+
+        float LeftPeak = 0.0f;
+        float RightPeak = 0.0f;
+    };
+
+    // Per-block decay of an integrator with the given time constant, or zero (each block on its own) for
+    // non-positive times
+    inline float MakeMeterDecay(float IntegrationSeconds, float SampleRate, int32_t NumFrames)
+    {
+        return (IntegrationSeconds > 0.0f) ? std::exp(-static_cast<float>(NumFrames) / (IntegrationSeconds * SampleRate)) : 0.0f;
+    }
+
+    inline FStereoMeterReadings GetStereoMeterReadings(const FStereoMeterState& State)
+    {
+        const FStereoSums& Sums = State.Integrated;
+
+        FStereoMeterReadings Readings;
+        Readings.LeftPeak = Sums.LeftPeak;
+        Readings.RightPeak = Sums.RightPeak;
+
+        // Square roots taken separately so quiet signals don't underflow the product
+        const float RmsProduct = std::sqrt(Sums.LeftSquared) * std::sqrt(Sums.RightSquared);
+        if (RmsProduct > 0.0f)
+        {
+            Readings.Correlation = Clamp(Sums.LeftRight / RmsProduct, -1.0f, 1.0f);
+        }
+
+        const float TotalEnergy = Sums.LeftSquared + Sums.RightSquared;
+        if (TotalEnergy > 0.0f)
+        {
+            Readings.Balance = (Sums.RightSquared - Sums.LeftSquared) / TotalEnergy;
+        }
+
+        return Readings;
+    }
+
+    // Adds one block to the integrators, which first decay by Decay; peaks fall by the same factor unless the block
+    // exceeds them
+    inline void ProcessStereoMeter(FStereoMeterState& State, const float* LeftData, const float* RightData, float Decay, int32_t NumFrames)
+    {
+        const FStereoSums Block = GetKernelTable().AccumulateStereoSums(LeftData, RightData, NumFrames);
+        FStereoSums& Integrated = State.Integrated;
+
+        Integrated.LeftRight = Integrated.LeftRight * Decay + Block.LeftRight;
+        Integrated.LeftSquared = Integrated.LeftSquared * Decay + Block.LeftSquared;
+        Integrated.RightSquared = Integrated.RightSquared * Decay + Block.RightSquared;
+        Integrated.LeftPeak = std::max(Integrated.LeftPeak * Decay, Block.LeftPeak);
+        Integrated.RightPeak = std::max(Integrated.RightPeak * Decay, Block.RightPeak);
+    }
+
+    // Block-boundary guard (see StateGuard.h): flushes subnormal integrators to zero, and resets the state and
+    // returns false if any is NaN or infinite
+    inline bool GuardStereoMeterState(FStereoMeterState& State)
+    {
+        FStereoSums& Integrated = State.Integrated;
+        float Values[] = { Integrated.LeftRight, Integrated.LeftSquared, Integrated.RightSquared, Integrated.LeftPeak, Integrated.RightPeak };
+
+        if (SanitizeState(Values, 5))
+        {
+            Integrated = FStereoSums{ Values[0], Values[1], Values[2], Values[3], Values[4] };
+            return true;
+        }
+
+        State = FStereoMeterState();
+        RecordNonFiniteReset();
+        return false;
+    }
+}
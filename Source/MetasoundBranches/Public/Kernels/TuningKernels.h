@@ -0,0 +1,32 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+
+namespace MetasoundBranches::Kernels
+{
+    constexpr int32_t NotesPerOctave = 12;
+
+    // Frequency of a note in an equal division of the octave, relative to a reference note and frequency
+    inline float EdoFrequency(int32_t NoteNumber, float ReferenceFrequency, int32_t ReferenceNote, int32_t Divisions)
+    {
+        if (Divisions == 0)
+        {
+            Divisions = 1;
+        }
+
+        const float Exponent = static_cast<float>(NoteNumber - ReferenceNote) / static_cast<float>(Divisions);
+        return ReferenceFrequency * std::pow(2.0f, Exponent);
+    }
+
+    // Frequency of a MIDI note in 12-TET (A440), offset by a per-pitch-class adjustment in cents
+    inline float TunedFrequency(int32_t MIDINote, const float (&TuningCents)[NotesPerOctave])
+    {
+        const int32_t NoteInOctave = MIDINote % NotesPerOctave;
+
+        const float TuningAdjustmentSemitones = TuningCents[NoteInOctave] / 100.0f;
+        const float AdjustedNote = static_cast<float>(MIDINote) + TuningAdjustmentSemitones;
+        return 440.0f * std::pow(2.0f, (AdjustedNote - 69.0f) / 12.0f);
+    }
+}
@@ -0,0 +1,1027 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// AVX2 versions of the dispatched kernels, 8 frames per iteration. Bit-identical with Scalar::.
+//
+// FMA is deliberately not enabled for these functions: fused multiply-adds round differently from the scalar code.
+
+#include "MetasoundBranches/Public/Kernels/KernelIsa.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsScalar.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsSse2.h"
+
+#if BRANCHES_KERNELS_X86
+
+namespace MetasoundBranches::Kernels::Avx2
+{
+    constexpr int32_t Width = 8;
+    constexpr uintptr_t Alignment = 32;
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoGains(LeftData, RightData, LeftGain, RightGain, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m256 LeftGainVector = _mm256_set1_ps(LeftGain);
+        const __m256 RightGainVector = _mm256_set1_ps(RightGain);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_mul_ps(_mm256_loadu_ps(LeftData + i), LeftGainVector));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_mul_ps(_mm256_loadu_ps(RightData + i), RightGainVector));
+        }
+
+        Scalar::ProcessStereoGains(LeftData + i, RightData + i, LeftGain, RightGain, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoSwapGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoSwapGains(LeftData, RightData, LeftGain, RightGain, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m256 LeftGainVector = _mm256_set1_ps(LeftGain);
+        const __m256 RightGainVector = _mm256_set1_ps(RightGain);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m256 Left = _mm256_loadu_ps(LeftData + i);
+            const __m256 Right = _mm256_loadu_ps(RightData + i);
+
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_mul_ps(Right, LeftGainVector));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_mul_ps(Left, RightGainVector));
+        }
+
+        Scalar::ProcessStereoSwapGains(LeftData + i, RightData + i, LeftGain, RightGain, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoWidth(const float* LeftData, const float* RightData, float WidthFactor, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoWidth(LeftData, RightData, WidthFactor, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m256 Half = _mm256_set1_ps(0.5f);
+        const __m256 WidthVector = _mm256_set1_ps(WidthFactor);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m256 Left = _mm256_loadu_ps(LeftData + i);
+            const __m256 Right = _mm256_loadu_ps(RightData + i);
+
+            const __m256 Mid = _mm256_mul_ps(Half, _mm256_add_ps(Left, Right));
+            const __m256 Side = _mm256_mul_ps(_mm256_mul_ps(Half, _mm256_sub_ps(Left, Right)), WidthVector);
+
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_add_ps(Mid, Side));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_sub_ps(Mid, Side));
+        }
+
+        Scalar::ProcessStereoWidth(LeftData + i, RightData + i, WidthFactor, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoMix(
+        const float* LeftData1, const float* RightData1, float Gain1,
+        const float* LeftData2, const float* RightData2, float Gain2,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoMix(LeftData1, RightData1, Gain1, LeftData2, RightData2, Gain2, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m256 Gain1Vector = _mm256_set1_ps(Gain1);
+        const __m256 Gain2Vector = _mm256_set1_ps(Gain2);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_add_ps(_mm256_mul_ps(Gain1Vector, _mm256_loadu_ps(LeftData1 + i)), _mm256_mul_ps(Gain2Vector, _mm256_loadu_ps(LeftData2 + i))));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_add_ps(_mm256_mul_ps(Gain1Vector, _mm256_loadu_ps(RightData1 + i)), _mm256_mul_ps(Gain2Vector, _mm256_loadu_ps(RightData2 + i))));
+        }
+
+        Scalar::ProcessStereoMix(LeftData1 + i, RightData1 + i, Gain1, LeftData2 + i, RightData2 + i, Gain2, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoAccumulate(const float* LeftData, const float* RightData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoAccumulate(LeftData, RightData, OutputLeftData, OutputRightData, PeelFrames);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_add_ps(_mm256_loadu_ps(OutputLeftData + i), _mm256_loadu_ps(LeftData + i)));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_add_ps(_mm256_loadu_ps(OutputRightData + i), _mm256_loadu_ps(RightData + i)));
+        }
+
+        Scalar::ProcessStereoAccumulate(LeftData + i, RightData + i, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    // Indices of the frames in the vector starting at Frame
+    BRANCHES_KERNELS_TARGET_AVX2 inline __m256 FrameIndices(int32_t Frame)
+    {
+        return _mm256_add_ps(_mm256_set1_ps(static_cast<float>(Frame)), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoGainsRamp(const float* LeftData, const float* RightData, float LeftStart, float LeftStep, float RightStart, float RightStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoGainsRamp(LeftData, RightData, LeftStart, LeftStep, RightStart, RightStep, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m256 LeftStartVector = _mm256_set1_ps(LeftStart);
+        const __m256 LeftStepVector = _mm256_set1_ps(LeftStep);
+        const __m256 RightStartVector = _mm256_set1_ps(RightStart);
+        const __m256 RightStepVector = _mm256_set1_ps(RightStep);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m256 Frame = FrameIndices(i);
+            const __m256 LeftGain = _mm256_add_ps(LeftStartVector, _mm256_mul_ps(LeftStepVector, Frame));
+            const __m256 RightGain = _mm256_add_ps(RightStartVector, _mm256_mul_ps(RightStepVector, Frame));
+
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_mul_ps(_mm256_loadu_ps(LeftData + i), LeftGain));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_mul_ps(_mm256_loadu_ps(RightData + i), RightGain));
+        }
+
+        Scalar::ProcessStereoGainsRamp(LeftData, RightData, LeftStart, LeftStep, RightStart, RightStep, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoWidthRamp(const float* LeftData, const float* RightData, float WidthStart, float WidthStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoWidthRamp(LeftData, RightData, WidthStart, WidthStep, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m256 Half = _mm256_set1_ps(0.5f);
+        const __m256 WidthStartVector = _mm256_set1_ps(WidthStart);
+        const __m256 WidthStepVector = _mm256_set1_ps(WidthStep);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m256 Left = _mm256_loadu_ps(LeftData + i);
+            const __m256 Right = _mm256_loadu_ps(RightData + i);
+            const __m256 WidthFactor = _mm256_add_ps(WidthStartVector, _mm256_mul_ps(WidthStepVector, FrameIndices(i)));
+
+            const __m256 Mid = _mm256_mul_ps(Half, _mm256_add_ps(Left, Right));
+            const __m256 Side = _mm256_mul_ps(_mm256_mul_ps(Half, _mm256_sub_ps(Left, Right)), WidthFactor);
+
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_add_ps(Mid, Side));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_sub_ps(Mid, Side));
+        }
+
+        Scalar::ProcessStereoWidthRamp(LeftData, RightData, WidthStart, WidthStep, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoMixRamp(
+        const float* LeftData1, const float* RightData1, float Gain1Start, float Gain1Step,
+        const float* LeftData2, const float* RightData2, float Gain2Start, float Gain2Step,
+        float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoMixRamp(LeftData1, RightData1, Gain1Start, Gain1Step, LeftData2, RightData2, Gain2Start, Gain2Step, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m256 Gain1StartVector = _mm256_set1_ps(Gain1Start);
+        const __m256 Gain1StepVector = _mm256_set1_ps(Gain1Step);
+        const __m256 Gain2StartVector = _mm256_set1_ps(Gain2Start);
+        const __m256 Gain2StepVector = _mm256_set1_ps(Gain2Step);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m256 Frame = FrameIndices(i);
+            const __m256 Gain1 = _mm256_add_ps(Gain1StartVector, _mm256_mul_ps(Gain1StepVector, Frame));
+            const __m256 Gain2 = _mm256_add_ps(Gain2StartVector, _mm256_mul_ps(Gain2StepVector, Frame));
+
+            const __m256 Left = _mm256_add_ps(_mm256_mul_ps(Gain1, _mm256_loadu_ps(LeftData1 + i)), _mm256_mul_ps(Gain2, _mm256_loadu_ps(LeftData2 + i)));
+            const __m256 Right = _mm256_add_ps(_mm256_mul_ps(Gain1, _mm256_loadu_ps(RightData1 + i)), _mm256_mul_ps(Gain2, _mm256_loadu_ps(RightData2 + i)));
+
+            _mm256_storeu_ps(OutputLeftData + i, Left);
+            _mm256_storeu_ps(OutputRightData + i, Right);
+        }
+
+        Scalar::ProcessStereoMixRamp(LeftData1, RightData1, Gain1Start, Gain1Step, LeftData2, RightData2, Gain2Start, Gain2Step, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    // Start + Step * Frame, or Start when nothing in the block ramps
+    template<bool bRamp>
+    BRANCHES_KERNELS_TARGET_AVX2 inline __m256 RampAt(__m256 Start, __m256 Step, __m256 Frame)
+    {
+        if constexpr (bRamp)
+        {
+            return _mm256_add_ps(Start, _mm256_mul_ps(Step, Frame));
+        }
+        else
+        {
+            return Start;
+        }
+    }
+
+    template<bool bMidSide, bool bRamp>
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoMatrixFrames(const float* LeftData, const float* RightData, FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoMatrix(LeftData, RightData, bMidSide, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m256 Half = _mm256_set1_ps(0.5f);
+        const __m256 WidthStart = _mm256_set1_ps(WidthRamp.Start);
+        const __m256 WidthStep = _mm256_set1_ps(WidthRamp.Step);
+        const __m256 LeftGainStart = _mm256_set1_ps(LeftRamp.Start);
+        const __m256 LeftGainStep = _mm256_set1_ps(LeftRamp.Step);
+        const __m256 RightGainStart = _mm256_set1_ps(RightRamp.Start);
+        const __m256 RightGainStep = _mm256_set1_ps(RightRamp.Step);
+        const __m256 GainStart = _mm256_set1_ps(GainRamp.Start);
+        const __m256 GainStep = _mm256_set1_ps(GainRamp.Step);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m256 Frame = FrameIndices(i);
+
+            __m256 Left = _mm256_loadu_ps(LeftData + i);
+            __m256 Right = _mm256_loadu_ps(RightData + i);
+
+            if constexpr (bMidSide)
+            {
+                const __m256 Mid = _mm256_mul_ps(Half, _mm256_add_ps(Left, Right));
+                const __m256 Side = _mm256_mul_ps(_mm256_mul_ps(Half, _mm256_sub_ps(Left, Right)), RampAt<bRamp>(WidthStart, WidthStep, Frame));
+
+                Left = _mm256_add_ps(Mid, Side);
+                Right = _mm256_sub_ps(Mid, Side);
+            }
+
+            const __m256 OutputGain = RampAt<bRamp>(GainStart, GainStep, Frame);
+            const __m256 LeftBalance = RampAt<bRamp>(LeftGainStart, LeftGainStep, Frame);
+            const __m256 RightBalance = RampAt<bRamp>(RightGainStart, RightGainStep, Frame);
+
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_mul_ps(_mm256_mul_ps(Left, LeftBalance), OutputGain));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_mul_ps(_mm256_mul_ps(Right, RightBalance), OutputGain));
+        }
+
+        Scalar::ProcessStereoMatrix(LeftData, RightData, bMidSide, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoMatrix(const float* LeftData, const float* RightData, bool bMidSide, FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const bool bRamp = Scalar::IsMatrixRamping(WidthRamp, LeftRamp, RightRamp, GainRamp);
+
+        if (bMidSide && bRamp)
+        {
+            ProcessStereoMatrixFrames<true, true>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else if (bMidSide)
+        {
+            ProcessStereoMatrixFrames<true, false>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else if (bRamp)
+        {
+            ProcessStereoMatrixFrames<false, true>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else
+        {
+            ProcessStereoMatrixFrames<false, false>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessMultichannelWidthRamp(const float* const* InputData, float* const* OutputData, int32_t NumChannels, float WidthStart, float WidthStep, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputData[0] + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessMultichannelWidthRamp(InputData, OutputData, NumChannels, WidthStart, WidthStep, StartFrame, PeelEnd);
+
+        const __m256 Scale = _mm256_set1_ps(1.0f / static_cast<float>(NumChannels));
+        const __m256 WidthStartVector = _mm256_set1_ps(WidthStart);
+        const __m256 WidthStepVector = _mm256_set1_ps(WidthStep);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            __m256 Sum = _mm256_loadu_ps(InputData[0] + i);
+            for (int32_t Channel = 1; Channel < NumChannels; ++Channel)
+            {
+                Sum = _mm256_add_ps(Sum, _mm256_loadu_ps(InputData[Channel] + i));
+            }
+
+            const __m256 Mid = _mm256_mul_ps(Sum, Scale);
+            const __m256 WidthFactor = _mm256_add_ps(WidthStartVector, _mm256_mul_ps(WidthStepVector, FrameIndices(i)));
+
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const __m256 Side = _mm256_sub_ps(_mm256_loadu_ps(InputData[Channel] + i), Mid);
+                _mm256_storeu_ps(OutputData[Channel] + i, _mm256_add_ps(Mid, _mm256_mul_ps(Side, WidthFactor)));
+            }
+        }
+
+        Scalar::ProcessMultichannelWidthRamp(InputData, OutputData, NumChannels, WidthStart, WidthStep, i, EndFrame);
+    }
+
+    // The last steps of Scalar::ReduceStereoSumLanes(), from eight lanes to one
+    BRANCHES_KERNELS_TARGET_AVX2 inline float ReduceSumLanes(__m256 Lanes)
+    {
+        const __m128 Quad = _mm_add_ps(_mm256_castps256_ps128(Lanes), _mm256_extractf128_ps(Lanes, 1));
+        const __m128 Pairs = _mm_add_ps(Quad, _mm_movehl_ps(Quad, Quad));
+        return _mm_cvtss_f32(_mm_add_ss(Pairs, _mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline float ReducePeakLanes(__m256 Lanes)
+    {
+        const __m128 Quad = _mm_max_ps(_mm256_extractf128_ps(Lanes, 1), _mm256_castps256_ps128(Lanes));
+        const __m128 Pairs = _mm_max_ps(_mm_movehl_ps(Quad, Quad), Quad);
+        return _mm_cvtss_f32(_mm_max_ss(_mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 1, 1, 1)), Pairs));
+    }
+
+    // Scalar::AccumulateStereoSums(), each group of SumLanes frames filling two vectors of lanes
+    BRANCHES_KERNELS_TARGET_AVX2 inline FStereoSums AccumulateStereoSums(const float* LeftData, const float* RightData, int32_t NumFrames)
+    {
+        static_assert(SumLanes == 2 * Width, "Two vectors per group of lanes");
+        const __m256 AbsMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+        __m256 LeftRight[2];
+        __m256 LeftSquared[2];
+        __m256 RightSquared[2];
+        __m256 LeftPeak[2];
+        __m256 RightPeak[2];
+        for (int32_t Vector = 0; Vector < 2; ++Vector)
+        {
+            LeftRight[Vector] = LeftSquared[Vector] = RightSquared[Vector] = LeftPeak[Vector] = RightPeak[Vector] = _mm256_setzero_ps();
+        }
+
+        int32_t i = 0;
+        for (; i + SumLanes <= NumFrames; i += SumLanes)
+        {
+            for (int32_t Vector = 0; Vector < 2; ++Vector)
+            {
+                const __m256 Left = _mm256_loadu_ps(LeftData + i + Vector * Width);
+                const __m256 Right = _mm256_loadu_ps(RightData + i + Vector * Width);
+
+                LeftRight[Vector] = _mm256_add_ps(LeftRight[Vector], _mm256_mul_ps(Left, Right));
+                LeftSquared[Vector] = _mm256_add_ps(LeftSquared[Vector], _mm256_mul_ps(Left, Left));
+                RightSquared[Vector] = _mm256_add_ps(RightSquared[Vector], _mm256_mul_ps(Right, Right));
+                LeftPeak[Vector] = _mm256_max_ps(_mm256_and_ps(Left, AbsMask), LeftPeak[Vector]);
+                RightPeak[Vector] = _mm256_max_ps(_mm256_and_ps(Right, AbsMask), RightPeak[Vector]);
+            }
+        }
+
+        // A partial group goes through the lanes in memory
+        if (i < NumFrames)
+        {
+            FStereoSumLanes Lanes;
+            for (int32_t Vector = 0; Vector < 2; ++Vector)
+            {
+                _mm256_storeu_ps(Lanes.LeftRight + Vector * Width, LeftRight[Vector]);
+                _mm256_storeu_ps(Lanes.LeftSquared + Vector * Width, LeftSquared[Vector]);
+                _mm256_storeu_ps(Lanes.RightSquared + Vector * Width, RightSquared[Vector]);
+                _mm256_storeu_ps(Lanes.LeftPeak + Vector * Width, LeftPeak[Vector]);
+                _mm256_storeu_ps(Lanes.RightPeak + Vector * Width, RightPeak[Vector]);
+            }
+
+            Scalar::AccumulateStereoSumLanes(LeftData, RightData, Lanes, i, NumFrames);
+            return Scalar::ReduceStereoSumLanes(Lanes);
+        }
+
+        // Lane k takes in lane k + 8 first
+        FStereoSums Sums;
+        Sums.LeftRight = ReduceSumLanes(_mm256_add_ps(LeftRight[0], LeftRight[1]));
+        Sums.LeftSquared = ReduceSumLanes(_mm256_add_ps(LeftSquared[0], LeftSquared[1]));
+        Sums.RightSquared = ReduceSumLanes(_mm256_add_ps(RightSquared[0], RightSquared[1]));
+        Sums.LeftPeak = ReducePeakLanes(_mm256_max_ps(LeftPeak[1], LeftPeak[0]));
+        Sums.RightPeak = ReducePeakLanes(_mm256_max_ps(RightPeak[1], RightPeak[0]));
+        return Sums;
+    }
+
+    // Scalar::Clamp() per lane; the operand order of min / max reproduces its NaN handling
+    BRANCHES_KERNELS_TARGET_AVX2 inline __m256 ClampVector(__m256 Value, __m256 Min, __m256 Max)
+    {
+        return _mm256_max_ps(Min, _mm256_min_ps(Value, Max));
+    }
+
+    // Scalar::LookupQuarterSine() per lane, gathering both interpolation points
+    BRANCHES_KERNELS_TARGET_AVX2 inline __m256 LookupQuarterSine(const float* Table, __m256 Position)
+    {
+        const __m256 Index = _mm256_mul_ps(Position, _mm256_set1_ps(static_cast<float>(QuarterSineTableSize)));
+        const __m256i Whole = _mm256_cvttps_epi32(Index);
+        const __m256 Fraction = _mm256_sub_ps(Index, _mm256_cvtepi32_ps(Whole));
+
+        const __m256 Lower = _mm256_i32gather_ps(Table, Whole, 4);
+        const __m256 Upper = _mm256_i32gather_ps(Table + 1, Whole, 4);
+
+        return _mm256_add_ps(Lower, _mm256_mul_ps(Fraction, _mm256_sub_ps(Upper, Lower)));
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoBalanceAudio(const float* LeftData, const float* RightData, const float* BalanceData, const float* Table, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoBalanceAudio(LeftData, RightData, BalanceData, Table, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m256 One = _mm256_set1_ps(1.0f);
+        const __m256 MinusOne = _mm256_set1_ps(-1.0f);
+        const __m256 Half = _mm256_set1_ps(0.5f);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m256 Position = _mm256_mul_ps(_mm256_add_ps(ClampVector(_mm256_loadu_ps(BalanceData + i), MinusOne, One), One), Half);
+
+            _mm256_storeu_ps(OutputLeftData + i, _mm256_mul_ps(_mm256_loadu_ps(LeftData + i), LookupQuarterSine(Table, _mm256_sub_ps(One, Position))));
+            _mm256_storeu_ps(OutputRightData + i, _mm256_mul_ps(_mm256_loadu_ps(RightData + i), LookupQuarterSine(Table, Position)));
+        }
+
+        Scalar::ProcessStereoBalanceAudio(LeftData + i, RightData + i, BalanceData + i, Table, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessStereoCrossfadeAudio(
+        const float* LeftData1, const float* RightData1,
+        const float* LeftData2, const float* RightData2,
+        const float* CrossfadeData, const float* Table,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoCrossfadeAudio(LeftData1, RightData1, LeftData2, RightData2, CrossfadeData, Table, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m256 Zero = _mm256_setzero_ps();
+        const __m256 One = _mm256_set1_ps(1.0f);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m256 Position = ClampVector(_mm256_loadu_ps(CrossfadeData + i), Zero, One);
+            const __m256 Gain1 = LookupQuarterSine(Table, _mm256_sub_ps(One, Position));
+            const __m256 Gain2 = LookupQuarterSine(Table, Position);
+
+            const __m256 Left = _mm256_add_ps(_mm256_mul_ps(Gain1, _mm256_loadu_ps(LeftData1 + i)), _mm256_mul_ps(Gain2, _mm256_loadu_ps(LeftData2 + i)));
+            const __m256 Right = _mm256_add_ps(_mm256_mul_ps(Gain1, _mm256_loadu_ps(RightData1 + i)), _mm256_mul_ps(Gain2, _mm256_loadu_ps(RightData2 + i)));
+
+            _mm256_storeu_ps(OutputLeftData + i, Left);
+            _mm256_storeu_ps(OutputRightData + i, Right);
+        }
+
+        Scalar::ProcessStereoCrossfadeAudio(LeftData1 + i, RightData1 + i, LeftData2 + i, RightData2 + i, CrossfadeData + i, Table, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    // The searches check the first frame against PreviousValue, then compare each vector of frames with the same
+    // vector loaded one frame earlier
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline int32_t FindRisingCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, float Threshold)
+    {
+        if (StartFrame >= EndFrame || (PreviousValue < Threshold && Data[StartFrame] >= Threshold))
+        {
+            return StartFrame;
+        }
+
+        const __m256 ThresholdVector = _mm256_set1_ps(Threshold);
+
+        int32_t i = StartFrame + 1;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m256 Previous = _mm256_loadu_ps(Data + i - 1);
+            const __m256 Current = _mm256_loadu_ps(Data + i);
+            const int Mask = _mm256_movemask_ps(_mm256_and_ps(_mm256_cmp_ps(Previous, ThresholdVector, _CMP_LT_OQ), _mm256_cmp_ps(Current, ThresholdVector, _CMP_GE_OQ)));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindRisingCrossing(Data, i, EndFrame, Data[i - 1], Threshold);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline int32_t FindDirectionChange(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, bool bFalling)
+    {
+        if (StartFrame >= EndFrame || (bFalling ? (Data[StartFrame] < PreviousValue) : (Data[StartFrame] > PreviousValue)))
+        {
+            return StartFrame;
+        }
+
+        int32_t i = StartFrame + 1;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m256 Previous = _mm256_loadu_ps(Data + i - 1);
+            const __m256 Current = _mm256_loadu_ps(Data + i);
+            const int Mask = _mm256_movemask_ps(bFalling ? _mm256_cmp_ps(Current, Previous, _CMP_LT_OQ) : _mm256_cmp_ps(Current, Previous, _CMP_GT_OQ));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindDirectionChange(Data, i, EndFrame, Data[i - 1], bFalling);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline int32_t FindZeroCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue)
+    {
+        if (StartFrame >= EndFrame || Scalar::FindZeroCrossing(Data, StartFrame, StartFrame + 1, PreviousValue) == StartFrame)
+        {
+            return StartFrame;
+        }
+
+        const __m256 Zero = _mm256_setzero_ps();
+
+        int32_t i = StartFrame + 1;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m256 Previous = _mm256_loadu_ps(Data + i - 1);
+            const __m256 Current = _mm256_loadu_ps(Data + i);
+            const __m256 Upwards = _mm256_and_ps(_mm256_cmp_ps(Previous, Zero, _CMP_LE_OQ), _mm256_cmp_ps(Current, Zero, _CMP_GT_OQ));
+            const __m256 Downwards = _mm256_and_ps(_mm256_cmp_ps(Previous, Zero, _CMP_GE_OQ), _mm256_cmp_ps(Current, Zero, _CMP_LT_OQ));
+            const int Mask = _mm256_movemask_ps(_mm256_or_ps(Upwards, Downwards));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindZeroCrossing(Data, i, EndFrame, Data[i - 1]);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX2 inline int32_t FindNotEqual(const float* Data, int32_t StartFrame, int32_t EndFrame, float Value)
+    {
+        const __m256 ValueVector = _mm256_set1_ps(Value);
+
+        int32_t i = StartFrame;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const int Mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(Data + i), ValueVector, _CMP_NEQ_UQ));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindNotEqual(Data, i, EndFrame, Value);
+    }
+
+    // Sse2::ProcessAllPassWave() with eight lanes per vector
+    template<int32_t NumVectors>
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessAllPassWave(float* Recent, float* Older, const float* Feedback, int32_t NumStages, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t NumLanes = NumVectors * Width;
+        const int32_t FirstLane = NumLanes - NumStages;
+
+        alignas(32) float RecentLanes[NumLanes] = {};
+        alignas(32) float OlderLanes[NumLanes] = {};
+        alignas(32) float FeedbackLanes[NumLanes] = {};
+        std::memcpy(RecentLanes + FirstLane, Recent, sizeof(float) * NumStages);
+        std::memcpy(OlderLanes + FirstLane, Older, sizeof(float) * NumStages);
+        std::memcpy(FeedbackLanes + FirstLane, Feedback, sizeof(float) * NumStages);
+
+        __m256 RecentVectors[NumVectors];
+        __m256 OlderVectors[NumVectors];
+        __m256 FeedbackVectors[NumVectors];
+        __m256 NegatedFeedbackVectors[NumVectors];
+        __m256 OutVectors[NumVectors];
+        __m256i LaneIndices[NumVectors];
+        __m256i StageLanes[NumVectors];
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            RecentVectors[v] = _mm256_load_ps(RecentLanes + v * Width);
+            OlderVectors[v] = _mm256_load_ps(OlderLanes + v * Width);
+            FeedbackVectors[v] = _mm256_load_ps(FeedbackLanes + v * Width);
+            NegatedFeedbackVectors[v] = _mm256_xor_ps(FeedbackVectors[v], _mm256_set1_ps(-0.0f));
+            OutVectors[v] = _mm256_setzero_ps();
+            LaneIndices[v] = _mm256_add_epi32(_mm256_set1_epi32(v * Width), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            StageLanes[v] = _mm256_cmpgt_epi32(LaneIndices[v], _mm256_set1_epi32(FirstLane - 1));
+        }
+
+        const __m256i ShiftLanes = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+        const __m256i LastLane = _mm256_set1_epi32(Width - 1);
+        const __m256i FrameCount = _mm256_set1_epi32(NumFrames);
+        const __m256i MinusOne = _mm256_set1_epi32(-1);
+        const int32_t NumSteps = NumFrames + NumLanes - 1;
+
+        for (int32_t Step = 0; Step < NumSteps; ++Step)
+        {
+            // Lane k is on frame Step - k, and only updates its state while that frame is in the block
+            const bool bAllLanes = Step >= NumLanes - 1 && Step < NumFrames;
+            const __m256i StepVector = _mm256_set1_epi32(Step);
+
+            // The frame entering the first lane, then the last lane of each vector in turn, from the step before
+            __m256 Carry = _mm256_set1_ps(Step < NumFrames ? InOutData[Step] : 0.0f);
+
+            for (int32_t v = 0; v < NumVectors; ++v)
+            {
+                const __m256 Previous = OutVectors[v];
+                const __m256 In = _mm256_blend_ps(_mm256_permutevar8x32_ps(Previous, ShiftLanes), Carry, 0x01);
+                Carry = _mm256_permutevar8x32_ps(Previous, LastLane);
+
+                __m256 Out = _mm256_add_ps(_mm256_mul_ps(NegatedFeedbackVectors[v], In), OlderVectors[v]);
+                const __m256 NewRecent = _mm256_add_ps(In, _mm256_mul_ps(FeedbackVectors[v], Out));
+
+                if (v == 0 && FirstLane > 0)
+                {
+                    Out = _mm256_blendv_ps(In, Out, _mm256_castsi256_ps(StageLanes[0]));
+                }
+
+                if (bAllLanes)
+                {
+                    OlderVectors[v] = RecentVectors[v];
+                    RecentVectors[v] = NewRecent;
+                }
+                else
+                {
+                    const __m256i Frame = _mm256_sub_epi32(StepVector, LaneIndices[v]);
+                    const __m256 Valid = _mm256_castsi256_ps(_mm256_and_si256(StageLanes[v], _mm256_and_si256(_mm256_cmpgt_epi32(Frame, MinusOne), _mm256_cmpgt_epi32(FrameCount, Frame))));
+
+                    OlderVectors[v] = _mm256_blendv_ps(OlderVectors[v], RecentVectors[v], Valid);
+                    RecentVectors[v] = _mm256_blendv_ps(RecentVectors[v], NewRecent, Valid);
+                }
+
+                OutVectors[v] = Out;
+            }
+
+            // The last stage finishes frame Step - (NumLanes - 1)
+            if (Step >= NumLanes - 1)
+            {
+                InOutData[Step - (NumLanes - 1)] = _mm256_cvtss_f32(_mm256_permutevar8x32_ps(OutVectors[NumVectors - 1], LastLane));
+            }
+        }
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            _mm256_store_ps(RecentLanes + v * Width, RecentVectors[v]);
+            _mm256_store_ps(OlderLanes + v * Width, OlderVectors[v]);
+        }
+
+        std::memcpy(Recent, RecentLanes + FirstLane, sizeof(float) * NumStages);
+        std::memcpy(Older, OlderLanes + FirstLane, sizeof(float) * NumStages);
+    }
+
+    // Sse2::ProcessAllPassStages()
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t GroupStages = AllPassWaveVectors * Width;
+
+        for (int32_t Stage = 0; Stage < NumStages; Stage += GroupStages)
+        {
+            const int32_t Count = NumStages - Stage < GroupStages ? NumStages - Stage : GroupStages;
+
+            if (Count < AllPassWaveMinStages)
+            {
+                Scalar::ProcessAllPassStages(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                continue;
+            }
+
+            switch ((Count + Width - 1) / Width)
+            {
+            case 1:
+                ProcessAllPassWave<1>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            case 2:
+                ProcessAllPassWave<2>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            case 3:
+                ProcessAllPassWave<3>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            default:
+                ProcessAllPassWave<AllPassWaveVectors>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            }
+        }
+    }
+
+    // Sse2::ProcessAllPassChannelGroup() with eight channels to a vector
+    template<int32_t NumGroupStages>
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessAllPassChannelGroup(float* Recent, float* Older, const float* Feedback, int32_t StateStride, float* Interleaved, int32_t FrameStride, int32_t NumFrames)
+    {
+        __m256 RecentVectors[NumGroupStages];
+        __m256 OlderVectors[NumGroupStages];
+        __m256 FeedbackVectors[NumGroupStages];
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            RecentVectors[s] = _mm256_loadu_ps(Recent + s * StateStride);
+            OlderVectors[s] = _mm256_loadu_ps(Older + s * StateStride);
+            FeedbackVectors[s] = _mm256_loadu_ps(Feedback + s * StateStride);
+        }
+
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            float* Frame = Interleaved + i * FrameStride;
+            __m256 Signal = _mm256_loadu_ps(Frame);
+
+            for (int32_t s = 0; s < NumGroupStages; ++s)
+            {
+                const __m256 Out = _mm256_sub_ps(OlderVectors[s], _mm256_mul_ps(FeedbackVectors[s], Signal));
+
+                OlderVectors[s] = RecentVectors[s];
+                RecentVectors[s] = _mm256_add_ps(Signal, _mm256_mul_ps(FeedbackVectors[s], Out));
+                Signal = Out;
+            }
+
+            _mm256_storeu_ps(Frame, Signal);
+        }
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            _mm256_storeu_ps(Recent + s * StateStride, RecentVectors[s]);
+            _mm256_storeu_ps(Older + s * StateStride, OlderVectors[s]);
+        }
+    }
+
+    // Sse2::ProcessAllPassChannelPairGroup() with four channels to a frame
+    template<int32_t NumGroupStages>
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessAllPassChannelPairGroup(float* Recent, float* Older, const float* Feedback, int32_t StateStride, float* Interleaved, int32_t NumFrames)
+    {
+        constexpr int32_t Channels = Width / 2;
+
+        alignas(32) float Lanes[Width];
+        __m256 StateVectors[NumGroupStages];
+        __m256 FeedbackVectors[NumGroupStages];
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            std::memcpy(Lanes, Older + s * StateStride, sizeof(float) * Channels);
+            std::memcpy(Lanes + Channels, Recent + s * StateStride, sizeof(float) * Channels);
+            StateVectors[s] = _mm256_load_ps(Lanes);
+
+            std::memcpy(Lanes, Feedback + s * StateStride, sizeof(float) * Channels);
+            std::memcpy(Lanes + Channels, Feedback + s * StateStride, sizeof(float) * Channels);
+            FeedbackVectors[s] = _mm256_load_ps(Lanes);
+        }
+
+        for (int32_t i = 0; i < NumFrames; i += 2)
+        {
+            float* Frames = Interleaved + i * Channels;
+            __m256 Signal = _mm256_loadu_ps(Frames);
+
+            for (int32_t s = 0; s < NumGroupStages; ++s)
+            {
+                const __m256 Out = _mm256_sub_ps(StateVectors[s], _mm256_mul_ps(FeedbackVectors[s], Signal));
+
+                StateVectors[s] = _mm256_add_ps(Signal, _mm256_mul_ps(FeedbackVectors[s], Out));
+                Signal = Out;
+            }
+
+            _mm256_storeu_ps(Frames, Signal);
+        }
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            _mm256_store_ps(Lanes, StateVectors[s]);
+            std::memcpy(Older + s * StateStride, Lanes, sizeof(float) * Channels);
+            std::memcpy(Recent + s * StateStride, Lanes + Channels, sizeof(float) * Channels);
+        }
+    }
+
+    // Sse2::ProcessAllPassChannelStages()
+    template<bool bPairs>
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessAllPassChannelStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, int32_t NumChannels, float* Interleaved, int32_t NumFrames)
+    {
+        for (int32_t Channel = 0; Channel < NumChannels; Channel += Width)
+        {
+            for (int32_t Stage = 0; Stage < NumStages; Stage += AllPassWaveVectors)
+            {
+                float* StageRecent = Recent + Stage * NumChannels + Channel;
+                float* StageOlder = Older + Stage * NumChannels + Channel;
+                const float* StageFeedback = Feedback + Stage * NumChannels + Channel;
+                const int32_t Count = NumStages - Stage < AllPassWaveVectors ? NumStages - Stage : AllPassWaveVectors;
+
+                if constexpr (bPairs)
+                {
+                    switch (Count)
+                    {
+                    case 1:
+                        ProcessAllPassChannelPairGroup<1>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    case 2:
+                        ProcessAllPassChannelPairGroup<2>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    case 3:
+                        ProcessAllPassChannelPairGroup<3>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    default:
+                        ProcessAllPassChannelPairGroup<AllPassWaveVectors>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    }
+                }
+                else
+                {
+                    switch (Count)
+                    {
+                    case 1:
+                        ProcessAllPassChannelGroup<1>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    case 2:
+                        ProcessAllPassChannelGroup<2>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    case 3:
+                        ProcessAllPassChannelGroup<3>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    default:
+                        ProcessAllPassChannelGroup<AllPassWaveVectors>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Sse2::ProcessMultichannelAllPassStages() with pairs of frames of four channels, or single frames of eight;
+    // other counts take the SSE2 kernel
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessMultichannelAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, int32_t NumChannels, float* const* InOutData, int32_t NumFrames)
+    {
+        const bool bPairs = NumChannels * 2 == Width;
+        if (!bPairs && NumChannels != Width)
+        {
+            Sse2::ProcessMultichannelAllPassStages(Recent, Older, Feedback, NumStages, NumChannels, InOutData, NumFrames);
+            return;
+        }
+
+        alignas(32) float Interleaved[AllPassChannelChunkFrames * MaxAllPassChannels];
+        const int32_t NumVectorFrames = bPairs ? NumFrames & ~1 : NumFrames;
+
+        for (int32_t Start = 0; Start < NumVectorFrames; Start += AllPassChannelChunkFrames)
+        {
+            const int32_t Count = NumVectorFrames - Start < AllPassChannelChunkFrames ? NumVectorFrames - Start : AllPassChannelChunkFrames;
+
+            Scalar::InterleaveChannels(InOutData, NumChannels, Start, Count, Interleaved);
+
+            if (bPairs)
+            {
+                ProcessAllPassChannelStages<true>(Recent, Older, Feedback, NumStages, NumChannels, Interleaved, Count);
+            }
+            else
+            {
+                ProcessAllPassChannelStages<false>(Recent, Older, Feedback, NumStages, NumChannels, Interleaved, Count);
+            }
+
+            Scalar::DeinterleaveChannels(Interleaved, NumChannels, Start, Count, InOutData);
+        }
+
+        if (NumVectorFrames < NumFrames)
+        {
+            float* LastFrame[MaxAllPassChannels];
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                LastFrame[Channel] = InOutData[Channel] + NumVectorFrames;
+            }
+
+            Scalar::ProcessMultichannelAllPassStages(Recent, Older, Feedback, NumStages, NumChannels, LastFrame, NumFrames - NumVectorFrames);
+        }
+    }
+
+    // Sse2::ProcessAllPassSectionWave() with eight lanes per vector
+    template<int32_t NumVectors>
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessAllPassSectionWave(float* State1, float* State2, const float* A1, const float* A2, int32_t NumSections, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t NumLanes = NumVectors * Width;
+        const int32_t FirstLane = NumLanes - NumSections;
+
+        alignas(32) float State1Lanes[NumLanes] = {};
+        alignas(32) float State2Lanes[NumLanes] = {};
+        alignas(32) float A1Lanes[NumLanes] = {};
+        alignas(32) float A2Lanes[NumLanes] = {};
+        std::memcpy(State1Lanes + FirstLane, State1, sizeof(float) * NumSections);
+        std::memcpy(State2Lanes + FirstLane, State2, sizeof(float) * NumSections);
+        std::memcpy(A1Lanes + FirstLane, A1, sizeof(float) * NumSections);
+        std::memcpy(A2Lanes + FirstLane, A2, sizeof(float) * NumSections);
+
+        __m256 State1Vectors[NumVectors];
+        __m256 State2Vectors[NumVectors];
+        __m256 A1Vectors[NumVectors];
+        __m256 A2Vectors[NumVectors];
+        __m256 OutVectors[NumVectors];
+        __m256i LaneIndices[NumVectors];
+        __m256i SectionLanes[NumVectors];
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            State1Vectors[v] = _mm256_load_ps(State1Lanes + v * Width);
+            State2Vectors[v] = _mm256_load_ps(State2Lanes + v * Width);
+            A1Vectors[v] = _mm256_load_ps(A1Lanes + v * Width);
+            A2Vectors[v] = _mm256_load_ps(A2Lanes + v * Width);
+            OutVectors[v] = _mm256_setzero_ps();
+            LaneIndices[v] = _mm256_add_epi32(_mm256_set1_epi32(v * Width), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            SectionLanes[v] = _mm256_cmpgt_epi32(LaneIndices[v], _mm256_set1_epi32(FirstLane - 1));
+        }
+
+        const __m256i ShiftLanes = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+        const __m256i LastLane = _mm256_set1_epi32(Width - 1);
+        const __m256i FrameCount = _mm256_set1_epi32(NumFrames);
+        const __m256i MinusOne = _mm256_set1_epi32(-1);
+        const int32_t NumSteps = NumFrames + NumLanes - 1;
+
+        for (int32_t Step = 0; Step < NumSteps; ++Step)
+        {
+            // Lane k is on frame Step - k, and only updates its state while that frame is in the block
+            const bool bAllLanes = Step >= NumLanes - 1 && Step < NumFrames;
+            const __m256i StepVector = _mm256_set1_epi32(Step);
+
+            // The frame entering the first lane, then the last lane of each vector in turn, from the step before
+            __m256 Carry = _mm256_set1_ps(Step < NumFrames ? InOutData[Step] : 0.0f);
+
+            for (int32_t v = 0; v < NumVectors; ++v)
+            {
+                const __m256 Previous = OutVectors[v];
+                const __m256 In = _mm256_blend_ps(_mm256_permutevar8x32_ps(Previous, ShiftLanes), Carry, 0x01);
+                Carry = _mm256_permutevar8x32_ps(Previous, LastLane);
+
+                __m256 Out = _mm256_add_ps(_mm256_mul_ps(A2Vectors[v], In), State1Vectors[v]);
+                const __m256 NewState1 = _mm256_add_ps(_mm256_mul_ps(A1Vectors[v], _mm256_sub_ps(In, Out)), State2Vectors[v]);
+                const __m256 NewState2 = _mm256_sub_ps(In, _mm256_mul_ps(A2Vectors[v], Out));
+
+                if (v == 0 && FirstLane > 0)
+                {
+                    Out = _mm256_blendv_ps(In, Out, _mm256_castsi256_ps(SectionLanes[0]));
+                }
+
+                if (bAllLanes)
+                {
+                    State1Vectors[v] = NewState1;
+                    State2Vectors[v] = NewState2;
+                }
+                else
+                {
+                    const __m256i Frame = _mm256_sub_epi32(StepVector, LaneIndices[v]);
+                    const __m256 Valid = _mm256_castsi256_ps(_mm256_and_si256(SectionLanes[v], _mm256_and_si256(_mm256_cmpgt_epi32(Frame, MinusOne), _mm256_cmpgt_epi32(FrameCount, Frame))));
+
+                    State1Vectors[v] = _mm256_blendv_ps(State1Vectors[v], NewState1, Valid);
+                    State2Vectors[v] = _mm256_blendv_ps(State2Vectors[v], NewState2, Valid);
+                }
+
+                OutVectors[v] = Out;
+            }
+
+            // The last section finishes frame Step - (NumLanes - 1)
+            if (Step >= NumLanes - 1)
+            {
+                InOutData[Step - (NumLanes - 1)] = _mm256_cvtss_f32(_mm256_permutevar8x32_ps(OutVectors[NumVectors - 1], LastLane));
+            }
+        }
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            _mm256_store_ps(State1Lanes + v * Width, State1Vectors[v]);
+            _mm256_store_ps(State2Lanes + v * Width, State2Vectors[v]);
+        }
+
+        std::memcpy(State1, State1Lanes + FirstLane, sizeof(float) * NumSections);
+        std::memcpy(State2, State2Lanes + FirstLane, sizeof(float) * NumSections);
+    }
+
+    // Sse2::ProcessAllPassSections()
+    BRANCHES_KERNELS_TARGET_AVX2 inline void ProcessAllPassSections(float* State1, float* State2, const float* A1, const float* A2, int32_t NumSections, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t GroupSections = AllPassWaveVectors * Width;
+
+        for (int32_t Section = 0; Section < NumSections; Section += GroupSections)
+        {
+            const int32_t Count = NumSections - Section < GroupSections ? NumSections - Section : GroupSections;
+
+            if (Count < AllPassWaveMinStages)
+            {
+                Scalar::ProcessAllPassSections(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                continue;
+            }
+
+            switch ((Count + Width - 1) / Width)
+            {
+            case 1:
+                ProcessAllPassSectionWave<1>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            case 2:
+                ProcessAllPassSectionWave<2>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            case 3:
+                ProcessAllPassSectionWave<3>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            default:
+                ProcessAllPassSectionWave<AllPassWaveVectors>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            }
+        }
+    }
+
+    // Scalar::SumSpectrumProducts(), a vector of bins at a time with the sums kept in registers
+    BRANCHES_KERNELS_TARGET_AVX2 inline void SumSpectrumProducts(
+        const float* const* InputReal, const float* const* InputImag, const float* ResponseReal, const float* ResponseImag, int32_t NumSpectra, int32_t NumBins,
+        float* SumReal, float* SumImag, int32_t StartBin, int32_t EndBin)
+    {
+        int32_t Bin = StartBin;
+        for (; Bin + Width <= EndBin; Bin += Width)
+        {
+            __m256 Real = _mm256_setzero_ps();
+            __m256 Imag = _mm256_setzero_ps();
+
+            for (int32_t Spectrum = 0; Spectrum < NumSpectra; ++Spectrum)
+            {
+                const __m256 InReal = _mm256_loadu_ps(InputReal[Spectrum] + Bin);
+                const __m256 InImag = _mm256_loadu_ps(InputImag[Spectrum] + Bin);
+                const __m256 RespReal = _mm256_loadu_ps(ResponseReal + Spectrum * NumBins + Bin);
+                const __m256 RespImag = _mm256_loadu_ps(ResponseImag + Spectrum * NumBins + Bin);
+
+                Real = _mm256_add_ps(Real, _mm256_sub_ps(_mm256_mul_ps(InReal, RespReal), _mm256_mul_ps(InImag, RespImag)));
+                Imag = _mm256_add_ps(Imag, _mm256_add_ps(_mm256_mul_ps(InReal, RespImag), _mm256_mul_ps(InImag, RespReal)));
+            }
+
+            _mm256_storeu_ps(SumReal + Bin, Real);
+            _mm256_storeu_ps(SumImag + Bin, Imag);
+        }
+
+        Scalar::SumSpectrumProducts(InputReal, InputImag, ResponseReal, ResponseImag, NumSpectra, NumBins, SumReal, SumImag, Bin, EndBin);
+    }
+}
+
+#endif
@@ -0,0 +1,897 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// AVX-512 (F) versions of the dispatched kernels, 16 frames per iteration. Bit-identical with Scalar::.
+//
+// AVX-512F includes FMA, so arithmetic uses the explicit-rounding intrinsics, which the compiler can't contract
+// into fused multiply-adds. The peeled head and the tail are processed as masked vectors rather than scalar code.
+
+#include "MetasoundBranches/Public/Kernels/KernelIsa.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsAvx2.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsScalar.h"
+
+#if BRANCHES_KERNELS_X86
+
+namespace MetasoundBranches::Kernels::Avx512
+{
+    constexpr int32_t Width = 16;
+    constexpr uintptr_t Alignment = 64;
+    constexpr int Rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+
+    // Mask covering the first NumFrames lanes (NumFrames in [0, 16])
+    inline __mmask16 FirstLanes(int32_t NumFrames)
+    {
+        return static_cast<__mmask16>((1u << NumFrames) - 1u);
+    }
+
+    // Calls Body(Frame, Mask) over [0, NumFrames): one masked block up to Output's alignment, full blocks, then a masked tail
+    template<typename BodyType>
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ForEachBlock(const float* Output, int32_t NumFrames, BodyType&& Body)
+    {
+        int32_t i = GetPeelFrames(Output, NumFrames, Alignment);
+        if (i > 0)
+        {
+            Body(0, FirstLanes(i));
+        }
+
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            Body(i, static_cast<__mmask16>(0xFFFF));
+        }
+
+        if (i < NumFrames)
+        {
+            Body(i, FirstLanes(NumFrames - i));
+        }
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const __m512 LeftGainVector = _mm512_set1_ps(LeftGain);
+        const __m512 RightGainVector = _mm512_set1_ps(RightGain);
+
+        ForEachBlock(OutputLeftData, NumFrames, [&](int32_t i, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, LeftData + i), LeftGainVector, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, RightData + i), RightGainVector, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoSwapGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const __m512 LeftGainVector = _mm512_set1_ps(LeftGain);
+        const __m512 RightGainVector = _mm512_set1_ps(RightGain);
+
+        ForEachBlock(OutputLeftData, NumFrames, [&](int32_t i, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const __m512 Left = _mm512_maskz_loadu_ps(Mask, LeftData + i);
+            const __m512 Right = _mm512_maskz_loadu_ps(Mask, RightData + i);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_mul_round_ps(Mask, Right, LeftGainVector, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_mul_round_ps(Mask, Left, RightGainVector, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoWidth(const float* LeftData, const float* RightData, float WidthFactor, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const __m512 Half = _mm512_set1_ps(0.5f);
+        const __m512 WidthVector = _mm512_set1_ps(WidthFactor);
+
+        ForEachBlock(OutputLeftData, NumFrames, [&](int32_t i, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const __m512 Left = _mm512_maskz_loadu_ps(Mask, LeftData + i);
+            const __m512 Right = _mm512_maskz_loadu_ps(Mask, RightData + i);
+
+            const __m512 Mid = _mm512_maskz_mul_round_ps(Mask, Half, _mm512_maskz_add_round_ps(Mask, Left, Right, Rounding), Rounding);
+            const __m512 Side = _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_mul_round_ps(Mask, Half, _mm512_maskz_sub_round_ps(Mask, Left, Right, Rounding), Rounding), WidthVector, Rounding);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_add_round_ps(Mask, Mid, Side, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_sub_round_ps(Mask, Mid, Side, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoMix(
+        const float* LeftData1, const float* RightData1, float Gain1,
+        const float* LeftData2, const float* RightData2, float Gain2,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const __m512 Gain1Vector = _mm512_set1_ps(Gain1);
+        const __m512 Gain2Vector = _mm512_set1_ps(Gain2);
+
+        ForEachBlock(OutputLeftData, NumFrames, [&](int32_t i, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const __m512 Left1 = _mm512_maskz_mul_round_ps(Mask, Gain1Vector, _mm512_maskz_loadu_ps(Mask, LeftData1 + i), Rounding);
+            const __m512 Left2 = _mm512_maskz_mul_round_ps(Mask, Gain2Vector, _mm512_maskz_loadu_ps(Mask, LeftData2 + i), Rounding);
+            const __m512 Right1 = _mm512_maskz_mul_round_ps(Mask, Gain1Vector, _mm512_maskz_loadu_ps(Mask, RightData1 + i), Rounding);
+            const __m512 Right2 = _mm512_maskz_mul_round_ps(Mask, Gain2Vector, _mm512_maskz_loadu_ps(Mask, RightData2 + i), Rounding);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_add_round_ps(Mask, Left1, Left2, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_add_round_ps(Mask, Right1, Right2, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoAccumulate(const float* LeftData, const float* RightData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        ForEachBlock(OutputLeftData, NumFrames, [&](int32_t i, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const __m512 Left = _mm512_maskz_add_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, OutputLeftData + i), _mm512_maskz_loadu_ps(Mask, LeftData + i), Rounding);
+            const __m512 Right = _mm512_maskz_add_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, OutputRightData + i), _mm512_maskz_loadu_ps(Mask, RightData + i), Rounding);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, Left);
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, Right);
+        });
+    }
+
+    // Indices of the frames in the vector starting at Frame
+    BRANCHES_KERNELS_TARGET_AVX512 inline __m512 FrameIndices(int32_t Frame)
+    {
+        return _mm512_add_ps(_mm512_set1_ps(static_cast<float>(Frame)), _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f));
+    }
+
+    // Start + Step * Frame for the frames in the vector starting at Frame
+    BRANCHES_KERNELS_TARGET_AVX512 inline __m512 RampGains(__mmask16 Mask, __m512 Start, __m512 Step, int32_t Frame)
+    {
+        return _mm512_maskz_add_round_ps(Mask, Start, _mm512_maskz_mul_round_ps(Mask, Step, FrameIndices(Frame), Rounding), Rounding);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoGainsRamp(const float* LeftData, const float* RightData, float LeftStart, float LeftStep, float RightStart, float RightStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const __m512 LeftStartVector = _mm512_set1_ps(LeftStart);
+        const __m512 LeftStepVector = _mm512_set1_ps(LeftStep);
+        const __m512 RightStartVector = _mm512_set1_ps(RightStart);
+        const __m512 RightStepVector = _mm512_set1_ps(RightStep);
+
+        ForEachBlock(OutputLeftData + StartFrame, EndFrame - StartFrame, [&](int32_t Offset, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const int32_t i = StartFrame + Offset;
+            const __m512 LeftGain = RampGains(Mask, LeftStartVector, LeftStepVector, i);
+            const __m512 RightGain = RampGains(Mask, RightStartVector, RightStepVector, i);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, LeftData + i), LeftGain, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, RightData + i), RightGain, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoWidthRamp(const float* LeftData, const float* RightData, float WidthStart, float WidthStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const __m512 Half = _mm512_set1_ps(0.5f);
+        const __m512 WidthStartVector = _mm512_set1_ps(WidthStart);
+        const __m512 WidthStepVector = _mm512_set1_ps(WidthStep);
+
+        ForEachBlock(OutputLeftData + StartFrame, EndFrame - StartFrame, [&](int32_t Offset, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const int32_t i = StartFrame + Offset;
+            const __m512 Left = _mm512_maskz_loadu_ps(Mask, LeftData + i);
+            const __m512 Right = _mm512_maskz_loadu_ps(Mask, RightData + i);
+            const __m512 WidthFactor = RampGains(Mask, WidthStartVector, WidthStepVector, i);
+
+            const __m512 Mid = _mm512_maskz_mul_round_ps(Mask, Half, _mm512_maskz_add_round_ps(Mask, Left, Right, Rounding), Rounding);
+            const __m512 Side = _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_mul_round_ps(Mask, Half, _mm512_maskz_sub_round_ps(Mask, Left, Right, Rounding), Rounding), WidthFactor, Rounding);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_add_round_ps(Mask, Mid, Side, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_sub_round_ps(Mask, Mid, Side, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoMixRamp(
+        const float* LeftData1, const float* RightData1, float Gain1Start, float Gain1Step,
+        const float* LeftData2, const float* RightData2, float Gain2Start, float Gain2Step,
+        float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const __m512 Gain1StartVector = _mm512_set1_ps(Gain1Start);
+        const __m512 Gain1StepVector = _mm512_set1_ps(Gain1Step);
+        const __m512 Gain2StartVector = _mm512_set1_ps(Gain2Start);
+        const __m512 Gain2StepVector = _mm512_set1_ps(Gain2Step);
+
+        ForEachBlock(OutputLeftData + StartFrame, EndFrame - StartFrame, [&](int32_t Offset, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const int32_t i = StartFrame + Offset;
+            const __m512 Gain1 = RampGains(Mask, Gain1StartVector, Gain1StepVector, i);
+            const __m512 Gain2 = RampGains(Mask, Gain2StartVector, Gain2StepVector, i);
+
+            const __m512 Left1 = _mm512_maskz_mul_round_ps(Mask, Gain1, _mm512_maskz_loadu_ps(Mask, LeftData1 + i), Rounding);
+            const __m512 Left2 = _mm512_maskz_mul_round_ps(Mask, Gain2, _mm512_maskz_loadu_ps(Mask, LeftData2 + i), Rounding);
+            const __m512 Right1 = _mm512_maskz_mul_round_ps(Mask, Gain1, _mm512_maskz_loadu_ps(Mask, RightData1 + i), Rounding);
+            const __m512 Right2 = _mm512_maskz_mul_round_ps(Mask, Gain2, _mm512_maskz_loadu_ps(Mask, RightData2 + i), Rounding);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_add_round_ps(Mask, Left1, Left2, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_add_round_ps(Mask, Right1, Right2, Rounding));
+        });
+    }
+
+    // RampGains(), or Start when nothing in the block ramps
+    template<bool bRamp>
+    BRANCHES_KERNELS_TARGET_AVX512 inline __m512 RampAt(__mmask16 Mask, __m512 Start, __m512 Step, int32_t Frame)
+    {
+        if constexpr (bRamp)
+        {
+            return RampGains(Mask, Start, Step, Frame);
+        }
+        else
+        {
+            return Start;
+        }
+    }
+
+    template<bool bMidSide, bool bRamp>
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoMatrixFrames(const float* LeftData, const float* RightData, FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const __m512 Half = _mm512_set1_ps(0.5f);
+        const __m512 WidthStart = _mm512_set1_ps(WidthRamp.Start);
+        const __m512 WidthStep = _mm512_set1_ps(WidthRamp.Step);
+        const __m512 LeftGainStart = _mm512_set1_ps(LeftRamp.Start);
+        const __m512 LeftGainStep = _mm512_set1_ps(LeftRamp.Step);
+        const __m512 RightGainStart = _mm512_set1_ps(RightRamp.Start);
+        const __m512 RightGainStep = _mm512_set1_ps(RightRamp.Step);
+        const __m512 GainStart = _mm512_set1_ps(GainRamp.Start);
+        const __m512 GainStep = _mm512_set1_ps(GainRamp.Step);
+
+        ForEachBlock(OutputLeftData + StartFrame, EndFrame - StartFrame, [&](int32_t Offset, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const int32_t i = StartFrame + Offset;
+
+            __m512 Left = _mm512_maskz_loadu_ps(Mask, LeftData + i);
+            __m512 Right = _mm512_maskz_loadu_ps(Mask, RightData + i);
+
+            if constexpr (bMidSide)
+            {
+                const __m512 WidthFactor = RampAt<bRamp>(Mask, WidthStart, WidthStep, i);
+                const __m512 Mid = _mm512_maskz_mul_round_ps(Mask, Half, _mm512_maskz_add_round_ps(Mask, Left, Right, Rounding), Rounding);
+                const __m512 Side = _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_mul_round_ps(Mask, Half, _mm512_maskz_sub_round_ps(Mask, Left, Right, Rounding), Rounding), WidthFactor, Rounding);
+
+                Left = _mm512_maskz_add_round_ps(Mask, Mid, Side, Rounding);
+                Right = _mm512_maskz_sub_round_ps(Mask, Mid, Side, Rounding);
+            }
+
+            const __m512 OutputGain = RampAt<bRamp>(Mask, GainStart, GainStep, i);
+            const __m512 LeftBalance = RampAt<bRamp>(Mask, LeftGainStart, LeftGainStep, i);
+            const __m512 RightBalance = RampAt<bRamp>(Mask, RightGainStart, RightGainStep, i);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_mul_round_ps(Mask, Left, LeftBalance, Rounding), OutputGain, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_mul_round_ps(Mask, Right, RightBalance, Rounding), OutputGain, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoMatrix(const float* LeftData, const float* RightData, bool bMidSide, FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const bool bRamp = Scalar::IsMatrixRamping(WidthRamp, LeftRamp, RightRamp, GainRamp);
+
+        if (bMidSide && bRamp)
+        {
+            ProcessStereoMatrixFrames<true, true>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else if (bMidSide)
+        {
+            ProcessStereoMatrixFrames<true, false>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else if (bRamp)
+        {
+            ProcessStereoMatrixFrames<false, true>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else
+        {
+            ProcessStereoMatrixFrames<false, false>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessMultichannelWidthRamp(const float* const* InputData, float* const* OutputData, int32_t NumChannels, float WidthStart, float WidthStep, int32_t StartFrame, int32_t EndFrame)
+    {
+        const __m512 Scale = _mm512_set1_ps(1.0f / static_cast<float>(NumChannels));
+        const __m512 WidthStartVector = _mm512_set1_ps(WidthStart);
+        const __m512 WidthStepVector = _mm512_set1_ps(WidthStep);
+
+        ForEachBlock(OutputData[0] + StartFrame, EndFrame - StartFrame, [&](int32_t Offset, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const int32_t i = StartFrame + Offset;
+
+            __m512 Sum = _mm512_maskz_loadu_ps(Mask, InputData[0] + i);
+            for (int32_t Channel = 1; Channel < NumChannels; ++Channel)
+            {
+                Sum = _mm512_maskz_add_round_ps(Mask, Sum, _mm512_maskz_loadu_ps(Mask, InputData[Channel] + i), Rounding);
+            }
+
+            const __m512 Mid = _mm512_maskz_mul_round_ps(Mask, Sum, Scale, Rounding);
+            const __m512 WidthFactor = RampGains(Mask, WidthStartVector, WidthStepVector, i);
+
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const __m512 Side = _mm512_maskz_sub_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, InputData[Channel] + i), Mid, Rounding);
+                _mm512_mask_storeu_ps(OutputData[Channel] + i, Mask, _mm512_maskz_add_round_ps(Mask, Mid, _mm512_maskz_mul_round_ps(Mask, Side, WidthFactor, Rounding), Rounding));
+            }
+        });
+    }
+
+    // Scalar::ReduceStereoSumLanes() on one vector of lanes. Only the first step needs 512-bit registers; the rest
+    // runs on the lower halves, with the SSE rounding mode, which is the same round-to-nearest.
+    BRANCHES_KERNELS_TARGET_AVX512 inline __m256 LowerHalf(__m512 Lanes)
+    {
+        return _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(Lanes), 0));
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline __m256 UpperHalf(__m512 Lanes)
+    {
+        return _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(Lanes), 1));
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline float ReduceSumLanes(__m512 Lanes)
+    {
+        const __m256 Octet = _mm256_add_ps(LowerHalf(Lanes), UpperHalf(Lanes));
+        const __m128 Quad = _mm_add_ps(_mm256_castps256_ps128(Octet), _mm256_extractf128_ps(Octet, 1));
+        const __m128 Pairs = _mm_add_ps(Quad, _mm_movehl_ps(Quad, Quad));
+        return _mm_cvtss_f32(_mm_add_ss(Pairs, _mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline float ReducePeakLanes(__m512 Lanes)
+    {
+        const __m256 Octet = _mm256_max_ps(UpperHalf(Lanes), LowerHalf(Lanes));
+        const __m128 Quad = _mm_max_ps(_mm256_extractf128_ps(Octet, 1), _mm256_castps256_ps128(Octet));
+        const __m128 Pairs = _mm_max_ps(_mm_movehl_ps(Quad, Quad), Quad);
+        return _mm_cvtss_f32(_mm_max_ss(_mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 1, 1, 1)), Pairs));
+    }
+
+    // Scalar::AccumulateStereoSums(), one vector of lanes; the tail updates only its lanes
+    BRANCHES_KERNELS_TARGET_AVX512 inline FStereoSums AccumulateStereoSums(const float* LeftData, const float* RightData, int32_t NumFrames)
+    {
+        static_assert(SumLanes == Width, "One vector per group of lanes");
+
+        __m512 LeftRight = _mm512_setzero_ps();
+        __m512 LeftSquared = _mm512_setzero_ps();
+        __m512 RightSquared = _mm512_setzero_ps();
+        __m512 LeftPeak = _mm512_setzero_ps();
+        __m512 RightPeak = _mm512_setzero_ps();
+
+        for (int32_t i = 0; i < NumFrames; i += Width)
+        {
+            const __mmask16 Mask = (NumFrames - i >= Width) ? static_cast<__mmask16>(0xFFFF) : FirstLanes(NumFrames - i);
+            const __m512 Left = _mm512_maskz_loadu_ps(Mask, LeftData + i);
+            const __m512 Right = _mm512_maskz_loadu_ps(Mask, RightData + i);
+
+            LeftRight = _mm512_mask_add_round_ps(LeftRight, Mask, LeftRight, _mm512_maskz_mul_round_ps(Mask, Left, Right, Rounding), Rounding);
+            LeftSquared = _mm512_mask_add_round_ps(LeftSquared, Mask, LeftSquared, _mm512_maskz_mul_round_ps(Mask, Left, Left, Rounding), Rounding);
+            RightSquared = _mm512_mask_add_round_ps(RightSquared, Mask, RightSquared, _mm512_maskz_mul_round_ps(Mask, Right, Right, Rounding), Rounding);
+            LeftPeak = _mm512_mask_max_ps(LeftPeak, Mask, _mm512_abs_ps(Left), LeftPeak);
+            RightPeak = _mm512_mask_max_ps(RightPeak, Mask, _mm512_abs_ps(Right), RightPeak);
+        }
+
+        FStereoSums Sums;
+        Sums.LeftRight = ReduceSumLanes(LeftRight);
+        Sums.LeftSquared = ReduceSumLanes(LeftSquared);
+        Sums.RightSquared = ReduceSumLanes(RightSquared);
+        Sums.LeftPeak = ReducePeakLanes(LeftPeak);
+        Sums.RightPeak = ReducePeakLanes(RightPeak);
+        return Sums;
+    }
+
+    // Scalar::Clamp() per lane; the operand order of min / max reproduces its NaN handling
+    BRANCHES_KERNELS_TARGET_AVX512 inline __m512 ClampVector(__mmask16 Mask, __m512 Value, __m512 Min, __m512 Max)
+    {
+        return _mm512_maskz_max_ps(Mask, Min, _mm512_maskz_min_ps(Mask, Value, Max));
+    }
+
+    // Scalar::LookupQuarterSine() per lane, gathering both interpolation points for the active lanes
+    BRANCHES_KERNELS_TARGET_AVX512 inline __m512 LookupQuarterSine(__mmask16 Mask, const float* Table, __m512 Position)
+    {
+        const __m512 Index = _mm512_maskz_mul_round_ps(Mask, Position, _mm512_set1_ps(static_cast<float>(QuarterSineTableSize)), Rounding);
+        const __m512i Whole = _mm512_maskz_cvtt_roundps_epi32(Mask, Index, _MM_FROUND_NO_EXC);
+        const __m512 Fraction = _mm512_maskz_sub_round_ps(Mask, Index, _mm512_maskz_cvtepi32_ps(Mask, Whole), Rounding);
+
+        const __m512 Lower = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), Mask, Whole, Table, 4);
+        const __m512 Upper = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), Mask, Whole, Table + 1, 4);
+
+        return _mm512_maskz_add_round_ps(Mask, Lower, _mm512_maskz_mul_round_ps(Mask, Fraction, _mm512_maskz_sub_round_ps(Mask, Upper, Lower, Rounding), Rounding), Rounding);
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoBalanceAudio(const float* LeftData, const float* RightData, const float* BalanceData, const float* Table, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const __m512 One = _mm512_set1_ps(1.0f);
+        const __m512 MinusOne = _mm512_set1_ps(-1.0f);
+        const __m512 Half = _mm512_set1_ps(0.5f);
+
+        ForEachBlock(OutputLeftData, NumFrames, [&](int32_t i, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const __m512 Balance = ClampVector(Mask, _mm512_maskz_loadu_ps(Mask, BalanceData + i), MinusOne, One);
+            const __m512 Position = _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_add_round_ps(Mask, Balance, One, Rounding), Half, Rounding);
+            const __m512 LeftGain = LookupQuarterSine(Mask, Table, _mm512_maskz_sub_round_ps(Mask, One, Position, Rounding));
+            const __m512 RightGain = LookupQuarterSine(Mask, Table, Position);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, LeftData + i), LeftGain, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_mul_round_ps(Mask, _mm512_maskz_loadu_ps(Mask, RightData + i), RightGain, Rounding));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessStereoCrossfadeAudio(
+        const float* LeftData1, const float* RightData1,
+        const float* LeftData2, const float* RightData2,
+        const float* CrossfadeData, const float* Table,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const __m512 Zero = _mm512_setzero_ps();
+        const __m512 One = _mm512_set1_ps(1.0f);
+
+        ForEachBlock(OutputLeftData, NumFrames, [&](int32_t i, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const __m512 Position = ClampVector(Mask, _mm512_maskz_loadu_ps(Mask, CrossfadeData + i), Zero, One);
+            const __m512 Gain1 = LookupQuarterSine(Mask, Table, _mm512_maskz_sub_round_ps(Mask, One, Position, Rounding));
+            const __m512 Gain2 = LookupQuarterSine(Mask, Table, Position);
+
+            const __m512 Left1 = _mm512_maskz_mul_round_ps(Mask, Gain1, _mm512_maskz_loadu_ps(Mask, LeftData1 + i), Rounding);
+            const __m512 Left2 = _mm512_maskz_mul_round_ps(Mask, Gain2, _mm512_maskz_loadu_ps(Mask, LeftData2 + i), Rounding);
+            const __m512 Right1 = _mm512_maskz_mul_round_ps(Mask, Gain1, _mm512_maskz_loadu_ps(Mask, RightData1 + i), Rounding);
+            const __m512 Right2 = _mm512_maskz_mul_round_ps(Mask, Gain2, _mm512_maskz_loadu_ps(Mask, RightData2 + i), Rounding);
+
+            _mm512_mask_storeu_ps(OutputLeftData + i, Mask, _mm512_maskz_add_round_ps(Mask, Left1, Left2, Rounding));
+            _mm512_mask_storeu_ps(OutputRightData + i, Mask, _mm512_maskz_add_round_ps(Mask, Right1, Right2, Rounding));
+        });
+    }
+
+    // The searches check the first frame against PreviousValue, then compare each vector of frames with the same
+    // vector loaded one frame earlier. CompareType(Previous, Current) returns the lanes that match.
+    template<typename CompareType>
+    BRANCHES_KERNELS_TARGET_AVX512 inline int32_t FindFirst(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, CompareType&& Compare)
+    {
+        if (StartFrame >= EndFrame)
+        {
+            return EndFrame;
+        }
+
+        if (Compare(_mm512_set1_ps(PreviousValue), _mm512_set1_ps(Data[StartFrame])) & 1)
+        {
+            return StartFrame;
+        }
+
+        for (int32_t i = StartFrame + 1; i < EndFrame; i += Width)
+        {
+            const __mmask16 Lanes = (EndFrame - i >= Width) ? static_cast<__mmask16>(0xFFFF) : FirstLanes(EndFrame - i);
+            const __m512 Previous = _mm512_maskz_loadu_ps(Lanes, Data + i - 1);
+            const __m512 Current = _mm512_maskz_loadu_ps(Lanes, Data + i);
+            const __mmask16 Mask = Compare(Previous, Current) & Lanes;
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return EndFrame;
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline int32_t FindRisingCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, float Threshold)
+    {
+        const __m512 ThresholdVector = _mm512_set1_ps(Threshold);
+
+        return FindFirst(Data, StartFrame, EndFrame, PreviousValue, [ThresholdVector](__m512 Previous, __m512 Current) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            return static_cast<__mmask16>(_mm512_cmp_ps_mask(Previous, ThresholdVector, _CMP_LT_OQ) & _mm512_cmp_ps_mask(Current, ThresholdVector, _CMP_GE_OQ));
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline int32_t FindDirectionChange(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, bool bFalling)
+    {
+        return FindFirst(Data, StartFrame, EndFrame, PreviousValue, [bFalling](__m512 Previous, __m512 Current) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            return bFalling ? _mm512_cmp_ps_mask(Current, Previous, _CMP_LT_OQ) : _mm512_cmp_ps_mask(Current, Previous, _CMP_GT_OQ);
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline int32_t FindZeroCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue)
+    {
+        const __m512 Zero = _mm512_setzero_ps();
+
+        return FindFirst(Data, StartFrame, EndFrame, PreviousValue, [Zero](__m512 Previous, __m512 Current) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const __mmask16 Upwards = _mm512_cmp_ps_mask(Previous, Zero, _CMP_LE_OQ) & _mm512_cmp_ps_mask(Current, Zero, _CMP_GT_OQ);
+            const __mmask16 Downwards = _mm512_cmp_ps_mask(Previous, Zero, _CMP_GE_OQ) & _mm512_cmp_ps_mask(Current, Zero, _CMP_LT_OQ);
+            return static_cast<__mmask16>(Upwards | Downwards);
+        });
+    }
+
+    BRANCHES_KERNELS_TARGET_AVX512 inline int32_t FindNotEqual(const float* Data, int32_t StartFrame, int32_t EndFrame, float Value)
+    {
+        const __m512 ValueVector = _mm512_set1_ps(Value);
+
+        for (int32_t i = StartFrame; i < EndFrame; i += Width)
+        {
+            const __mmask16 Lanes = (EndFrame - i >= Width) ? static_cast<__mmask16>(0xFFFF) : FirstLanes(EndFrame - i);
+            const __mmask16 Mask = _mm512_mask_cmp_ps_mask(Lanes, _mm512_maskz_loadu_ps(Lanes, Data + i), ValueVector, _CMP_NEQ_UQ);
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return EndFrame;
+    }
+
+    // Sse2::ProcessAllPassWave() with sixteen lanes per vector and the lane masks in mask registers
+    template<int32_t NumVectors>
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessAllPassWave(float* Recent, float* Older, const float* Feedback, int32_t NumStages, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t NumLanes = NumVectors * Width;
+        const int32_t FirstLane = NumLanes - NumStages;
+        const __mmask16 AllLanes = 0xFFFF;
+
+        alignas(64) float RecentLanes[NumLanes] = {};
+        alignas(64) float OlderLanes[NumLanes] = {};
+        alignas(64) float FeedbackLanes[NumLanes] = {};
+        std::memcpy(RecentLanes + FirstLane, Recent, sizeof(float) * NumStages);
+        std::memcpy(OlderLanes + FirstLane, Older, sizeof(float) * NumStages);
+        std::memcpy(FeedbackLanes + FirstLane, Feedback, sizeof(float) * NumStages);
+
+        __m512 RecentVectors[NumVectors];
+        __m512 OlderVectors[NumVectors];
+        __m512 FeedbackVectors[NumVectors];
+        __m512 NegatedFeedbackVectors[NumVectors];
+        __m512 OutVectors[NumVectors];
+        __m512i LaneIndices[NumVectors];
+        __mmask16 StageLanes[NumVectors];
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            RecentVectors[v] = _mm512_maskz_load_ps(AllLanes, RecentLanes + v * Width);
+            OlderVectors[v] = _mm512_maskz_load_ps(AllLanes, OlderLanes + v * Width);
+            FeedbackVectors[v] = _mm512_maskz_load_ps(AllLanes, FeedbackLanes + v * Width);
+            NegatedFeedbackVectors[v] = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(FeedbackVectors[v]), _mm512_set1_epi32(static_cast<int32_t>(0x80000000u))));
+            OutVectors[v] = _mm512_setzero_ps();
+            LaneIndices[v] = _mm512_add_epi32(_mm512_set1_epi32(v * Width), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+            StageLanes[v] = _mm512_cmpge_epi32_mask(LaneIndices[v], _mm512_set1_epi32(FirstLane));
+        }
+
+        // Lane 0 from the last lane of the second operand, every other lane from the lane below it
+        const __m512i ShiftLanes = _mm512_setr_epi32(31, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14);
+        const __m512i LastLane = _mm512_set1_epi32(Width - 1);
+        const __m512i FrameCount = _mm512_set1_epi32(NumFrames);
+        const __m512i Zero = _mm512_setzero_si512();
+        const int32_t NumSteps = NumFrames + NumLanes - 1;
+
+        for (int32_t Step = 0; Step < NumSteps; ++Step)
+        {
+            // Lane k is on frame Step - k, and only updates its state while that frame is in the block
+            const bool bAllLanes = Step >= NumLanes - 1 && Step < NumFrames;
+            const __m512i StepVector = _mm512_set1_epi32(Step);
+
+            // The frame entering the first lane, then the last vector's outputs from the step before
+            __m512 Carry = _mm512_set1_ps(Step < NumFrames ? InOutData[Step] : 0.0f);
+
+            for (int32_t v = 0; v < NumVectors; ++v)
+            {
+                const __m512 Previous = OutVectors[v];
+                const __m512 In = _mm512_permutex2var_ps(Previous, ShiftLanes, Carry);
+                Carry = Previous;
+
+                __m512 Out = _mm512_maskz_add_round_ps(AllLanes, _mm512_maskz_mul_round_ps(AllLanes, NegatedFeedbackVectors[v], In, Rounding), OlderVectors[v], Rounding);
+                const __m512 NewRecent = _mm512_maskz_add_round_ps(AllLanes, In, _mm512_maskz_mul_round_ps(AllLanes, FeedbackVectors[v], Out, Rounding), Rounding);
+
+                if (v == 0 && FirstLane > 0)
+                {
+                    Out = _mm512_mask_mov_ps(In, StageLanes[0], Out);
+                }
+
+                __mmask16 Valid = StageLanes[v];
+                if (!bAllLanes)
+                {
+                    const __m512i Frame = _mm512_sub_epi32(StepVector, LaneIndices[v]);
+                    Valid &= _mm512_cmpge_epi32_mask(Frame, Zero) & _mm512_cmplt_epi32_mask(Frame, FrameCount);
+                }
+
+                OlderVectors[v] = _mm512_mask_mov_ps(OlderVectors[v], Valid, RecentVectors[v]);
+                RecentVectors[v] = _mm512_mask_mov_ps(RecentVectors[v], Valid, NewRecent);
+                OutVectors[v] = Out;
+            }
+
+            // The last stage finishes frame Step - (NumLanes - 1)
+            if (Step >= NumLanes - 1)
+            {
+                InOutData[Step - (NumLanes - 1)] = _mm512_cvtss_f32(_mm512_maskz_permutexvar_ps(AllLanes, LastLane, OutVectors[NumVectors - 1]));
+            }
+        }
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            _mm512_store_ps(RecentLanes + v * Width, RecentVectors[v]);
+            _mm512_store_ps(OlderLanes + v * Width, OlderVectors[v]);
+        }
+
+        std::memcpy(Recent, RecentLanes + FirstLane, sizeof(float) * NumStages);
+        std::memcpy(Older, OlderLanes + FirstLane, sizeof(float) * NumStages);
+    }
+
+    // Sse2::ProcessAllPassStages()
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t GroupStages = AllPassWaveVectors * Width;
+
+        for (int32_t Stage = 0; Stage < NumStages; Stage += GroupStages)
+        {
+            const int32_t Count = NumStages - Stage < GroupStages ? NumStages - Stage : GroupStages;
+
+            if (Count < AllPassWaveMinStages)
+            {
+                Scalar::ProcessAllPassStages(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                continue;
+            }
+
+            switch ((Count + Width - 1) / Width)
+            {
+            case 1:
+                ProcessAllPassWave<1>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            case 2:
+                ProcessAllPassWave<2>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            case 3:
+                ProcessAllPassWave<3>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            default:
+                ProcessAllPassWave<AllPassWaveVectors>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            }
+        }
+    }
+
+    // Sse2::ProcessAllPassChannelPairGroup() with eight channels to a frame
+    template<int32_t NumGroupStages>
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessAllPassChannelPairGroup(float* Recent, float* Older, const float* Feedback, int32_t StateStride, float* Interleaved, int32_t NumFrames)
+    {
+        constexpr int32_t Channels = Width / 2;
+        const __mmask16 AllLanes = 0xFFFF;
+
+        alignas(64) float Lanes[Width];
+        __m512 StateVectors[NumGroupStages];
+        __m512 FeedbackVectors[NumGroupStages];
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            std::memcpy(Lanes, Older + s * StateStride, sizeof(float) * Channels);
+            std::memcpy(Lanes + Channels, Recent + s * StateStride, sizeof(float) * Channels);
+            StateVectors[s] = _mm512_load_ps(Lanes);
+
+            std::memcpy(Lanes, Feedback + s * StateStride, sizeof(float) * Channels);
+            std::memcpy(Lanes + Channels, Feedback + s * StateStride, sizeof(float) * Channels);
+            FeedbackVectors[s] = _mm512_load_ps(Lanes);
+        }
+
+        for (int32_t i = 0; i < NumFrames; i += 2)
+        {
+            float* Frames = Interleaved + i * Channels;
+            __m512 Signal = _mm512_loadu_ps(Frames);
+
+            for (int32_t s = 0; s < NumGroupStages; ++s)
+            {
+                const __m512 Out = _mm512_maskz_sub_round_ps(AllLanes, StateVectors[s], _mm512_maskz_mul_round_ps(AllLanes, FeedbackVectors[s], Signal, Rounding), Rounding);
+
+                StateVectors[s] = _mm512_maskz_add_round_ps(AllLanes, Signal, _mm512_maskz_mul_round_ps(AllLanes, FeedbackVectors[s], Out, Rounding), Rounding);
+                Signal = Out;
+            }
+
+            _mm512_storeu_ps(Frames, Signal);
+        }
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            _mm512_store_ps(Lanes, StateVectors[s]);
+            std::memcpy(Older + s * StateStride, Lanes, sizeof(float) * Channels);
+            std::memcpy(Recent + s * StateStride, Lanes + Channels, sizeof(float) * Channels);
+        }
+    }
+
+    // Sse2::ProcessMultichannelAllPassStages() with pairs of frames of eight channels; fewer channels take the AVX2
+    // kernel
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessMultichannelAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, int32_t NumChannels, float* const* InOutData, int32_t NumFrames)
+    {
+        if (NumChannels * 2 != Width)
+        {
+            Avx2::ProcessMultichannelAllPassStages(Recent, Older, Feedback, NumStages, NumChannels, InOutData, NumFrames);
+            return;
+        }
+
+        alignas(64) float Interleaved[AllPassChannelChunkFrames * MaxAllPassChannels];
+        const int32_t NumVectorFrames = NumFrames & ~1;
+
+        for (int32_t Start = 0; Start < NumVectorFrames; Start += AllPassChannelChunkFrames)
+        {
+            const int32_t Count = NumVectorFrames - Start < AllPassChannelChunkFrames ? NumVectorFrames - Start : AllPassChannelChunkFrames;
+
+            Scalar::InterleaveChannels(InOutData, NumChannels, Start, Count, Interleaved);
+
+            for (int32_t Stage = 0; Stage < NumStages; Stage += AllPassWaveVectors)
+            {
+                float* StageRecent = Recent + Stage * NumChannels;
+                float* StageOlder = Older + Stage * NumChannels;
+                const float* StageFeedback = Feedback + Stage * NumChannels;
+
+                switch (NumStages - Stage < AllPassWaveVectors ? NumStages - Stage : AllPassWaveVectors)
+                {
+                case 1:
+                    ProcessAllPassChannelPairGroup<1>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, Count);
+                    break;
+                case 2:
+                    ProcessAllPassChannelPairGroup<2>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, Count);
+                    break;
+                case 3:
+                    ProcessAllPassChannelPairGroup<3>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, Count);
+                    break;
+                default:
+                    ProcessAllPassChannelPairGroup<AllPassWaveVectors>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, Count);
+                    break;
+                }
+            }
+
+            Scalar::DeinterleaveChannels(Interleaved, NumChannels, Start, Count, InOutData);
+        }
+
+        if (NumVectorFrames < NumFrames)
+        {
+            float* LastFrame[MaxAllPassChannels];
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                LastFrame[Channel] = InOutData[Channel] + NumVectorFrames;
+            }
+
+            Scalar::ProcessMultichannelAllPassStages(Recent, Older, Feedback, NumStages, NumChannels, LastFrame, NumFrames - NumVectorFrames);
+        }
+    }
+
+    // Sse2::ProcessAllPassSectionWave() with sixteen lanes per vector and the lane masks in mask registers
+    template<int32_t NumVectors>
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessAllPassSectionWave(float* State1, float* State2, const float* A1, const float* A2, int32_t NumSections, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t NumLanes = NumVectors * Width;
+        const int32_t FirstLane = NumLanes - NumSections;
+        const __mmask16 AllLanes = 0xFFFF;
+
+        alignas(64) float State1Lanes[NumLanes] = {};
+        alignas(64) float State2Lanes[NumLanes] = {};
+        alignas(64) float A1Lanes[NumLanes] = {};
+        alignas(64) float A2Lanes[NumLanes] = {};
+        std::memcpy(State1Lanes + FirstLane, State1, sizeof(float) * NumSections);
+        std::memcpy(State2Lanes + FirstLane, State2, sizeof(float) * NumSections);
+        std::memcpy(A1Lanes + FirstLane, A1, sizeof(float) * NumSections);
+        std::memcpy(A2Lanes + FirstLane, A2, sizeof(float) * NumSections);
+
+        __m512 State1Vectors[NumVectors];
+        __m512 State2Vectors[NumVectors];
+        __m512 A1Vectors[NumVectors];
+        __m512 A2Vectors[NumVectors];
+        __m512 OutVectors[NumVectors];
+        __m512i LaneIndices[NumVectors];
+        __mmask16 SectionLanes[NumVectors];
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            State1Vectors[v] = _mm512_maskz_load_ps(AllLanes, State1Lanes + v * Width);
+            State2Vectors[v] = _mm512_maskz_load_ps(AllLanes, State2Lanes + v * Width);
+            A1Vectors[v] = _mm512_maskz_load_ps(AllLanes, A1Lanes + v * Width);
+            A2Vectors[v] = _mm512_maskz_load_ps(AllLanes, A2Lanes + v * Width);
+            OutVectors[v] = _mm512_setzero_ps();
+            LaneIndices[v] = _mm512_add_epi32(_mm512_set1_epi32(v * Width), _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+            SectionLanes[v] = _mm512_cmpge_epi32_mask(LaneIndices[v], _mm512_set1_epi32(FirstLane));
+        }
+
+        // Lane 0 from the last lane of the second operand, every other lane from the lane below it
+        const __m512i ShiftLanes = _mm512_setr_epi32(31, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14);
+        const __m512i LastLane = _mm512_set1_epi32(Width - 1);
+        const __m512i FrameCount = _mm512_set1_epi32(NumFrames);
+        const __m512i Zero = _mm512_setzero_si512();
+        const int32_t NumSteps = NumFrames + NumLanes - 1;
+
+        for (int32_t Step = 0; Step < NumSteps; ++Step)
+        {
+            // Lane k is on frame Step - k, and only updates its state while that frame is in the block
+            const bool bAllLanes = Step >= NumLanes - 1 && Step < NumFrames;
+            const __m512i StepVector = _mm512_set1_epi32(Step);
+
+            // The frame entering the first lane, then the last vector's outputs from the step before
+            __m512 Carry = _mm512_set1_ps(Step < NumFrames ? InOutData[Step] : 0.0f);
+
+            for (int32_t v = 0; v < NumVectors; ++v)
+            {
+                const __m512 Previous = OutVectors[v];
+                const __m512 In = _mm512_permutex2var_ps(Previous, ShiftLanes, Carry);
+                Carry = Previous;
+
+                __m512 Out = _mm512_maskz_add_round_ps(AllLanes, _mm512_maskz_mul_round_ps(AllLanes, A2Vectors[v], In, Rounding), State1Vectors[v], Rounding);
+                const __m512 Difference = _mm512_maskz_sub_round_ps(AllLanes, In, Out, Rounding);
+                const __m512 NewState1 = _mm512_maskz_add_round_ps(AllLanes, _mm512_maskz_mul_round_ps(AllLanes, A1Vectors[v], Difference, Rounding), State2Vectors[v], Rounding);
+                const __m512 NewState2 = _mm512_maskz_sub_round_ps(AllLanes, In, _mm512_maskz_mul_round_ps(AllLanes, A2Vectors[v], Out, Rounding), Rounding);
+
+                if (v == 0 && FirstLane > 0)
+                {
+                    Out = _mm512_mask_mov_ps(In, SectionLanes[0], Out);
+                }
+
+                __mmask16 Valid = SectionLanes[v];
+                if (!bAllLanes)
+                {
+                    const __m512i Frame = _mm512_sub_epi32(StepVector, LaneIndices[v]);
+                    Valid &= _mm512_cmpge_epi32_mask(Frame, Zero) & _mm512_cmplt_epi32_mask(Frame, FrameCount);
+                }
+
+                State1Vectors[v] = _mm512_mask_mov_ps(State1Vectors[v], Valid, NewState1);
+                State2Vectors[v] = _mm512_mask_mov_ps(State2Vectors[v], Valid, NewState2);
+                OutVectors[v] = Out;
+            }
+
+            // The last section finishes frame Step - (NumLanes - 1)
+            if (Step >= NumLanes - 1)
+            {
+                InOutData[Step - (NumLanes - 1)] = _mm512_cvtss_f32(_mm512_maskz_permutexvar_ps(AllLanes, LastLane, OutVectors[NumVectors - 1]));
+            }
+        }
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            _mm512_store_ps(State1Lanes + v * Width, State1Vectors[v]);
+            _mm512_store_ps(State2Lanes + v * Width, State2Vectors[v]);
+        }
+
+        std::memcpy(State1, State1Lanes + FirstLane, sizeof(float) * NumSections);
+        std::memcpy(State2, State2Lanes + FirstLane, sizeof(float) * NumSections);
+    }
+
+    // Sse2::ProcessAllPassSections()
+    BRANCHES_KERNELS_TARGET_AVX512 inline void ProcessAllPassSections(float* State1, float* State2, const float* A1, const float* A2, int32_t NumSections, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t GroupSections = AllPassWaveVectors * Width;
+
+        for (int32_t Section = 0; Section < NumSections; Section += GroupSections)
+        {
+            const int32_t Count = NumSections - Section < GroupSections ? NumSections - Section : GroupSections;
+
+            if (Count < AllPassWaveMinStages)
+            {
+                Scalar::ProcessAllPassSections(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                continue;
+            }
+
+            switch ((Count + Width - 1) / Width)
+            {
+            case 1:
+                ProcessAllPassSectionWave<1>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            case 2:
+                ProcessAllPassSectionWave<2>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            case 3:
+                ProcessAllPassSectionWave<3>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            default:
+                ProcessAllPassSectionWave<AllPassWaveVectors>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            }
+        }
+    }
+
+    // Scalar::SumSpectrumProducts(), a vector of bins at a time with the sums kept in registers
+    BRANCHES_KERNELS_TARGET_AVX512 inline void SumSpectrumProducts(
+        const float* const* InputReal, const float* const* InputImag, const float* ResponseReal, const float* ResponseImag, int32_t NumSpectra, int32_t NumBins,
+        float* SumReal, float* SumImag, int32_t StartBin, int32_t EndBin)
+    {
+        ForEachBlock(SumReal + StartBin, EndBin - StartBin, [&](int32_t Offset, __mmask16 Mask) BRANCHES_KERNELS_TARGET_AVX512
+        {
+            const int32_t Bin = StartBin + Offset;
+            __m512 Real = _mm512_setzero_ps();
+            __m512 Imag = _mm512_setzero_ps();
+
+            for (int32_t Spectrum = 0; Spectrum < NumSpectra; ++Spectrum)
+            {
+                const __m512 InReal = _mm512_maskz_loadu_ps(Mask, InputReal[Spectrum] + Bin);
+                const __m512 InImag = _mm512_maskz_loadu_ps(Mask, InputImag[Spectrum] + Bin);
+                const __m512 RespReal = _mm512_maskz_loadu_ps(Mask, ResponseReal + Spectrum * NumBins + Bin);
+                const __m512 RespImag = _mm512_maskz_loadu_ps(Mask, ResponseImag + Spectrum * NumBins + Bin);
+
+                const __m512 ProductReal = _mm512_maskz_sub_round_ps(Mask, _mm512_maskz_mul_round_ps(Mask, InReal, RespReal, Rounding), _mm512_maskz_mul_round_ps(Mask, InImag, RespImag, Rounding), Rounding);
+                const __m512 ProductImag = _mm512_maskz_add_round_ps(Mask, _mm512_maskz_mul_round_ps(Mask, InReal, RespImag, Rounding), _mm512_maskz_mul_round_ps(Mask, InImag, RespReal, Rounding), Rounding);
+
+                Real = _mm512_maskz_add_round_ps(Mask, Real, ProductReal, Rounding);
+                Imag = _mm512_maskz_add_round_ps(Mask, Imag, ProductImag, Rounding);
+            }
+
+            _mm512_mask_storeu_ps(SumReal + Bin, Mask, Real);
+            _mm512_mask_storeu_ps(SumImag + Bin, Mask, Imag);
+        });
+    }
+}
+
+#endif
@@ -0,0 +1,488 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Reference implementations of the dispatched kernels (see KernelDispatch.h). The SIMD versions produce
+// bit-identical results; these are also used on platforms without an x86 vector path, where the compiler
+// auto-vectorizes them for the baseline ISA. Bit-identity assumes floating-point contraction is off, as in
+// the engine's own compiler settings.
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernelCommon.h"
+#include "MetasoundBranches/Public/Kernels/QuarterSineTable.h"
+
+namespace MetasoundBranches::Kernels::Scalar
+{
+    inline void ProcessStereoGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            OutputLeftData[i] = LeftData[i] * LeftGain;
+            OutputRightData[i] = RightData[i] * RightGain;
+        }
+    }
+
+    // Swaps the channels while applying the gains. Each frame is read before it is written, so the outputs may be the
+    // inputs themselves, swapped or not.
+    inline void ProcessStereoSwapGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            const float Left = LeftData[i];
+            const float Right = RightData[i];
+
+            OutputLeftData[i] = Right * LeftGain;
+            OutputRightData[i] = Left * RightGain;
+        }
+    }
+
+    // WidthFactor is expected to be clamped to [0, 2] already
+    inline void ProcessStereoWidth(const float* LeftData, const float* RightData, float WidthFactor, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            const float Left = LeftData[i];
+            const float Right = RightData[i];
+
+            const float Mid = 0.5f * (Left + Right);
+            const float Side = 0.5f * (Left - Right) * WidthFactor;
+
+            OutputLeftData[i] = Mid + Side;
+            OutputRightData[i] = Mid - Side;
+        }
+    }
+
+    inline void ProcessStereoMix(
+        const float* LeftData1, const float* RightData1, float Gain1,
+        const float* LeftData2, const float* RightData2, float Gain2,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            OutputLeftData[i] = Gain1 * LeftData1[i] + Gain2 * LeftData2[i];
+            OutputRightData[i] = Gain1 * RightData1[i] + Gain2 * RightData2[i];
+        }
+    }
+
+    // Adds a stereo signal into the outputs, which may be the inputs
+    inline void ProcessStereoAccumulate(const float* LeftData, const float* RightData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            OutputLeftData[i] += LeftData[i];
+            OutputRightData[i] += RightData[i];
+        }
+    }
+
+    // The ramped kernels process frames [StartFrame, EndFrame) of the block, applying Start + Step * i at frame i. The
+    // gain is computed from the frame index rather than accumulated, so the vector versions can start anywhere.
+    inline void ProcessStereoGainsRamp(const float* LeftData, const float* RightData, float LeftStart, float LeftStep, float RightStart, float RightStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            const float Frame = static_cast<float>(i);
+
+            OutputLeftData[i] = LeftData[i] * (LeftStart + LeftStep * Frame);
+            OutputRightData[i] = RightData[i] * (RightStart + RightStep * Frame);
+        }
+    }
+
+    inline void ProcessStereoWidthRamp(const float* LeftData, const float* RightData, float WidthStart, float WidthStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            const float Left = LeftData[i];
+            const float Right = RightData[i];
+
+            const float Mid = 0.5f * (Left + Right);
+            const float Side = 0.5f * (Left - Right) * (WidthStart + WidthStep * static_cast<float>(i));
+
+            OutputLeftData[i] = Mid + Side;
+            OutputRightData[i] = Mid - Side;
+        }
+    }
+
+    inline void ProcessStereoMixRamp(
+        const float* LeftData1, const float* RightData1, float Gain1Start, float Gain1Step,
+        const float* LeftData2, const float* RightData2, float Gain2Start, float Gain2Step,
+        float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            const float Frame = static_cast<float>(i);
+            const float Gain1 = Gain1Start + Gain1Step * Frame;
+            const float Gain2 = Gain2Start + Gain2Step * Frame;
+
+            OutputLeftData[i] = Gain1 * LeftData1[i] + Gain2 * LeftData2[i];
+            OutputRightData[i] = Gain1 * RightData1[i] + Gain2 * RightData2[i];
+        }
+    }
+
+    inline bool IsMatrixRamping(FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp)
+    {
+        return WidthRamp.Step != 0.0f || LeftRamp.Step != 0.0f || RightRamp.Step != 0.0f || GainRamp.Step != 0.0f;
+    }
+
+    // The Stereo Matrix chain (Width -> Balance -> Inverter -> Gain) over frames [StartFrame, EndFrame), each stage
+    // applied in the same order and precision as the separate nodes. Polarity is folded into the balance gains and a
+    // swap is applied by the caller exchanging the outputs, both of which are exact.
+    inline void ProcessStereoMatrix(const float* LeftData, const float* RightData, bool bMidSide, FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        // Without a ramp the gains are used as they are, like the constant-gain kernels
+        const bool bRamp = IsMatrixRamping(WidthRamp, LeftRamp, RightRamp, GainRamp);
+
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            const float Frame = static_cast<float>(i);
+
+            float Left = LeftData[i];
+            float Right = RightData[i];
+
+            if (bMidSide)
+            {
+                const float Mid = 0.5f * (Left + Right);
+                const float Side = 0.5f * (Left - Right) * (bRamp ? WidthRamp.Start + WidthRamp.Step * Frame : WidthRamp.Start);
+
+                Left = Mid + Side;
+                Right = Mid - Side;
+            }
+
+            const float OutputGain = bRamp ? GainRamp.Start + GainRamp.Step * Frame : GainRamp.Start;
+            const float LeftGain = bRamp ? LeftRamp.Start + LeftRamp.Step * Frame : LeftRamp.Start;
+            const float RightGain = bRamp ? RightRamp.Start + RightRamp.Step * Frame : RightRamp.Start;
+
+            OutputLeftData[i] = Left * LeftGain * OutputGain;
+            OutputRightData[i] = Right * RightGain * OutputGain;
+        }
+    }
+
+    // Width across NumChannels channels, the generalization of mid / side: each channel is split into the mean of all
+    // channels and its difference from it, and the difference is scaled by Start + Step * i at frame i. Every channel
+    // of a frame is read before any is written, so the outputs may be the inputs.
+    inline void ProcessMultichannelWidthRamp(const float* const* InputData, float* const* OutputData, int32_t NumChannels, float WidthStart, float WidthStep, int32_t StartFrame, int32_t EndFrame)
+    {
+        const float Scale = 1.0f / static_cast<float>(NumChannels);
+
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            float Sum = InputData[0][i];
+            for (int32_t Channel = 1; Channel < NumChannels; ++Channel)
+            {
+                Sum += InputData[Channel][i];
+            }
+
+            const float Mid = Sum * Scale;
+            const float WidthFactor = WidthStart + WidthStep * static_cast<float>(i);
+
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                OutputData[Channel][i] = Mid + (InputData[Channel][i] - Mid) * WidthFactor;
+            }
+        }
+    }
+
+    // The larger of A and B as the SIMD max instructions compute it: B unless A is greater, so a NaN A leaves B
+    inline float MaxLane(float A, float B)
+    {
+        return A > B ? A : B;
+    }
+
+    inline void AccumulateStereoSumFrame(FStereoSumLanes& Lanes, int32_t Lane, float Left, float Right)
+    {
+        Lanes.LeftRight[Lane] += Left * Right;
+        Lanes.LeftSquared[Lane] += Left * Left;
+        Lanes.RightSquared[Lane] += Right * Right;
+        Lanes.LeftPeak[Lane] = MaxLane(std::fabs(Left), Lanes.LeftPeak[Lane]);
+        Lanes.RightPeak[Lane] = MaxLane(std::fabs(Right), Lanes.RightPeak[Lane]);
+    }
+
+    // Adds frames [StartFrame, EndFrame) to their lanes; StartFrame is a multiple of SumLanes
+    inline void AccumulateStereoSumLanes(const float* LeftData, const float* RightData, FStereoSumLanes& Lanes, int32_t StartFrame, int32_t EndFrame)
+    {
+        int32_t i = StartFrame;
+        for (; i + SumLanes <= EndFrame; i += SumLanes)
+        {
+            for (int32_t Lane = 0; Lane < SumLanes; ++Lane)
+            {
+                AccumulateStereoSumFrame(Lanes, Lane, LeftData[i + Lane], RightData[i + Lane]);
+            }
+        }
+
+        for (int32_t Lane = 0; i < EndFrame; ++i, ++Lane)
+        {
+            AccumulateStereoSumFrame(Lanes, Lane, LeftData[i], RightData[i]);
+        }
+    }
+
+    // Combines the lanes pairwise, halving the count each step
+    inline FStereoSums ReduceStereoSumLanes(FStereoSumLanes& Lanes)
+    {
+        for (int32_t Half = SumLanes / 2; Half > 0; Half /= 2)
+        {
+            for (int32_t Lane = 0; Lane < Half; ++Lane)
+            {
+                Lanes.LeftRight[Lane] += Lanes.LeftRight[Lane + Half];
+                Lanes.LeftSquared[Lane] += Lanes.LeftSquared[Lane + Half];
+                Lanes.RightSquared[Lane] += Lanes.RightSquared[Lane + Half];
+                Lanes.LeftPeak[Lane] = MaxLane(Lanes.LeftPeak[Lane + Half], Lanes.LeftPeak[Lane]);
+                Lanes.RightPeak[Lane] = MaxLane(Lanes.RightPeak[Lane + Half], Lanes.RightPeak[Lane]);
+            }
+        }
+
+        FStereoSums Sums;
+        Sums.LeftRight = Lanes.LeftRight[0];
+        Sums.LeftSquared = Lanes.LeftSquared[0];
+        Sums.RightSquared = Lanes.RightSquared[0];
+        Sums.LeftPeak = Lanes.LeftPeak[0];
+        Sums.RightPeak = Lanes.RightPeak[0];
+        return Sums;
+    }
+
+    // Sum of L * R, L * L and R * R over the block, and the peak magnitude of each channel
+    inline FStereoSums AccumulateStereoSums(const float* LeftData, const float* RightData, int32_t NumFrames)
+    {
+        FStereoSumLanes Lanes;
+        AccumulateStereoSumLanes(LeftData, RightData, Lanes, 0, NumFrames);
+        return ReduceStereoSumLanes(Lanes);
+    }
+
+    // Table (see QuarterSineTable.h) interpolated linearly at Position in [0, 1]
+    inline float LookupQuarterSine(const float* Table, float Position)
+    {
+        const float Index = Position * static_cast<float>(QuarterSineTableSize);
+        const int32_t Whole = static_cast<int32_t>(Index);
+        const float Fraction = Index - static_cast<float>(Whole);
+        const float Lower = Table[Whole];
+
+        return Lower + Fraction * (Table[Whole + 1] - Lower);
+    }
+
+    // Equal-power balance per frame, BalanceData in [-1, 1] (clamped, NaN reads as full right like FMath::Clamp)
+    inline void ProcessStereoBalanceAudio(const float* LeftData, const float* RightData, const float* BalanceData, const float* Table, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            const float Position = (Clamp(BalanceData[i], -1.0f, 1.0f) + 1.0f) * 0.5f;
+
+            OutputLeftData[i] = LeftData[i] * LookupQuarterSine(Table, 1.0f - Position);
+            OutputRightData[i] = RightData[i] * LookupQuarterSine(Table, Position);
+        }
+    }
+
+    // Equal-power crossfade per frame, CrossfadeData in [0, 1] (clamped, NaN reads as the second input)
+    inline void ProcessStereoCrossfadeAudio(
+        const float* LeftData1, const float* RightData1,
+        const float* LeftData2, const float* RightData2,
+        const float* CrossfadeData, const float* Table,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            const float Position = Clamp(CrossfadeData[i], 0.0f, 1.0f);
+            const float Gain1 = LookupQuarterSine(Table, 1.0f - Position);
+            const float Gain2 = LookupQuarterSine(Table, Position);
+
+            OutputLeftData[i] = Gain1 * LeftData1[i] + Gain2 * LeftData2[i];
+            OutputRightData[i] = Gain1 * RightData1[i] + Gain2 * RightData2[i];
+        }
+    }
+
+    // First frame in [StartFrame, EndFrame) where the signal crosses Threshold upwards (previous < Threshold,
+    // current >= Threshold), or EndFrame. PreviousValue is the sample before StartFrame.
+    inline int32_t FindRisingCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, float Threshold)
+    {
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            const float Current = Data[i];
+            if (PreviousValue < Threshold && Current >= Threshold)
+            {
+                return i;
+            }
+            PreviousValue = Current;
+        }
+        return EndFrame;
+    }
+
+    // First frame in [StartFrame, EndFrame) where the signal falls (bFalling) or rises (!bFalling) relative to the
+    // previous sample, or EndFrame
+    inline int32_t FindDirectionChange(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, bool bFalling)
+    {
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            const float Current = Data[i];
+            if (bFalling ? (Current < PreviousValue) : (Current > PreviousValue))
+            {
+                return i;
+            }
+            PreviousValue = Current;
+        }
+        return EndFrame;
+    }
+
+    // First frame in [StartFrame, EndFrame) where the signal moves from <= 0 to > 0 or from >= 0 to < 0, or EndFrame
+    inline int32_t FindZeroCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue)
+    {
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            const float Current = Data[i];
+            if ((PreviousValue <= 0.0f && Current > 0.0f) || (PreviousValue >= 0.0f && Current < 0.0f))
+            {
+                return i;
+            }
+            PreviousValue = Current;
+        }
+        return EndFrame;
+    }
+
+    // First frame in [StartFrame, EndFrame) whose value doesn't compare equal to Value (NaN never does), or EndFrame
+    inline int32_t FindNotEqual(const float* Data, int32_t StartFrame, int32_t EndFrame, float Value)
+    {
+        for (int32_t i = StartFrame; i < EndFrame; ++i)
+        {
+            if (!(Data[i] == Value))
+            {
+                return i;
+            }
+        }
+        return EndFrame;
+    }
+
+    // The Phase Disperser's allpass cascade, in place. Each stage runs y[n] = -a * x[n] + w[n - 2], with
+    // w[n] = x[n] + a * y[n] in its two-sample delay line; Recent and Older hold every stage's w[n - 1] and
+    // w[n - 2] between blocks. This version runs one stage at a time over the block.
+    inline void ProcessAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, float* InOutData, int32_t NumFrames)
+    {
+        for (int32_t Stage = 0; Stage < NumStages; ++Stage)
+        {
+            const float StageFeedback = Feedback[Stage];
+            float StageRecent = Recent[Stage];
+            float StageOlder = Older[Stage];
+
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                const float InSample = InOutData[i];
+                const float OutSample = -StageFeedback * InSample + StageOlder;
+
+                StageOlder = StageRecent;
+                StageRecent = InSample + StageFeedback * OutSample;
+                InOutData[i] = OutSample;
+            }
+
+            Recent[Stage] = StageRecent;
+            Older[Stage] = StageOlder;
+        }
+    }
+
+    // NumFrames frames of NumChannels channels from StartFrame, frame by frame into Interleaved: channel c of frame i
+    // at [i * NumChannels + c]
+    inline void InterleaveChannels(const float* const* Data, int32_t NumChannels, int32_t StartFrame, int32_t NumFrames, float* Interleaved)
+    {
+        for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            const float* ChannelData = Data[Channel] + StartFrame;
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                Interleaved[i * NumChannels + Channel] = ChannelData[i];
+            }
+        }
+    }
+
+    // InterleaveChannels() in reverse
+    inline void DeinterleaveChannels(const float* Interleaved, int32_t NumChannels, int32_t StartFrame, int32_t NumFrames, float* const* Data)
+    {
+        for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            float* ChannelData = Data[Channel] + StartFrame;
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                ChannelData[i] = Interleaved[i * NumChannels + Channel];
+            }
+        }
+    }
+
+    // ProcessAllPassStages() for NumChannels channels, each with its own state and feedback. A stage keeps its
+    // channels side by side, channel c of stage s at [s * NumChannels + c]. This version runs each channel through
+    // the stages in turn, exactly as ProcessAllPassStages() runs one.
+    inline void ProcessMultichannelAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, int32_t NumChannels, float* const* InOutData, int32_t NumFrames)
+    {
+        for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+        {
+            float* ChannelData = InOutData[Channel];
+
+            for (int32_t Stage = 0; Stage < NumStages; ++Stage)
+            {
+                const int32_t Index = Stage * NumChannels + Channel;
+                const float StageFeedback = Feedback[Index];
+                float StageRecent = Recent[Index];
+                float StageOlder = Older[Index];
+
+                for (int32_t i = 0; i < NumFrames; ++i)
+                {
+                    const float InSample = ChannelData[i];
+                    const float OutSample = -StageFeedback * InSample + StageOlder;
+
+                    StageOlder = StageRecent;
+                    StageRecent = InSample + StageFeedback * OutSample;
+                    ChannelData[i] = OutSample;
+                }
+
+                Recent[Index] = StageRecent;
+                Older[Index] = StageOlder;
+            }
+        }
+    }
+
+    // Second-order allpass sections in series over the buffer in place, each H(z) = (A2 + A1 z^-1 + z^-2) /
+    // (1 + A1 z^-1 + A2 z^-2) in transposed direct form II, State1 and State2 being its two state variables:
+    // y[n] = A2 * x[n] + s1, then s1 = A1 * (x[n] - y[n]) + s2 and s2 = x[n] - A2 * y[n]
+    inline void ProcessAllPassSections(float* State1, float* State2, const float* A1, const float* A2, int32_t NumSections, float* InOutData, int32_t NumFrames)
+    {
+        for (int32_t Section = 0; Section < NumSections; ++Section)
+        {
+            const float SectionA1 = A1[Section];
+            const float SectionA2 = A2[Section];
+            float SectionState1 = State1[Section];
+            float SectionState2 = State2[Section];
+
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                const float InSample = InOutData[i];
+                const float OutSample = SectionA2 * InSample + SectionState1;
+
+                SectionState1 = SectionA1 * (InSample - OutSample) + SectionState2;
+                SectionState2 = InSample - SectionA2 * OutSample;
+                InOutData[i] = OutSample;
+            }
+
+            State1[Section] = SectionState1;
+            State2[Section] = SectionState2;
+        }
+    }
+
+    // Complex products of NumSpectra input spectra with the response spectra at the same index, summed per bin in
+    // order of index, for bins [StartBin, EndBin). Spectra are split into real and imaginary arrays; the response
+    // spectra are stored one after another, NumBins apart.
+    inline void SumSpectrumProducts(
+        const float* const* InputReal, const float* const* InputImag, const float* ResponseReal, const float* ResponseImag, int32_t NumSpectra, int32_t NumBins,
+        float* SumReal, float* SumImag, int32_t StartBin, int32_t EndBin)
+    {
+        for (int32_t Bin = StartBin; Bin < EndBin; ++Bin)
+        {
+            float Real = 0.0f;
+            float Imag = 0.0f;
+
+            for (int32_t Spectrum = 0; Spectrum < NumSpectra; ++Spectrum)
+            {
+                const float InReal = InputReal[Spectrum][Bin];
+                const float InImag = InputImag[Spectrum][Bin];
+                const float RespReal = ResponseReal[Spectrum * NumBins + Bin];
+                const float RespImag = ResponseImag[Spectrum * NumBins + Bin];
+
+                Real = Real + (InReal * RespReal - InImag * RespImag);
+                Imag = Imag + (InReal * RespImag + InImag * RespReal);
+            }
+
+            SumReal[Bin] = Real;
+            SumImag[Bin] = Imag;
+        }
+    }
+}
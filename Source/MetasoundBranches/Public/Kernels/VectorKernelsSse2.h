@@ -0,0 +1,1051 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// SSE2 versions of the dispatched kernels, 4 frames per iteration. Bit-identical with Scalar::.
+
+#include "MetasoundBranches/Public/Kernels/KernelIsa.h"
+#include "MetasoundBranches/Public/Kernels/VectorKernelsScalar.h"
+
+#if BRANCHES_KERNELS_X86
+
+namespace MetasoundBranches::Kernels::Sse2
+{
+    constexpr int32_t Width = 4;
+    constexpr uintptr_t Alignment = 16;
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoGains(LeftData, RightData, LeftGain, RightGain, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m128 LeftGainVector = _mm_set1_ps(LeftGain);
+        const __m128 RightGainVector = _mm_set1_ps(RightGain);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            _mm_storeu_ps(OutputLeftData + i, _mm_mul_ps(_mm_loadu_ps(LeftData + i), LeftGainVector));
+            _mm_storeu_ps(OutputRightData + i, _mm_mul_ps(_mm_loadu_ps(RightData + i), RightGainVector));
+        }
+
+        Scalar::ProcessStereoGains(LeftData + i, RightData + i, LeftGain, RightGain, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoSwapGains(const float* LeftData, const float* RightData, float LeftGain, float RightGain, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoSwapGains(LeftData, RightData, LeftGain, RightGain, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m128 LeftGainVector = _mm_set1_ps(LeftGain);
+        const __m128 RightGainVector = _mm_set1_ps(RightGain);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m128 Left = _mm_loadu_ps(LeftData + i);
+            const __m128 Right = _mm_loadu_ps(RightData + i);
+
+            _mm_storeu_ps(OutputLeftData + i, _mm_mul_ps(Right, LeftGainVector));
+            _mm_storeu_ps(OutputRightData + i, _mm_mul_ps(Left, RightGainVector));
+        }
+
+        Scalar::ProcessStereoSwapGains(LeftData + i, RightData + i, LeftGain, RightGain, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoWidth(const float* LeftData, const float* RightData, float WidthFactor, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoWidth(LeftData, RightData, WidthFactor, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m128 Half = _mm_set1_ps(0.5f);
+        const __m128 WidthVector = _mm_set1_ps(WidthFactor);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m128 Left = _mm_loadu_ps(LeftData + i);
+            const __m128 Right = _mm_loadu_ps(RightData + i);
+
+            const __m128 Mid = _mm_mul_ps(Half, _mm_add_ps(Left, Right));
+            const __m128 Side = _mm_mul_ps(_mm_mul_ps(Half, _mm_sub_ps(Left, Right)), WidthVector);
+
+            _mm_storeu_ps(OutputLeftData + i, _mm_add_ps(Mid, Side));
+            _mm_storeu_ps(OutputRightData + i, _mm_sub_ps(Mid, Side));
+        }
+
+        Scalar::ProcessStereoWidth(LeftData + i, RightData + i, WidthFactor, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoMix(
+        const float* LeftData1, const float* RightData1, float Gain1,
+        const float* LeftData2, const float* RightData2, float Gain2,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoMix(LeftData1, RightData1, Gain1, LeftData2, RightData2, Gain2, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m128 Gain1Vector = _mm_set1_ps(Gain1);
+        const __m128 Gain2Vector = _mm_set1_ps(Gain2);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            _mm_storeu_ps(OutputLeftData + i, _mm_add_ps(_mm_mul_ps(Gain1Vector, _mm_loadu_ps(LeftData1 + i)), _mm_mul_ps(Gain2Vector, _mm_loadu_ps(LeftData2 + i))));
+            _mm_storeu_ps(OutputRightData + i, _mm_add_ps(_mm_mul_ps(Gain1Vector, _mm_loadu_ps(RightData1 + i)), _mm_mul_ps(Gain2Vector, _mm_loadu_ps(RightData2 + i))));
+        }
+
+        Scalar::ProcessStereoMix(LeftData1 + i, RightData1 + i, Gain1, LeftData2 + i, RightData2 + i, Gain2, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoAccumulate(const float* LeftData, const float* RightData, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoAccumulate(LeftData, RightData, OutputLeftData, OutputRightData, PeelFrames);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            _mm_storeu_ps(OutputLeftData + i, _mm_add_ps(_mm_loadu_ps(OutputLeftData + i), _mm_loadu_ps(LeftData + i)));
+            _mm_storeu_ps(OutputRightData + i, _mm_add_ps(_mm_loadu_ps(OutputRightData + i), _mm_loadu_ps(RightData + i)));
+        }
+
+        Scalar::ProcessStereoAccumulate(LeftData + i, RightData + i, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    // Indices of the frames in the vector starting at Frame
+    BRANCHES_KERNELS_TARGET_SSE2 inline __m128 FrameIndices(int32_t Frame)
+    {
+        return _mm_add_ps(_mm_set1_ps(static_cast<float>(Frame)), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoGainsRamp(const float* LeftData, const float* RightData, float LeftStart, float LeftStep, float RightStart, float RightStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoGainsRamp(LeftData, RightData, LeftStart, LeftStep, RightStart, RightStep, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m128 LeftStartVector = _mm_set1_ps(LeftStart);
+        const __m128 LeftStepVector = _mm_set1_ps(LeftStep);
+        const __m128 RightStartVector = _mm_set1_ps(RightStart);
+        const __m128 RightStepVector = _mm_set1_ps(RightStep);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m128 Frame = FrameIndices(i);
+            const __m128 LeftGain = _mm_add_ps(LeftStartVector, _mm_mul_ps(LeftStepVector, Frame));
+            const __m128 RightGain = _mm_add_ps(RightStartVector, _mm_mul_ps(RightStepVector, Frame));
+
+            _mm_storeu_ps(OutputLeftData + i, _mm_mul_ps(_mm_loadu_ps(LeftData + i), LeftGain));
+            _mm_storeu_ps(OutputRightData + i, _mm_mul_ps(_mm_loadu_ps(RightData + i), RightGain));
+        }
+
+        Scalar::ProcessStereoGainsRamp(LeftData, RightData, LeftStart, LeftStep, RightStart, RightStep, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoWidthRamp(const float* LeftData, const float* RightData, float WidthStart, float WidthStep, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoWidthRamp(LeftData, RightData, WidthStart, WidthStep, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m128 Half = _mm_set1_ps(0.5f);
+        const __m128 WidthStartVector = _mm_set1_ps(WidthStart);
+        const __m128 WidthStepVector = _mm_set1_ps(WidthStep);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m128 Left = _mm_loadu_ps(LeftData + i);
+            const __m128 Right = _mm_loadu_ps(RightData + i);
+            const __m128 WidthFactor = _mm_add_ps(WidthStartVector, _mm_mul_ps(WidthStepVector, FrameIndices(i)));
+
+            const __m128 Mid = _mm_mul_ps(Half, _mm_add_ps(Left, Right));
+            const __m128 Side = _mm_mul_ps(_mm_mul_ps(Half, _mm_sub_ps(Left, Right)), WidthFactor);
+
+            _mm_storeu_ps(OutputLeftData + i, _mm_add_ps(Mid, Side));
+            _mm_storeu_ps(OutputRightData + i, _mm_sub_ps(Mid, Side));
+        }
+
+        Scalar::ProcessStereoWidthRamp(LeftData, RightData, WidthStart, WidthStep, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoMixRamp(
+        const float* LeftData1, const float* RightData1, float Gain1Start, float Gain1Step,
+        const float* LeftData2, const float* RightData2, float Gain2Start, float Gain2Step,
+        float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoMixRamp(LeftData1, RightData1, Gain1Start, Gain1Step, LeftData2, RightData2, Gain2Start, Gain2Step, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m128 Gain1StartVector = _mm_set1_ps(Gain1Start);
+        const __m128 Gain1StepVector = _mm_set1_ps(Gain1Step);
+        const __m128 Gain2StartVector = _mm_set1_ps(Gain2Start);
+        const __m128 Gain2StepVector = _mm_set1_ps(Gain2Step);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m128 Frame = FrameIndices(i);
+            const __m128 Gain1 = _mm_add_ps(Gain1StartVector, _mm_mul_ps(Gain1StepVector, Frame));
+            const __m128 Gain2 = _mm_add_ps(Gain2StartVector, _mm_mul_ps(Gain2StepVector, Frame));
+
+            const __m128 Left = _mm_add_ps(_mm_mul_ps(Gain1, _mm_loadu_ps(LeftData1 + i)), _mm_mul_ps(Gain2, _mm_loadu_ps(LeftData2 + i)));
+            const __m128 Right = _mm_add_ps(_mm_mul_ps(Gain1, _mm_loadu_ps(RightData1 + i)), _mm_mul_ps(Gain2, _mm_loadu_ps(RightData2 + i)));
+
+            _mm_storeu_ps(OutputLeftData + i, Left);
+            _mm_storeu_ps(OutputRightData + i, Right);
+        }
+
+        Scalar::ProcessStereoMixRamp(LeftData1, RightData1, Gain1Start, Gain1Step, LeftData2, RightData2, Gain2Start, Gain2Step, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    // Start + Step * Frame, or Start when nothing in the block ramps
+    template<bool bRamp>
+    BRANCHES_KERNELS_TARGET_SSE2 inline __m128 RampAt(__m128 Start, __m128 Step, __m128 Frame)
+    {
+        if constexpr (bRamp)
+        {
+            return _mm_add_ps(Start, _mm_mul_ps(Step, Frame));
+        }
+        else
+        {
+            return Start;
+        }
+    }
+
+    template<bool bMidSide, bool bRamp>
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoMatrixFrames(const float* LeftData, const float* RightData, FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputLeftData + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessStereoMatrix(LeftData, RightData, bMidSide, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, PeelEnd);
+
+        const __m128 Half = _mm_set1_ps(0.5f);
+        const __m128 WidthStart = _mm_set1_ps(WidthRamp.Start);
+        const __m128 WidthStep = _mm_set1_ps(WidthRamp.Step);
+        const __m128 LeftGainStart = _mm_set1_ps(LeftRamp.Start);
+        const __m128 LeftGainStep = _mm_set1_ps(LeftRamp.Step);
+        const __m128 RightGainStart = _mm_set1_ps(RightRamp.Start);
+        const __m128 RightGainStep = _mm_set1_ps(RightRamp.Step);
+        const __m128 GainStart = _mm_set1_ps(GainRamp.Start);
+        const __m128 GainStep = _mm_set1_ps(GainRamp.Step);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m128 Frame = FrameIndices(i);
+
+            __m128 Left = _mm_loadu_ps(LeftData + i);
+            __m128 Right = _mm_loadu_ps(RightData + i);
+
+            if constexpr (bMidSide)
+            {
+                const __m128 Mid = _mm_mul_ps(Half, _mm_add_ps(Left, Right));
+                const __m128 Side = _mm_mul_ps(_mm_mul_ps(Half, _mm_sub_ps(Left, Right)), RampAt<bRamp>(WidthStart, WidthStep, Frame));
+
+                Left = _mm_add_ps(Mid, Side);
+                Right = _mm_sub_ps(Mid, Side);
+            }
+
+            const __m128 OutputGain = RampAt<bRamp>(GainStart, GainStep, Frame);
+            const __m128 LeftBalance = RampAt<bRamp>(LeftGainStart, LeftGainStep, Frame);
+            const __m128 RightBalance = RampAt<bRamp>(RightGainStart, RightGainStep, Frame);
+
+            _mm_storeu_ps(OutputLeftData + i, _mm_mul_ps(_mm_mul_ps(Left, LeftBalance), OutputGain));
+            _mm_storeu_ps(OutputRightData + i, _mm_mul_ps(_mm_mul_ps(Right, RightBalance), OutputGain));
+        }
+
+        Scalar::ProcessStereoMatrix(LeftData, RightData, bMidSide, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, i, EndFrame);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoMatrix(const float* LeftData, const float* RightData, bool bMidSide, FRamp WidthRamp, FRamp LeftRamp, FRamp RightRamp, FRamp GainRamp, float* OutputLeftData, float* OutputRightData, int32_t StartFrame, int32_t EndFrame)
+    {
+        const bool bRamp = Scalar::IsMatrixRamping(WidthRamp, LeftRamp, RightRamp, GainRamp);
+
+        if (bMidSide && bRamp)
+        {
+            ProcessStereoMatrixFrames<true, true>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else if (bMidSide)
+        {
+            ProcessStereoMatrixFrames<true, false>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else if (bRamp)
+        {
+            ProcessStereoMatrixFrames<false, true>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+        else
+        {
+            ProcessStereoMatrixFrames<false, false>(LeftData, RightData, WidthRamp, LeftRamp, RightRamp, GainRamp, OutputLeftData, OutputRightData, StartFrame, EndFrame);
+        }
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessMultichannelWidthRamp(const float* const* InputData, float* const* OutputData, int32_t NumChannels, float WidthStart, float WidthStep, int32_t StartFrame, int32_t EndFrame)
+    {
+        const int32_t PeelEnd = StartFrame + GetPeelFrames(OutputData[0] + StartFrame, EndFrame - StartFrame, Alignment);
+        Scalar::ProcessMultichannelWidthRamp(InputData, OutputData, NumChannels, WidthStart, WidthStep, StartFrame, PeelEnd);
+
+        const __m128 Scale = _mm_set1_ps(1.0f / static_cast<float>(NumChannels));
+        const __m128 WidthStartVector = _mm_set1_ps(WidthStart);
+        const __m128 WidthStepVector = _mm_set1_ps(WidthStep);
+
+        int32_t i = PeelEnd;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            __m128 Sum = _mm_loadu_ps(InputData[0] + i);
+            for (int32_t Channel = 1; Channel < NumChannels; ++Channel)
+            {
+                Sum = _mm_add_ps(Sum, _mm_loadu_ps(InputData[Channel] + i));
+            }
+
+            const __m128 Mid = _mm_mul_ps(Sum, Scale);
+            const __m128 WidthFactor = _mm_add_ps(WidthStartVector, _mm_mul_ps(WidthStepVector, FrameIndices(i)));
+
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const __m128 Side = _mm_sub_ps(_mm_loadu_ps(InputData[Channel] + i), Mid);
+                _mm_storeu_ps(OutputData[Channel] + i, _mm_add_ps(Mid, _mm_mul_ps(Side, WidthFactor)));
+            }
+        }
+
+        Scalar::ProcessMultichannelWidthRamp(InputData, OutputData, NumChannels, WidthStart, WidthStep, i, EndFrame);
+    }
+
+    // The last steps of Scalar::ReduceStereoSumLanes(), from four lanes to one
+    BRANCHES_KERNELS_TARGET_SSE2 inline float ReduceSumLanes(__m128 Lanes)
+    {
+        const __m128 Pairs = _mm_add_ps(Lanes, _mm_movehl_ps(Lanes, Lanes));
+        return _mm_cvtss_f32(_mm_add_ss(Pairs, _mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline float ReducePeakLanes(__m128 Lanes)
+    {
+        const __m128 Pairs = _mm_max_ps(_mm_movehl_ps(Lanes, Lanes), Lanes);
+        return _mm_cvtss_f32(_mm_max_ss(_mm_shuffle_ps(Pairs, Pairs, _MM_SHUFFLE(1, 1, 1, 1)), Pairs));
+    }
+
+    // Scalar::AccumulateStereoSums(), each group of SumLanes frames filling four vectors of lanes
+    BRANCHES_KERNELS_TARGET_SSE2 inline FStereoSums AccumulateStereoSums(const float* LeftData, const float* RightData, int32_t NumFrames)
+    {
+        static_assert(SumLanes == 4 * Width, "Four vectors per group of lanes");
+        const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+        __m128 LeftRight[4];
+        __m128 LeftSquared[4];
+        __m128 RightSquared[4];
+        __m128 LeftPeak[4];
+        __m128 RightPeak[4];
+        for (int32_t Vector = 0; Vector < 4; ++Vector)
+        {
+            LeftRight[Vector] = LeftSquared[Vector] = RightSquared[Vector] = LeftPeak[Vector] = RightPeak[Vector] = _mm_setzero_ps();
+        }
+
+        int32_t i = 0;
+        for (; i + SumLanes <= NumFrames; i += SumLanes)
+        {
+            for (int32_t Vector = 0; Vector < 4; ++Vector)
+            {
+                const __m128 Left = _mm_loadu_ps(LeftData + i + Vector * Width);
+                const __m128 Right = _mm_loadu_ps(RightData + i + Vector * Width);
+
+                LeftRight[Vector] = _mm_add_ps(LeftRight[Vector], _mm_mul_ps(Left, Right));
+                LeftSquared[Vector] = _mm_add_ps(LeftSquared[Vector], _mm_mul_ps(Left, Left));
+                RightSquared[Vector] = _mm_add_ps(RightSquared[Vector], _mm_mul_ps(Right, Right));
+                LeftPeak[Vector] = _mm_max_ps(_mm_and_ps(Left, AbsMask), LeftPeak[Vector]);
+                RightPeak[Vector] = _mm_max_ps(_mm_and_ps(Right, AbsMask), RightPeak[Vector]);
+            }
+        }
+
+        // A partial group goes through the lanes in memory
+        if (i < NumFrames)
+        {
+            FStereoSumLanes Lanes;
+            for (int32_t Vector = 0; Vector < 4; ++Vector)
+            {
+                _mm_storeu_ps(Lanes.LeftRight + Vector * Width, LeftRight[Vector]);
+                _mm_storeu_ps(Lanes.LeftSquared + Vector * Width, LeftSquared[Vector]);
+                _mm_storeu_ps(Lanes.RightSquared + Vector * Width, RightSquared[Vector]);
+                _mm_storeu_ps(Lanes.LeftPeak + Vector * Width, LeftPeak[Vector]);
+                _mm_storeu_ps(Lanes.RightPeak + Vector * Width, RightPeak[Vector]);
+            }
+
+            Scalar::AccumulateStereoSumLanes(LeftData, RightData, Lanes, i, NumFrames);
+            return Scalar::ReduceStereoSumLanes(Lanes);
+        }
+
+        // Lane k takes in lane k + 8, then lane k + 4
+        auto ReduceSums = [](const __m128* Vectors) BRANCHES_KERNELS_TARGET_SSE2
+        {
+            return ReduceSumLanes(_mm_add_ps(_mm_add_ps(Vectors[0], Vectors[2]), _mm_add_ps(Vectors[1], Vectors[3])));
+        };
+
+        auto ReducePeaks = [](const __m128* Vectors) BRANCHES_KERNELS_TARGET_SSE2
+        {
+            return ReducePeakLanes(_mm_max_ps(_mm_max_ps(Vectors[3], Vectors[1]), _mm_max_ps(Vectors[2], Vectors[0])));
+        };
+
+        FStereoSums Sums;
+        Sums.LeftRight = ReduceSums(LeftRight);
+        Sums.LeftSquared = ReduceSums(LeftSquared);
+        Sums.RightSquared = ReduceSums(RightSquared);
+        Sums.LeftPeak = ReducePeaks(LeftPeak);
+        Sums.RightPeak = ReducePeaks(RightPeak);
+        return Sums;
+    }
+
+    // Scalar::Clamp() per lane; the operand order of min / max reproduces its NaN handling
+    BRANCHES_KERNELS_TARGET_SSE2 inline __m128 ClampVector(__m128 Value, __m128 Min, __m128 Max)
+    {
+        return _mm_max_ps(Min, _mm_min_ps(Value, Max));
+    }
+
+    // Scalar::LookupQuarterSine() per lane. SSE2 has no gather, so the table is read through the lane indices.
+    BRANCHES_KERNELS_TARGET_SSE2 inline __m128 LookupQuarterSine(const float* Table, __m128 Position)
+    {
+        const __m128 Index = _mm_mul_ps(Position, _mm_set1_ps(static_cast<float>(QuarterSineTableSize)));
+        const __m128i Whole = _mm_cvttps_epi32(Index);
+        const __m128 Fraction = _mm_sub_ps(Index, _mm_cvtepi32_ps(Whole));
+
+        alignas(16) int32_t Indices[Width];
+        _mm_store_si128(reinterpret_cast<__m128i*>(Indices), Whole);
+
+        const __m128 Lower = _mm_setr_ps(Table[Indices[0]], Table[Indices[1]], Table[Indices[2]], Table[Indices[3]]);
+        const __m128 Upper = _mm_setr_ps(Table[Indices[0] + 1], Table[Indices[1] + 1], Table[Indices[2] + 1], Table[Indices[3] + 1]);
+
+        return _mm_add_ps(Lower, _mm_mul_ps(Fraction, _mm_sub_ps(Upper, Lower)));
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoBalanceAudio(const float* LeftData, const float* RightData, const float* BalanceData, const float* Table, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoBalanceAudio(LeftData, RightData, BalanceData, Table, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m128 One = _mm_set1_ps(1.0f);
+        const __m128 MinusOne = _mm_set1_ps(-1.0f);
+        const __m128 Half = _mm_set1_ps(0.5f);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m128 Position = _mm_mul_ps(_mm_add_ps(ClampVector(_mm_loadu_ps(BalanceData + i), MinusOne, One), One), Half);
+
+            _mm_storeu_ps(OutputLeftData + i, _mm_mul_ps(_mm_loadu_ps(LeftData + i), LookupQuarterSine(Table, _mm_sub_ps(One, Position))));
+            _mm_storeu_ps(OutputRightData + i, _mm_mul_ps(_mm_loadu_ps(RightData + i), LookupQuarterSine(Table, Position)));
+        }
+
+        Scalar::ProcessStereoBalanceAudio(LeftData + i, RightData + i, BalanceData + i, Table, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessStereoCrossfadeAudio(
+        const float* LeftData1, const float* RightData1,
+        const float* LeftData2, const float* RightData2,
+        const float* CrossfadeData, const float* Table,
+        float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+    {
+        const int32_t PeelFrames = GetPeelFrames(OutputLeftData, NumFrames, Alignment);
+        Scalar::ProcessStereoCrossfadeAudio(LeftData1, RightData1, LeftData2, RightData2, CrossfadeData, Table, OutputLeftData, OutputRightData, PeelFrames);
+
+        const __m128 Zero = _mm_setzero_ps();
+        const __m128 One = _mm_set1_ps(1.0f);
+
+        int32_t i = PeelFrames;
+        for (; i + Width <= NumFrames; i += Width)
+        {
+            const __m128 Position = ClampVector(_mm_loadu_ps(CrossfadeData + i), Zero, One);
+            const __m128 Gain1 = LookupQuarterSine(Table, _mm_sub_ps(One, Position));
+            const __m128 Gain2 = LookupQuarterSine(Table, Position);
+
+            const __m128 Left = _mm_add_ps(_mm_mul_ps(Gain1, _mm_loadu_ps(LeftData1 + i)), _mm_mul_ps(Gain2, _mm_loadu_ps(LeftData2 + i)));
+            const __m128 Right = _mm_add_ps(_mm_mul_ps(Gain1, _mm_loadu_ps(RightData1 + i)), _mm_mul_ps(Gain2, _mm_loadu_ps(RightData2 + i)));
+
+            _mm_storeu_ps(OutputLeftData + i, Left);
+            _mm_storeu_ps(OutputRightData + i, Right);
+        }
+
+        Scalar::ProcessStereoCrossfadeAudio(LeftData1 + i, RightData1 + i, LeftData2 + i, RightData2 + i, CrossfadeData + i, Table, OutputLeftData + i, OutputRightData + i, NumFrames - i);
+    }
+
+    // The searches check the first frame against PreviousValue, then compare each vector of frames with the same
+    // vector loaded one frame earlier
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline int32_t FindRisingCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, float Threshold)
+    {
+        if (StartFrame >= EndFrame || (PreviousValue < Threshold && Data[StartFrame] >= Threshold))
+        {
+            return StartFrame;
+        }
+
+        const __m128 ThresholdVector = _mm_set1_ps(Threshold);
+
+        int32_t i = StartFrame + 1;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m128 Previous = _mm_loadu_ps(Data + i - 1);
+            const __m128 Current = _mm_loadu_ps(Data + i);
+            const int Mask = _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(Previous, ThresholdVector), _mm_cmpge_ps(Current, ThresholdVector)));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindRisingCrossing(Data, i, EndFrame, Data[i - 1], Threshold);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline int32_t FindDirectionChange(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue, bool bFalling)
+    {
+        if (StartFrame >= EndFrame || (bFalling ? (Data[StartFrame] < PreviousValue) : (Data[StartFrame] > PreviousValue)))
+        {
+            return StartFrame;
+        }
+
+        int32_t i = StartFrame + 1;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m128 Previous = _mm_loadu_ps(Data + i - 1);
+            const __m128 Current = _mm_loadu_ps(Data + i);
+            const int Mask = _mm_movemask_ps(bFalling ? _mm_cmplt_ps(Current, Previous) : _mm_cmpgt_ps(Current, Previous));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindDirectionChange(Data, i, EndFrame, Data[i - 1], bFalling);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline int32_t FindZeroCrossing(const float* Data, int32_t StartFrame, int32_t EndFrame, float PreviousValue)
+    {
+        if (StartFrame >= EndFrame || Scalar::FindZeroCrossing(Data, StartFrame, StartFrame + 1, PreviousValue) == StartFrame)
+        {
+            return StartFrame;
+        }
+
+        const __m128 Zero = _mm_setzero_ps();
+
+        int32_t i = StartFrame + 1;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const __m128 Previous = _mm_loadu_ps(Data + i - 1);
+            const __m128 Current = _mm_loadu_ps(Data + i);
+            const __m128 Upwards = _mm_and_ps(_mm_cmple_ps(Previous, Zero), _mm_cmpgt_ps(Current, Zero));
+            const __m128 Downwards = _mm_and_ps(_mm_cmpge_ps(Previous, Zero), _mm_cmplt_ps(Current, Zero));
+            const int Mask = _mm_movemask_ps(_mm_or_ps(Upwards, Downwards));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindZeroCrossing(Data, i, EndFrame, Data[i - 1]);
+    }
+
+    BRANCHES_KERNELS_TARGET_SSE2 inline int32_t FindNotEqual(const float* Data, int32_t StartFrame, int32_t EndFrame, float Value)
+    {
+        const __m128 ValueVector = _mm_set1_ps(Value);
+
+        int32_t i = StartFrame;
+        for (; i + Width <= EndFrame; i += Width)
+        {
+            const int Mask = _mm_movemask_ps(_mm_cmpneq_ps(_mm_loadu_ps(Data + i), ValueVector));
+
+            if (Mask != 0)
+            {
+                return i + CountTrailingZeros(static_cast<uint32_t>(Mask));
+            }
+        }
+
+        return Scalar::FindNotEqual(Data, i, EndFrame, Value);
+    }
+
+    // Scalar::ProcessAllPassStages() for up to NumVectors * Width stages, skewed across the lanes: lane k runs its
+    // stage one frame behind lane k - 1, on the output lane k - 1 produced the step before, so every stage in the
+    // group advances on each step. The stages take the last lanes, putting the final one in the last lane of the
+    // last vector, and any lanes in front of them pass their input on unchanged. The pipeline fills and drains
+    // within the block, so every stage sees exactly the frames it would running alone.
+    template<int32_t NumVectors>
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessAllPassWave(float* Recent, float* Older, const float* Feedback, int32_t NumStages, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t NumLanes = NumVectors * Width;
+        const int32_t FirstLane = NumLanes - NumStages;
+
+        alignas(16) float RecentLanes[NumLanes] = {};
+        alignas(16) float OlderLanes[NumLanes] = {};
+        alignas(16) float FeedbackLanes[NumLanes] = {};
+        std::memcpy(RecentLanes + FirstLane, Recent, sizeof(float) * NumStages);
+        std::memcpy(OlderLanes + FirstLane, Older, sizeof(float) * NumStages);
+        std::memcpy(FeedbackLanes + FirstLane, Feedback, sizeof(float) * NumStages);
+
+        __m128 RecentVectors[NumVectors];
+        __m128 OlderVectors[NumVectors];
+        __m128 FeedbackVectors[NumVectors];
+        __m128 NegatedFeedbackVectors[NumVectors];
+        __m128 OutVectors[NumVectors];
+        __m128i LaneIndices[NumVectors];
+        __m128i StageLanes[NumVectors];
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            RecentVectors[v] = _mm_load_ps(RecentLanes + v * Width);
+            OlderVectors[v] = _mm_load_ps(OlderLanes + v * Width);
+            FeedbackVectors[v] = _mm_load_ps(FeedbackLanes + v * Width);
+            NegatedFeedbackVectors[v] = _mm_xor_ps(FeedbackVectors[v], _mm_set1_ps(-0.0f));
+            OutVectors[v] = _mm_setzero_ps();
+            LaneIndices[v] = _mm_add_epi32(_mm_set1_epi32(v * Width), _mm_setr_epi32(0, 1, 2, 3));
+            StageLanes[v] = _mm_cmpgt_epi32(LaneIndices[v], _mm_set1_epi32(FirstLane - 1));
+        }
+
+        const __m128i FrameCount = _mm_set1_epi32(NumFrames);
+        const __m128i MinusOne = _mm_set1_epi32(-1);
+        const int32_t NumSteps = NumFrames + NumLanes - 1;
+
+        for (int32_t Step = 0; Step < NumSteps; ++Step)
+        {
+            // Lane k is on frame Step - k, and only updates its state while that frame is in the block
+            const bool bAllLanes = Step >= NumLanes - 1 && Step < NumFrames;
+            const __m128i StepVector = _mm_set1_epi32(Step);
+
+            // The frame entering the first lane, then the last lane of each vector in turn, from the step before
+            __m128 Carry = _mm_set1_ps(Step < NumFrames ? InOutData[Step] : 0.0f);
+
+            for (int32_t v = 0; v < NumVectors; ++v)
+            {
+                const __m128 Previous = OutVectors[v];
+                const __m128 In = _mm_move_ss(_mm_shuffle_ps(Previous, Previous, _MM_SHUFFLE(2, 1, 0, 3)), Carry);
+                Carry = _mm_shuffle_ps(Previous, Previous, _MM_SHUFFLE(3, 3, 3, 3));
+
+                __m128 Out = _mm_add_ps(_mm_mul_ps(NegatedFeedbackVectors[v], In), OlderVectors[v]);
+                const __m128 NewRecent = _mm_add_ps(In, _mm_mul_ps(FeedbackVectors[v], Out));
+
+                if (v == 0 && FirstLane > 0)
+                {
+                    const __m128 Stages = _mm_castsi128_ps(StageLanes[0]);
+                    Out = _mm_or_ps(_mm_and_ps(Stages, Out), _mm_andnot_ps(Stages, In));
+                }
+
+                if (bAllLanes)
+                {
+                    OlderVectors[v] = RecentVectors[v];
+                    RecentVectors[v] = NewRecent;
+                }
+                else
+                {
+                    const __m128i Frame = _mm_sub_epi32(StepVector, LaneIndices[v]);
+                    const __m128 Valid = _mm_castsi128_ps(_mm_and_si128(StageLanes[v], _mm_and_si128(_mm_cmpgt_epi32(Frame, MinusOne), _mm_cmpgt_epi32(FrameCount, Frame))));
+
+                    OlderVectors[v] = _mm_or_ps(_mm_and_ps(Valid, RecentVectors[v]), _mm_andnot_ps(Valid, OlderVectors[v]));
+                    RecentVectors[v] = _mm_or_ps(_mm_and_ps(Valid, NewRecent), _mm_andnot_ps(Valid, RecentVectors[v]));
+                }
+
+                OutVectors[v] = Out;
+            }
+
+            // The last stage finishes frame Step - (NumLanes - 1)
+            if (Step >= NumLanes - 1)
+            {
+                const __m128 Last = OutVectors[NumVectors - 1];
+                InOutData[Step - (NumLanes - 1)] = _mm_cvtss_f32(_mm_shuffle_ps(Last, Last, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+        }
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            _mm_store_ps(RecentLanes + v * Width, RecentVectors[v]);
+            _mm_store_ps(OlderLanes + v * Width, OlderVectors[v]);
+        }
+
+        std::memcpy(Recent, RecentLanes + FirstLane, sizeof(float) * NumStages);
+        std::memcpy(Older, OlderLanes + FirstLane, sizeof(float) * NumStages);
+    }
+
+    // Runs the stages in groups of up to AllPassWaveVectors vectors, each group a pass over the block; a group too
+    // small to fill the pipeline runs one stage at a time
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t GroupStages = AllPassWaveVectors * Width;
+
+        for (int32_t Stage = 0; Stage < NumStages; Stage += GroupStages)
+        {
+            const int32_t Count = NumStages - Stage < GroupStages ? NumStages - Stage : GroupStages;
+
+            if (Count < AllPassWaveMinStages)
+            {
+                Scalar::ProcessAllPassStages(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                continue;
+            }
+
+            switch ((Count + Width - 1) / Width)
+            {
+            case 1:
+                ProcessAllPassWave<1>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            case 2:
+                ProcessAllPassWave<2>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            case 3:
+                ProcessAllPassWave<3>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            default:
+                ProcessAllPassWave<AllPassWaveVectors>(Recent + Stage, Older + Stage, Feedback + Stage, Count, InOutData, NumFrames);
+                break;
+            }
+        }
+    }
+
+    // Scalar::ProcessMultichannelAllPassStages() for NumGroupStages stages of Width channels, with the stages' state
+    // StateStride floats apart and the frames interleaved FrameStride floats apart. One vector carries the channels
+    // through a stage, and the stages follow each other on every frame. Each stage's recurrence reaches back two
+    // frames rather than to the stage before, so successive frames overlap in the pipeline without skewing the stages.
+    template<int32_t NumGroupStages>
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessAllPassChannelGroup(float* Recent, float* Older, const float* Feedback, int32_t StateStride, float* Interleaved, int32_t FrameStride, int32_t NumFrames)
+    {
+        __m128 RecentVectors[NumGroupStages];
+        __m128 OlderVectors[NumGroupStages];
+        __m128 FeedbackVectors[NumGroupStages];
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            RecentVectors[s] = _mm_loadu_ps(Recent + s * StateStride);
+            OlderVectors[s] = _mm_loadu_ps(Older + s * StateStride);
+            FeedbackVectors[s] = _mm_loadu_ps(Feedback + s * StateStride);
+        }
+
+        for (int32_t i = 0; i < NumFrames; ++i)
+        {
+            float* Frame = Interleaved + i * FrameStride;
+            __m128 Signal = _mm_loadu_ps(Frame);
+
+            for (int32_t s = 0; s < NumGroupStages; ++s)
+            {
+                // -a * x + w[n - 2], which rounds exactly as w[n - 2] - a * x
+                const __m128 Out = _mm_sub_ps(OlderVectors[s], _mm_mul_ps(FeedbackVectors[s], Signal));
+
+                OlderVectors[s] = RecentVectors[s];
+                RecentVectors[s] = _mm_add_ps(Signal, _mm_mul_ps(FeedbackVectors[s], Out));
+                Signal = Out;
+            }
+
+            _mm_storeu_ps(Frame, Signal);
+        }
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            _mm_storeu_ps(Recent + s * StateStride, RecentVectors[s]);
+            _mm_storeu_ps(Older + s * StateStride, OlderVectors[s]);
+        }
+    }
+
+    // ProcessAllPassChannelGroup() for Width / 2 channels, two frames at a time. Frames n and n + 1 read w[n - 2]
+    // and w[n - 1], Older and Recent, and write w[n] and w[n + 1], so with both frames' channels in one vector and
+    // Older and Recent side by side in another, a stage advances both frames at once and its output is the state for
+    // the next pair. NumFrames must be even.
+    template<int32_t NumGroupStages>
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessAllPassChannelPairGroup(float* Recent, float* Older, const float* Feedback, int32_t StateStride, float* Interleaved, int32_t NumFrames)
+    {
+        constexpr int32_t Channels = Width / 2;
+
+        alignas(16) float Lanes[Width];
+        __m128 StateVectors[NumGroupStages];
+        __m128 FeedbackVectors[NumGroupStages];
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            std::memcpy(Lanes, Older + s * StateStride, sizeof(float) * Channels);
+            std::memcpy(Lanes + Channels, Recent + s * StateStride, sizeof(float) * Channels);
+            StateVectors[s] = _mm_load_ps(Lanes);
+
+            std::memcpy(Lanes, Feedback + s * StateStride, sizeof(float) * Channels);
+            std::memcpy(Lanes + Channels, Feedback + s * StateStride, sizeof(float) * Channels);
+            FeedbackVectors[s] = _mm_load_ps(Lanes);
+        }
+
+        for (int32_t i = 0; i < NumFrames; i += 2)
+        {
+            float* Frames = Interleaved + i * Channels;
+            __m128 Signal = _mm_loadu_ps(Frames);
+
+            for (int32_t s = 0; s < NumGroupStages; ++s)
+            {
+                const __m128 Out = _mm_sub_ps(StateVectors[s], _mm_mul_ps(FeedbackVectors[s], Signal));
+
+                StateVectors[s] = _mm_add_ps(Signal, _mm_mul_ps(FeedbackVectors[s], Out));
+                Signal = Out;
+            }
+
+            _mm_storeu_ps(Frames, Signal);
+        }
+
+        for (int32_t s = 0; s < NumGroupStages; ++s)
+        {
+            _mm_store_ps(Lanes, StateVectors[s]);
+            std::memcpy(Older + s * StateStride, Lanes, sizeof(float) * Channels);
+            std::memcpy(Recent + s * StateStride, Lanes + Channels, sizeof(float) * Channels);
+        }
+    }
+
+    // Every stage over NumFrames interleaved frames of NumChannels channels, AllPassWaveVectors stages at a time:
+    // Width channels to a vector, or pairs of frames of Width / 2 channels with bPairs
+    template<bool bPairs>
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessAllPassChannelStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, int32_t NumChannels, float* Interleaved, int32_t NumFrames)
+    {
+        for (int32_t Channel = 0; Channel < NumChannels; Channel += Width)
+        {
+            for (int32_t Stage = 0; Stage < NumStages; Stage += AllPassWaveVectors)
+            {
+                float* StageRecent = Recent + Stage * NumChannels + Channel;
+                float* StageOlder = Older + Stage * NumChannels + Channel;
+                const float* StageFeedback = Feedback + Stage * NumChannels + Channel;
+                const int32_t Count = NumStages - Stage < AllPassWaveVectors ? NumStages - Stage : AllPassWaveVectors;
+
+                if constexpr (bPairs)
+                {
+                    switch (Count)
+                    {
+                    case 1:
+                        ProcessAllPassChannelPairGroup<1>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    case 2:
+                        ProcessAllPassChannelPairGroup<2>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    case 3:
+                        ProcessAllPassChannelPairGroup<3>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    default:
+                        ProcessAllPassChannelPairGroup<AllPassWaveVectors>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved, NumFrames);
+                        break;
+                    }
+                }
+                else
+                {
+                    switch (Count)
+                    {
+                    case 1:
+                        ProcessAllPassChannelGroup<1>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    case 2:
+                        ProcessAllPassChannelGroup<2>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    case 3:
+                        ProcessAllPassChannelGroup<3>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    default:
+                        ProcessAllPassChannelGroup<AllPassWaveVectors>(StageRecent, StageOlder, StageFeedback, NumChannels, Interleaved + Channel, NumChannels, NumFrames);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // The channels go in the lanes: the block is interleaved a chunk at a time, so each frame's channels load as one
+    // vector. Two channels take a pair of frames to a vector, the last frame of an odd block running on the scalar
+    // kernel; multiples of four channels take one frame. Other counts, or more than MaxAllPassChannels, run the
+    // scalar kernel.
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessMultichannelAllPassStages(float* Recent, float* Older, const float* Feedback, int32_t NumStages, int32_t NumChannels, float* const* InOutData, int32_t NumFrames)
+    {
+        const bool bPairs = NumChannels * 2 == Width;
+        if (!bPairs && (NumChannels % Width != 0 || NumChannels > MaxAllPassChannels))
+        {
+            Scalar::ProcessMultichannelAllPassStages(Recent, Older, Feedback, NumStages, NumChannels, InOutData, NumFrames);
+            return;
+        }
+
+        alignas(16) float Interleaved[AllPassChannelChunkFrames * MaxAllPassChannels];
+        const int32_t NumVectorFrames = bPairs ? NumFrames & ~1 : NumFrames;
+
+        for (int32_t Start = 0; Start < NumVectorFrames; Start += AllPassChannelChunkFrames)
+        {
+            const int32_t Count = NumVectorFrames - Start < AllPassChannelChunkFrames ? NumVectorFrames - Start : AllPassChannelChunkFrames;
+
+            Scalar::InterleaveChannels(InOutData, NumChannels, Start, Count, Interleaved);
+
+            if (bPairs)
+            {
+                ProcessAllPassChannelStages<true>(Recent, Older, Feedback, NumStages, NumChannels, Interleaved, Count);
+            }
+            else
+            {
+                ProcessAllPassChannelStages<false>(Recent, Older, Feedback, NumStages, NumChannels, Interleaved, Count);
+            }
+
+            Scalar::DeinterleaveChannels(Interleaved, NumChannels, Start, Count, InOutData);
+        }
+
+        if (NumVectorFrames < NumFrames)
+        {
+            float* LastFrame[MaxAllPassChannels];
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                LastFrame[Channel] = InOutData[Channel] + NumVectorFrames;
+            }
+
+            Scalar::ProcessMultichannelAllPassStages(Recent, Older, Feedback, NumStages, NumChannels, LastFrame, NumFrames - NumVectorFrames);
+        }
+    }
+
+    // Scalar::ProcessAllPassSections() for up to NumVectors * Width sections, skewed across the lanes as by
+    // ProcessAllPassWave()
+    template<int32_t NumVectors>
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessAllPassSectionWave(float* State1, float* State2, const float* A1, const float* A2, int32_t NumSections, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t NumLanes = NumVectors * Width;
+        const int32_t FirstLane = NumLanes - NumSections;
+
+        alignas(16) float State1Lanes[NumLanes] = {};
+        alignas(16) float State2Lanes[NumLanes] = {};
+        alignas(16) float A1Lanes[NumLanes] = {};
+        alignas(16) float A2Lanes[NumLanes] = {};
+        std::memcpy(State1Lanes + FirstLane, State1, sizeof(float) * NumSections);
+        std::memcpy(State2Lanes + FirstLane, State2, sizeof(float) * NumSections);
+        std::memcpy(A1Lanes + FirstLane, A1, sizeof(float) * NumSections);
+        std::memcpy(A2Lanes + FirstLane, A2, sizeof(float) * NumSections);
+
+        __m128 State1Vectors[NumVectors];
+        __m128 State2Vectors[NumVectors];
+        __m128 A1Vectors[NumVectors];
+        __m128 A2Vectors[NumVectors];
+        __m128 OutVectors[NumVectors];
+        __m128i LaneIndices[NumVectors];
+        __m128i SectionLanes[NumVectors];
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            State1Vectors[v] = _mm_load_ps(State1Lanes + v * Width);
+            State2Vectors[v] = _mm_load_ps(State2Lanes + v * Width);
+            A1Vectors[v] = _mm_load_ps(A1Lanes + v * Width);
+            A2Vectors[v] = _mm_load_ps(A2Lanes + v * Width);
+            OutVectors[v] = _mm_setzero_ps();
+            LaneIndices[v] = _mm_add_epi32(_mm_set1_epi32(v * Width), _mm_setr_epi32(0, 1, 2, 3));
+            SectionLanes[v] = _mm_cmpgt_epi32(LaneIndices[v], _mm_set1_epi32(FirstLane - 1));
+        }
+
+        const __m128i FrameCount = _mm_set1_epi32(NumFrames);
+        const __m128i MinusOne = _mm_set1_epi32(-1);
+        const int32_t NumSteps = NumFrames + NumLanes - 1;
+
+        for (int32_t Step = 0; Step < NumSteps; ++Step)
+        {
+            // Lane k is on frame Step - k, and only updates its state while that frame is in the block
+            const bool bAllLanes = Step >= NumLanes - 1 && Step < NumFrames;
+            const __m128i StepVector = _mm_set1_epi32(Step);
+
+            // The frame entering the first lane, then the last lane of each vector in turn, from the step before
+            __m128 Carry = _mm_set1_ps(Step < NumFrames ? InOutData[Step] : 0.0f);
+
+            for (int32_t v = 0; v < NumVectors; ++v)
+            {
+                const __m128 Previous = OutVectors[v];
+                const __m128 In = _mm_move_ss(_mm_shuffle_ps(Previous, Previous, _MM_SHUFFLE(2, 1, 0, 3)), Carry);
+                Carry = _mm_shuffle_ps(Previous, Previous, _MM_SHUFFLE(3, 3, 3, 3));
+
+                __m128 Out = _mm_add_ps(_mm_mul_ps(A2Vectors[v], In), State1Vectors[v]);
+                const __m128 NewState1 = _mm_add_ps(_mm_mul_ps(A1Vectors[v], _mm_sub_ps(In, Out)), State2Vectors[v]);
+                const __m128 NewState2 = _mm_sub_ps(In, _mm_mul_ps(A2Vectors[v], Out));
+
+                if (v == 0 && FirstLane > 0)
+                {
+                    const __m128 Sections = _mm_castsi128_ps(SectionLanes[0]);
+                    Out = _mm_or_ps(_mm_and_ps(Sections, Out), _mm_andnot_ps(Sections, In));
+                }
+
+                if (bAllLanes)
+                {
+                    State1Vectors[v] = NewState1;
+                    State2Vectors[v] = NewState2;
+                }
+                else
+                {
+                    const __m128i Frame = _mm_sub_epi32(StepVector, LaneIndices[v]);
+                    const __m128 Valid = _mm_castsi128_ps(_mm_and_si128(SectionLanes[v], _mm_and_si128(_mm_cmpgt_epi32(Frame, MinusOne), _mm_cmpgt_epi32(FrameCount, Frame))));
+
+                    State1Vectors[v] = _mm_or_ps(_mm_and_ps(Valid, NewState1), _mm_andnot_ps(Valid, State1Vectors[v]));
+                    State2Vectors[v] = _mm_or_ps(_mm_and_ps(Valid, NewState2), _mm_andnot_ps(Valid, State2Vectors[v]));
+                }
+
+                OutVectors[v] = Out;
+            }
+
+            // The last section finishes frame Step - (NumLanes - 1)
+            if (Step >= NumLanes - 1)
+            {
+                const __m128 Last = OutVectors[NumVectors - 1];
+                InOutData[Step - (NumLanes - 1)] = _mm_cvtss_f32(_mm_shuffle_ps(Last, Last, _MM_SHUFFLE(3, 3, 3, 3)));
+            }
+        }
+
+        for (int32_t v = 0; v < NumVectors; ++v)
+        {
+            _mm_store_ps(State1Lanes + v * Width, State1Vectors[v]);
+            _mm_store_ps(State2Lanes + v * Width, State2Vectors[v]);
+        }
+
+        std::memcpy(State1, State1Lanes + FirstLane, sizeof(float) * NumSections);
+        std::memcpy(State2, State2Lanes + FirstLane, sizeof(float) * NumSections);
+    }
+
+    // Runs the sections in groups as ProcessAllPassStages() runs the stages
+    BRANCHES_KERNELS_TARGET_SSE2 inline void ProcessAllPassSections(float* State1, float* State2, const float* A1, const float* A2, int32_t NumSections, float* InOutData, int32_t NumFrames)
+    {
+        constexpr int32_t GroupSections = AllPassWaveVectors * Width;
+
+        for (int32_t Section = 0; Section < NumSections; Section += GroupSections)
+        {
+            const int32_t Count = NumSections - Section < GroupSections ? NumSections - Section : GroupSections;
+
+            if (Count < AllPassWaveMinStages)
+            {
+                Scalar::ProcessAllPassSections(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                continue;
+            }
+
+            switch ((Count + Width - 1) / Width)
+            {
+            case 1:
+                ProcessAllPassSectionWave<1>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            case 2:
+                ProcessAllPassSectionWave<2>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            case 3:
+                ProcessAllPassSectionWave<3>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            default:
+                ProcessAllPassSectionWave<AllPassWaveVectors>(State1 + Section, State2 + Section, A1 + Section, A2 + Section, Count, InOutData, NumFrames);
+                break;
+            }
+        }
+    }
+
+    // Scalar::SumSpectrumProducts(), a vector of bins at a time with the sums kept in registers
+    BRANCHES_KERNELS_TARGET_SSE2 inline void SumSpectrumProducts(
+        const float* const* InputReal, const float* const* InputImag, const float* ResponseReal, const float* ResponseImag, int32_t NumSpectra, int32_t NumBins,
+        float* SumReal, float* SumImag, int32_t StartBin, int32_t EndBin)
+    {
+        int32_t Bin = StartBin;
+        for (; Bin + Width <= EndBin; Bin += Width)
+        {
+            __m128 Real = _mm_setzero_ps();
+            __m128 Imag = _mm_setzero_ps();
+
+            for (int32_t Spectrum = 0; Spectrum < NumSpectra; ++Spectrum)
+            {
+                const __m128 InReal = _mm_loadu_ps(InputReal[Spectrum] + Bin);
+                const __m128 InImag = _mm_loadu_ps(InputImag[Spectrum] + Bin);
+                const __m128 RespReal = _mm_loadu_ps(ResponseReal + Spectrum * NumBins + Bin);
+                const __m128 RespImag = _mm_loadu_ps(ResponseImag + Spectrum * NumBins + Bin);
+
+                Real = _mm_add_ps(Real, _mm_sub_ps(_mm_mul_ps(InReal, RespReal), _mm_mul_ps(InImag, RespImag)));
+                Imag = _mm_add_ps(Imag, _mm_add_ps(_mm_mul_ps(InReal, RespImag), _mm_mul_ps(InImag, RespReal)));
+            }
+
+            _mm_storeu_ps(SumReal + Bin, Real);
+            _mm_storeu_ps(SumImag + Bin, Imag);
+        }
+
+        Scalar::SumSpectrumProducts(InputReal, InputImag, ResponseReal, ResponseImag, NumSpectra, NumBins, SumReal, SumImag, Bin, EndBin);
+    }
+}
+
+#endif
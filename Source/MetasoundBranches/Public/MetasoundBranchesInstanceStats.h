@@ -0,0 +1,207 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "MetasoundAudioBuffer.h"
+#include "MetasoundOperatorSettings.h"
+#include "MetasoundTrigger.h"
+#include "Templates/Function.h"
+#include <atomic>
+
+// Live per-instance cost of the Branches operators, listed with the au.Branches.Stats console command.
+//
+// Each operator owns an FInstanceStatsHandle, named InstanceStats, and opens METASOUND_BRANCHES_INSTANCE_SCOPE at
+// the top of Execute(). The handle is given the operator's CaptureInputs() const member, which adds its input values
+// to an FInstanceInputSnapshot in the order they are logged.
+//
+// Blocks that take longer than au.Branches.Stats.OverrunShare of the block duration are counted, and the
+// instance's input values at that moment are logged from the game thread. Only operators built while
+// au.Branches.Stats.Enabled is set are tracked; the others' handles stay empty, so building and destroying them
+// takes no lock and allocates nothing, and their scopes don't read the clock. Everything compiles out in Shipping.
+
+#define METASOUND_BRANCHES_INSTANCE_STATS !UE_BUILD_SHIPPING
+
+namespace MetasoundBranches
+{
+    // Input values of one operator instance, captured when a block overruns. Fixed-size so capturing never allocates
+    // on the render thread; inputs past MaxValues are counted in NumOmitted, and the log says how many were left out.
+    struct FInstanceInputSnapshot
+    {
+        static constexpr int32 MaxValues = 16;
+
+        const TCHAR* Names[MaxValues];
+        float Values[MaxValues];
+        bool bIsPeak[MaxValues];
+        int32 Num = 0;
+        int32 NumOmitted = 0;
+
+        void Reset()
+        {
+            Num = 0;
+            NumOmitted = 0;
+        }
+
+        void Add(const TCHAR* Name, float Value)
+        {
+            AddValue(Name, Value, false);
+        }
+
+        // Audio inputs are summarized by their peak magnitude over the block
+        void Add(const TCHAR* Name, const Metasound::FAudioBuffer& Buffer)
+        {
+            float Peak = 0.0f;
+            for (const float Sample : Buffer)
+            {
+                Peak = FMath::Max(Peak, FMath::Abs(Sample));
+            }
+
+            AddValue(Name, Peak, true);
+        }
+
+        // Trigger inputs are summarized by the number of triggers in the block
+        void Add(const TCHAR* Name, const Metasound::FTrigger& Trigger)
+        {
+            Add(Name, static_cast<float>(Trigger.NumTriggeredInBlock()));
+        }
+
+    private:
+        void AddValue(const TCHAR* Name, float Value, bool bPeak)
+        {
+            if (Num < MaxValues)
+            {
+                Names[Num] = Name;
+                Values[Num] = Value;
+                bIsPeak[Num] = bPeak;
+                ++Num;
+            }
+            else
+            {
+                ++NumOmitted;
+            }
+        }
+    };
+
+    using FCaptureInputsFunction = TFunction<void(FInstanceInputSnapshot&)>;
+
+#if METASOUND_BRANCHES_INSTANCE_STATS
+
+    // Cost counters of one live operator instance. Written only by the audio render thread.
+    class METASOUNDBRANCHES_API FInstanceStats
+    {
+    public:
+        FInstanceStats(const TCHAR* InNodeClass, const Metasound::FOperatorSettings& InSettings, FCaptureInputsFunction&& InCaptureInputs);
+
+        void AddBlock(uint64 Cycles);
+
+        const TCHAR* const NodeClass;
+        const uint32 InstanceId;
+        const int32 BlockSize;
+        const double BlockSeconds;
+
+        std::atomic<uint64> NumBlocks { 0 };
+        std::atomic<uint64> TotalCycles { 0 };
+        std::atomic<uint64> PeakCycles { 0 };
+        std::atomic<uint64> NumOverruns { 0 };
+
+        // Set by the render thread once the snapshot below is complete, cleared by the game thread after logging it
+        std::atomic<bool> bOverrunPending { false };
+        uint64 OverrunCycles = 0;
+        FInstanceInputSnapshot OverrunInputs;
+
+        // Game thread only, throttles the overrun log
+        double LastLogTime = 0.0;
+
+        // Render thread only: the last "au.Branches.Stats reset" applied to the counters above
+        uint32 ResetGeneration = 0;
+
+        // Index in the list of live instances, so the handle removes it in constant time; guarded by the list's lock
+        int32 RegistryIndex = INDEX_NONE;
+
+    private:
+        FCaptureInputsFunction CaptureInputs;
+    };
+
+    // True while au.Branches.Stats.Enabled is set
+    METASOUNDBRANCHES_API bool AreInstanceStatsEnabled();
+
+    // Owned by an operator; keeps its FInstanceStats registered for as long as the operator lives, if stats were
+    // enabled when it was built
+    class METASOUNDBRANCHES_API FInstanceStatsHandle
+    {
+    public:
+        template<typename CaptureInputsType>
+        FInstanceStatsHandle(const TCHAR* NodeClass, const Metasound::FOperatorSettings& Settings, CaptureInputsType&& CaptureInputs)
+        {
+            if (AreInstanceStatsEnabled())
+            {
+                Register(NodeClass, Settings, FCaptureInputsFunction(Forward<CaptureInputsType>(CaptureInputs)));
+            }
+        }
+
+        ~FInstanceStatsHandle();
+
+        FInstanceStatsHandle(const FInstanceStatsHandle&) = delete;
+        FInstanceStatsHandle& operator=(const FInstanceStatsHandle&) = delete;
+
+        // Times one Execute() call
+        class FScope
+        {
+        public:
+            explicit FScope(FInstanceStatsHandle& InHandle)
+                : Stats(InHandle.Stats.Get())
+                , StartCycles(Stats != nullptr ? FPlatformTime::Cycles64() : 0)
+            {
+            }
+
+            ~FScope()
+            {
+                if (Stats != nullptr)
+                {
+                    Stats->AddBlock(FPlatformTime::Cycles64() - StartCycles);
+                }
+            }
+
+        private:
+            FInstanceStats* const Stats;
+            const uint64 StartCycles;
+        };
+
+    private:
+        void Register(const TCHAR* NodeClass, const Metasound::FOperatorSettings& Settings, FCaptureInputsFunction&& CaptureInputs);
+
+        // Null if stats were off when the operator was built
+        TSharedPtr<FInstanceStats, ESPMode::ThreadSafe> Stats;
+    };
+
+    // Starts and stops logging overruns, called by the module
+    void StartInstanceStatsLogging();
+    void StopInstanceStatsLogging();
+
+    #define METASOUND_BRANCHES_INSTANCE_SCOPE(Handle) \
+        MetasoundBranches::FInstanceStatsHandle::FScope InstanceStatsScope(Handle)
+
+#else
+
+    class FInstanceStatsHandle
+    {
+    public:
+        template<typename CaptureInputsType>
+        FInstanceStatsHandle(const TCHAR*, const Metasound::FOperatorSettings&, CaptureInputsType&&)
+        {
+        }
+    };
+
+    inline void StartInstanceStatsLogging()
+    {
+    }
+
+    inline void StopInstanceStatsLogging()
+    {
+    }
+
+    #define METASOUND_BRANCHES_INSTANCE_SCOPE(Handle)
+
+#endif
+}
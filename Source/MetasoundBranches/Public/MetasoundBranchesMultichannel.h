@@ -0,0 +1,21 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundVertex.h"
+
+// Audio vertices shared by the multichannel nodes, which are registered for 4, 6 and 8 channels (2, 4 and 8 for
+// Multichannel Phase Disperser, whose channels share SIMD lanes). Channels are numbered from 1 ("In 1" to "In 8",
+// "Out 1" to "Out 8"), and each variant uses the first NumChannels of them.
+
+namespace MetasoundBranches::Multichannel
+{
+    constexpr int32 MaxChannels = 8;
+
+    const TCHAR* GetInputName(int32 Channel);
+    const TCHAR* GetOutputName(int32 Channel);
+
+    // Adds the audio vertices of the first NumChannels channels
+    void AddInputVertices(Metasound::FInputVertexInterface& OutInterface, int32 NumChannels);
+    void AddOutputVertices(Metasound::FOutputVertexInterface& OutInterface, int32 NumChannels);
+}
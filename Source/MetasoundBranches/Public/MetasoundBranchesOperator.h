@@ -0,0 +1,17 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundOperatorInterface.h"
+#include <type_traits>
+
+// Every Branches operator has a Reset() that returns it to its initial state in place, so pooled generators can
+// restart a voice without rebuilding it; stateless operators only clear their outputs.
+//
+// TExecutableOperator finds an operator's Reset() by its signature rather than through a virtual in IOperator,
+// so Reset() can't be marked override. A Reset() whose signature drifts would silently stop being called when a
+// graph is reset; this checks it at compile time instead. Place it after the operator class (or one of its
+// instantiations for a template).
+#define METASOUND_BRANCHES_CHECK_RESET(...) \
+    static_assert(std::is_same_v<decltype(&__VA_ARGS__::Reset), void (__VA_ARGS__::*)(const Metasound::IOperator::FResetParams&)>, \
+        #__VA_ARGS__ "::Reset() must take const IOperator::FResetParams& to be called by TExecutableOperator")
@@ -0,0 +1,24 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundVertexData.h"
+
+// Build-time passthrough for the stereo nodes.
+//
+// An input that is left unconnected keeps its vertex default, and one bound to a constant value can't change
+// either, so the operator knows at build time whether its configuration is an identity (unity gain, width one,
+// no inversion, a crossfade at either end). In that case it binds its outputs straight to its inputs in
+// BindOutputs(), creates no output buffers of its own, and Execute() does nothing. Otherwise they run the vector
+// kernels as usual, even for a configuration that only happens to be an identity at runtime: at block sizes a
+// memcpy of each channel is no cheaper than the unity-gain kernel.
+
+namespace MetasoundBranches
+{
+    // True if the input can't change after the operator is built
+    inline bool IsConstantInput(const Metasound::FInputVertexInterfaceData& InputData, const Metasound::FVertexName& InVertexName)
+    {
+        const Metasound::FAnyDataReference* DataReference = InputData.FindDataReference(InVertexName);
+        return DataReference == nullptr || DataReference->GetAccessType() == Metasound::EDataReferenceAccessType::Value;
+    }
+}
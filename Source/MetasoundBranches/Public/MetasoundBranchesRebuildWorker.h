@@ -0,0 +1,18 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "MetasoundBranches/Public/Kernels/RebuildSlot.h"
+
+// The worker thread behind every TRebuildSlot in the plugin (see Kernels/RebuildSlot.h). It is started by the first
+// slot to register, sleeps while no slot is registered, and otherwise checks every few milliseconds whether a slot
+// has flagged work.
+
+namespace MetasoundBranches
+{
+    // The scheduler to construct TRebuildSlots with
+    Kernels::IRebuildScheduler& GetRebuildWorker();
+
+    // Stops the thread, called by the module at shutdown. A slot registering after this starts it again.
+    void StopRebuildWorker();
+}
@@ -0,0 +1,34 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+// Per-node profiling for the Branches operators: one cycle stat per node class in "stat MetasoundBranches",
+// and a named CPU trace scope per Execute() in Unreal Insights. Both compile out in Shipping.
+//
+// Usage, in the node's .cpp:
+//     METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(PhaseDisperser, "Phase Disperser");
+//     ...
+//     void Execute()
+//     {
+//         METASOUND_BRANCHES_EXECUTE_SCOPE(PhaseDisperser);
+
+DECLARE_STATS_GROUP(TEXT("MetasoundBranches"), STATGROUP_MetasoundBranches, STATCAT_Advanced);
+
+#if UE_BUILD_SHIPPING
+
+#define METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Name, DisplayName)
+#define METASOUND_BRANCHES_EXECUTE_SCOPE(Name)
+
+#else
+
+#define METASOUND_BRANCHES_DECLARE_EXECUTE_STAT(Name, DisplayName) \
+    DECLARE_CYCLE_STAT(TEXT(DisplayName), STAT_MetasoundBranches_##Name, STATGROUP_MetasoundBranches)
+
+#define METASOUND_BRANCHES_EXECUTE_SCOPE(Name) \
+    SCOPE_CYCLE_COUNTER(STAT_MetasoundBranches_##Name); \
+    TRACE_CPUPROFILER_EVENT_SCOPE(MetasoundBranches_##Name)
+
+#endif
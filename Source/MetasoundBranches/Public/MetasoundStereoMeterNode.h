@@ -0,0 +1,15 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "Metasound.h"
+#include "MetasoundNode.h"
+
+namespace MetasoundBranches
+{
+    class FMetasoundStereoMeterNode : public Metasound::FNode
+    {
+    public:
+        FMetasoundStereoMeterNode();
+    };
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BRANCHES_BENCHMARK_HAS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define BRANCHES_BENCHMARK_HAS_TSC 0
+#endif
+
+namespace MetasoundBranches::Benchmarks
+{
+    inline uint64_t ReadNanoseconds()
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Time stamp counter ticks. On current x86 parts this runs at the nominal clock rather than the boosted core
+    // clock, so it is a stable cycle estimate rather than an exact core cycle count. Zero where unavailable.
+    inline uint64_t ReadCycleCounter()
+    {
+#if BRANCHES_BENCHMARK_HAS_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    inline bool HasCycleCounter()
+    {
+        return BRANCHES_BENCHMARK_HAS_TSC != 0;
+    }
+}
@@ -0,0 +1,157 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace MetasoundBranches::Benchmarks
+{
+    // Minimal streaming JSON writer for benchmark reports
+    class FJsonWriter
+    {
+    public:
+        explicit FJsonWriter(FILE* InFile)
+            : File(InFile)
+        {
+        }
+
+        void BeginObject(const char* Key = nullptr)
+        {
+            WritePrefix(Key);
+            std::fputc('{', File);
+            Scopes.push_back(false);
+        }
+
+        void EndObject()
+        {
+            EndScope('}');
+        }
+
+        void BeginArray(const char* Key = nullptr)
+        {
+            WritePrefix(Key);
+            std::fputc('[', File);
+            Scopes.push_back(false);
+        }
+
+        void EndArray()
+        {
+            EndScope(']');
+        }
+
+        void Write(const char* Key, const char* Value)
+        {
+            WritePrefix(Key);
+            WriteString(Value);
+        }
+
+        void Write(const char* Key, double Value)
+        {
+            WritePrefix(Key);
+            if (std::isfinite(Value))
+            {
+                std::fprintf(File, "%.6g", Value);
+            }
+            else
+            {
+                std::fputs("null", File);
+            }
+        }
+
+        void Write(const char* Key, int64_t Value)
+        {
+            WritePrefix(Key);
+            std::fprintf(File, "%lld", static_cast<long long>(Value));
+        }
+
+        void Write(const char* Key, bool Value)
+        {
+            WritePrefix(Key);
+            std::fputs(Value ? "true" : "false", File);
+        }
+
+        void WriteNull(const char* Key)
+        {
+            WritePrefix(Key);
+            std::fputs("null", File);
+        }
+
+        void Finish()
+        {
+            std::fputc('\n', File);
+            std::fflush(File);
+        }
+
+    private:
+        void WritePrefix(const char* Key)
+        {
+            if (!Scopes.empty())
+            {
+                if (Scopes.back())
+                {
+                    std::fputc(',', File);
+                }
+                Scopes.back() = true;
+
+                WriteNewline();
+            }
+
+            if (Key)
+            {
+                WriteString(Key);
+                std::fputs(": ", File);
+            }
+        }
+
+        void EndScope(char Closer)
+        {
+            const bool bHadValues = Scopes.back();
+            Scopes.pop_back();
+
+            if (bHadValues)
+            {
+                WriteNewline();
+            }
+            std::fputc(Closer, File);
+        }
+
+        void WriteNewline()
+        {
+            std::fputc('\n', File);
+            for (size_t Depth = 0; Depth < Scopes.size(); ++Depth)
+            {
+                std::fputs("  ", File);
+            }
+        }
+
+        void WriteString(const char* Value)
+        {
+            std::fputc('"', File);
+            for (const char* Char = Value; *Char; ++Char)
+            {
+                if (*Char == '"' || *Char == '\\')
+                {
+                    std::fputc('\\', File);
+                    std::fputc(*Char, File);
+                }
+                else if (static_cast<unsigned char>(*Char) < 0x20)
+                {
+                    std::fprintf(File, "\\u%04x", static_cast<unsigned>(*Char));
+                }
+                else
+                {
+                    std::fputc(*Char, File);
+                }
+            }
+            std::fputc('"', File);
+        }
+
+        FILE* File;
+
+        // One entry per open object/array: whether it already holds a value
+        std::vector<bool> Scopes;
+    };
+}
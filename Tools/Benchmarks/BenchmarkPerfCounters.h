@@ -0,0 +1,205 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Hardware performance counters through Linux perf_event_open.
+//
+// Counters are opened for the calling thread, user space only, which works with the default
+// perf_event_paranoid setting of 2. Any counter the PMU or the kernel refuses (common in virtual machines) is
+// reported as unavailable instead of failing the run. There are more events than most PMUs have programmable
+// counters, so the kernel multiplexes them and the counts are scaled by the time each one was actually enabled.
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BRANCHES_BENCHMARK_HAS_PERF_EVENTS 1
+#else
+#define BRANCHES_BENCHMARK_HAS_PERF_EVENTS 0
+#endif
+
+namespace MetasoundBranches::Benchmarks
+{
+    enum class EPerfCounter : int32_t
+    {
+        Cycles,
+        Instructions,
+        Branches,
+        BranchMisses,
+        L1DReads,
+        L1DReadMisses,
+        LLCReads,
+        LLCReadMisses,
+        Count
+    };
+
+    constexpr int32_t NumPerfCounters = static_cast<int32_t>(EPerfCounter::Count);
+
+    struct FPerfCounterValues
+    {
+        double Values[NumPerfCounters] = {};
+        bool bValid[NumPerfCounters] = {};
+
+        bool IsValid(EPerfCounter Counter) const
+        {
+            return bValid[static_cast<int32_t>(Counter)];
+        }
+
+        double Get(EPerfCounter Counter) const
+        {
+            return Values[static_cast<int32_t>(Counter)];
+        }
+    };
+
+    class FPerfCounters
+    {
+    public:
+        FPerfCounters() = default;
+        FPerfCounters(const FPerfCounters&) = delete;
+        FPerfCounters& operator=(const FPerfCounters&) = delete;
+
+        ~FPerfCounters()
+        {
+            Close();
+        }
+
+        // Opens every counter the system allows. Returns false if none could be opened.
+        bool Open()
+        {
+            bool bAnyOpen = false;
+
+#if BRANCHES_BENCHMARK_HAS_PERF_EVENTS
+            for (int32_t Index = 0; Index < NumPerfCounters; ++Index)
+            {
+                uint32_t Type = 0;
+                uint64_t Config = 0;
+                GetEventConfig(static_cast<EPerfCounter>(Index), Type, Config);
+
+                perf_event_attr Attributes = {};
+                Attributes.size = sizeof(Attributes);
+                Attributes.type = Type;
+                Attributes.config = Config;
+                Attributes.disabled = 1;
+                Attributes.exclude_kernel = 1;
+                Attributes.exclude_hv = 1;
+                Attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                Descriptors[Index] = static_cast<int>(syscall(SYS_perf_event_open, &Attributes, 0, -1, -1, 0));
+                bAnyOpen |= Descriptors[Index] >= 0;
+            }
+#endif
+
+            return bAnyOpen;
+        }
+
+        void Close()
+        {
+#if BRANCHES_BENCHMARK_HAS_PERF_EVENTS
+            for (int& Descriptor : Descriptors)
+            {
+                if (Descriptor >= 0)
+                {
+                    close(Descriptor);
+                    Descriptor = -1;
+                }
+            }
+#endif
+        }
+
+        void Start()
+        {
+#if BRANCHES_BENCHMARK_HAS_PERF_EVENTS
+            for (int Descriptor : Descriptors)
+            {
+                if (Descriptor >= 0)
+                {
+                    ioctl(Descriptor, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(Descriptor, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        // Stops counting and adds the scaled counts since Start() to the totals
+        void Stop(FPerfCounterValues& InOutTotals)
+        {
+#if BRANCHES_BENCHMARK_HAS_PERF_EVENTS
+            for (int Descriptor : Descriptors)
+            {
+                if (Descriptor >= 0)
+                {
+                    ioctl(Descriptor, PERF_EVENT_IOC_DISABLE, 0);
+                }
+            }
+
+            for (int32_t Index = 0; Index < NumPerfCounters; ++Index)
+            {
+                // Value, time enabled, time running
+                uint64_t Data[3] = {};
+                if (Descriptors[Index] < 0 || read(Descriptors[Index], Data, sizeof(Data)) != sizeof(Data) || Data[2] == 0)
+                {
+                    continue;
+                }
+
+                InOutTotals.Values[Index] += static_cast<double>(Data[0]) * static_cast<double>(Data[1]) / static_cast<double>(Data[2]);
+                InOutTotals.bValid[Index] = true;
+            }
+#else
+            (void)InOutTotals;
+#endif
+        }
+
+    private:
+#if BRANCHES_BENCHMARK_HAS_PERF_EVENTS
+        static constexpr uint64_t CacheEvent(uint64_t Cache, uint64_t Op, uint64_t Result)
+        {
+            return Cache | (Op << 8) | (Result << 16);
+        }
+
+        static void GetEventConfig(EPerfCounter Counter, uint32_t& OutType, uint64_t& OutConfig)
+        {
+            OutType = PERF_TYPE_HARDWARE;
+
+            switch (Counter)
+            {
+            case EPerfCounter::Cycles:
+                OutConfig = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case EPerfCounter::Instructions:
+                OutConfig = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case EPerfCounter::Branches:
+                OutConfig = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+                break;
+            case EPerfCounter::BranchMisses:
+                OutConfig = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case EPerfCounter::L1DReads:
+                OutType = PERF_TYPE_HW_CACHE;
+                OutConfig = CacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+                break;
+            case EPerfCounter::L1DReadMisses:
+                OutType = PERF_TYPE_HW_CACHE;
+                OutConfig = CacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+            case EPerfCounter::LLCReads:
+                OutType = PERF_TYPE_HW_CACHE;
+                OutConfig = CacheEvent(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_ACCESS);
+                break;
+            case EPerfCounter::LLCReadMisses:
+                OutType = PERF_TYPE_HW_CACHE;
+                OutConfig = CacheEvent(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+            default:
+                OutConfig = 0;
+                break;
+            }
+        }
+#endif
+
+        int Descriptors[NumPerfCounters] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+    };
+}
@@ -0,0 +1,177 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Stand-in for the plugin's rebuild worker (MetasoundBranchesRebuildWorker.cpp) on a std::thread, with the same
+// locking and polling: the task list is only locked to step from one task to the next, Unregister() waits for the
+// task's own rebuild only, and FlagWork() only sets an atomic that the thread polls for while any task is
+// registered. The thread starts with the first task and is joined at exit.
+
+#include "MetasoundBranches/Public/Kernels/RebuildSlot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MetasoundBranches::Benchmarks
+{
+    class FBenchmarkRebuildWorker final : public Kernels::IRebuildScheduler
+    {
+    public:
+        static FBenchmarkRebuildWorker& Get()
+        {
+            static FBenchmarkRebuildWorker Worker;
+            return Worker;
+        }
+
+        ~FBenchmarkRebuildWorker()
+        {
+            {
+                std::lock_guard<std::mutex> Lock(WakeMutex);
+                bStopping = true;
+            }
+            WakeCondition.notify_one();
+
+            if (Thread.joinable())
+            {
+                Thread.join();
+            }
+        }
+
+        virtual void Register(Kernels::IRebuildTask* Task) override
+        {
+            {
+                std::lock_guard<std::mutex> Lock(TasksMutex);
+                Tasks.push_back(Task);
+
+                if (!Thread.joinable())
+                {
+                    Thread = std::thread([this]() { Run(); });
+                }
+            }
+
+            // Wakes the thread from its idle wait to start polling
+            {
+                std::lock_guard<std::mutex> Lock(WakeMutex);
+                bWoken = true;
+            }
+            WakeCondition.notify_one();
+        }
+
+        virtual void Unregister(Kernels::IRebuildTask* Task) override
+        {
+            std::lock_guard<std::mutex> Lock(TasksMutex);
+
+            const auto Found = std::find(Tasks.begin(), Tasks.end(), Task);
+            if (Found != Tasks.end())
+            {
+                const size_t Index = static_cast<size_t>(Found - Tasks.begin());
+                Tasks.erase(Found);
+                if (Index < NextIndex)
+                {
+                    --NextIndex;
+                }
+            }
+
+            // Still holding TasksMutex, so the thread can't step on to another task's rebuild meanwhile
+            if (RunningTask == Task)
+            {
+                std::lock_guard<std::mutex> Wait(BuildMutex);
+            }
+        }
+
+        virtual void FlagWork() override
+        {
+            bWorkPending.store(true, std::memory_order_release);
+        }
+
+    private:
+        // Matches the plugin worker's poll interval
+        static constexpr std::chrono::milliseconds PollInterval { 5 };
+
+        FBenchmarkRebuildWorker() = default;
+
+        bool HasTasks()
+        {
+            std::lock_guard<std::mutex> Lock(TasksMutex);
+            return !Tasks.empty();
+        }
+
+        void Run()
+        {
+            for (;;)
+            {
+                {
+                    const bool bPoll = HasTasks();
+
+                    std::unique_lock<std::mutex> Lock(WakeMutex);
+                    const auto IsWoken = [this]() { return bWoken || bStopping; };
+                    if (bPoll)
+                    {
+                        WakeCondition.wait_for(Lock, PollInterval, IsWoken);
+                    }
+                    else
+                    {
+                        WakeCondition.wait(Lock, IsWoken);
+                    }
+
+                    if (bStopping)
+                    {
+                        return;
+                    }
+                    bWoken = false;
+                }
+
+                if (bWorkPending.exchange(false, std::memory_order_acq_rel))
+                {
+                    RunTasks();
+                }
+            }
+        }
+
+        void RunTasks()
+        {
+            for (;;)
+            {
+                Kernels::IRebuildTask* Task = nullptr;
+                {
+                    std::lock_guard<std::mutex> Lock(TasksMutex);
+                    RunningTask = nullptr;
+
+                    if (NextIndex >= Tasks.size())
+                    {
+                        NextIndex = 0;
+                        return;
+                    }
+
+                    Task = Tasks[NextIndex++];
+                    RunningTask = Task;
+                    BuildMutex.lock();
+                }
+
+                Task->RunRebuild();
+                BuildMutex.unlock();
+            }
+        }
+
+        std::thread Thread;
+
+        std::mutex WakeMutex;
+        std::condition_variable WakeCondition;
+        bool bWoken = false;
+        bool bStopping = false;
+
+        std::atomic<bool> bWorkPending { false };
+
+        std::mutex TasksMutex;
+        std::vector<Kernels::IRebuildTask*> Tasks;
+        size_t NextIndex = 0;
+        Kernels::IRebuildTask* RunningTask = nullptr;
+
+        std::mutex BuildMutex;
+    };
+}
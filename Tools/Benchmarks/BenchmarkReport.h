@@ -0,0 +1,172 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+#include "BenchmarkClock.h"
+#include "BenchmarkJson.h"
+#include "MetasoundBranches/Public/Kernels/KernelDispatch.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace MetasoundBranches::Benchmarks
+{
+    // Parses a comma separated list such as "64,128,256"; returns an empty list on malformed input
+    inline std::vector<int64_t> ParseIntegerList(const char* Text)
+    {
+        std::vector<int64_t> Values;
+        const char* Cursor = Text;
+
+        while (*Cursor)
+        {
+            char* End = nullptr;
+            const long long Value = std::strtoll(Cursor, &End, 10);
+            if (End == Cursor || Value <= 0)
+            {
+                return {};
+            }
+
+            Values.push_back(Value);
+            Cursor = (*End == ',') ? End + 1 : End;
+        }
+
+        return Values;
+    }
+
+    // Parses an --isa value (auto, scalar, sse2, sse4.1, avx2, avx512); auto selects the most capable kernels
+    inline bool ParseKernelIsa(const char* Text, Kernels::EKernelIsa& OutIsa)
+    {
+        using Kernels::EKernelIsa;
+
+        static const struct { const char* Name; EKernelIsa Isa; } Names[] = {
+            { "auto", EKernelIsa::AVX512 },
+            { "scalar", EKernelIsa::Scalar },
+            { "sse2", EKernelIsa::SSE2 },
+            { "sse4.1", EKernelIsa::SSE41 },
+            { "avx2", EKernelIsa::AVX2 },
+            { "avx512", EKernelIsa::AVX512 },
+        };
+
+        for (const auto& Entry : Names)
+        {
+            if (std::strcmp(Text, Entry.Name) == 0)
+            {
+                OutIsa = Entry.Isa;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline std::string GetCpuModelName()
+    {
+        std::ifstream CpuInfo("/proc/cpuinfo");
+        std::string Line;
+
+        while (std::getline(CpuInfo, Line))
+        {
+            if (Line.rfind("model name", 0) == 0)
+            {
+                const size_t Colon = Line.find(':');
+                if (Colon != std::string::npos)
+                {
+                    return Line.substr(Line.find_first_not_of(' ', Colon + 1));
+                }
+            }
+        }
+
+        return "unknown";
+    }
+
+    struct FCacheInfo
+    {
+        int64_t Level = 0;
+        std::string Type;
+        int64_t SizeBytes = 0;
+    };
+
+    // Cache hierarchy of the first CPU, from sysfs (empty where unavailable)
+    inline std::vector<FCacheInfo> GetCacheInfo()
+    {
+        std::vector<FCacheInfo> Caches;
+
+        for (int32_t Index = 0; ; ++Index)
+        {
+            const std::string Directory = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(Index) + "/";
+            std::ifstream LevelFile(Directory + "level");
+            std::ifstream TypeFile(Directory + "type");
+            std::ifstream SizeFile(Directory + "size");
+
+            if (!LevelFile || !TypeFile || !SizeFile)
+            {
+                break;
+            }
+
+            FCacheInfo Cache;
+            std::string Size;
+            LevelFile >> Cache.Level;
+            TypeFile >> Cache.Type;
+            SizeFile >> Size;
+
+            Cache.SizeBytes = std::atoll(Size.c_str());
+            if (!Size.empty() && (Size.back() == 'K' || Size.back() == 'k'))
+            {
+                Cache.SizeBytes *= 1024;
+            }
+            else if (!Size.empty() && Size.back() == 'M')
+            {
+                Cache.SizeBytes *= 1024 * 1024;
+            }
+
+            Caches.push_back(Cache);
+        }
+
+        return Caches;
+    }
+
+    // Describes the machine and build so reports from different builds can be compared
+    inline void WriteHostInfo(FJsonWriter& Writer)
+    {
+        Writer.BeginObject("host");
+
+        Writer.Write("cpu", GetCpuModelName().c_str());
+        Writer.Write("timestamp", static_cast<int64_t>(std::time(nullptr)));
+
+#if defined(__clang__)
+        Writer.Write("compiler", "clang " __clang_version__);
+#elif defined(__GNUC__)
+        Writer.Write("compiler", "gcc " __VERSION__);
+#elif defined(_MSC_VER)
+        Writer.Write("compiler", "msvc");
+#else
+        Writer.Write("compiler", "unknown");
+#endif
+
+#if defined(NDEBUG)
+        Writer.Write("optimized", true);
+#else
+        Writer.Write("optimized", false);
+#endif
+
+        Writer.Write("cycle_counter", HasCycleCounter() ? "tsc" : "none");
+        Writer.Write("kernel_isa", Kernels::GetKernelIsaName(Kernels::GetActiveKernelIsa()));
+        Writer.Write("kernel_isa_detected", Kernels::GetKernelIsaName(Kernels::GetDetectedKernelIsa()));
+
+        Writer.BeginArray("caches");
+        for (const FCacheInfo& Cache : GetCacheInfo())
+        {
+            Writer.BeginObject();
+            Writer.Write("level", Cache.Level);
+            Writer.Write("type", Cache.Type.c_str());
+            Writer.Write("size_bytes", Cache.SizeBytes);
+            Writer.EndObject();
+        }
+        Writer.EndArray();
+
+        Writer.EndObject();
+    }
+}
@@ -0,0 +1,1297 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#include "BenchmarkVoices.h"
+#include "BenchmarkRebuildWorker.h"
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernels.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MetasoundBranches::Benchmarks
+{
+    namespace
+    {
+        using namespace MetasoundBranches::Kernels;
+
+        using FBuffer = std::vector<float>;
+
+        // Deterministic white noise in [-Amplitude, Amplitude]
+        void FillNoise(FBuffer& Buffer, uint32_t Seed, float Amplitude = 1.0f)
+        {
+            FRandomStreamState Random;
+            Random.Initialize(static_cast<int32_t>(Seed));
+
+            for (float& Sample : Buffer)
+            {
+                Sample = (Random.GetFraction() * 2.0f - 1.0f) * Amplitude;
+            }
+        }
+
+        void FillSine(FBuffer& Buffer, float Frequency, float SampleRate, float Amplitude = 1.0f, float Offset = 0.0f)
+        {
+            const double PhaseIncrement = 2.0 * 3.14159265358979323846 * Frequency / SampleRate;
+
+            for (size_t i = 0; i < Buffer.size(); ++i)
+            {
+                Buffer[i] = Offset + Amplitude * static_cast<float>(std::sin(PhaseIncrement * static_cast<double>(i)));
+            }
+        }
+
+        void FillSquare(FBuffer& Buffer, float Frequency, float SampleRate, float Low = 0.0f, float High = 1.0f)
+        {
+            const double Period = SampleRate / Frequency;
+
+            for (size_t i = 0; i < Buffer.size(); ++i)
+            {
+                Buffer[i] = std::fmod(static_cast<double>(i), Period) < Period * 0.5 ? High : Low;
+            }
+        }
+
+        // Replaces a generated audio input with silence or a DC value when the settings ask for it
+        void ApplyVoiceInput(FBuffer& Buffer, const FVoiceSettings& Settings)
+        {
+            if (Settings.Input == EVoiceInput::Silent)
+            {
+                std::fill(Buffer.begin(), Buffer.end(), 0.0f);
+            }
+            else if (Settings.Input == EVoiceInput::Constant)
+            {
+                std::fill(Buffer.begin(), Buffer.end(), 0.25f);
+            }
+        }
+
+        // Stand-in for a trigger input firing at a fixed period, carried across blocks
+        struct FTriggerPattern
+        {
+            int32_t Period = 1000;
+            int32_t Countdown = 0;
+
+            template<typename OnTriggerType>
+            void ExecuteBlock(int32_t NumFrames, OnTriggerType&& OnTrigger)
+            {
+                int32_t Frame = Countdown;
+                while (Frame < NumFrames)
+                {
+                    OnTrigger(Frame);
+                    Frame += Period;
+                }
+
+                Countdown = Frame - NumFrames;
+            }
+        };
+
+        // Stand-in for a trigger output; only counts so the work can't be optimized away
+        struct FTriggerSink
+        {
+            int32_t NumTriggers = 0;
+
+            void TriggerFrame(int32_t)
+            {
+                ++NumTriggers;
+            }
+        };
+
+        class FSahVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                Signal.assign(NumFrames, 0.0f);
+                Trigger.assign(NumFrames, 0.0f);
+                Output.assign(NumFrames, 0.0f);
+
+                FillNoise(Signal, InSettings.Seed);
+                FillSquare(Trigger, 200.0f + static_cast<float>(InSettings.Seed % 50), InSettings.SampleRate);
+
+                ApplyVoiceInput(Signal, InSettings);
+                ApplyVoiceInput(Trigger, InSettings);
+            }
+
+            virtual void Execute() override
+            {
+                ProcessSah(State, Signal.data(), Trigger.data(), Threshold, Output.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                State = FSahState();
+                std::fill(Output.begin(), Output.end(), 0.0f);
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            FBuffer Signal;
+            FBuffer Trigger;
+            FBuffer Output;
+            float Threshold = 0.5f;
+            FSahState State;
+        };
+
+        class FSlewVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                SampleRate = static_cast<int32_t>(InSettings.SampleRate);
+                Signal.assign(NumFrames, 0.0f);
+                Output.assign(NumFrames, 0.0f);
+
+                FillSquare(Signal, 50.0f + static_cast<float>(InSettings.Seed % 100), InSettings.SampleRate, -1.0f, 1.0f);
+
+                ApplyVoiceInput(Signal, InSettings);
+            }
+
+            virtual void Execute() override
+            {
+                const FScopedFlushDenormals FlushDenormals;
+
+                const FSlewCoefficients Coefficients = MakeSlewCoefficients(RiseTime, FallTime, static_cast<float>(SampleRate));
+                ProcessSlew(State, Signal.data(), Output.data(), NumFrames, Coefficients);
+
+                if (!GuardSlewState(State))
+                {
+                    std::memset(Output.data(), 0, NumFrames * sizeof(float));
+                }
+            }
+
+            virtual void Reset() override
+            {
+                State = FSlewState();
+                std::fill(Output.begin(), Output.end(), 0.0f);
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            int32_t SampleRate = 48000;
+            FBuffer Signal;
+            FBuffer Output;
+            float RiseTime = 0.01f;
+            float FallTime = 0.05f;
+            FSlewState State;
+        };
+
+        class FSlewFloatVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                SampleRate = static_cast<int32_t>(InSettings.SampleRate);
+                BlockCounter = InSettings.Seed;
+            }
+
+            virtual void Execute() override
+            {
+                const float Input = ((++BlockCounter / 16) % 2) ? 1.0f : 0.0f;
+                const FSlewCoefficients Coefficients = MakeSlewCoefficients(RiseTime, FallTime, static_cast<float>(SampleRate));
+
+                State.PreviousOutput = SlewSample(State.PreviousOutput, Input, Coefficients);
+                GuardSlewState(State);
+                Output = State.PreviousOutput;
+            }
+
+            virtual void Reset() override
+            {
+                State = FSlewState();
+                Output = 0.0f;
+            }
+
+        private:
+            int32_t SampleRate = 48000;
+            uint32_t BlockCounter = 0;
+            float RiseTime = 0.01f;
+            float FallTime = 0.05f;
+            float Output = 0.0f;
+            FSlewState State;
+        };
+
+        class FBoolToAudioVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                SampleRate = InSettings.SampleRate;
+                Output.assign(NumFrames, 0.0f);
+                BlockCounter = InSettings.Seed;
+            }
+
+            virtual void Execute() override
+            {
+                const FScopedFlushDenormals FlushDenormals;
+
+                const float TargetValue = ((++BlockCounter / 8) % 2) ? 1.0f : 0.0f;
+                const FSlewCoefficients Coefficients = MakeSlewCoefficients(RiseTime, FallTime, SampleRate);
+                ProcessSlewToTarget(State, TargetValue, Output.data(), NumFrames, Coefficients);
+
+                if (!GuardSlewState(State))
+                {
+                    std::memset(Output.data(), 0, NumFrames * sizeof(float));
+                }
+            }
+
+            virtual void Reset() override
+            {
+                State = FSlewState();
+                std::fill(Output.begin(), Output.end(), 0.0f);
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            float SampleRate = 48000.0f;
+            uint32_t BlockCounter = 0;
+            FBuffer Output;
+            float RiseTime = 0.005f;
+            float FallTime = 0.02f;
+            FSlewState State;
+        };
+
+        class FDustVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                Density.assign(NumFrames, 0.0f);
+                Output.assign(NumFrames, 0.0f);
+
+                FillSine(Density, 0.5f, InSettings.SampleRate, 10.0f, 20.0f);
+                Seed = InSettings.Seed;
+                State.Random.Initialize(static_cast<int32_t>(Seed));
+            }
+
+            virtual void Execute() override
+            {
+                ProcessDust(State, Density.data(), DensityOffset, true, true, Output.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                State = FDustState();
+                State.Random.Initialize(static_cast<int32_t>(Seed));
+                std::fill(Output.begin(), Output.end(), 0.0f);
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            FBuffer Density;
+            FBuffer Output;
+            float DensityOffset = 0.1f;
+            uint32_t Seed = 1;
+            FDustState State;
+        };
+
+        class FDustTriggerVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                Density.assign(NumFrames, 0.0f);
+
+                FillSine(Density, 0.5f, InSettings.SampleRate, 10.0f, 20.0f);
+                Seed = InSettings.Seed;
+                Random.Initialize(static_cast<int32_t>(Seed));
+            }
+
+            virtual void Execute() override
+            {
+                ProcessDustTrigger(Random, Density.data(), DensityOffset, true, NumFrames,
+                    [this](int32_t Frame)
+                    {
+                        OutputTrigger.TriggerFrame(Frame);
+                    }
+                );
+            }
+
+            virtual void Reset() override
+            {
+                Random.Initialize(static_cast<int32_t>(Seed));
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            FBuffer Density;
+            float DensityOffset = 0.1f;
+            uint32_t Seed = 1;
+            FRandomStreamState Random;
+            FTriggerSink OutputTrigger;
+        };
+
+        class FImpulseVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                Output.assign(NumFrames, 0.0f);
+                InputTrigger.Period = 400 + static_cast<int32_t>(InSettings.Seed % 200);
+            }
+
+            virtual void Execute() override
+            {
+                float* OutputData = Output.data();
+                std::memset(OutputData, 0, sizeof(float) * NumFrames);
+
+                InputTrigger.ExecuteBlock(NumFrames,
+                    [&](int32_t TriggerFrame)
+                    {
+                        OnTrigger.TriggerFrame(TriggerFrame);
+                        OutputData[TriggerFrame] = NextImpulseValue(State, true);
+                    }
+                );
+            }
+
+            virtual void Reset() override
+            {
+                State = FImpulseState();
+                std::fill(Output.begin(), Output.end(), 0.0f);
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            FBuffer Output;
+            FTriggerPattern InputTrigger;
+            FTriggerSink OnTrigger;
+            FImpulseState State;
+        };
+
+        class FEdgeVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                SampleRate = InSettings.SampleRate;
+                Signal.assign(NumFrames, 0.0f);
+
+                FillSine(Signal, 110.0f + static_cast<float>(InSettings.Seed % 100), SampleRate);
+
+                ApplyVoiceInput(Signal, InSettings);
+            }
+
+            virtual void Execute() override
+            {
+                if (LastDebounceTime != DebounceTime)
+                {
+                    DebounceSamples = DebounceSamplesFromSeconds(DebounceTime, SampleRate);
+                    LastDebounceTime = DebounceTime;
+                }
+
+                ProcessEdge(State, Signal.data(), NumFrames, DebounceSamples,
+                    [this](int32_t Frame)
+                    {
+                        OutputTriggerRise.TriggerFrame(Frame);
+                    },
+                    [this](int32_t Frame)
+                    {
+                        OutputTriggerFall.TriggerFrame(Frame);
+                    }
+                );
+            }
+
+            virtual void Reset() override
+            {
+                State = FEdgeState();
+                State.PreviousSignalValue = Signal.empty() ? 0.0f : Signal[0];
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            float SampleRate = 48000.0f;
+            FBuffer Signal;
+            float DebounceTime = 0.001f;
+            float LastDebounceTime = -1.0f;
+            int32_t DebounceSamples = 0;
+            FEdgeState State;
+            FTriggerSink OutputTriggerRise;
+            FTriggerSink OutputTriggerFall;
+        };
+
+        class FZeroCrossingVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                SampleRate = InSettings.SampleRate;
+                Signal.assign(NumFrames, 0.0f);
+
+                FillNoise(Signal, InSettings.Seed);
+
+                ApplyVoiceInput(Signal, InSettings);
+            }
+
+            virtual void Execute() override
+            {
+                if (LastDebounceTime != DebounceTime)
+                {
+                    DebounceSamples = DebounceSamplesFromSeconds(DebounceTime, SampleRate);
+                    LastDebounceTime = DebounceTime;
+                }
+
+                ProcessZeroCrossing(State, Signal.data(), NumFrames, DebounceSamples,
+                    [this](int32_t Frame)
+                    {
+                        OutputTrigger.TriggerFrame(Frame);
+                    }
+                );
+            }
+
+            virtual void Reset() override
+            {
+                State = FZeroCrossingState();
+                State.PreviousSignalValue = Signal.empty() ? 0.0f : Signal[0];
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            float SampleRate = 48000.0f;
+            FBuffer Signal;
+            float DebounceTime = 0.001f;
+            float LastDebounceTime = -1.0f;
+            int32_t DebounceSamples = 0;
+            FZeroCrossingState State;
+            FTriggerSink OutputTrigger;
+        };
+
+        // Designed voices run DispersionMs of dispersion across 100 Hz - 4 kHz in place of the stages. Automated ones
+        // alternate it with 1.5 times as much every block, so the operator requests a new design every block.
+        template<int32_t NumStages, EAllPassMode Mode = EAllPassMode::Recursive, int32_t DispersionMs = 0, bool bAutomated = false>
+        class TPhaseDisperserVoice : public IBenchmarkVoice
+        {
+        public:
+            // Matches FPhaseDisperserOperator::MaxAllowedFilters
+            static constexpr int32_t MaxAllowedFilters = MaxAllPassStages;
+
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                Signal.assign(NumFrames, 0.0f);
+                Output.assign(NumFrames, 0.0f);
+
+                // Like an operator whose mode is constant
+                AllocateAllPassDisperserModes(AllPassState, Mode == EAllPassMode::Convolution || Mode == EAllPassMode::Auto, Mode == EAllPassMode::Designed);
+                ResetAllPassDisperser(AllPassState, Clamp(NumStages, 1, MaxAllowedFilters));
+
+                DispersionParams.DispersionSeconds = DispersionMs * 0.001f;
+                DispersionParams.LowFrequency = 100.0f;
+                DispersionParams.HighFrequency = 4000.0f;
+                DispersionParams.SampleRate = InSettings.SampleRate;
+                RequestedParams = DispersionParams;
+                if (Mode == EAllPassMode::Designed)
+                {
+                    DesignSlot = std::make_unique<TRebuildSlot<FDispersionParams, FDispersionDesign>>(FBenchmarkRebuildWorker::Get(), &MakeDispersionDesign, DispersionParams);
+                }
+
+                // The module builds the bank at startup
+                GetAllPassResponseBank();
+
+                FillNoise(Signal, InSettings.Seed);
+
+                ApplyVoiceInput(Signal, InSettings);
+            }
+
+            virtual void Execute() override
+            {
+                const FScopedFlushDenormals FlushDenormals;
+
+                std::memcpy(Output.data(), Signal.data(), NumFrames * sizeof(float));
+
+                const int32_t CurrentNumFilters = Clamp(NumStages, 1, MaxAllowedFilters);
+                if (Mode == EAllPassMode::Designed)
+                {
+                    FDispersionParams Params = DispersionParams;
+                    if (bAutomated && (BlockIndex++ & 1) != 0)
+                    {
+                        Params.DispersionSeconds *= 1.5f;
+                    }
+
+                    if (Params != RequestedParams)
+                    {
+                        DesignSlot->Request(Params);
+                        RequestedParams = Params;
+                    }
+
+                    DesignSlot->Acquire();
+                    SetAllPassDispersionDesign(AllPassState, &DesignSlot->Get(), true);
+                }
+                ProcessAllPassDisperser(AllPassState, Mode, CurrentNumFilters, Output.data(), NumFrames);
+
+                if (!GuardAllPassDisperserState(AllPassState, CurrentNumFilters))
+                {
+                    std::memset(Output.data(), 0, NumFrames * sizeof(float));
+                }
+            }
+
+            virtual void Reset() override
+            {
+                ResetAllPassDisperser(AllPassState, Clamp(NumStages, 1, MaxAllowedFilters));
+
+                std::fill(Output.begin(), Output.end(), 0.0f);
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            FBuffer Signal;
+            FBuffer Output;
+            FAllPassDisperserState AllPassState;
+            FDispersionParams DispersionParams;
+            FDispersionParams RequestedParams;
+            uint32_t BlockIndex = 0;
+            std::unique_ptr<TRebuildSlot<FDispersionParams, FDispersionDesign>> DesignSlot;
+        };
+
+        // The automated stereo voices alternate their parameter between two values every block, so every block
+        // ramps; the others hold it, which keeps them on the constant-gain kernels like an unmodulated operator
+        class FStereoVoiceBase : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                Left.assign(NumFrames, 0.0f);
+                Right.assign(NumFrames, 0.0f);
+                OutputLeft.assign(NumFrames, 0.0f);
+                OutputRight.assign(NumFrames, 0.0f);
+
+                FillNoise(Left, InSettings.Seed, 0.5f);
+                FillNoise(Right, InSettings.Seed + 1, 0.5f);
+
+                ApplyVoiceInput(Left, InSettings);
+                ApplyVoiceInput(Right, InSettings);
+            }
+
+            virtual void Reset() override
+            {
+                BlockIndex = 0;
+
+                std::fill(OutputLeft.begin(), OutputLeft.end(), 0.0f);
+                std::fill(OutputRight.begin(), OutputRight.end(), 0.0f);
+            }
+
+        protected:
+            // True every other block for the automated variants
+            bool IsAlternateBlock(bool bAutomated)
+            {
+                return bAutomated && (BlockIndex++ & 1) != 0;
+            }
+
+            int32_t NumFrames = 0;
+            uint32_t BlockIndex = 0;
+            FBuffer Left;
+            FBuffer Right;
+            FBuffer OutputLeft;
+            FBuffer OutputRight;
+        };
+
+        template<bool bAutomated>
+        class TStereoBalanceVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Execute() override
+            {
+                const float Balance = IsAlternateBlock(bAutomated) ? -0.2f : 0.3f;
+                ProcessStereoGainsRamped(Gains, MakeBalanceGains(Balance), Left.data(), Right.data(), OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                FStereoVoiceBase::Reset();
+                Gains = MakeBalanceGains(0.3f);
+            }
+
+        private:
+            FStereoGains Gains = MakeBalanceGains(0.3f);
+        };
+
+        template<bool bAutomated>
+        class TStereoCrossfadeVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                FStereoVoiceBase::Prepare(InSettings);
+
+                Left2.assign(NumFrames, 0.0f);
+                Right2.assign(NumFrames, 0.0f);
+
+                FillNoise(Left2, InSettings.Seed + 2, 0.5f);
+                FillNoise(Right2, InSettings.Seed + 3, 0.5f);
+
+                ApplyVoiceInput(Left2, InSettings);
+                ApplyVoiceInput(Right2, InSettings);
+            }
+
+            virtual void Execute() override
+            {
+                const float Crossfade = IsAlternateBlock(bAutomated) ? 0.6f : 0.4f;
+                ProcessStereoCrossfadeRamped(
+                    Gains,
+                    Left.data(), Right.data(),
+                    Left2.data(), Right2.data(),
+                    Crossfade, OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                FStereoVoiceBase::Reset();
+                Gains = MakeCrossfadeGains(0.4f);
+            }
+
+        private:
+            FBuffer Left2;
+            FBuffer Right2;
+            FStereoGains Gains = MakeCrossfadeGains(0.4f);
+        };
+
+        template<int32_t NumInputs, bool bAutomated>
+        class TStereoCrossfadeMultiVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                FStereoVoiceBase::Prepare(InSettings);
+
+                Inputs.assign(NumInputs * 2, FBuffer(NumFrames, 0.0f));
+                for (int32_t Index = 0; Index < NumInputs * 2; ++Index)
+                {
+                    FillNoise(Inputs[Index], InSettings.Seed + 2 + Index, 0.5f);
+                    ApplyVoiceInput(Inputs[Index], InSettings);
+                }
+
+                for (int32_t Index = 0; Index < NumInputs; ++Index)
+                {
+                    LeftData[Index] = Inputs[Index * 2].data();
+                    RightData[Index] = Inputs[Index * 2 + 1].data();
+                }
+            }
+
+            virtual void Execute() override
+            {
+                const float Position = IsAlternateBlock(bAutomated) ? 1.7f : 1.4f;
+                ProcessStereoCrossfadeN(State, LeftData, RightData, NumInputs, Position, OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                FStereoVoiceBase::Reset();
+                State = 1.4f;
+            }
+
+        private:
+            std::vector<FBuffer> Inputs;
+            const float* LeftData[NumInputs] = {};
+            const float* RightData[NumInputs] = {};
+            float State = 1.4f;
+        };
+
+        // The audio-rate voices sweep their position with a sine in the low audio range
+        class FStereoBalanceAudioVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                FStereoVoiceBase::Prepare(InSettings);
+
+                Balance.assign(NumFrames, 0.0f);
+                FillSine(Balance, 300.0f + static_cast<float>(InSettings.Seed % 50), InSettings.SampleRate);
+            }
+
+            virtual void Execute() override
+            {
+                ProcessStereoBalanceAudio(Left.data(), Right.data(), Balance.data(), OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+        private:
+            FBuffer Balance;
+        };
+
+        class FStereoCrossfadeAudioVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                FStereoVoiceBase::Prepare(InSettings);
+
+                Left2.assign(NumFrames, 0.0f);
+                Right2.assign(NumFrames, 0.0f);
+                Crossfade.assign(NumFrames, 0.0f);
+
+                FillNoise(Left2, InSettings.Seed + 2, 0.5f);
+                FillNoise(Right2, InSettings.Seed + 3, 0.5f);
+                FillSine(Crossfade, 300.0f + static_cast<float>(InSettings.Seed % 50), InSettings.SampleRate, 0.5f, 0.5f);
+
+                ApplyVoiceInput(Left2, InSettings);
+                ApplyVoiceInput(Right2, InSettings);
+            }
+
+            virtual void Execute() override
+            {
+                ProcessStereoCrossfadeAudio(
+                    Left.data(), Right.data(),
+                    Left2.data(), Right2.data(),
+                    Crossfade.data(), OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+        private:
+            FBuffer Left2;
+            FBuffer Right2;
+            FBuffer Crossfade;
+        };
+
+        template<bool bAutomated>
+        class TStereoGainVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Execute() override
+            {
+                const float Gain = IsAlternateBlock(bAutomated) ? 0.5f : 0.7f;
+                ProcessStereoGainsRamped(Gains, FStereoGains{ Gain, Gain }, Left.data(), Right.data(), OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                FStereoVoiceBase::Reset();
+                Gains = FStereoGains{ 0.7f, 0.7f };
+            }
+
+        private:
+            FStereoGains Gains{ 0.7f, 0.7f };
+        };
+
+        template<bool bAutomated>
+        class TStereoMatrixVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Execute() override
+            {
+                const bool bAlternate = IsAlternateBlock(bAutomated);
+                const float Width = bAlternate ? 1.2f : 1.5f;
+                const float Balance = bAlternate ? -0.2f : 0.3f;
+                const float Gain = bAlternate ? 0.5f : 0.7f;
+
+                ProcessStereoMatrix(
+                    State,
+                    Left.data(), Right.data(),
+                    true, Width, Balance, true, false, true, Gain,
+                    OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                FStereoVoiceBase::Reset();
+                State = MakeStereoMatrixState(1.5f, 0.3f, 0.7f);
+            }
+
+        private:
+            FStereoMatrixState State = MakeStereoMatrixState(1.5f, 0.3f, 0.7f);
+        };
+
+        class FStereoInverterVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Execute() override
+            {
+                ProcessStereoInverter(Left.data(), Right.data(), true, false, true, OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+        };
+
+        class FStereoMeterVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                FStereoVoiceBase::Prepare(InSettings);
+                Decay = MakeMeterDecay(0.3f, InSettings.SampleRate, NumFrames);
+            }
+
+            virtual void Execute() override
+            {
+                ProcessStereoMeter(State, Left.data(), Right.data(), Decay, NumFrames);
+                GuardStereoMeterState(State);
+                Readings = GetStereoMeterReadings(State);
+            }
+
+            virtual void Reset() override
+            {
+                FStereoVoiceBase::Reset();
+                State = FStereoMeterState();
+            }
+
+        private:
+            FStereoMeterState State;
+            FStereoMeterReadings Readings;
+            float Decay = 0.0f;
+        };
+
+        template<bool bAutomated>
+        class TStereoWidthVoice : public FStereoVoiceBase
+        {
+        public:
+            virtual void Execute() override
+            {
+                const float Width = IsAlternateBlock(bAutomated) ? 1.2f : 1.5f;
+                ProcessStereoWidthRamped(WidthFactor, Width, Left.data(), Right.data(), OutputLeft.data(), OutputRight.data(), NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                FStereoVoiceBase::Reset();
+                WidthFactor = 1.5f;
+            }
+
+        private:
+            float WidthFactor = 1.5f;
+        };
+
+        // NumChannels channels of noise in, NumChannels out
+        template<int32_t NumChannels>
+        class TMultichannelVoiceBase : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                Inputs.assign(NumChannels, FBuffer(NumFrames, 0.0f));
+                Outputs.assign(NumChannels, FBuffer(NumFrames, 0.0f));
+
+                for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    FillNoise(Inputs[Channel], InSettings.Seed + Channel, 0.5f);
+                    ApplyVoiceInput(Inputs[Channel], InSettings);
+
+                    InputData[Channel] = Inputs[Channel].data();
+                    OutputData[Channel] = Outputs[Channel].data();
+                }
+            }
+
+            virtual void Reset() override
+            {
+                BlockIndex = 0;
+
+                for (FBuffer& Output : Outputs)
+                {
+                    std::fill(Output.begin(), Output.end(), 0.0f);
+                }
+            }
+
+        protected:
+            // True every other block for the automated variants
+            bool IsAlternateBlock(bool bAutomated)
+            {
+                return bAutomated && (BlockIndex++ & 1) != 0;
+            }
+
+            int32_t NumFrames = 0;
+            uint32_t BlockIndex = 0;
+            std::vector<FBuffer> Inputs;
+            std::vector<FBuffer> Outputs;
+            const float* InputData[NumChannels] = {};
+            float* OutputData[NumChannels] = {};
+        };
+
+        template<int32_t NumChannels, bool bAutomated>
+        class TMultichannelGainVoice : public TMultichannelVoiceBase<NumChannels>
+        {
+        public:
+            virtual void Execute() override
+            {
+                const float Gain = this->IsAlternateBlock(bAutomated) ? 0.5f : 0.7f;
+                ProcessMultichannelGainRamped(State, Gain, this->InputData, this->OutputData, NumChannels, this->NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                TMultichannelVoiceBase<NumChannels>::Reset();
+                State = 0.7f;
+            }
+
+        private:
+            float State = 0.7f;
+        };
+
+        // Reverses the channels and inverts every other one
+        template<int32_t NumChannels>
+        class TMultichannelInverterVoice : public TMultichannelVoiceBase<NumChannels>
+        {
+        public:
+            virtual void Execute() override
+            {
+                int32_t Sources[NumChannels];
+                for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    Sources[Channel] = NumChannels - 1 - Channel;
+                }
+
+                ProcessMultichannelInverter(this->InputData, Sources, 0x55u, this->OutputData, NumChannels, this->NumFrames);
+            }
+        };
+
+        template<int32_t NumChannels, bool bAutomated>
+        class TMultichannelWidthVoice : public TMultichannelVoiceBase<NumChannels>
+        {
+        public:
+            virtual void Execute() override
+            {
+                const float Width = this->IsAlternateBlock(bAutomated) ? 1.2f : 1.5f;
+                ProcessMultichannelWidthRamped(WidthFactor, Width, this->InputData, this->OutputData, NumChannels, this->NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                TMultichannelVoiceBase<NumChannels>::Reset();
+                WidthFactor = 1.5f;
+            }
+
+        private:
+            float WidthFactor = 1.5f;
+        };
+
+        // NumStages stages on every channel, with the channels' feedback spread halfway
+        template<int32_t NumChannels, int32_t NumStages>
+        class TMultichannelPhaseDisperserVoice : public TMultichannelVoiceBase<NumChannels>
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                TMultichannelVoiceBase<NumChannels>::Prepare(InSettings);
+                State.Init(NumChannels, Spread);
+            }
+
+            virtual void Execute() override
+            {
+                const FScopedFlushDenormals FlushDenormals;
+
+                for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                {
+                    std::memcpy(this->OutputData[Channel], this->InputData[Channel], this->NumFrames * sizeof(float));
+                }
+
+                SetAllPassChannelSpread(State, Spread);
+                ProcessAllPassChannelCascade(State, NumStages, this->OutputData, this->NumFrames);
+
+                if (!GuardAllPassChannelCascadeState(State, NumStages))
+                {
+                    for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                    {
+                        std::memset(this->OutputData[Channel], 0, this->NumFrames * sizeof(float));
+                    }
+                }
+            }
+
+            virtual void Reset() override
+            {
+                TMultichannelVoiceBase<NumChannels>::Reset();
+                State.Init(NumChannels, Spread);
+            }
+
+        private:
+            static constexpr float Spread = 0.5f;
+
+            FAllPassChannelCascadeState State;
+        };
+
+        // NumRoutes routes through a NumChannels x NumChannels stereo router, spread so every output is fed before
+        // any takes a second input; every other route is at unity, the rest at a gain that the automated variants
+        // alternate every block
+        template<int32_t NumChannels, int32_t NumRoutes, bool bAutomated>
+        class TStereoRouterVoice : public TMultichannelVoiceBase<NumChannels * 2>
+        {
+            static_assert(NumRoutes <= NumChannels * NumChannels, "More routes than the matrix holds");
+
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                TMultichannelVoiceBase<NumChannels * 2>::Prepare(InSettings);
+
+                for (int32_t Index = 0; Index < NumChannels; ++Index)
+                {
+                    LeftData[Index] = this->InputData[Index * 2];
+                    RightData[Index] = this->InputData[Index * 2 + 1];
+                    OutputLeftData[Index] = this->OutputData[Index * 2];
+                    OutputRightData[Index] = this->OutputData[Index * 2 + 1];
+                }
+
+                Reset();
+            }
+
+            virtual void Execute() override
+            {
+                const float Gain = this->IsAlternateBlock(bAutomated) ? 0.6f : 0.5f;
+                for (int32_t Route = 1; Route < NumRoutes; Route += 2)
+                {
+                    Gains[GetRouteIndex(Route)] = Gain;
+                }
+
+                UpdateStereoRoutes(State, Gains, NumChannels * NumChannels, NumChannels, NumChannels, this->NumFrames);
+                ProcessStereoRouter(State, LeftData, RightData, OutputLeftData, OutputRightData, NumChannels, this->NumFrames);
+            }
+
+            virtual void Reset() override
+            {
+                TMultichannelVoiceBase<NumChannels * 2>::Reset();
+
+                std::fill(std::begin(Gains), std::end(Gains), 0.0f);
+                for (int32_t Route = 0; Route < NumRoutes; ++Route)
+                {
+                    Gains[GetRouteIndex(Route)] = (Route & 1) != 0 ? 0.5f : 1.0f;
+                }
+
+                ResetStereoRouter(State, Gains, NumChannels * NumChannels, NumChannels, NumChannels);
+            }
+
+        private:
+            static int32_t GetRouteIndex(int32_t Route)
+            {
+                const int32_t Output = Route % NumChannels;
+                const int32_t Input = (Route / NumChannels + Output) % NumChannels;
+                return GetRouterGainIndex(Input, Output, NumChannels);
+            }
+
+            const float* LeftData[NumChannels] = {};
+            const float* RightData[NumChannels] = {};
+            float* OutputLeftData[NumChannels] = {};
+            float* OutputRightData[NumChannels] = {};
+            float Gains[NumChannels * NumChannels] = {};
+            FStereoRouterState State;
+        };
+
+        class FEdoVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NoteNumber = 48 + static_cast<int32_t>(InSettings.Seed % 24);
+            }
+
+            virtual void Execute() override
+            {
+                NoteNumber = 48 + (NoteNumber + 7) % 36;
+                OutputFrequency = EdoFrequency(NoteNumber, 440.0f, 69, 19);
+            }
+
+            virtual void Reset() override
+            {
+                OutputFrequency = 0.0f;
+            }
+
+        private:
+            int32_t NoteNumber = 60;
+            float OutputFrequency = 0.0f;
+        };
+
+        class FTuningVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                MIDINoteNumber = 48 + static_cast<int32_t>(InSettings.Seed % 24);
+
+                for (int32_t Note = 0; Note < NotesPerOctave; ++Note)
+                {
+                    TuningCents[Note] = static_cast<float>((Note * 7) % 13) - 6.0f;
+                }
+            }
+
+            virtual void Execute() override
+            {
+                MIDINoteNumber = 48 + (MIDINoteNumber + 5) % 36;
+
+                // The operator gathers the twelve cent inputs into a local table every block
+                float TuningCentsArray[NotesPerOctave];
+                std::memcpy(TuningCentsArray, TuningCents, sizeof(TuningCentsArray));
+
+                OutputFrequency = TunedFrequency(MIDINoteNumber, TuningCentsArray);
+            }
+
+            virtual void Reset() override
+            {
+                OutputFrequency = 0.0f;
+            }
+
+        private:
+            int32_t MIDINoteNumber = 60;
+            float TuningCents[NotesPerOctave] = {};
+            float OutputFrequency = 0.0f;
+        };
+
+        class FClockDividerVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                InputTrigger.Period = 200 + static_cast<int32_t>(InSettings.Seed % 100);
+            }
+
+            virtual void Execute() override
+            {
+                InputTrigger.ExecuteBlock(NumFrames,
+                    [this](int32_t StartFrame)
+                    {
+                        const uint32_t OutputMask = AdvanceClockDivider(State);
+
+                        for (int32_t OutputIndex = 0; OutputIndex < ClockDividerNumOutputs; ++OutputIndex)
+                        {
+                            if (OutputMask & (1u << OutputIndex))
+                            {
+                                OutputTriggers[OutputIndex].TriggerFrame(StartFrame);
+                            }
+                        }
+                    }
+                );
+            }
+
+            virtual void Reset() override
+            {
+                State.Reset();
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            FTriggerPattern InputTrigger;
+            FClockDividerState State;
+            FTriggerSink OutputTriggers[ClockDividerNumOutputs];
+        };
+
+        class FShiftRegisterVoice : public IBenchmarkVoice
+        {
+        public:
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                NumFrames = InSettings.NumFrames;
+                InputTrigger.Period = 1000 + static_cast<int32_t>(InSettings.Seed % 500);
+            }
+
+            virtual void Execute() override
+            {
+                InputTrigger.ExecuteBlock(NumFrames,
+                    [this](int32_t)
+                    {
+                        InputValue += 1.0f;
+                        ShiftRegister(State, InputValue);
+                    }
+                );
+
+                std::memcpy(Outputs, State.Values, sizeof(Outputs));
+            }
+
+            virtual void Reset() override
+            {
+                State = FShiftRegisterState();
+                std::fill(std::begin(Outputs), std::end(Outputs), 0.0f);
+            }
+
+        private:
+            int32_t NumFrames = 0;
+            float InputValue = 0.0f;
+            FTriggerPattern InputTrigger;
+            FShiftRegisterState State;
+            float Outputs[ShiftRegisterNumStages] = {};
+        };
+
+        template<typename VoiceType>
+        std::unique_ptr<IBenchmarkVoice> CreateVoice()
+        {
+            return std::make_unique<VoiceType>();
+        }
+    }
+
+    const std::vector<FBenchmarkNode>& GetBenchmarkNodes()
+    {
+        static const std::vector<FBenchmarkNode> Nodes =
+        {
+            { "BoolToAudio", "FBoolToAudioOperator", &CreateVoice<FBoolToAudioVoice> },
+            { "ClockDivider", "FClockDividerOperator", &CreateVoice<FClockDividerVoice> },
+            { "Dust", "FDustOperator", &CreateVoice<FDustVoice> },
+            { "DustTrigger", "FDustTriggerOperator", &CreateVoice<FDustTriggerVoice> },
+            { "Edge", "FEdgeOperator", &CreateVoice<FEdgeVoice> },
+            { "EDO", "FEdoNodeOperator", &CreateVoice<FEdoVoice> },
+            { "Impulse", "FImpulseOperator", &CreateVoice<FImpulseVoice> },
+            { "MultichannelGain/4", "TMultichannelGainOperator", &CreateVoice<TMultichannelGainVoice<4, false>> },
+            { "MultichannelGain/4/Automated", "TMultichannelGainOperator", &CreateVoice<TMultichannelGainVoice<4, true>> },
+            { "MultichannelGain/8", "TMultichannelGainOperator", &CreateVoice<TMultichannelGainVoice<8, false>> },
+            { "MultichannelGain/8/Automated", "TMultichannelGainOperator", &CreateVoice<TMultichannelGainVoice<8, true>> },
+            { "MultichannelInverter/4", "TMultichannelInverterOperator", &CreateVoice<TMultichannelInverterVoice<4>> },
+            { "MultichannelInverter/8", "TMultichannelInverterOperator", &CreateVoice<TMultichannelInverterVoice<8>> },
+            { "MultichannelPhaseDisperser/2/32", "TMultichannelPhaseDisperserOperator", &CreateVoice<TMultichannelPhaseDisperserVoice<2, 32>> },
+            { "MultichannelPhaseDisperser/4/8", "TMultichannelPhaseDisperserOperator", &CreateVoice<TMultichannelPhaseDisperserVoice<4, 8>> },
+            { "MultichannelPhaseDisperser/4/32", "TMultichannelPhaseDisperserOperator", &CreateVoice<TMultichannelPhaseDisperserVoice<4, 32>> },
+            { "MultichannelPhaseDisperser/4/128", "TMultichannelPhaseDisperserOperator", &CreateVoice<TMultichannelPhaseDisperserVoice<4, 128>> },
+            { "MultichannelPhaseDisperser/8/8", "TMultichannelPhaseDisperserOperator", &CreateVoice<TMultichannelPhaseDisperserVoice<8, 8>> },
+            { "MultichannelPhaseDisperser/8/32", "TMultichannelPhaseDisperserOperator", &CreateVoice<TMultichannelPhaseDisperserVoice<8, 32>> },
+            { "MultichannelPhaseDisperser/8/128", "TMultichannelPhaseDisperserOperator", &CreateVoice<TMultichannelPhaseDisperserVoice<8, 128>> },
+            { "MultichannelWidth/4", "TMultichannelWidthOperator", &CreateVoice<TMultichannelWidthVoice<4, false>> },
+            { "MultichannelWidth/4/Automated", "TMultichannelWidthOperator", &CreateVoice<TMultichannelWidthVoice<4, true>> },
+            { "MultichannelWidth/8", "TMultichannelWidthOperator", &CreateVoice<TMultichannelWidthVoice<8, false>> },
+            { "MultichannelWidth/8/Automated", "TMultichannelWidthOperator", &CreateVoice<TMultichannelWidthVoice<8, true>> },
+            { "PhaseDisperser/1", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<1>> },
+            { "PhaseDisperser/8", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<8>> },
+            { "PhaseDisperser/32", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<32>> },
+            { "PhaseDisperser/128", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<128>> },
+            { "PhaseDisperser/Convolution/16", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<16, EAllPassMode::Convolution>> },
+            { "PhaseDisperser/Convolution/32", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<32, EAllPassMode::Convolution>> },
+            { "PhaseDisperser/Convolution/48", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<48, EAllPassMode::Convolution>> },
+            { "PhaseDisperser/Convolution/64", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<64, EAllPassMode::Convolution>> },
+            { "PhaseDisperser/Convolution/96", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<96, EAllPassMode::Convolution>> },
+            { "PhaseDisperser/Convolution/128", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<128, EAllPassMode::Convolution>> },
+            { "PhaseDisperser/Recursive/16", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<16, EAllPassMode::Recursive>> },
+            { "PhaseDisperser/Recursive/32", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<32, EAllPassMode::Recursive>> },
+            { "PhaseDisperser/Recursive/48", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<48, EAllPassMode::Recursive>> },
+            { "PhaseDisperser/Recursive/64", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<64, EAllPassMode::Recursive>> },
+            { "PhaseDisperser/Recursive/96", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<96, EAllPassMode::Recursive>> },
+            { "PhaseDisperser/Recursive/128", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<128, EAllPassMode::Recursive>> },
+            { "PhaseDisperser/Designed/5ms", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<1, EAllPassMode::Designed, 5>> },
+            { "PhaseDisperser/Designed/10ms", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<1, EAllPassMode::Designed, 10>> },
+            { "PhaseDisperser/Designed/10ms/Automated", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<1, EAllPassMode::Designed, 10, true>> },
+            { "PhaseDisperser/Designed/30ms", "FPhaseDisperserOperator", &CreateVoice<TPhaseDisperserVoice<1, EAllPassMode::Designed, 30>> },
+            { "Sah", "FSahOperator", &CreateVoice<FSahVoice> },
+            { "ShiftRegister", "FShiftRegisterOperator", &CreateVoice<FShiftRegisterVoice> },
+            { "Slew", "FSlewOperator", &CreateVoice<FSlewVoice> },
+            { "SlewFloat", "FSlewFloatOperator", &CreateVoice<FSlewFloatVoice> },
+            { "StereoBalance", "FBalanceOperator", &CreateVoice<TStereoBalanceVoice<false>> },
+            { "StereoBalance/Automated", "FBalanceOperator", &CreateVoice<TStereoBalanceVoice<true>> },
+            { "StereoBalanceAudio", "FBalanceAudioOperator", &CreateVoice<FStereoBalanceAudioVoice> },
+            { "StereoCrossfade", "FCrossfadeStereoOperator", &CreateVoice<TStereoCrossfadeVoice<false>> },
+            { "StereoCrossfade/Automated", "FCrossfadeStereoOperator", &CreateVoice<TStereoCrossfadeVoice<true>> },
+            { "StereoCrossfadeAudio", "FCrossfadeStereoAudioOperator", &CreateVoice<FStereoCrossfadeAudioVoice> },
+            { "StereoCrossfadeMulti/4", "TCrossfadeStereoMultiOperator", &CreateVoice<TStereoCrossfadeMultiVoice<4, false>> },
+            { "StereoCrossfadeMulti/4/Automated", "TCrossfadeStereoMultiOperator", &CreateVoice<TStereoCrossfadeMultiVoice<4, true>> },
+            { "StereoCrossfadeMulti/8", "TCrossfadeStereoMultiOperator", &CreateVoice<TStereoCrossfadeMultiVoice<8, false>> },
+            { "StereoCrossfadeMulti/8/Automated", "TCrossfadeStereoMultiOperator", &CreateVoice<TStereoCrossfadeMultiVoice<8, true>> },
+            { "StereoGain", "FStereoGainOperator", &CreateVoice<TStereoGainVoice<false>> },
+            { "StereoGain/Automated", "FStereoGainOperator", &CreateVoice<TStereoGainVoice<true>> },
+            { "StereoInverter", "FStereoInverterOperator", &CreateVoice<FStereoInverterVoice> },
+            { "StereoMatrix", "FStereoMatrixOperator", &CreateVoice<TStereoMatrixVoice<false>> },
+            { "StereoMatrix/Automated", "FStereoMatrixOperator", &CreateVoice<TStereoMatrixVoice<true>> },
+            { "StereoMeter", "FStereoMeterOperator", &CreateVoice<FStereoMeterVoice> },
+            { "StereoRouter/4x4/4", "TStereoRouterOperator", &CreateVoice<TStereoRouterVoice<4, 4, false>> },
+            { "StereoRouter/8x8/8", "TStereoRouterOperator", &CreateVoice<TStereoRouterVoice<8, 8, false>> },
+            { "StereoRouter/8x8/16", "TStereoRouterOperator", &CreateVoice<TStereoRouterVoice<8, 16, false>> },
+            { "StereoRouter/8x8/16/Automated", "TStereoRouterOperator", &CreateVoice<TStereoRouterVoice<8, 16, true>> },
+            { "StereoRouter/8x8/64", "TStereoRouterOperator", &CreateVoice<TStereoRouterVoice<8, 64, false>> },
+            { "StereoWidth", "FWidthOperator", &CreateVoice<TStereoWidthVoice<false>> },
+            { "StereoWidth/Automated", "FWidthOperator", &CreateVoice<TStereoWidthVoice<true>> },
+            { "Tuning", "FTuningNodeOperator", &CreateVoice<FTuningVoice> },
+            { "ZeroCrossing", "FZeroCrossingOperator", &CreateVoice<FZeroCrossingVoice> },
+        };
+
+        return Nodes;
+    }
+
+    const FBenchmarkNode* FindBenchmarkNode(const char* Name)
+    {
+        for (const FBenchmarkNode& Node : GetBenchmarkNodes())
+        {
+            if (std::strcmp(Node.Name, Name) == 0)
+            {
+                return &Node;
+            }
+        }
+
+        return nullptr;
+    }
+}
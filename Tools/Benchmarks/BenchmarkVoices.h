@@ -0,0 +1,69 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+#pragma once
+
+// Engine-free stand-ins for the Branches operators.
+//
+// Each voice owns the same buffers and state as the matching operator in Source/MetasoundBranches/Private
+// and its Execute() performs the same per-block work (kernel calls, coefficient updates, trigger handling),
+// so its cost is representative of one node instance on the audio render thread.
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MetasoundBranches::Benchmarks
+{
+    // What the voices' audio inputs carry
+    enum class EVoiceInput
+    {
+        // Noise, sines or square waves, depending on the node
+        Signal,
+        Silent,
+        Constant
+    };
+
+    struct FVoiceSettings
+    {
+        int32_t NumFrames = 256;
+        float SampleRate = 48000.0f;
+
+        // Varies the input signals and parameters between voices of the same node
+        uint32_t Seed = 1;
+
+        EVoiceInput Input = EVoiceInput::Signal;
+    };
+
+    class IBenchmarkVoice
+    {
+    public:
+        virtual ~IBenchmarkVoice() = default;
+
+        // Allocates buffers and generates input signals; not timed
+        virtual void Prepare(const FVoiceSettings& InSettings) = 0;
+
+        // Processes one block, mirroring the operator's Execute()
+        virtual void Execute() = 0;
+
+        // Returns to the state after Prepare() without reallocating, mirroring the operator's Reset()
+        virtual void Reset() = 0;
+    };
+
+    struct FBenchmarkNode
+    {
+        // Node name as reported in results, e.g. "PhaseDisperser/128"
+        const char* Name;
+
+        // Operator class the voice stands in for
+        const char* OperatorClass;
+
+        std::unique_ptr<IBenchmarkVoice> (*CreateVoice)();
+    };
+
+    // Every node in the plugin, with several stage counts for the Phase Disperser and automated variants of the
+    // stereo nodes
+    const std::vector<FBenchmarkNode>& GetBenchmarkNodes();
+
+    // Looks up a node by its exact name, or returns nullptr
+    const FBenchmarkNode* FindBenchmarkNode(const char* Name);
+}
@@ -0,0 +1,456 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+// Microbenchmark for every Branches node across block sizes and sample rates.
+//
+// Usage: BranchesBenchmark [--filter <text>] [--block-sizes 64,128,...] [--sample-rates 44100,...]
+//                          [--min-time-ms <ms>] [--output <file.json>] [--isa <level>] [--input <kind>]
+//                          [--perf-counters] [--list]
+//
+// Results are written as JSON (stdout by default), one entry per node / block size / sample rate, followed by the
+// PhaseDisperser crossovers from recursive to convolution when both modes were measured.
+// With --perf-counters, hardware counters (Linux perf_event) are captured over the timed runs as well.
+// --isa (auto, scalar, sse2, sse4.1, avx2, avx512) selects the dispatched kernels, as au.Branches.Simd does in the engine.
+// --input (signal, silent, constant) replaces the audio inputs, to measure idle voices.
+
+#include "BenchmarkClock.h"
+#include "BenchmarkJson.h"
+#include "BenchmarkPerfCounters.h"
+#include "BenchmarkReport.h"
+#include "BenchmarkVoices.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace MetasoundBranches::Benchmarks
+{
+    namespace
+    {
+        constexpr int32_t NumRepetitions = 5;
+        constexpr int32_t NumWarmupBlocks = 16;
+
+        struct FBenchmarkOptions
+        {
+            std::string Filter;
+            std::vector<int64_t> BlockSizes = { 64, 128, 256, 512, 1024, 2048, 4096 };
+            std::vector<int64_t> SampleRates = { 44100, 48000, 96000 };
+            double MinTimeMs = 20.0;
+            const char* OutputPath = nullptr;
+            Kernels::EKernelIsa KernelIsa = Kernels::EKernelIsa::AVX512;
+            EVoiceInput Input = EVoiceInput::Signal;
+            bool bPerfCounters = false;
+            bool bList = false;
+        };
+
+        struct FBenchmarkResult
+        {
+            int64_t NumBlocks = 0;
+            double NanosecondsPerSample = 0.0;
+            double MinNanosecondsPerSample = 0.0;
+            double CyclesPerSample = 0.0;
+
+            // Totals over all repetitions, only filled in when counters are captured
+            double NumMeasuredSamples = 0.0;
+            FPerfCounterValues Counters;
+        };
+
+        void PrintUsage()
+        {
+            std::fprintf(stderr,
+                "Usage: BranchesBenchmark [--filter <text>] [--block-sizes 64,128,...] [--sample-rates 44100,...]\n"
+                "                         [--min-time-ms <ms>] [--output <file.json>] [--isa <level>] [--input <kind>]\n"
+                "                         [--perf-counters] [--list]\n");
+        }
+
+        bool ParseOptions(int Argc, char** Argv, FBenchmarkOptions& OutOptions)
+        {
+            for (int ArgIndex = 1; ArgIndex < Argc; ++ArgIndex)
+            {
+                const char* Arg = Argv[ArgIndex];
+                const char* Value = (ArgIndex + 1 < Argc) ? Argv[ArgIndex + 1] : nullptr;
+
+                if (std::strcmp(Arg, "--list") == 0)
+                {
+                    OutOptions.bList = true;
+                    continue;
+                }
+
+                if (std::strcmp(Arg, "--perf-counters") == 0)
+                {
+                    OutOptions.bPerfCounters = true;
+                    continue;
+                }
+
+                if (!Value)
+                {
+                    return false;
+                }
+
+                if (std::strcmp(Arg, "--filter") == 0)
+                {
+                    OutOptions.Filter = Value;
+                }
+                else if (std::strcmp(Arg, "--block-sizes") == 0)
+                {
+                    OutOptions.BlockSizes = ParseIntegerList(Value);
+                }
+                else if (std::strcmp(Arg, "--sample-rates") == 0)
+                {
+                    OutOptions.SampleRates = ParseIntegerList(Value);
+                }
+                else if (std::strcmp(Arg, "--min-time-ms") == 0)
+                {
+                    OutOptions.MinTimeMs = std::atof(Value);
+                }
+                else if (std::strcmp(Arg, "--output") == 0)
+                {
+                    OutOptions.OutputPath = Value;
+                }
+                else if (std::strcmp(Arg, "--isa") == 0)
+                {
+                    if (!ParseKernelIsa(Value, OutOptions.KernelIsa))
+                    {
+                        return false;
+                    }
+                }
+                else if (std::strcmp(Arg, "--input") == 0)
+                {
+                    if (std::strcmp(Value, "signal") == 0)
+                    {
+                        OutOptions.Input = EVoiceInput::Signal;
+                    }
+                    else if (std::strcmp(Value, "silent") == 0)
+                    {
+                        OutOptions.Input = EVoiceInput::Silent;
+                    }
+                    else if (std::strcmp(Value, "constant") == 0)
+                    {
+                        OutOptions.Input = EVoiceInput::Constant;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    return false;
+                }
+
+                ++ArgIndex;
+            }
+
+            return !OutOptions.BlockSizes.empty() && !OutOptions.SampleRates.empty() && OutOptions.MinTimeMs > 0.0;
+        }
+
+        FBenchmarkResult RunBenchmark(const FBenchmarkNode& Node, const FVoiceSettings& Settings, double MinTimeMs, FPerfCounters* PerfCounters)
+        {
+            std::unique_ptr<IBenchmarkVoice> Voice = Node.CreateVoice();
+            Voice->Prepare(Settings);
+
+            for (int32_t Block = 0; Block < NumWarmupBlocks; ++Block)
+            {
+                Voice->Execute();
+            }
+
+            // Calibrate the number of blocks per repetition from a short run
+            int64_t BlocksPerRepetition = 1;
+            const uint64_t TargetNanoseconds = static_cast<uint64_t>(MinTimeMs * 1.0e6 / NumRepetitions);
+            for (;;)
+            {
+                const uint64_t Start = ReadNanoseconds();
+                for (int64_t Block = 0; Block < BlocksPerRepetition; ++Block)
+                {
+                    Voice->Execute();
+                }
+                const uint64_t Elapsed = ReadNanoseconds() - Start;
+
+                if (Elapsed * 8 >= TargetNanoseconds || BlocksPerRepetition >= (int64_t(1) << 30))
+                {
+                    BlocksPerRepetition = std::max<int64_t>(1, static_cast<int64_t>(static_cast<double>(BlocksPerRepetition) * TargetNanoseconds / std::max<uint64_t>(Elapsed, 1)));
+                    break;
+                }
+                BlocksPerRepetition *= 2;
+            }
+
+            std::vector<double> NanosecondsPerSample;
+            std::vector<double> CyclesPerSample;
+            const double SamplesPerRepetition = static_cast<double>(BlocksPerRepetition) * Settings.NumFrames;
+            FBenchmarkResult Result;
+
+            for (int32_t Repetition = 0; Repetition < NumRepetitions; ++Repetition)
+            {
+                if (PerfCounters)
+                {
+                    PerfCounters->Start();
+                }
+
+                const uint64_t StartCycles = ReadCycleCounter();
+                const uint64_t StartNanoseconds = ReadNanoseconds();
+
+                for (int64_t Block = 0; Block < BlocksPerRepetition; ++Block)
+                {
+                    Voice->Execute();
+                }
+
+                const uint64_t ElapsedNanoseconds = ReadNanoseconds() - StartNanoseconds;
+                const uint64_t ElapsedCycles = ReadCycleCounter() - StartCycles;
+
+                if (PerfCounters)
+                {
+                    PerfCounters->Stop(Result.Counters);
+                    Result.NumMeasuredSamples += SamplesPerRepetition;
+                }
+
+                NanosecondsPerSample.push_back(static_cast<double>(ElapsedNanoseconds) / SamplesPerRepetition);
+                CyclesPerSample.push_back(static_cast<double>(ElapsedCycles) / SamplesPerRepetition);
+            }
+
+            std::sort(NanosecondsPerSample.begin(), NanosecondsPerSample.end());
+            std::sort(CyclesPerSample.begin(), CyclesPerSample.end());
+
+            Result.NumBlocks = BlocksPerRepetition * NumRepetitions;
+            Result.NanosecondsPerSample = NanosecondsPerSample[NumRepetitions / 2];
+            Result.MinNanosecondsPerSample = NanosecondsPerSample.front();
+            Result.CyclesPerSample = CyclesPerSample[NumRepetitions / 2];
+            return Result;
+        }
+
+        // Writes Numerator / Denominator, or null if either counter is unavailable
+        void WriteRatio(FJsonWriter& Writer, const char* Key, const FPerfCounterValues& Counters, EPerfCounter Numerator, EPerfCounter Denominator)
+        {
+            if (Counters.IsValid(Numerator) && Counters.IsValid(Denominator) && Counters.Get(Denominator) > 0.0)
+            {
+                Writer.Write(Key, Counters.Get(Numerator) / Counters.Get(Denominator));
+            }
+            else
+            {
+                Writer.WriteNull(Key);
+            }
+        }
+
+        void WriteCounters(FJsonWriter& Writer, const FBenchmarkResult& Result)
+        {
+            const FPerfCounterValues& Counters = Result.Counters;
+
+            auto WritePerSample = [&Writer, &Result, &Counters](const char* Key, EPerfCounter Counter)
+            {
+                if (Counters.IsValid(Counter))
+                {
+                    Writer.Write(Key, Counters.Get(Counter) / Result.NumMeasuredSamples);
+                }
+                else
+                {
+                    Writer.WriteNull(Key);
+                }
+            };
+
+            Writer.BeginObject("counters");
+            WritePerSample("cycles_per_sample", EPerfCounter::Cycles);
+            WritePerSample("instructions_per_sample", EPerfCounter::Instructions);
+            WritePerSample("branch_misses_per_sample", EPerfCounter::BranchMisses);
+            WritePerSample("l1d_read_misses_per_sample", EPerfCounter::L1DReadMisses);
+            WritePerSample("llc_read_misses_per_sample", EPerfCounter::LLCReadMisses);
+            WriteRatio(Writer, "ipc", Counters, EPerfCounter::Instructions, EPerfCounter::Cycles);
+            WriteRatio(Writer, "branch_miss_rate", Counters, EPerfCounter::BranchMisses, EPerfCounter::Branches);
+            WriteRatio(Writer, "l1d_miss_rate", Counters, EPerfCounter::L1DReadMisses, EPerfCounter::L1DReads);
+            WriteRatio(Writer, "llc_miss_rate", Counters, EPerfCounter::LLCReadMisses, EPerfCounter::LLCReads);
+            Writer.EndObject();
+        }
+
+        void WriteResult(FJsonWriter& Writer, const FBenchmarkNode& Node, const FVoiceSettings& Settings, const FBenchmarkResult& Result)
+        {
+            Writer.BeginObject();
+            Writer.Write("node", Node.Name);
+            Writer.Write("operator", Node.OperatorClass);
+            Writer.Write("block_size", static_cast<int64_t>(Settings.NumFrames));
+            Writer.Write("sample_rate", static_cast<int64_t>(Settings.SampleRate));
+            Writer.Write("blocks", Result.NumBlocks);
+            Writer.Write("ns_per_block", Result.NanosecondsPerSample * Settings.NumFrames);
+            Writer.Write("ns_per_sample", Result.NanosecondsPerSample);
+            Writer.Write("ns_per_sample_min", Result.MinNanosecondsPerSample);
+            Writer.Write("samples_per_second", 1.0e9 / Result.NanosecondsPerSample);
+
+            if (HasCycleCounter())
+            {
+                Writer.Write("cycles_per_sample", Result.CyclesPerSample);
+            }
+            else
+            {
+                Writer.WriteNull("cycles_per_sample");
+            }
+
+            // How many instances of this node one core could run in real time
+            Writer.Write("realtime_voices", 1.0e9 / (Result.NanosecondsPerSample * Settings.SampleRate));
+
+            if (Result.NumMeasuredSamples > 0.0)
+            {
+                WriteCounters(Writer, Result);
+            }
+
+            Writer.EndObject();
+        }
+
+        struct FMeasurement
+        {
+            std::string NodeName;
+            int64_t SampleRate = 0;
+            int64_t BlockSize = 0;
+            double NanosecondsPerSample = 0.0;
+        };
+
+        // Stage count of a PhaseDisperser voice pinned to the given mode, or 0 for any other node
+        int32_t GetDisperserStages(const std::string& NodeName, const char* Mode)
+        {
+            const std::string Prefix = std::string("PhaseDisperser/") + Mode + "/";
+            return NodeName.compare(0, Prefix.size(), Prefix) == 0 ? std::atoi(NodeName.c_str() + Prefix.size()) : 0;
+        }
+
+        // For every sample rate and block size with both PhaseDisperser modes measured, the fewest stages at which
+        // convolution beat the recursive cascade (null if it never did); GetAllPassConvolutionCrossover() is set
+        // from these
+        void WriteCrossovers(FJsonWriter& Writer, const std::vector<FMeasurement>& Measurements, const FBenchmarkOptions& Options)
+        {
+            Writer.BeginArray("crossovers");
+
+            for (int64_t SampleRate : Options.SampleRates)
+            {
+                for (int64_t BlockSize : Options.BlockSizes)
+                {
+                    int32_t NumCompared = 0;
+                    int32_t Crossover = 0;
+
+                    for (const FMeasurement& Convolution : Measurements)
+                    {
+                        const int32_t NumStages = GetDisperserStages(Convolution.NodeName, "Convolution");
+                        if (NumStages == 0 || Convolution.SampleRate != SampleRate || Convolution.BlockSize != BlockSize)
+                        {
+                            continue;
+                        }
+
+                        for (const FMeasurement& Recursive : Measurements)
+                        {
+                            if (GetDisperserStages(Recursive.NodeName, "Recursive") == NumStages && Recursive.SampleRate == SampleRate && Recursive.BlockSize == BlockSize)
+                            {
+                                ++NumCompared;
+                                if (Convolution.NanosecondsPerSample < Recursive.NanosecondsPerSample && (Crossover == 0 || NumStages < Crossover))
+                                {
+                                    Crossover = NumStages;
+                                }
+                            }
+                        }
+                    }
+
+                    if (NumCompared == 0)
+                    {
+                        continue;
+                    }
+
+                    Writer.BeginObject();
+                    Writer.Write("sample_rate", SampleRate);
+                    Writer.Write("block_size", BlockSize);
+                    if (Crossover > 0)
+                    {
+                        Writer.Write("stages", static_cast<int64_t>(Crossover));
+                        std::fprintf(stderr, "PhaseDisperser convolution from %d stages at %lld Hz, %lld frames\n", Crossover, static_cast<long long>(SampleRate), static_cast<long long>(BlockSize));
+                    }
+                    else
+                    {
+                        Writer.WriteNull("stages");
+                        std::fprintf(stderr, "PhaseDisperser recursive at every stage count at %lld Hz, %lld frames\n", static_cast<long long>(SampleRate), static_cast<long long>(BlockSize));
+                    }
+                    Writer.EndObject();
+                }
+            }
+
+            Writer.EndArray();
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    using namespace MetasoundBranches::Benchmarks;
+
+    FBenchmarkOptions Options;
+    if (!ParseOptions(Argc, Argv, Options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    MetasoundBranches::Kernels::SetKernelIsa(Options.KernelIsa);
+
+    if (Options.bList)
+    {
+        for (const FBenchmarkNode& Node : GetBenchmarkNodes())
+        {
+            std::printf("%s (%s)\n", Node.Name, Node.OperatorClass);
+        }
+        return 0;
+    }
+
+    FPerfCounters PerfCounters;
+    if (Options.bPerfCounters && !PerfCounters.Open())
+    {
+        std::fprintf(stderr, "No hardware performance counters are available (check /proc/sys/kernel/perf_event_paranoid)\n");
+        return 1;
+    }
+
+    FILE* OutputFile = Options.OutputPath ? std::fopen(Options.OutputPath, "w") : stdout;
+    if (!OutputFile)
+    {
+        std::fprintf(stderr, "Could not open %s for writing\n", Options.OutputPath);
+        return 1;
+    }
+
+    FJsonWriter Writer(OutputFile);
+    Writer.BeginObject();
+    Writer.Write("schema", "branches-benchmark/1");
+    WriteHostInfo(Writer);
+    Writer.Write("perf_counters", Options.bPerfCounters);
+    Writer.Write("input", Options.Input == EVoiceInput::Silent ? "silent" : (Options.Input == EVoiceInput::Constant ? "constant" : "signal"));
+    Writer.BeginArray("results");
+
+    std::vector<FMeasurement> Measurements;
+
+    for (const FBenchmarkNode& Node : GetBenchmarkNodes())
+    {
+        if (!Options.Filter.empty() && std::string(Node.Name).find(Options.Filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        for (int64_t SampleRate : Options.SampleRates)
+        {
+            for (int64_t BlockSize : Options.BlockSizes)
+            {
+                FVoiceSettings Settings;
+                Settings.NumFrames = static_cast<int32_t>(BlockSize);
+                Settings.SampleRate = static_cast<float>(SampleRate);
+                Settings.Input = Options.Input;
+
+                const FBenchmarkResult Result = RunBenchmark(Node, Settings, Options.MinTimeMs, Options.bPerfCounters ? &PerfCounters : nullptr);
+                WriteResult(Writer, Node, Settings, Result);
+                Measurements.push_back({ Node.Name, SampleRate, BlockSize, Result.NanosecondsPerSample });
+
+                std::fprintf(stderr, "%-20s %6lld Hz %5lld frames %10.3f ns/sample\n", Node.Name, static_cast<long long>(SampleRate), static_cast<long long>(BlockSize), Result.NanosecondsPerSample);
+            }
+        }
+    }
+
+    Writer.EndArray();
+    WriteCrossovers(Writer, Measurements, Options);
+    Writer.EndObject();
+    Writer.Finish();
+
+    if (OutputFile != stdout)
+    {
+        std::fclose(OutputFile);
+    }
+
+    return 0;
+}
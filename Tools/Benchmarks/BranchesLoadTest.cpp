@@ -0,0 +1,444 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+// Voice-scaling load test.
+//
+// Instantiates N voices of a node (each with its own heap-allocated buffers and state, created one after the
+// other like operators in separate graphs), runs them round-robin one block at a time as the render thread
+// would, and reports the cost per voice against N. The point where the per-voice cost rises shows where the
+// working set stops fitting in cache.
+//
+// Usage: BranchesLoadTest [--nodes Dust,Slew,...] [--voices 1,16,256,...] [--block-size <frames>]
+//                         [--sample-rate <hz>] [--min-time-ms <ms>] [--output <file.json>] [--isa <level>]
+//
+// The pseudo node "VoiceTemplate" chains Dust, Slew, PhaseDisperser/8, StereoWidth and StereoGain in one voice.
+
+#include "BenchmarkClock.h"
+#include "BenchmarkJson.h"
+#include "BenchmarkReport.h"
+#include "BenchmarkVoices.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Bytes allocated while voices are being prepared, to report the working set per voice
+    std::atomic<bool> bCountAllocations { false };
+    std::atomic<int64_t> NumAllocatedBytes { 0 };
+}
+
+void* operator new(size_t Size)
+{
+    if (bCountAllocations.load(std::memory_order_relaxed))
+    {
+        NumAllocatedBytes.fetch_add(static_cast<int64_t>(Size), std::memory_order_relaxed);
+    }
+
+    if (void* Memory = std::malloc(Size ? Size : 1))
+    {
+        return Memory;
+    }
+    throw std::bad_alloc();
+}
+
+// Pairs with the replacement operator new above. GCC can't see that once it inlines these deletes, and may warn
+// that free() is given memory from operator new.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* Memory) noexcept
+{
+    std::free(Memory);
+}
+
+void operator delete(void* Memory, size_t) noexcept
+{
+    std::free(Memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace MetasoundBranches::Benchmarks
+{
+    namespace
+    {
+        // Per-voice cost relative to the small-N baseline above which the curve is no longer considered flat
+        constexpr double KneeThreshold = 1.25;
+
+        struct FLoadTestOptions
+        {
+            std::vector<std::string> Nodes = { "Dust", "Slew", "PhaseDisperser/8", "PhaseDisperser/128", "StereoGain", "VoiceTemplate" };
+            std::vector<int64_t> VoiceCounts = { 1, 4, 16, 64, 256, 1024, 2048, 4096, 8192, 10000 };
+            int32_t BlockSize = 256;
+            float SampleRate = 48000.0f;
+            double MinTimeMs = 50.0;
+            const char* OutputPath = nullptr;
+            Kernels::EKernelIsa KernelIsa = Kernels::EKernelIsa::AVX512;
+        };
+
+        // A typical per-voice chain, with every node owning separate buffers
+        class FVoiceTemplate : public IBenchmarkVoice
+        {
+        public:
+            FVoiceTemplate()
+            {
+                for (const char* Name : { "Dust", "Slew", "PhaseDisperser/8", "StereoWidth", "StereoGain" })
+                {
+                    Voices.push_back(FindBenchmarkNode(Name)->CreateVoice());
+                }
+            }
+
+            virtual void Prepare(const FVoiceSettings& InSettings) override
+            {
+                for (std::unique_ptr<IBenchmarkVoice>& Voice : Voices)
+                {
+                    Voice->Prepare(InSettings);
+                }
+            }
+
+            virtual void Execute() override
+            {
+                for (std::unique_ptr<IBenchmarkVoice>& Voice : Voices)
+                {
+                    Voice->Execute();
+                }
+            }
+
+            virtual void Reset() override
+            {
+                for (std::unique_ptr<IBenchmarkVoice>& Voice : Voices)
+                {
+                    Voice->Reset();
+                }
+            }
+
+        private:
+            std::vector<std::unique_ptr<IBenchmarkVoice>> Voices;
+        };
+
+        std::unique_ptr<IBenchmarkVoice> CreateVoiceTemplate()
+        {
+            return std::make_unique<FVoiceTemplate>();
+        }
+
+        const FBenchmarkNode VoiceTemplateNode = { "VoiceTemplate", "Dust+Slew+PhaseDisperser+StereoWidth+StereoGain", &CreateVoiceTemplate };
+
+        std::vector<std::string> SplitList(const char* Text)
+        {
+            std::vector<std::string> Items;
+            std::string Item;
+
+            for (const char* Char = Text; ; ++Char)
+            {
+                if (*Char == ',' || *Char == '\0')
+                {
+                    if (!Item.empty())
+                    {
+                        Items.push_back(Item);
+                    }
+                    Item.clear();
+
+                    if (*Char == '\0')
+                    {
+                        break;
+                    }
+                }
+                else
+                {
+                    Item += *Char;
+                }
+            }
+
+            return Items;
+        }
+
+        bool ParseOptions(int Argc, char** Argv, FLoadTestOptions& OutOptions)
+        {
+            for (int ArgIndex = 1; ArgIndex + 1 < Argc; ArgIndex += 2)
+            {
+                const char* Arg = Argv[ArgIndex];
+                const char* Value = Argv[ArgIndex + 1];
+
+                if (std::strcmp(Arg, "--nodes") == 0)
+                {
+                    OutOptions.Nodes = SplitList(Value);
+                }
+                else if (std::strcmp(Arg, "--voices") == 0)
+                {
+                    OutOptions.VoiceCounts = ParseIntegerList(Value);
+                }
+                else if (std::strcmp(Arg, "--block-size") == 0)
+                {
+                    OutOptions.BlockSize = std::atoi(Value);
+                }
+                else if (std::strcmp(Arg, "--sample-rate") == 0)
+                {
+                    OutOptions.SampleRate = static_cast<float>(std::atof(Value));
+                }
+                else if (std::strcmp(Arg, "--min-time-ms") == 0)
+                {
+                    OutOptions.MinTimeMs = std::atof(Value);
+                }
+                else if (std::strcmp(Arg, "--output") == 0)
+                {
+                    OutOptions.OutputPath = Value;
+                }
+                else if (std::strcmp(Arg, "--isa") == 0)
+                {
+                    if (!ParseKernelIsa(Value, OutOptions.KernelIsa))
+                    {
+                        return false;
+                    }
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            return (Argc % 2 == 1) && !OutOptions.Nodes.empty() && !OutOptions.VoiceCounts.empty()
+                && OutOptions.BlockSize > 0 && OutOptions.SampleRate > 0.0f && OutOptions.MinTimeMs > 0.0;
+        }
+
+        struct FLoadTestResult
+        {
+            int64_t NumVoices = 0;
+            int64_t NumRenderBlocks = 0;
+            int64_t FootprintBytes = 0;
+            double NanosecondsPerVoiceBlock = 0.0;
+            double CyclesPerVoiceBlock = 0.0;
+
+            // Voice start cost: building and preparing a new voice, against resetting a pooled one in place
+            double BuildNanosecondsPerVoice = 0.0;
+            double ResetNanosecondsPerVoice = 0.0;
+        };
+
+        FLoadTestResult RunLoadTest(const FBenchmarkNode& Node, int64_t NumVoices, const FLoadTestOptions& Options)
+        {
+            FVoiceSettings Settings;
+            Settings.NumFrames = Options.BlockSize;
+            Settings.SampleRate = Options.SampleRate;
+
+            std::vector<std::unique_ptr<IBenchmarkVoice>> Voices;
+            Voices.reserve(static_cast<size_t>(NumVoices));
+
+            NumAllocatedBytes = 0;
+            bCountAllocations = true;
+            const uint64_t BuildStartNanoseconds = ReadNanoseconds();
+            for (int64_t VoiceIndex = 0; VoiceIndex < NumVoices; ++VoiceIndex)
+            {
+                Settings.Seed = static_cast<uint32_t>(VoiceIndex * 7919 + 1);
+
+                Voices.push_back(Node.CreateVoice());
+                Voices.back()->Prepare(Settings);
+            }
+            const uint64_t BuildNanoseconds = ReadNanoseconds() - BuildStartNanoseconds;
+            bCountAllocations = false;
+
+            auto RenderBlock = [&Voices]()
+            {
+                for (std::unique_ptr<IBenchmarkVoice>& Voice : Voices)
+                {
+                    Voice->Execute();
+                }
+            };
+
+            // Warm up, so every voice has touched its state at least twice
+            RenderBlock();
+            RenderBlock();
+
+            const uint64_t TargetNanoseconds = static_cast<uint64_t>(Options.MinTimeMs * 1.0e6);
+            const uint64_t StartCycles = ReadCycleCounter();
+            const uint64_t StartNanoseconds = ReadNanoseconds();
+
+            int64_t NumRenderBlocks = 0;
+            uint64_t ElapsedNanoseconds = 0;
+            while (NumRenderBlocks < 3 || ElapsedNanoseconds < TargetNanoseconds)
+            {
+                RenderBlock();
+                ++NumRenderBlocks;
+                ElapsedNanoseconds = ReadNanoseconds() - StartNanoseconds;
+            }
+
+            const uint64_t ElapsedCycles = ReadCycleCounter() - StartCycles;
+
+            const uint64_t ResetStartNanoseconds = ReadNanoseconds();
+            for (std::unique_ptr<IBenchmarkVoice>& Voice : Voices)
+            {
+                Voice->Reset();
+            }
+            const uint64_t ResetNanoseconds = ReadNanoseconds() - ResetStartNanoseconds;
+
+            const double NumVoiceBlocks = static_cast<double>(NumRenderBlocks) * static_cast<double>(NumVoices);
+
+            FLoadTestResult Result;
+            Result.NumVoices = NumVoices;
+            Result.NumRenderBlocks = NumRenderBlocks;
+            Result.FootprintBytes = NumAllocatedBytes.load() / NumVoices;
+            Result.NanosecondsPerVoiceBlock = static_cast<double>(ElapsedNanoseconds) / NumVoiceBlocks;
+            Result.CyclesPerVoiceBlock = static_cast<double>(ElapsedCycles) / NumVoiceBlocks;
+            Result.BuildNanosecondsPerVoice = static_cast<double>(BuildNanoseconds) / static_cast<double>(NumVoices);
+            Result.ResetNanosecondsPerVoice = static_cast<double>(ResetNanoseconds) / static_cast<double>(NumVoices);
+            return Result;
+        }
+
+        void WriteNodeResults(FJsonWriter& Writer, const FBenchmarkNode& Node, const std::vector<FLoadTestResult>& Results, const FLoadTestOptions& Options)
+        {
+            // Reference cost: the cheapest per-voice cost among the small voice counts
+            double BaselineNanoseconds = Results.front().NanosecondsPerVoiceBlock;
+            for (const FLoadTestResult& Result : Results)
+            {
+                if (Result.NumVoices <= 16)
+                {
+                    BaselineNanoseconds = std::min(BaselineNanoseconds, Result.NanosecondsPerVoiceBlock);
+                }
+            }
+
+            const double BlockDeadlineNanoseconds = 1.0e9 * Options.BlockSize / Options.SampleRate;
+
+            // The knee is the smallest voice count from which the cost stays above the threshold, so a single noisy
+            // measurement does not count
+            int64_t KneeVoices = -1;
+            for (const FLoadTestResult& Result : Results)
+            {
+                if (Result.NanosecondsPerVoiceBlock / BaselineNanoseconds <= KneeThreshold)
+                {
+                    KneeVoices = -1;
+                }
+                else if (KneeVoices < 0)
+                {
+                    KneeVoices = Result.NumVoices;
+                }
+            }
+
+            Writer.BeginObject();
+            Writer.Write("node", Node.Name);
+            Writer.Write("operator", Node.OperatorClass);
+            Writer.BeginArray("scaling");
+
+            for (const FLoadTestResult& Result : Results)
+            {
+                const double RelativeCost = Result.NanosecondsPerVoiceBlock / BaselineNanoseconds;
+
+                Writer.BeginObject();
+                Writer.Write("voices", Result.NumVoices);
+                Writer.Write("render_blocks", Result.NumRenderBlocks);
+                Writer.Write("ns_per_voice_block", Result.NanosecondsPerVoiceBlock);
+                Writer.Write("ns_per_voice_sample", Result.NanosecondsPerVoiceBlock / Options.BlockSize);
+                Writer.Write("relative_cost", RelativeCost);
+
+                if (HasCycleCounter())
+                {
+                    Writer.Write("cycles_per_voice_sample", Result.CyclesPerVoiceBlock / Options.BlockSize);
+                }
+                else
+                {
+                    Writer.WriteNull("cycles_per_voice_sample");
+                }
+
+                Writer.Write("bytes_per_voice", Result.FootprintBytes);
+                Writer.Write("working_set_bytes", Result.FootprintBytes * Result.NumVoices);
+                Writer.Write("build_ns_per_voice", Result.BuildNanosecondsPerVoice);
+                Writer.Write("reset_ns_per_voice", Result.ResetNanosecondsPerVoice);
+
+                // Share of one core's block deadline used by all voices together
+                Writer.Write("core_load", Result.NanosecondsPerVoiceBlock * static_cast<double>(Result.NumVoices) / BlockDeadlineNanoseconds);
+                Writer.EndObject();
+            }
+
+            Writer.EndArray();
+
+            if (KneeVoices > 0)
+            {
+                Writer.Write("knee_voices", KneeVoices);
+            }
+            else
+            {
+                Writer.WriteNull("knee_voices");
+            }
+
+            Writer.EndObject();
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    using namespace MetasoundBranches::Benchmarks;
+
+    FLoadTestOptions Options;
+    if (!ParseOptions(Argc, Argv, Options))
+    {
+        std::fprintf(stderr,
+            "Usage: BranchesLoadTest [--nodes Dust,Slew,...] [--voices 1,16,256,...] [--block-size <frames>]\n"
+            "                        [--sample-rate <hz>] [--min-time-ms <ms>] [--output <file.json>] [--isa <level>]\n");
+        return 2;
+    }
+
+    MetasoundBranches::Kernels::SetKernelIsa(Options.KernelIsa);
+
+    std::vector<const FBenchmarkNode*> Nodes;
+    for (const std::string& Name : Options.Nodes)
+    {
+        const FBenchmarkNode* Node = (Name == VoiceTemplateNode.Name) ? &VoiceTemplateNode : FindBenchmarkNode(Name.c_str());
+        if (!Node)
+        {
+            std::fprintf(stderr, "Unknown node '%s' (see BranchesBenchmark --list)\n", Name.c_str());
+            return 2;
+        }
+        Nodes.push_back(Node);
+    }
+
+    FILE* OutputFile = Options.OutputPath ? std::fopen(Options.OutputPath, "w") : stdout;
+    if (!OutputFile)
+    {
+        std::fprintf(stderr, "Could not open %s for writing\n", Options.OutputPath);
+        return 1;
+    }
+
+    FJsonWriter Writer(OutputFile);
+    Writer.BeginObject();
+    Writer.Write("schema", "branches-loadtest/1");
+    WriteHostInfo(Writer);
+    Writer.Write("block_size", static_cast<int64_t>(Options.BlockSize));
+    Writer.Write("sample_rate", static_cast<double>(Options.SampleRate));
+    Writer.BeginArray("results");
+
+    for (const FBenchmarkNode* Node : Nodes)
+    {
+        std::vector<FLoadTestResult> Results;
+
+        for (int64_t NumVoices : Options.VoiceCounts)
+        {
+            Results.push_back(RunLoadTest(*Node, NumVoices, Options));
+
+            const FLoadTestResult& Result = Results.back();
+            std::fprintf(stderr, "%-20s %6lld voices %10.1f ns/voice/block %8lld KiB working set\n",
+                Node->Name, static_cast<long long>(NumVoices), Result.NanosecondsPerVoiceBlock,
+                static_cast<long long>(Result.FootprintBytes * NumVoices / 1024));
+        }
+
+        WriteNodeResults(Writer, *Node, Results, Options);
+    }
+
+    Writer.EndArray();
+    Writer.EndObject();
+    Writer.Finish();
+
+    if (OutputFile != stdout)
+    {
+        std::fclose(OutputFile);
+    }
+
+    return 0;
+}
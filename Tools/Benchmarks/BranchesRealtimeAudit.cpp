@@ -0,0 +1,379 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+// Real-time safety audit for every Branches node.
+//
+// Runs each voice's Execute() with the allocator, mutexes and sleeping calls intercepted, and fails with the node
+// name and a stack trace if anything allocates, frees or may block while audio is being rendered. Prepare() is
+// not audited, as the operators allocate in their constructors.
+//
+// Usage: BranchesRealtimeAudit [--filter <text>] [--block-sizes 64,256,...] [--blocks <count>]
+//
+// Interception relies on glibc symbol interposition, so this tool is only built on Linux.
+
+#include "BenchmarkReport.h"
+#include "BenchmarkVoices.h"
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+    void* __libc_malloc(size_t Size);
+    void* __libc_calloc(size_t Count, size_t Size);
+    void* __libc_realloc(void* Memory, size_t Size);
+    void* __libc_memalign(size_t Alignment, size_t Size);
+    void __libc_free(void* Memory);
+}
+
+namespace MetasoundBranches::Benchmarks
+{
+    namespace
+    {
+        constexpr int32_t MaxBacktraceFrames = 48;
+
+        // First violation seen inside the audited region. Filled in without allocating and reported afterwards.
+        struct FViolation
+        {
+            const char* Call = nullptr;
+            void* Frames[MaxBacktraceFrames];
+            int32_t NumFrames = 0;
+        };
+
+        thread_local bool bInAuditedRegion = false;
+        thread_local bool bRecordingViolation = false;
+        thread_local FViolation Violation;
+
+        using FMutexFunction = int (*)(pthread_mutex_t*);
+        using FCondWaitFunction = int (*)(pthread_cond_t*, pthread_mutex_t*);
+        using FNanosleepFunction = int (*)(const struct timespec*, struct timespec*);
+        using FUsleepFunction = int (*)(useconds_t);
+        using FYieldFunction = int (*)();
+
+        FMutexFunction NextMutexLock = nullptr;
+        FMutexFunction NextMutexTryLock = nullptr;
+        FCondWaitFunction NextCondWait = nullptr;
+        FNanosleepFunction NextNanosleep = nullptr;
+        FUsleepFunction NextUsleep = nullptr;
+        FYieldFunction NextYield = nullptr;
+
+        void ReportCall(const char* Call)
+        {
+            if (!bInAuditedRegion || bRecordingViolation || Violation.Call)
+            {
+                return;
+            }
+
+            bRecordingViolation = true;
+            Violation.Call = Call;
+            Violation.NumFrames = backtrace(Violation.Frames, MaxBacktraceFrames);
+            bRecordingViolation = false;
+        }
+
+        template<typename FunctionType>
+        FunctionType FindNext(FunctionType, const char* Name)
+        {
+            return reinterpret_cast<FunctionType>(dlsym(RTLD_NEXT, Name));
+        }
+
+        // Resolves the wrapped functions and loads the unwinder, both of which allocate on first use
+        void InitializeInterception()
+        {
+            NextMutexLock = FindNext(NextMutexLock, "pthread_mutex_lock");
+            NextMutexTryLock = FindNext(NextMutexTryLock, "pthread_mutex_trylock");
+            NextCondWait = FindNext(NextCondWait, "pthread_cond_wait");
+            NextNanosleep = FindNext(NextNanosleep, "nanosleep");
+            NextUsleep = FindNext(NextUsleep, "usleep");
+            NextYield = FindNext(NextYield, "sched_yield");
+
+            void* Frames[1];
+            backtrace(Frames, 1);
+        }
+
+        class FAuditedRegion
+        {
+        public:
+            FAuditedRegion()
+            {
+                Violation.Call = nullptr;
+                bInAuditedRegion = true;
+            }
+
+            ~FAuditedRegion()
+            {
+                bInAuditedRegion = false;
+            }
+        };
+
+        struct FAuditOptions
+        {
+            std::string Filter;
+            std::vector<int64_t> BlockSizes = { 64, 256, 1024, 4096 };
+            int64_t NumBlocks = 16;
+        };
+
+        bool ParseOptions(int Argc, char** Argv, FAuditOptions& OutOptions)
+        {
+            for (int ArgIndex = 1; ArgIndex + 1 < Argc; ArgIndex += 2)
+            {
+                const char* Arg = Argv[ArgIndex];
+                const char* Value = Argv[ArgIndex + 1];
+
+                if (std::strcmp(Arg, "--filter") == 0)
+                {
+                    OutOptions.Filter = Value;
+                }
+                else if (std::strcmp(Arg, "--block-sizes") == 0)
+                {
+                    OutOptions.BlockSizes = ParseIntegerList(Value);
+                }
+                else if (std::strcmp(Arg, "--blocks") == 0)
+                {
+                    OutOptions.NumBlocks = std::atoll(Value);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            return (Argc % 2 == 1) && !OutOptions.BlockSizes.empty() && OutOptions.NumBlocks > 0;
+        }
+
+        void PrintViolation(const char* NodeName, int64_t BlockSize, int64_t Block)
+        {
+            std::fprintf(stderr, "FAIL %s: %s called from Execute() (block size %lld, block %lld)\n",
+                NodeName, Violation.Call, static_cast<long long>(BlockSize), static_cast<long long>(Block));
+            std::fflush(stderr);
+
+            backtrace_symbols_fd(Violation.Frames, Violation.NumFrames, STDERR_FILENO);
+            std::fprintf(stderr, "\n");
+        }
+
+        // Makes sure the interception is live, so a broken build can't pass the audit by catching nothing
+        bool CheckInterception()
+        {
+            volatile void* Memory = nullptr;
+            {
+                FAuditedRegion AuditedRegion;
+                Memory = std::malloc(16);
+            }
+            std::free(const_cast<void*>(Memory));
+
+            return Violation.Call != nullptr;
+        }
+    }
+}
+
+using namespace MetasoundBranches::Benchmarks;
+
+extern "C"
+{
+    void* malloc(size_t Size)
+    {
+        ReportCall("malloc");
+        return __libc_malloc(Size);
+    }
+
+    void* calloc(size_t Count, size_t Size)
+    {
+        ReportCall("calloc");
+        return __libc_calloc(Count, Size);
+    }
+
+    void* realloc(void* Memory, size_t Size)
+    {
+        ReportCall("realloc");
+        return __libc_realloc(Memory, Size);
+    }
+
+    void* memalign(size_t Alignment, size_t Size)
+    {
+        ReportCall("memalign");
+        return __libc_memalign(Alignment, Size);
+    }
+
+    void* aligned_alloc(size_t Alignment, size_t Size)
+    {
+        ReportCall("aligned_alloc");
+        return __libc_memalign(Alignment, Size);
+    }
+
+    int posix_memalign(void** OutMemory, size_t Alignment, size_t Size)
+    {
+        ReportCall("posix_memalign");
+        *OutMemory = __libc_memalign(Alignment, Size);
+        return *OutMemory ? 0 : ENOMEM;
+    }
+
+    void free(void* Memory)
+    {
+        if (Memory)
+        {
+            ReportCall("free");
+        }
+        __libc_free(Memory);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* Mutex)
+    {
+        ReportCall("pthread_mutex_lock");
+        return NextMutexLock(Mutex);
+    }
+
+    int pthread_mutex_trylock(pthread_mutex_t* Mutex)
+    {
+        ReportCall("pthread_mutex_trylock");
+        return NextMutexTryLock(Mutex);
+    }
+
+    int pthread_cond_wait(pthread_cond_t* Condition, pthread_mutex_t* Mutex)
+    {
+        ReportCall("pthread_cond_wait");
+        return NextCondWait(Condition, Mutex);
+    }
+
+    int nanosleep(const struct timespec* Duration, struct timespec* Remaining)
+    {
+        ReportCall("nanosleep");
+        return NextNanosleep(Duration, Remaining);
+    }
+
+    int usleep(useconds_t Microseconds)
+    {
+        ReportCall("usleep");
+        return NextUsleep(Microseconds);
+    }
+
+    int sched_yield()
+    {
+        ReportCall("sched_yield");
+        return NextYield();
+    }
+}
+
+// libstdc++ forwards these to malloc/free, but they are replaced as well so the audit does not depend on it
+void* operator new(size_t Size)
+{
+    ReportCall("operator new");
+    if (void* Memory = __libc_malloc(Size ? Size : 1))
+    {
+        return Memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t Size)
+{
+    ReportCall("operator new[]");
+    if (void* Memory = __libc_malloc(Size ? Size : 1))
+    {
+        return Memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* Memory) noexcept
+{
+    free(Memory);
+}
+
+void operator delete[](void* Memory) noexcept
+{
+    free(Memory);
+}
+
+void operator delete(void* Memory, size_t) noexcept
+{
+    free(Memory);
+}
+
+void operator delete[](void* Memory, size_t) noexcept
+{
+    free(Memory);
+}
+
+int main(int Argc, char** Argv)
+{
+    FAuditOptions Options;
+    if (!ParseOptions(Argc, Argv, Options))
+    {
+        std::fprintf(stderr, "Usage: BranchesRealtimeAudit [--filter <text>] [--block-sizes 64,256,...] [--blocks <count>]\n");
+        return 2;
+    }
+
+    InitializeInterception();
+
+    if (!CheckInterception())
+    {
+        std::fprintf(stderr, "Allocator interception is not active; the audit can't run\n");
+        return 1;
+    }
+
+    // Audit the kernels the plugin would select at startup
+    MetasoundBranches::Kernels::InitializeKernelDispatch();
+
+    int32_t NumAudited = 0;
+    int32_t NumFailed = 0;
+
+    for (const FBenchmarkNode& Node : GetBenchmarkNodes())
+    {
+        if (!Options.Filter.empty() && std::string(Node.Name).find(Options.Filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        bool bPassed = true;
+
+        for (int64_t BlockSize : Options.BlockSizes)
+        {
+            FVoiceSettings Settings;
+            Settings.NumFrames = static_cast<int32_t>(BlockSize);
+
+            std::unique_ptr<IBenchmarkVoice> Voice = Node.CreateVoice();
+            Voice->Prepare(Settings);
+
+            for (int64_t Block = 0; Block < Options.NumBlocks && bPassed; ++Block)
+            {
+                {
+                    FAuditedRegion AuditedRegion;
+                    Voice->Execute();
+                }
+
+                if (Violation.Call)
+                {
+                    PrintViolation(Node.Name, BlockSize, Block);
+                    bPassed = false;
+                }
+            }
+
+            if (!bPassed)
+            {
+                break;
+            }
+        }
+
+        ++NumAudited;
+        if (bPassed)
+        {
+            std::fprintf(stderr, "ok   %s\n", Node.Name);
+        }
+        else
+        {
+            ++NumFailed;
+        }
+    }
+
+    std::fprintf(stderr, "%d of %d nodes are real-time safe\n", NumAudited - NumFailed, NumAudited);
+    return NumFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,1674 @@
+// Copyright Charles Matthews. All Rights Reserved.
+
+// Regression tests for the Branches DSP kernels.
+//
+// Every test runs a kernel over the same input at each kernel level this machine supports, cut into blocks of uneven
+// sizes so the vector kernels see unaligned heads and tails, and the silent and constant fast paths are entered and
+// left mid-stream. The output is checked:
+//     - against the Scalar level, bit for bit, as KernelDispatch.h promises;
+//     - where the kernel replaced a loop in a node's Execute(), against a copy of that loop (namespace Baseline),
+//       bit for bit unless the test allows for a deliberate difference.
+//
+// Usage: BranchesKernelTests [--filter <text>]
+
+#include "MetasoundBranches/Public/Kernels/BranchesKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace MetasoundBranches::Tests
+{
+    using namespace MetasoundBranches::Kernels;
+
+    using FSamples = std::vector<float>;
+
+    // Copies of the per-sample loops the nodes ran before their kernels existed, with the engine types replaced by
+    // their standard equivalents and nothing else changed
+    namespace Baseline
+    {
+        constexpr float PI = 3.1415926535897932f;
+        constexpr float HALF_PI = 1.57079632679f;
+
+        // Stereo Gain
+        void ProcessStereoGain(const float* LeftData, const float* RightData, float GainVal, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+        {
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                OutputLeftData[i] = LeftData[i] * GainVal;
+                OutputRightData[i] = RightData[i] * GainVal;
+            }
+        }
+
+        // Stereo Balance
+        void ProcessStereoBalance(const float* LeftData, const float* RightData, float InputBalance, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+        {
+            float Balance = Clamp(InputBalance, -1.0f, 1.0f);
+
+            float Angle = (Balance + 1.0f) * (PI / 4.0f);
+
+            float LeftGain = std::cos(Angle);
+            float RightGain = std::sin(Angle);
+
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                OutputLeftData[i] = LeftData[i] * LeftGain;
+                OutputRightData[i] = RightData[i] * RightGain;
+            }
+        }
+
+        // Stereo Width
+        void ProcessStereoWidth(const float* LeftData, const float* RightData, float InputWidth, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+        {
+            float WidthFactor = Clamp(InputWidth, 0.0f, 2.0f);
+
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                float Left = LeftData[i];
+                float Right = RightData[i];
+
+                float Mid = 0.5f * (Left + Right);
+                float Side = 0.5f * (Left - Right);
+
+                Side *= WidthFactor;
+
+                OutputLeftData[i] = Mid + Side;
+                OutputRightData[i] = Mid - Side;
+            }
+        }
+
+        // Stereo Crossfade
+        void ProcessStereoCrossfade(
+            const float* LeftData1, const float* RightData1,
+            const float* LeftData2, const float* RightData2,
+            float InputCrossfade, float* OutputLeftData, float* OutputRightData, int32_t NumFrames)
+        {
+            float CrossfadeFactor = Clamp(InputCrossfade, 0.0f, 1.0f);
+
+            float Gain1 = std::cos(CrossfadeFactor * HALF_PI); // HALF_PI = PI / 2
+            float Gain2 = std::sin(CrossfadeFactor * HALF_PI);
+
+            for (int32_t i = 0; i < NumFrames; ++i)
+            {
+                OutputLeftData[i] = Gain1 * LeftData1[i] + Gain2 * LeftData2[i];
+                OutputRightData[i] = Gain1 * RightData1[i] + Gain2 * RightData2[i];
+            }
+        }
+
+        // Slew (Audio)
+        struct FSlew
+        {
+            float PreviousOutputSample = 0.0f;
+
+            void Process(const float* SignalData, float* OutputDataPtr, int32_t NumFrames, float RiseTimeSeconds, float FallTimeSeconds, int32_t SampleRate)
+            {
+                // Calculate alpha values based on rise and fall times
+                // Alpha = exp(-1 / (time * sample rate))
+                float RiseAlpha = (RiseTimeSeconds > 0.0f) ? std::exp(-1.0f / (RiseTimeSeconds * SampleRate)) : 0.0f;
+                float FallAlpha = (FallTimeSeconds > 0.0f) ? std::exp(-1.0f / (FallTimeSeconds * SampleRate)) : 0.0f;
+
+                for (int32_t i = 0; i < NumFrames; ++i)
+                {
+                    float SignalSample = SignalData[i];
+                    float OutputSample = PreviousOutputSample;
+
+                    if (SignalSample > PreviousOutputSample)
+                    {
+                        OutputSample = RiseAlpha * PreviousOutputSample + (1.0f - RiseAlpha) * SignalSample;
+                    }
+                    else if (SignalSample < PreviousOutputSample)
+                    {
+                        OutputSample = FallAlpha * PreviousOutputSample + (1.0f - FallAlpha) * SignalSample;
+                    }
+                    else
+                    {
+                        OutputSample = SignalSample;
+                    }
+
+                    OutputDataPtr[i] = OutputSample;
+                    PreviousOutputSample = OutputSample;
+                }
+            }
+        };
+
+        // Sample And Hold
+        struct FSah
+        {
+            float SampledValue = 0.0f;
+            float PreviousTriggerValue = 0.0f;
+
+            void Process(const float* SignalData, const float* TriggerData, float Threshold, float* OutputData, int32_t NumFrames)
+            {
+                for (int32_t i = 0; i < NumFrames; ++i)
+                {
+                    float CurrentTriggerValue = TriggerData[i];
+
+                    // Detect rising edge
+                    if (PreviousTriggerValue < Threshold && CurrentTriggerValue >= Threshold)
+                    {
+                        // Sample the input signal
+                        SampledValue = SignalData[i];
+                    }
+
+                    // Output the sampled value
+                    OutputData[i] = SampledValue;
+
+                    // Update previous trigger value
+                    PreviousTriggerValue = CurrentTriggerValue;
+                }
+            }
+        };
+
+        // Edge, with the trigger outputs replaced by callbacks
+        struct FEdge
+        {
+            float PreviousSignalValue = 0.0f;
+            bool PreviousIsRising = false;
+            int32_t DebounceCounter = 0;
+
+            template<typename OnRiseType, typename OnFallType>
+            void Process(const float* SignalData, int32_t NumFrames, int32_t DebounceSamples, OnRiseType&& OnRise, OnFallType&& OnFall)
+            {
+                for (int32_t i = 0; i < NumFrames; ++i)
+                {
+                    float CurrentSignal = SignalData[i];
+
+                    // Decrement debounce counter
+                    if (DebounceCounter > 0)
+                    {
+                        DebounceCounter--;
+                    }
+
+                    // Detect rising edge
+                    if (CurrentSignal > PreviousSignalValue && !PreviousIsRising && DebounceCounter <= 0)
+                    {
+                        // Rising edge detected
+                        OnRise(i);
+                        DebounceCounter = DebounceSamples;
+                        PreviousIsRising = true;
+                    }
+                    // Detect falling edge
+                    else if (CurrentSignal < PreviousSignalValue && PreviousIsRising && DebounceCounter <= 0)
+                    {
+                        // Falling edge detected
+                        OnFall(i);
+                        DebounceCounter = DebounceSamples;
+                        PreviousIsRising = false;
+                    }
+
+                    // Update previous signal value
+                    PreviousSignalValue = CurrentSignal;
+                }
+            }
+        };
+
+        // Zero Crossing, with the trigger output replaced by a callback
+        struct FZeroCrossing
+        {
+            float PreviousSignalValue = 0.0f;
+            int32_t DebounceCounter = 0;
+
+            template<typename OnCrossingType>
+            void Process(const float* SignalData, int32_t NumFrames, int32_t DebounceSamples, OnCrossingType&& OnCrossing)
+            {
+                for (int32_t i = 0; i < NumFrames; ++i)
+                {
+                    float CurrentSignal = SignalData[i];
+
+                    if (DebounceCounter > 0)
+                    {
+                        DebounceCounter--;
+                    }
+
+                    bool PreviousNonPositive = (PreviousSignalValue <= 0.0f);
+                    bool CurrentPositive = (CurrentSignal > 0.0f);
+                    bool PreviousNonNegative = (PreviousSignalValue >= 0.0f);
+                    bool CurrentNegative = (CurrentSignal < 0.0f);
+
+                    // Crossing from negative or zero to positive
+                    if (PreviousNonPositive && CurrentPositive && DebounceCounter <= 0)
+                    {
+                        OnCrossing(i);
+                        DebounceCounter = DebounceSamples;
+                    }
+                    // Crossing from positive or zero to negative
+                    else if (PreviousNonNegative && CurrentNegative && DebounceCounter <= 0)
+                    {
+                        OnCrossing(i);
+                        DebounceCounter = DebounceSamples;
+                    }
+
+                    PreviousSignalValue = CurrentSignal;
+                }
+            }
+        };
+
+        // One stage of Phase Disperser
+        class FAllPassFilter
+        {
+        public:
+            void Init(float InFeedback = 0.5f)
+            {
+                DelayBuffer.assign(2, 0.0f); // For D = 1
+                WriteIndex = 0;
+                Feedback = InFeedback;
+            }
+
+            void ProcessBuffer(float* InOutBuffer, int32_t NumSamples)
+            {
+                for (int32_t i = 0; i < NumSamples; ++i)
+                {
+                    float InSample = InOutBuffer[i];
+                    float DelayedSample = DelayBuffer[WriteIndex];
+
+                    // Allpass difference equation: y[n] = -a * x[n] + x[n-D] + a * y[n-D]
+                    float OutSample = -Feedback * InSample + DelayedSample;
+                    DelayBuffer[WriteIndex] = InSample + Feedback * OutSample;
+
+                    InOutBuffer[i] = OutSample;
+
+                    // Update write index for D = 1
+                    WriteIndex = (WriteIndex + 1) % 2;
+                }
+            }
+
+        private:
+            std::vector<float> DelayBuffer;
+            int32_t WriteIndex;
+            float Feedback;
+        };
+    }
+
+    namespace
+    {
+        constexpr float TestSampleRate = 48000.0f;
+
+        // The input is cut into blocks of these sizes in turn
+        constexpr int32_t BlockSizes[] = { 256, 1, 7, 64, 255, 333, 16, 1000, 3, 129 };
+
+        constexpr int32_t GetNumTestFrames()
+        {
+            int32_t NumFrames = 0;
+            for (const int32_t BlockSize : BlockSizes)
+            {
+                NumFrames += BlockSize;
+            }
+            return 2 * NumFrames;
+        }
+
+        // Two rounds of BlockSizes
+        constexpr int32_t NumTestFrames = GetNumTestFrames();
+
+        // Calls Process(Start, NumFrames, Block) for consecutive blocks covering NumTestFrames
+        template<typename ProcessType>
+        void ForEachBlock(ProcessType&& Process)
+        {
+            int32_t Start = 0;
+            for (int32_t Block = 0; Start < NumTestFrames; ++Block)
+            {
+                const int32_t NumFrames = std::min(BlockSizes[Block % std::size(BlockSizes)], NumTestFrames - Start);
+                Process(Start, NumFrames, Block);
+                Start += NumFrames;
+            }
+        }
+
+        // Noise, a slow sine with a little noise on it, silence, DC and louder noise, a fifth of the frames each. The
+        // segments don't line up with the blocks, so the silent and constant fast paths start and stop mid-stream.
+        FSamples MakeTestSignal(uint32_t Seed)
+        {
+            uint32_t State = Seed * 747796405u + 2891336453u;
+            const auto Noise = [&State]()
+                {
+                    State = State * 1664525u + 1013904223u;
+                    return static_cast<float>(State >> 8) * (2.0f / 16777216.0f) - 1.0f;
+                };
+
+            FSamples Signal(NumTestFrames);
+            const int32_t SegmentFrames = NumTestFrames / 5;
+
+            for (int32_t i = 0; i < NumTestFrames; ++i)
+            {
+                switch (i / SegmentFrames)
+                {
+                case 0:
+                    Signal[i] = Noise();
+                    break;
+                case 1:
+                    Signal[i] = 0.8f * std::sin(0.01f * static_cast<float>(i + static_cast<int32_t>(Seed))) + 0.05f * Noise();
+                    break;
+                case 2:
+                    Signal[i] = 0.0f;
+                    break;
+                case 3:
+                    Signal[i] = 0.25f;
+                    break;
+                default:
+                    Signal[i] = 4.0f * Noise();
+                    break;
+                }
+            }
+
+            return Signal;
+        }
+
+        // Slow sine between Min and Max, for the audio-rate balance and crossfade positions
+        FSamples MakeSweep(float Min, float Max)
+        {
+            FSamples Sweep(NumTestFrames);
+            for (int32_t i = 0; i < NumTestFrames; ++i)
+            {
+                Sweep[i] = Min + (Max - Min) * (0.5f + 0.5f * std::sin(0.004f * static_cast<float>(i)));
+            }
+            return Sweep;
+        }
+
+        struct FTestInputs
+        {
+            FSamples Left = MakeTestSignal(1);
+            FSamples Right = MakeTestSignal(2);
+            FSamples Left2 = MakeTestSignal(3);
+            FSamples Right2 = MakeTestSignal(4);
+
+            // A little past the ends of the balance and crossfade ranges, so the clamping is covered too
+            FSamples Balance = MakeSweep(-1.2f, 1.2f);
+            FSamples Crossfade = MakeSweep(-0.2f, 1.2f);
+        };
+
+        // Min and Max, and values past each, in a pattern that doesn't line up with the vectors
+        FSamples MakeEndPoints(float Min, float Max)
+        {
+            const float Values[] = { Min, Max, Max, Min - 0.5f, Max + 0.5f, Min, Max + 3.0f };
+
+            FSamples EndPoints(NumTestFrames);
+            for (int32_t i = 0; i < NumTestFrames; ++i)
+            {
+                EndPoints[i] = Values[i % std::size(Values)];
+            }
+            return EndPoints;
+        }
+
+        const FTestInputs& GetTestInputs()
+        {
+            static const FTestInputs Inputs;
+            return Inputs;
+        }
+
+        // Value of an automated parameter in the given block. Some values repeat, so both the ramped and the held paths
+        // run, and both ends of the range are reached.
+        float GetAutomation(int32_t Block, float Min, float Max)
+        {
+            constexpr float Positions[] = { 0.0f, 0.3f, 0.3f, 1.0f, 0.75f, 0.75f, 0.1f };
+            return Min + (Max - Min) * Positions[Block % std::size(Positions)];
+        }
+
+        // A control-rate parameter at Frame of a block, as the ramps are meant to apply it: held at Target when it
+        // hasn't changed, otherwise moving linearly from the previous block's value by the same step every frame, so
+        // it would reach Target exactly at the first frame of the next block, where a held Target takes over
+        float GetRampedValue(float Previous, float Target, int32_t Frame, int32_t NumFrames)
+        {
+            if (Previous == Target)
+            {
+                return Target;
+            }
+
+            const float Step = (Target - Previous) / static_cast<float>(NumFrames);
+            return Previous + Step * static_cast<float>(Frame);
+        }
+
+        // Runs a stereo kernel block by block; Process(Start, NumFrames, Block, OutputLeft, OutputRight). The output
+        // holds the left channel followed by the right.
+        template<typename ProcessType>
+        FSamples RunStereo(ProcessType&& Process)
+        {
+            FSamples Output(2 * NumTestFrames);
+            ForEachBlock([&Output, &Process](int32_t Start, int32_t NumFrames, int32_t Block)
+                {
+                    Process(Start, NumFrames, Block, Output.data() + Start, Output.data() + NumTestFrames + Start);
+                });
+            return Output;
+        }
+
+        // Runs an in-place kernel block by block over a copy of Input; Process(Data, NumFrames, Block)
+        template<typename ProcessType>
+        FSamples RunInPlace(const FSamples& Input, ProcessType&& Process)
+        {
+            FSamples Output = Input;
+            ForEachBlock([&Output, &Process](int32_t Start, int32_t NumFrames, int32_t Block)
+                {
+                    Process(Output.data() + Start, NumFrames, Block);
+                });
+            return Output;
+        }
+
+        // Runs an in-place kernel over NumChannels channels; the output holds the channels one after the other
+        template<typename ProcessType>
+        FSamples RunChannelsInPlace(int32_t NumChannels, ProcessType&& Process)
+        {
+            FSamples Output(static_cast<size_t>(NumChannels) * NumTestFrames);
+            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+            {
+                const FSamples Input = MakeTestSignal(static_cast<uint32_t>(10 + Channel));
+                std::copy(Input.begin(), Input.end(), Output.begin() + static_cast<ptrdiff_t>(Channel) * NumTestFrames);
+            }
+
+            ForEachBlock([&Output, &Process, NumChannels](int32_t Start, int32_t NumFrames, int32_t Block)
+                {
+                    float* Data[MaxAllPassChannels];
+                    for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                    {
+                        Data[Channel] = Output.data() + static_cast<ptrdiff_t>(Channel) * NumTestFrames + Start;
+                    }
+                    Process(Data, NumFrames, Block);
+                });
+            return Output;
+        }
+
+        struct FKernelTest
+        {
+            FKernelTest(std::string InName, std::function<FSamples()> InRun, std::function<FSamples()> InReference = nullptr, const char* InReferenceName = "the baseline loop", std::optional<double> InReferenceToleranceDb = std::nullopt)
+                : Name(std::move(InName))
+                , Run(std::move(InRun))
+                , Reference(std::move(InReference))
+                , ReferenceName(InReferenceName)
+                , ReferenceToleranceDb(InReferenceToleranceDb)
+            {
+            }
+
+            std::string Name;
+
+            // Output of the kernel at the active kernel level
+            std::function<FSamples()> Run;
+
+            // What the output must also match at every level, if anything besides the Scalar level
+            std::function<FSamples()> Reference;
+            const char* ReferenceName;
+
+            // Largest error against Reference relative to its energy, in dB; a bit-exact match if unset
+            std::optional<double> ReferenceToleranceDb;
+        };
+
+        // Tolerance for a match in value rather than in bits, so zeros of either sign are equal
+        constexpr double ValueMatchDb = -std::numeric_limits<double>::infinity();
+
+        // The audio-rate gains are interpolated from a table, within about 4e-7 of cos / sin (see QuarterSineTable.h)
+        constexpr double AudioRateToleranceDb = -120.0;
+
+        // Error energy of Output relative to the energy of Expected, in dB
+        double GetRelativeErrorDb(const FSamples& Output, const FSamples& Expected)
+        {
+            double ErrorEnergy = 0.0;
+            double Energy = 0.0;
+            for (size_t i = 0; i < Expected.size(); ++i)
+            {
+                const double Error = static_cast<double>(Output[i]) - static_cast<double>(Expected[i]);
+                ErrorEnergy += Error * Error;
+                Energy += static_cast<double>(Expected[i]) * static_cast<double>(Expected[i]);
+            }
+
+            if (ErrorEnergy == 0.0)
+            {
+                return -std::numeric_limits<double>::infinity();
+            }
+            return 10.0 * std::log10(ErrorEnergy / Energy);
+        }
+
+        // Prints the first difference and returns false if Output doesn't match Expected
+        bool CheckOutput(const FKernelTest& Test, EKernelIsa Isa, const char* ExpectedName, const FSamples& Output, const FSamples& Expected, std::optional<double> ToleranceDb)
+        {
+            if (Output.size() != Expected.size())
+            {
+                std::fprintf(stderr, "FAIL %s (%s): %zu values, %zu from %s\n", Test.Name.c_str(), GetKernelIsaName(Isa), Output.size(), Expected.size(), ExpectedName);
+                return false;
+            }
+
+            if (ToleranceDb)
+            {
+                const double ErrorDb = GetRelativeErrorDb(Output, Expected);
+                if (!(ErrorDb <= *ToleranceDb))
+                {
+                    std::fprintf(stderr, "FAIL %s (%s): differs from %s by %.1f dB, more than %.1f dB\n", Test.Name.c_str(), GetKernelIsaName(Isa), ExpectedName, ErrorDb, *ToleranceDb);
+                    return false;
+                }
+                return true;
+            }
+
+            for (size_t i = 0; i < Expected.size(); ++i)
+            {
+                if (std::memcmp(&Output[i], &Expected[i], sizeof(float)) != 0)
+                {
+                    std::fprintf(stderr, "FAIL %s (%s): value %zu is %.9g, %.9g from %s\n", Test.Name.c_str(), GetKernelIsaName(Isa), i, Output[i], Expected[i], ExpectedName);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool RunTest(const FKernelTest& Test)
+        {
+            const FSamples Reference = Test.Reference ? Test.Reference() : FSamples();
+
+            FSamples ScalarOutput;
+            bool bPassed = true;
+
+            for (int32_t Level = 0; Level <= static_cast<int32_t>(GetDetectedKernelIsa()); ++Level)
+            {
+                const EKernelIsa Isa = SetKernelIsa(static_cast<EKernelIsa>(Level));
+                const FSamples Output = Test.Run();
+
+                if (Isa == EKernelIsa::Scalar)
+                {
+                    ScalarOutput = Output;
+                }
+                else
+                {
+                    bPassed &= CheckOutput(Test, Isa, "the Scalar level", Output, ScalarOutput, std::nullopt);
+                }
+
+                if (Test.Reference)
+                {
+                    bPassed &= CheckOutput(Test, Isa, Test.ReferenceName, Output, Reference, Test.ReferenceToleranceDb);
+                }
+            }
+
+            return bPassed;
+        }
+
+        void AddStereoTests(std::vector<FKernelTest>& Tests)
+        {
+            const FTestInputs& In = GetTestInputs();
+
+            Tests.push_back({ "StereoGain",
+                [&In]()
+                {
+                    FStereoGains Gains{ 0.7f, 0.7f };
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoGainsRamped(Gains, FStereoGains{ 0.7f, 0.7f }, In.Left.data() + Start, In.Right.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            Baseline::ProcessStereoGain(In.Left.data() + Start, In.Right.data() + Start, 0.7f, OutLeft, OutRight, NumFrames);
+                        });
+                } });
+
+            Tests.push_back({ "StereoGain/Automated",
+                [&In]()
+                {
+                    FStereoGains Gains;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const float Gain = GetAutomation(Block, -1.0f, 2.0f);
+                            ProcessStereoGainsRamped(Gains, FStereoGains{ Gain, Gain }, In.Left.data() + Start, In.Right.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    float Previous = 1.0f;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const float Gain = GetAutomation(Block, -1.0f, 2.0f);
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                const float FrameGain = GetRampedValue(Previous, Gain, i, NumFrames);
+                                OutLeft[i] = In.Left[Start + i] * FrameGain;
+                                OutRight[i] = In.Right[Start + i] * FrameGain;
+                            }
+                            Previous = Gain;
+                        });
+                },
+                "the per-sample ramp" });
+
+            Tests.push_back({ "StereoBalance",
+                [&In]()
+                {
+                    FStereoGains Gains = MakeBalanceGains(0.3f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoGainsRamped(Gains, MakeBalanceGains(0.3f), In.Left.data() + Start, In.Right.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            Baseline::ProcessStereoBalance(In.Left.data() + Start, In.Right.data() + Start, 0.3f, OutLeft, OutRight, NumFrames);
+                        });
+                } });
+
+            Tests.push_back({ "StereoBalance/Automated",
+                [&In]()
+                {
+                    FStereoGains Gains = MakeBalanceGains(0.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoGainsRamped(Gains, MakeBalanceGains(GetAutomation(Block, -1.0f, 1.0f)), In.Left.data() + Start, In.Right.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    FStereoGains Previous = MakeBalanceGains(0.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const FStereoGains Gains = MakeBalanceGains(GetAutomation(Block, -1.0f, 1.0f));
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                OutLeft[i] = In.Left[Start + i] * GetRampedValue(Previous.Left, Gains.Left, i, NumFrames);
+                                OutRight[i] = In.Right[Start + i] * GetRampedValue(Previous.Right, Gains.Right, i, NumFrames);
+                            }
+                            Previous = Gains;
+                        });
+                },
+                "the per-sample ramp" });
+
+            Tests.push_back({ "StereoBalance/Audio",
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoBalanceAudio(In.Left.data() + Start, In.Right.data() + Start, In.Balance.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                const FStereoGains Gains = MakeBalanceGains(In.Balance[Start + i]);
+                                OutLeft[i] = In.Left[Start + i] * Gains.Left;
+                                OutRight[i] = In.Right[Start + i] * Gains.Right;
+                            }
+                        });
+                },
+                "cos / sin per sample", AudioRateToleranceDb });
+
+            // At the ends of the range, and past them, one channel is passed through and the other silenced exactly
+            Tests.push_back({ "StereoBalance/Audio/Ends",
+                [&In]()
+                {
+                    const FSamples Balance = MakeEndPoints(-1.0f, 1.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoBalanceAudio(In.Left.data() + Start, In.Right.data() + Start, Balance.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    const FSamples Balance = MakeEndPoints(-1.0f, 1.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                const bool bLeft = Balance[Start + i] < 0.0f;
+                                OutLeft[i] = In.Left[Start + i] * (bLeft ? 1.0f : 0.0f);
+                                OutRight[i] = In.Right[Start + i] * (bLeft ? 0.0f : 1.0f);
+                            }
+                        });
+                },
+                "the channels passed through" });
+
+            Tests.push_back({ "StereoWidth",
+                [&In]()
+                {
+                    float WidthFactor = 1.6f;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoWidthRamped(WidthFactor, 1.6f, In.Left.data() + Start, In.Right.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            Baseline::ProcessStereoWidth(In.Left.data() + Start, In.Right.data() + Start, 1.6f, OutLeft, OutRight, NumFrames);
+                        });
+                } });
+
+            Tests.push_back({ "StereoWidth/Automated",
+                [&In]()
+                {
+                    float WidthFactor = 1.0f;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoWidthRamped(WidthFactor, GetAutomation(Block, -0.5f, 2.5f), In.Left.data() + Start, In.Right.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    // The width is clamped before it is ramped to
+                    float Previous = 1.0f;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const float Width = Clamp(GetAutomation(Block, -0.5f, 2.5f), 0.0f, 2.0f);
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                const float Left = In.Left[Start + i];
+                                const float Right = In.Right[Start + i];
+                                const float Mid = 0.5f * (Left + Right);
+                                const float Side = 0.5f * (Left - Right) * GetRampedValue(Previous, Width, i, NumFrames);
+                                OutLeft[i] = Mid + Side;
+                                OutRight[i] = Mid - Side;
+                            }
+                            Previous = Width;
+                        });
+                },
+                "the per-sample ramp" });
+
+            // Crossfade is the equal-power mix of the pair, ramped or held, or one input copied through at either end
+            const auto RunCrossfade = [&In](float Crossfade)
+                {
+                    FStereoGains Gains = MakeCrossfadeGains(Crossfade);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoCrossfadeRamped(Gains, In.Left.data() + Start, In.Right.data() + Start, In.Left2.data() + Start, In.Right2.data() + Start, Crossfade, OutLeft, OutRight, NumFrames);
+                        });
+                };
+            const auto RunBaselineCrossfade = [&In](float Crossfade)
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            Baseline::ProcessStereoCrossfade(In.Left.data() + Start, In.Right.data() + Start, In.Left2.data() + Start, In.Right2.data() + Start, Crossfade, OutLeft, OutRight, NumFrames);
+                        });
+                };
+
+            Tests.push_back({ "StereoCrossfade", [=]() { return RunCrossfade(0.3f); }, [=]() { return RunBaselineCrossfade(0.3f); } });
+            Tests.push_back({ "StereoCrossfade/0", [=]() { return RunCrossfade(0.0f); }, [=]() { return RunBaselineCrossfade(0.0f); } });
+
+            // The kernel passes the second input through at 1, where the baseline mixed in cos(pi / 2), about -4e-8, of the first
+            Tests.push_back({ "StereoCrossfade/1", [=]() { return RunCrossfade(1.0f); }, [=]() { return RunBaselineCrossfade(1.0f); }, "the baseline loop", -140.0 });
+
+            Tests.push_back({ "StereoCrossfade/Automated",
+                [&In]()
+                {
+                    FStereoGains Gains = MakeCrossfadeGains(0.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoCrossfadeRamped(Gains, In.Left.data() + Start, In.Right.data() + Start, In.Left2.data() + Start, In.Right2.data() + Start, GetAutomation(Block, 0.0f, 1.0f), OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    // Compared in value, as the held end points copy one input rather than adding a zero-gain other
+                    FStereoGains Previous = MakeCrossfadeGains(0.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const FStereoGains Gains = MakeCrossfadeGains(GetAutomation(Block, 0.0f, 1.0f));
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                const float Gain1 = GetRampedValue(Previous.Left, Gains.Left, i, NumFrames);
+                                const float Gain2 = GetRampedValue(Previous.Right, Gains.Right, i, NumFrames);
+                                OutLeft[i] = Gain1 * In.Left[Start + i] + Gain2 * In.Left2[Start + i];
+                                OutRight[i] = Gain1 * In.Right[Start + i] + Gain2 * In.Right2[Start + i];
+                            }
+                            Previous = Gains;
+                        });
+                },
+                "the per-sample ramp", ValueMatchDb });
+
+            Tests.push_back({ "StereoCrossfade/Audio",
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoCrossfadeAudio(In.Left.data() + Start, In.Right.data() + Start, In.Left2.data() + Start, In.Right2.data() + Start, In.Crossfade.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                const FStereoGains Gains = MakeCrossfadeGains(In.Crossfade[Start + i]);
+                                OutLeft[i] = Gains.Left * In.Left[Start + i] + Gains.Right * In.Left2[Start + i];
+                                OutRight[i] = Gains.Left * In.Right[Start + i] + Gains.Right * In.Right2[Start + i];
+                            }
+                        });
+                },
+                "cos / sin per sample", AudioRateToleranceDb });
+
+            // At the ends of the range, and past them, one input is passed through
+            Tests.push_back({ "StereoCrossfade/Audio/Ends",
+                [&In]()
+                {
+                    const FSamples Crossfade = MakeEndPoints(0.0f, 1.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoCrossfadeAudio(In.Left.data() + Start, In.Right.data() + Start, In.Left2.data() + Start, In.Right2.data() + Start, Crossfade.data() + Start, OutLeft, OutRight, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    const FSamples Crossfade = MakeEndPoints(0.0f, 1.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* OutLeft, float* OutRight)
+                        {
+                            for (int32_t i = 0; i < NumFrames; ++i)
+                            {
+                                const bool bFirst = Crossfade[Start + i] < 0.5f;
+                                OutLeft[i] = bFirst ? In.Left[Start + i] : In.Left2[Start + i];
+                                OutRight[i] = bFirst ? In.Right[Start + i] : In.Right2[Start + i];
+                            }
+                        });
+                },
+                "the inputs passed through", ValueMatchDb });
+
+            Tests.push_back({ "StereoCrossfadeN",
+                [&In]()
+                {
+                    float Position = 0.0f;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const float* LeftData[] = { In.Left.data() + Start, In.Left2.data() + Start, In.Right.data() + Start };
+                            const float* RightData[] = { In.Right.data() + Start, In.Right2.data() + Start, In.Left.data() + Start };
+                            ProcessStereoCrossfadeN(Position, LeftData, RightData, 3, GetAutomation(Block, 0.0f, 2.0f), OutLeft, OutRight, NumFrames);
+                        });
+                } });
+
+            // Which changes ramp: any change between finite values, and nothing else. NaN never equals itself, so a held
+            // NaN must not count as a change either.
+            Tests.push_back({ "ShouldRamp",
+                []()
+                {
+                    constexpr float Infinity = std::numeric_limits<float>::infinity();
+                    const float NaN = std::numeric_limits<float>::quiet_NaN();
+                    const std::pair<float, float> Cases[] = {
+                        { 0.3f, 0.3f }, { 0.0f, -0.0f }, { 0.3f, 0.7f }, { 1.0f, -1.0f }, { 0.7f, std::nextafter(0.7f, 1.0f) },
+                        { NaN, NaN }, { NaN, 1.0f }, { 1.0f, NaN }, { Infinity, Infinity }, { Infinity, 1.0f }, { 1.0f, -Infinity }
+                    };
+
+                    FSamples Decisions;
+                    for (const std::pair<float, float>& Case : Cases)
+                    {
+                        Decisions.push_back(ShouldRamp(Case.first, Case.second) ? 1.0f : 0.0f);
+                    }
+                    return Decisions;
+                },
+                []()
+                {
+                    return FSamples{ 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+                },
+                "the expected decisions" });
+
+            // Every input mixed with its equal-power gain, in double precision, against the kernel that only reads the
+            // audible ones. The positions ramp within a pair, across pair boundaries (up to four inputs at once), jump
+            // between whole numbers and go past both ends.
+            for (const int32_t NumInputs : { 4, 8 })
+            {
+                const auto GetPosition = [NumInputs](int32_t Block)
+                    {
+                        const float Last = static_cast<float>(NumInputs - 1);
+                        const float Positions[] = { 0.0f, 0.5f, 2.5f, 2.5f, 1.0f, 1.0f, -1.0f, 0.3f, Last + 2.0f, Last, Last - 0.4f, 1.7f, 2.2f, Last - 1.5f };
+                        return Positions[Block % std::size(Positions)];
+                    };
+
+                const auto GetInputs = [NumInputs]()
+                    {
+                        std::vector<FSamples> Inputs;
+                        for (int32_t Channel = 0; Channel < 2 * NumInputs; ++Channel)
+                        {
+                            Inputs.push_back(MakeTestSignal(static_cast<uint32_t>(40 + Channel)));
+                        }
+                        return Inputs;
+                    };
+
+                Tests.push_back({ "StereoCrossfadeN/" + std::to_string(NumInputs),
+                    [=]()
+                    {
+                        const std::vector<FSamples> Inputs = GetInputs();
+                        float Position = 0.0f;
+                        return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                            {
+                                const float* LeftData[8];
+                                const float* RightData[8];
+                                for (int32_t Input = 0; Input < NumInputs; ++Input)
+                                {
+                                    LeftData[Input] = Inputs[2 * Input].data() + Start;
+                                    RightData[Input] = Inputs[2 * Input + 1].data() + Start;
+                                }
+                                ProcessStereoCrossfadeN(Position, LeftData, RightData, NumInputs, GetPosition(Block), OutLeft, OutRight, NumFrames);
+                            });
+                    },
+                    [=]()
+                    {
+                        // Equal-power gain of Input at Position; the top pair reaches its second input at the last position
+                        const auto GetGain = [NumInputs](double Position, int32_t Input)
+                            {
+                                const double Clamped = std::min(std::max(Position, 0.0), static_cast<double>(NumInputs - 1));
+                                const int32_t Pair = std::min(static_cast<int32_t>(Clamped), NumInputs - 2);
+                                const double Angle = (Clamped - Pair) * 1.57079632679489661923;
+                                return Input == Pair ? std::cos(Angle) : (Input == Pair + 1 ? std::sin(Angle) : 0.0);
+                            };
+
+                        const std::vector<FSamples> Inputs = GetInputs();
+                        double Previous = 0.0;
+                        return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                            {
+                                const double Position = GetPosition(Block);
+                                for (int32_t i = 0; i < NumFrames; ++i)
+                                {
+                                    double Left = 0.0;
+                                    double Right = 0.0;
+                                    for (int32_t Input = 0; Input < NumInputs; ++Input)
+                                    {
+                                        // The gains, not the position, move linearly across a block
+                                        const double StartGain = GetGain(Previous, Input);
+                                        const double Gain = StartGain + (GetGain(Position, Input) - StartGain) * i / NumFrames;
+                                        Left += Gain * Inputs[2 * Input][Start + i];
+                                        Right += Gain * Inputs[2 * Input + 1][Start + i];
+                                    }
+                                    OutLeft[i] = static_cast<float>(Left);
+                                    OutRight[i] = static_cast<float>(Right);
+                                }
+                                Previous = std::min(std::max(Position, 0.0), static_cast<double>(NumInputs - 1));
+                            });
+                    },
+                    "the equal-power mix of every input", -120.0 });
+            }
+
+            Tests.push_back({ "StereoInverter",
+                [&In]()
+                {
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoInverter(In.Left.data() + Start, In.Right.data() + Start, Block % 2 == 0, Block % 3 == 0, Block % 4 < 2, OutLeft, OutRight, NumFrames);
+                        });
+                } });
+
+            Tests.push_back({ "StereoMatrix/Automated",
+                [&In]()
+                {
+                    FStereoMatrixState State = MakeStereoMatrixState(1.0f, 0.0f, 1.0f);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            ProcessStereoMatrix(
+                                State, In.Left.data() + Start, In.Right.data() + Start,
+                                Block % 5 != 0, GetAutomation(Block, 0.0f, 2.0f), GetAutomation(Block + 2, -1.0f, 1.0f), Block % 2 == 0, Block % 3 == 0, Block % 4 < 2, GetAutomation(Block + 4, -1.0f, 2.0f),
+                                OutLeft, OutRight, NumFrames);
+                        });
+                } });
+
+            // The matrix against Width -> Balance -> Inverter -> Gain run as separate kernels, as the nodes would, with
+            // the settings held and then changing every block. Without mid-side the Width node passes its inputs through.
+            struct FMatrixSettings
+            {
+                float Width;
+                float Balance;
+                bool bInvertLeft;
+                bool bInvertRight;
+                bool bSwap;
+                float Gain;
+            };
+
+            const auto GetMatrixSettings = [](bool bAutomated, int32_t Block)
+                {
+                    if (!bAutomated)
+                    {
+                        return FMatrixSettings{ 1.4f, -0.35f, true, false, true, 0.8f };
+                    }
+                    return FMatrixSettings{ GetAutomation(Block, 0.0f, 2.0f), GetAutomation(Block + 2, -1.0f, 1.0f), Block % 2 == 0, Block % 3 == 0, Block % 4 < 2, GetAutomation(Block + 4, -1.0f, 2.0f) };
+                };
+
+            const auto RunMatrix = [&In, GetMatrixSettings](bool bMidSide, bool bAutomated)
+                {
+                    const FMatrixSettings Initial = GetMatrixSettings(bAutomated, 0);
+                    FStereoMatrixState State = MakeStereoMatrixState(bMidSide ? Initial.Width : 1.0f, Initial.Balance, Initial.Gain);
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const FMatrixSettings Settings = GetMatrixSettings(bAutomated, Block);
+                            ProcessStereoMatrix(
+                                State, In.Left.data() + Start, In.Right.data() + Start,
+                                bMidSide, bMidSide ? Settings.Width : 1.0f, Settings.Balance, Settings.bInvertLeft, Settings.bInvertRight, Settings.bSwap, Settings.Gain,
+                                OutLeft, OutRight, NumFrames);
+                        });
+                };
+
+            const auto RunChain = [&In, GetMatrixSettings](bool bMidSide, bool bAutomated)
+                {
+                    const FMatrixSettings Initial = GetMatrixSettings(bAutomated, 0);
+                    float WidthFactor = Clamp(Initial.Width, 0.0f, 2.0f);
+                    FStereoGains BalanceGains = MakeBalanceGains(Initial.Balance);
+                    FStereoGains Gains{ Initial.Gain, Initial.Gain };
+
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t Block, float* OutLeft, float* OutRight)
+                        {
+                            const FMatrixSettings Settings = GetMatrixSettings(bAutomated, Block);
+
+                            if (bMidSide)
+                            {
+                                ProcessStereoWidthRamped(WidthFactor, Settings.Width, In.Left.data() + Start, In.Right.data() + Start, OutLeft, OutRight, NumFrames);
+                            }
+                            else
+                            {
+                                std::copy_n(In.Left.data() + Start, NumFrames, OutLeft);
+                                std::copy_n(In.Right.data() + Start, NumFrames, OutRight);
+                            }
+
+                            ProcessStereoGainsRamped(BalanceGains, MakeBalanceGains(Settings.Balance), OutLeft, OutRight, OutLeft, OutRight, NumFrames);
+                            ProcessStereoInverter(OutLeft, OutRight, Settings.bInvertLeft, Settings.bInvertRight, Settings.bSwap, OutLeft, OutRight, NumFrames);
+                            ProcessStereoGainsRamped(Gains, FStereoGains{ Settings.Gain, Settings.Gain }, OutLeft, OutRight, OutLeft, OutRight, NumFrames);
+                        });
+                };
+
+            Tests.push_back({ "StereoMatrix/Chain", [=]() { return RunMatrix(true, false); }, [=]() { return RunChain(true, false); }, "the separate nodes in series" });
+            Tests.push_back({ "StereoMatrix/Chain/Automated", [=]() { return RunMatrix(true, true); }, [=]() { return RunChain(true, true); }, "the separate nodes in series" });
+            Tests.push_back({ "StereoMatrix/Chain/NoMidSide", [=]() { return RunMatrix(false, true); }, [=]() { return RunChain(false, true); }, "the separate nodes in series" });
+
+            Tests.push_back({ "StereoRouter/Automated",
+                [&In]()
+                {
+                    FStereoRouterState State;
+                    FSamples Output(4 * NumTestFrames);
+                    ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t Block)
+                        {
+                            // Unity, held, ramped and silent routes, by output then input
+                            const float Gains[] = { 1.0f, GetAutomation(Block, 0.0f, 1.0f), Block % 3 == 0 ? 0.0f : 0.5f, GetAutomation(Block + 3, -1.0f, 1.0f) };
+                            const float* LeftData[] = { In.Left.data() + Start, In.Left2.data() + Start };
+                            const float* RightData[] = { In.Right.data() + Start, In.Right2.data() + Start };
+                            float* OutputLeft[] = { Output.data() + Start, Output.data() + 2 * NumTestFrames + Start };
+                            float* OutputRight[] = { Output.data() + NumTestFrames + Start, Output.data() + 3 * NumTestFrames + Start };
+
+                            UpdateStereoRoutes(State, Gains, 4, 2, 2, NumFrames);
+                            ProcessStereoRouter(State, LeftData, RightData, OutputLeft, OutputRight, 2, NumFrames);
+                        });
+                    return Output;
+                } });
+
+            // The sparse routes against a dense mix of every input into every output, sample by sample, over a
+            // matrix that changes mid-stream. Every fourth group of blocks the matrix is a permutation, the
+            // configuration the node binds straight through when it is fixed at build time.
+            for (const int32_t NumChannels : { 4, 8 })
+            {
+                const auto GetRouterGains = [NumChannels](int32_t Block)
+                    {
+                        constexpr float Values[] = { 0.0f, 1.0f, 0.5f, 0.0f, -0.25f, 0.0f, 0.8f };
+
+                        std::vector<float> Gains(static_cast<size_t>(NumChannels) * NumChannels);
+                        for (int32_t Output = 0; Output < NumChannels; ++Output)
+                        {
+                            for (int32_t Input = 0; Input < NumChannels; ++Input)
+                            {
+                                float& Gain = Gains[GetRouterGainIndex(Input, Output, NumChannels)];
+                                if ((Block / 3) % 4 == 3)
+                                {
+                                    Gain = Input == (Output + 1) % NumChannels ? 1.0f : 0.0f;
+                                }
+                                else
+                                {
+                                    Gain = Values[(Output * 5 + Input * 3 + Block / 3 + (Input == 0 ? Block : 0)) % std::size(Values)];
+                                }
+                            }
+                        }
+                        return Gains;
+                    };
+
+                const auto GetRouterInputs = [NumChannels]()
+                    {
+                        std::vector<FSamples> Inputs;
+                        for (int32_t Channel = 0; Channel < 2 * NumChannels; ++Channel)
+                        {
+                            Inputs.push_back(MakeTestSignal(static_cast<uint32_t>(20 + Channel)));
+                        }
+                        return Inputs;
+                    };
+
+                const std::string Name = "StereoRouter/" + std::to_string(NumChannels) + "x" + std::to_string(NumChannels);
+
+                Tests.push_back({ Name,
+                    [=]()
+                    {
+                        const std::vector<FSamples> Inputs = GetRouterInputs();
+                        const std::unique_ptr<FStereoRouterState> State = std::make_unique<FStereoRouterState>();
+                        FSamples Output(2 * static_cast<size_t>(NumChannels) * NumTestFrames);
+
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t Block)
+                            {
+                                const float* LeftData[MaxRouterChannels];
+                                const float* RightData[MaxRouterChannels];
+                                float* OutputLeft[MaxRouterChannels];
+                                float* OutputRight[MaxRouterChannels];
+                                for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                                {
+                                    LeftData[Channel] = Inputs[2 * Channel].data() + Start;
+                                    RightData[Channel] = Inputs[2 * Channel + 1].data() + Start;
+                                    OutputLeft[Channel] = Output.data() + static_cast<ptrdiff_t>(2 * Channel) * NumTestFrames + Start;
+                                    OutputRight[Channel] = Output.data() + static_cast<ptrdiff_t>(2 * Channel + 1) * NumTestFrames + Start;
+                                }
+
+                                const std::vector<float> Gains = GetRouterGains(Block);
+                                UpdateStereoRoutes(*State, Gains.data(), static_cast<int32_t>(Gains.size()), NumChannels, NumChannels, NumFrames);
+                                ProcessStereoRouter(*State, LeftData, RightData, OutputLeft, OutputRight, NumChannels, NumFrames);
+                            });
+                        return Output;
+                    },
+                    [=]()
+                    {
+                        const std::vector<FSamples> Inputs = GetRouterInputs();
+                        FSamples Mix(2 * static_cast<size_t>(NumChannels) * NumTestFrames);
+
+                        // A changed gain moves linearly from the previous block's value, reaching it at the next block
+                        std::vector<float> Previous(static_cast<size_t>(NumChannels) * NumChannels, 0.0f);
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t Block)
+                            {
+                                const std::vector<float> Gains = GetRouterGains(Block);
+
+                                for (int32_t Output = 0; Output < NumChannels; ++Output)
+                                {
+                                    for (int32_t Side = 0; Side < 2; ++Side)
+                                    {
+                                        float* OutputData = Mix.data() + static_cast<ptrdiff_t>(2 * Output + Side) * NumTestFrames + Start;
+                                        for (int32_t Frame = 0; Frame < NumFrames; ++Frame)
+                                        {
+                                            float Sum = 0.0f;
+                                            for (int32_t Input = 0; Input < NumChannels; ++Input)
+                                            {
+                                                const int32_t Index = GetRouterGainIndex(Input, Output, NumChannels);
+                                                const float Step = (Gains[Index] - Previous[Index]) / static_cast<float>(NumFrames);
+                                                const float Gain = Gains[Index] == Previous[Index] ? Gains[Index] : Previous[Index] + Step * static_cast<float>(Frame);
+                                                Sum += Gain * Inputs[2 * Input + Side][Start + Frame];
+                                            }
+                                            OutputData[Frame] = Sum;
+                                        }
+                                    }
+                                }
+
+                                Previous = Gains;
+                            });
+                        return Mix;
+                    },
+                    "the dense mix", ValueMatchDb });
+            }
+
+            Tests.push_back({ "StereoMeter",
+                [&In]()
+                {
+                    FStereoMeterState State;
+                    FSamples Output;
+                    ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t)
+                        {
+                            ProcessStereoMeter(State, In.Left.data() + Start, In.Right.data() + Start, MakeMeterDecay(0.3f, TestSampleRate, NumFrames), NumFrames);
+
+                            const FStereoSums& Sums = State.Integrated;
+                            Output.insert(Output.end(), { Sums.LeftRight, Sums.LeftSquared, Sums.RightSquared, Sums.LeftPeak, Sums.RightPeak });
+                        });
+                    return Output;
+                } });
+
+            // Readings for signals whose correlation and balance are known: the right channel is the left one scaled by
+            // RightGain, so the correlation is its sign and the balance (RightGain^2 - 1) / (RightGain^2 + 1), or the
+            // left channel is silent. Peaks are the block peaks with the integrator's decay. Silence reads as zeros.
+            struct FMeterCase
+            {
+                const char* Name;
+                float LeftGain;
+                float RightGain;
+                float Correlation;
+                float Balance;
+            };
+
+            const FMeterCase MeterCases[] = {
+                { "Identical", 1.0f, 1.0f, 1.0f, 0.0f },
+                { "Inverted", 1.0f, -1.0f, -1.0f, 0.0f },
+                { "HardLeft", 1.0f, 0.0f, 0.0f, -1.0f },
+                { "HardRight", 0.0f, 1.0f, 0.0f, 1.0f },
+                { "Panned", 1.0f, 0.5f, 1.0f, -0.6f },
+                { "Silence", 0.0f, 0.0f, 0.0f, 0.0f }
+            };
+
+            for (const FMeterCase& Case : MeterCases)
+            {
+                const auto GetChannels = [&In, Case]()
+                    {
+                        std::pair<FSamples, FSamples> Channels(In.Left, In.Left);
+                        for (int32_t i = 0; i < NumTestFrames; ++i)
+                        {
+                            Channels.first[i] = In.Left[i] * Case.LeftGain;
+                            Channels.second[i] = In.Left[i] * Case.RightGain;
+                        }
+                        return Channels;
+                    };
+
+                Tests.push_back({ std::string("StereoMeter/") + Case.Name,
+                    [GetChannels]()
+                    {
+                        const std::pair<FSamples, FSamples> Channels = GetChannels();
+                        FStereoMeterState State;
+                        FSamples Output;
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t)
+                            {
+                                ProcessStereoMeter(State, Channels.first.data() + Start, Channels.second.data() + Start, MakeMeterDecay(0.3f, TestSampleRate, NumFrames), NumFrames);
+
+                                const FStereoMeterReadings Readings = GetStereoMeterReadings(State);
+                                Output.insert(Output.end(), { Readings.Correlation, Readings.Balance, Readings.LeftPeak, Readings.RightPeak });
+                            });
+                        return Output;
+                    },
+                    [GetChannels, Case]()
+                    {
+                        const std::pair<FSamples, FSamples> Channels = GetChannels();
+                        float LeftPeak = 0.0f;
+                        float RightPeak = 0.0f;
+                        FSamples Output;
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t)
+                            {
+                                const float Decay = MakeMeterDecay(0.3f, TestSampleRate, NumFrames);
+                                LeftPeak *= Decay;
+                                RightPeak *= Decay;
+                                for (int32_t i = Start; i < Start + NumFrames; ++i)
+                                {
+                                    LeftPeak = std::max(LeftPeak, std::abs(Channels.first[i]));
+                                    RightPeak = std::max(RightPeak, std::abs(Channels.second[i]));
+                                }
+
+                                Output.insert(Output.end(), { Case.Correlation, Case.Balance, LeftPeak, RightPeak });
+                            });
+                        return Output;
+                    },
+                    "the known readings", -120.0 });
+            }
+        }
+
+        void AddTriggerTests(std::vector<FKernelTest>& Tests)
+        {
+            const FTestInputs& In = GetTestInputs();
+
+            Tests.push_back({ "Slew",
+                [&In]()
+                {
+                    FSlewState State;
+                    const FSlewCoefficients Coefficients = MakeSlewCoefficients(0.002f, 0.01f, TestSampleRate);
+                    return RunInPlace(In.Left, [&](float* Data, int32_t NumFrames, int32_t)
+                        {
+                            ProcessSlew(State, Data, Data, NumFrames, Coefficients);
+                        });
+                },
+                [&In]()
+                {
+                    Baseline::FSlew Slew;
+                    return RunInPlace(In.Left, [&](float* Data, int32_t NumFrames, int32_t)
+                        {
+                            Slew.Process(Data, Data, NumFrames, 0.002f, 0.01f, static_cast<int32_t>(TestSampleRate));
+                        });
+                } });
+
+            Tests.push_back({ "SampleAndHold",
+                [&In]()
+                {
+                    FSahState State;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* Output, float*)
+                        {
+                            ProcessSah(State, In.Left.data() + Start, In.Right.data() + Start, 0.2f, Output, NumFrames);
+                        });
+                },
+                [&In]()
+                {
+                    Baseline::FSah Sah;
+                    return RunStereo([&](int32_t Start, int32_t NumFrames, int32_t, float* Output, float*)
+                        {
+                            Sah.Process(In.Left.data() + Start, In.Right.data() + Start, 0.2f, Output, NumFrames);
+                        });
+                } });
+
+            // Triggers are recorded as their frame in the whole signal, falling edges negated and offset by one
+            for (const int32_t DebounceSamples : { 3, DebounceSamplesFromSeconds(0.001f, TestSampleRate) })
+            {
+                const std::string Debounce = "/Debounce" + std::to_string(DebounceSamples);
+
+                Tests.push_back({ "Edge" + Debounce,
+                    [&In, DebounceSamples]()
+                    {
+                        FEdgeState State;
+                        FSamples Triggers;
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t)
+                            {
+                                ProcessEdge(State, In.Left.data() + Start, NumFrames, DebounceSamples,
+                                    [&](int32_t Frame) { Triggers.push_back(static_cast<float>(Start + Frame)); },
+                                    [&](int32_t Frame) { Triggers.push_back(-static_cast<float>(Start + Frame + 1)); });
+                            });
+                        return Triggers;
+                    },
+                    [&In, DebounceSamples]()
+                    {
+                        Baseline::FEdge Edge;
+                        FSamples Triggers;
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t)
+                            {
+                                Edge.Process(In.Left.data() + Start, NumFrames, DebounceSamples,
+                                    [&](int32_t Frame) { Triggers.push_back(static_cast<float>(Start + Frame)); },
+                                    [&](int32_t Frame) { Triggers.push_back(-static_cast<float>(Start + Frame + 1)); });
+                            });
+                        return Triggers;
+                    } });
+
+                Tests.push_back({ "ZeroCrossing" + Debounce,
+                    [&In, DebounceSamples]()
+                    {
+                        FZeroCrossingState State;
+                        FSamples Triggers;
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t)
+                            {
+                                ProcessZeroCrossing(State, In.Left.data() + Start, NumFrames, DebounceSamples,
+                                    [&](int32_t Frame) { Triggers.push_back(static_cast<float>(Start + Frame)); });
+                            });
+                        return Triggers;
+                    },
+                    [&In, DebounceSamples]()
+                    {
+                        Baseline::FZeroCrossing ZeroCrossing;
+                        FSamples Triggers;
+                        ForEachBlock([&](int32_t Start, int32_t NumFrames, int32_t)
+                            {
+                                ZeroCrossing.Process(In.Left.data() + Start, NumFrames, DebounceSamples,
+                                    [&](int32_t Frame) { Triggers.push_back(static_cast<float>(Start + Frame)); });
+                            });
+                        return Triggers;
+                    } });
+            }
+        }
+
+        // The Phase Disperser's cascade as the node ran it before the kernels, each stage with its own feedback
+        FSamples RunBaselineCascade(const FSamples& Input, int32_t NumStages, float Feedback)
+        {
+            std::vector<Baseline::FAllPassFilter> AllPassFilters(NumStages);
+            for (Baseline::FAllPassFilter& Filter : AllPassFilters)
+            {
+                Filter.Init(Feedback);
+            }
+
+            return RunInPlace(Input, [&AllPassFilters](float* Data, int32_t NumFrames, int32_t)
+                {
+                    for (Baseline::FAllPassFilter& Filter : AllPassFilters)
+                    {
+                        Filter.ProcessBuffer(Data, NumFrames);
+                    }
+                });
+        }
+
+        // Designed sections in double precision, straight from their transfer function
+        // H(z) = (A2 + A1 z^-1 + z^-2) / (1 + A1 z^-1 + A2 z^-2)
+        FSamples RunReferenceSections(const FSamples& Input, const FDispersionDesign& Design)
+        {
+            std::vector<double> Signal(Input.begin(), Input.end());
+
+            for (int32_t Section = 0; Section < Design.NumSections; ++Section)
+            {
+                const double A1 = Design.A1[Section];
+                const double A2 = Design.A2[Section];
+                double X1 = 0.0, X2 = 0.0, Y1 = 0.0, Y2 = 0.0;
+
+                for (double& Value : Signal)
+                {
+                    const double Output = A2 * Value + A1 * X1 + X2 - A1 * Y1 - A2 * Y2;
+                    X2 = X1;
+                    X1 = Value;
+                    Y2 = Y1;
+                    Y1 = Output;
+                    Value = Output;
+                }
+            }
+
+            return FSamples(Signal.begin(), Signal.end());
+        }
+
+        void AddAllPassTests(std::vector<FKernelTest>& Tests)
+        {
+            const FTestInputs& In = GetTestInputs();
+
+            const auto RunDisperser = [&In](EAllPassMode Mode, int32_t NumStages)
+                {
+                    const std::unique_ptr<FAllPassDisperserState> State = std::make_unique<FAllPassDisperserState>();
+                    AllocateAllPassDisperserModes(*State, true, true);
+                    ResetAllPassDisperser(*State, NumStages);
+
+                    return RunInPlace(In.Left, [&](float* Data, int32_t NumFrames, int32_t)
+                        {
+                            ProcessAllPassDisperser(*State, Mode, NumStages, Data, NumFrames);
+                        });
+                };
+
+            // Short cascades run the stages one at a time, longer ones in waves of AllPassWaveVectors vectors
+            for (const int32_t NumStages : { 1, 3, 4, 5, 8, 17, 64, MaxAllPassStages })
+            {
+                Tests.push_back({ "PhaseDisperser/Recursive/" + std::to_string(NumStages),
+                    [=]() { return RunDisperser(EAllPassMode::Recursive, NumStages); },
+                    [&In, NumStages]() { return RunBaselineCascade(In.Left, NumStages, DefaultAllPassFeedback); } });
+            }
+
+            // The responses are truncated at -120 dB, and the FFTs round in single precision; 128 stages come to about -118 dB
+            for (const int32_t NumStages : { 1, 16, MaxAllPassStages })
+            {
+                Tests.push_back({ "PhaseDisperser/Convolution/" + std::to_string(NumStages),
+                    [=]() { return RunDisperser(EAllPassMode::Convolution, NumStages); },
+                    [&In, NumStages]() { return RunBaselineCascade(In.Left, NumStages, DefaultAllPassFeedback); },
+                    "the baseline loop", -110.0 });
+            }
+
+            // A node whose constant mode can't convolve has no convolver, and runs the stages instead
+            Tests.push_back({ "PhaseDisperser/Convolution/Unallocated",
+                [&In]()
+                {
+                    const std::unique_ptr<FAllPassDisperserState> State = std::make_unique<FAllPassDisperserState>();
+                    ResetAllPassDisperser(*State, MaxAllPassStages);
+
+                    return RunInPlace(In.Left, [&](float* Data, int32_t NumFrames, int32_t)
+                        {
+                            ProcessAllPassDisperser(*State, EAllPassMode::Convolution, MaxAllPassStages, Data, NumFrames);
+                        });
+                },
+                [&In]() { return RunBaselineCascade(In.Left, MaxAllPassStages, DefaultAllPassFeedback); } });
+
+            // Sections with poles close to the unit circle amplify the single-precision rounding; the longest design,
+            // 64 sections, comes to about -88 dB
+            for (const float DispersionMs : { 2.0f, 10.0f, 40.0f })
+            {
+                const std::shared_ptr<FDispersionDesign> Design = std::make_shared<FDispersionDesign>(MakeDispersionDesign(FDispersionParams{ DispersionMs / 1000.0f, 100.0f, 4000.0f, TestSampleRate }));
+
+                Tests.push_back({ "PhaseDisperser/Designed/" + std::to_string(static_cast<int32_t>(DispersionMs)),
+                    [&In, Design]()
+                    {
+                        const std::unique_ptr<FAllPassDisperserState> State = std::make_unique<FAllPassDisperserState>();
+                        AllocateAllPassDisperserModes(*State, false, true);
+                        ResetAllPassDisperser(*State, 1);
+                        SetAllPassDispersionDesign(*State, Design.get(), false);
+
+                        return RunInPlace(In.Left, [&](float* Data, int32_t NumFrames, int32_t)
+                            {
+                                ProcessAllPassDisperser(*State, EAllPassMode::Designed, 1, Data, NumFrames);
+                            });
+                    },
+                    [&In, Design]() { return RunReferenceSections(In.Left, *Design); },
+                    "the double-precision sections", -80.0 });
+            }
+
+            Tests.push_back({ "PhaseDisperser/Designed/Crossfade",
+                [&In]()
+                {
+                    const std::unique_ptr<FDispersionDesign> Designs[] = {
+                        std::make_unique<FDispersionDesign>(MakeDispersionDesign(FDispersionParams{ 0.01f, 100.0f, 4000.0f, TestSampleRate })),
+                        std::make_unique<FDispersionDesign>(MakeDispersionDesign(FDispersionParams{ -0.025f, 200.0f, 6000.0f, TestSampleRate })),
+                        std::make_unique<FDispersionDesign>(MakeDispersionDesign(FDispersionParams{ 0.004f, 50.0f, 1000.0f, TestSampleRate }))
+                    };
+
+                    const std::unique_ptr<FAllPassDisperserState> State = std::make_unique<FAllPassDisperserState>();
+                    AllocateAllPassDisperserModes(*State, false, true);
+                    ResetAllPassDisperser(*State, 1);
+
+                    return RunInPlace(In.Left, [&](float* Data, int32_t NumFrames, int32_t Block)
+                        {
+                            SetAllPassDispersionDesign(*State, Designs[(Block / 3) % std::size(Designs)].get(), true);
+                            ProcessAllPassDisperser(*State, EAllPassMode::Designed, 1, Data, NumFrames);
+                        });
+                } });
+        }
+
+        void AddMultichannelTests(std::vector<FKernelTest>& Tests)
+        {
+            // Every channel against the mono cascade with that channel's feedback; channel counts that don't fill a
+            // vector are covered too, though the nodes only use 2, 4 and 8
+            for (const int32_t NumChannels : { 2, 3, 4, 8 })
+            {
+                for (const int32_t NumStages : { 1, 5, 17, MaxAllPassStages })
+                {
+                    constexpr float Spread = 0.5f;
+
+                    Tests.push_back({ "MultichannelPhaseDisperser/" + std::to_string(NumChannels) + "/" + std::to_string(NumStages),
+                        [=]()
+                        {
+                            const std::unique_ptr<FAllPassChannelCascadeState> State = std::make_unique<FAllPassChannelCascadeState>();
+                            State->Init(NumChannels, Spread);
+
+                            return RunChannelsInPlace(NumChannels, [&](float* const* Data, int32_t NumFrames, int32_t)
+                                {
+                                    ProcessAllPassChannelCascade(*State, NumStages, Data, NumFrames);
+                                });
+                        },
+                        [=]()
+                        {
+                            FSamples Output;
+                            for (int32_t Channel = 0; Channel < NumChannels; ++Channel)
+                            {
+                                const FSamples ChannelOutput = RunBaselineCascade(MakeTestSignal(static_cast<uint32_t>(10 + Channel)), NumStages, GetAllPassChannelFeedback(Channel, NumChannels, Spread));
+                                Output.insert(Output.end(), ChannelOutput.begin(), ChannelOutput.end());
+                            }
+                            return Output;
+                        } });
+                }
+            }
+
+            Tests.push_back({ "MultichannelPhaseDisperser/4/17/Automated",
+                []()
+                {
+                    const std::unique_ptr<FAllPassChannelCascadeState> State = std::make_unique<FAllPassChannelCascadeState>();
+                    State->Init(4);
+
+                    return RunChannelsInPlace(4, [&](float* const* Data, int32_t NumFrames, int32_t Block)
+                        {
+                            SetAllPassChannelSpread(*State, GetAutomation(Block, 0.0f, 1.0f));
+                            ProcessAllPassChannelCascade(*State, 17, Data, NumFrames);
+                        });
+                } });
+
+            // An odd channel count pairs the last channel with itself
+            Tests.push_back({ "MultichannelGain/3",
+                []()
+                {
+                    float Gain = 0.7f;
+                    return RunChannelsInPlace(3, [&](float* const* Data, int32_t NumFrames, int32_t)
+                        {
+                            ProcessMultichannelGainRamped(Gain, 0.7f, Data, Data, 3, NumFrames);
+                        });
+                },
+                []()
+                {
+                    return RunChannelsInPlace(3, [&](float* const* Data, int32_t NumFrames, int32_t)
+                        {
+                            Baseline::ProcessStereoGain(Data[0], Data[1], 0.7f, Data[0], Data[1], NumFrames);
+                            Baseline::ProcessStereoGain(Data[2], Data[2], 0.7f, Data[2], Data[2], NumFrames);
+                        });
+                } });
+
+            Tests.push_back({ "MultichannelGain/3/Automated",
+                []()
+                {
+                    float Gain = 1.0f;
+                    return RunChannelsInPlace(3, [&](float* const* Data, int32_t NumFrames, int32_t Block)
+                        {
+                            ProcessMultichannelGainRamped(Gain, GetAutomation(Block, -1.0f, 2.0f), Data, Data, 3, NumFrames);
+                        });
+                } });
+
+            // Two channels are Stereo Width up to rounding, as the mean is taken as a sum scaled by 1 / 2
+            Tests.push_back({ "MultichannelWidth/2",
+                []()
+                {
+                    float WidthFactor = 1.6f;
+                    return RunChannelsInPlace(2, [&](float* const* Data, int32_t NumFrames, int32_t)
+                        {
+                            ProcessMultichannelWidthRamped(WidthFactor, 1.6f, Data, Data, 2, NumFrames);
+                        });
+                },
+                []()
+                {
+                    return RunChannelsInPlace(2, [&](float* const* Data, int32_t NumFrames, int32_t)
+                        {
+                            Baseline::ProcessStereoWidth(Data[0], Data[1], 1.6f, Data[0], Data[1], NumFrames);
+                        });
+                },
+                "the baseline loop", -150.0 });
+
+            Tests.push_back({ "MultichannelWidth/5/Automated",
+                []()
+                {
+                    float WidthFactor = 1.0f;
+                    return RunChannelsInPlace(5, [&](float* const* Data, int32_t NumFrames, int32_t Block)
+                        {
+                            ProcessMultichannelWidthRamped(WidthFactor, GetAutomation(Block, 0.0f, 2.0f), Data, Data, 5, NumFrames);
+                        });
+                } });
+        }
+
+        std::vector<FKernelTest> MakeKernelTests()
+        {
+            std::vector<FKernelTest> Tests;
+            AddStereoTests(Tests);
+            AddTriggerTests(Tests);
+            AddAllPassTests(Tests);
+            AddMultichannelTests(Tests);
+            return Tests;
+        }
+    }
+}
+
+int main(int Argc, char** Argv)
+{
+    using namespace MetasoundBranches::Tests;
+    using namespace MetasoundBranches::Kernels;
+
+    std::string Filter;
+    if (Argc == 3 && std::strcmp(Argv[1], "--filter") == 0)
+    {
+        Filter = Argv[2];
+    }
+    else if (Argc != 1)
+    {
+        std::fprintf(stderr, "Usage: BranchesKernelTests [--filter <text>]\n");
+        return 2;
+    }
+
+    std::fprintf(stderr, "Kernel levels: Scalar to %s\n", GetKernelIsaName(GetDetectedKernelIsa()));
+
+    int32_t NumRun = 0;
+    int32_t NumFailed = 0;
+
+    for (const FKernelTest& Test : MakeKernelTests())
+    {
+        if (!Filter.empty() && Test.Name.find(Filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        ++NumRun;
+        if (RunTest(Test))
+        {
+            std::fprintf(stderr, "ok   %s\n", Test.Name.c_str());
+        }
+        else
+        {
+            ++NumFailed;
+        }
+    }
+
+    std::fprintf(stderr, "%d of %d kernel tests passed\n", NumRun - NumFailed, NumRun);
+    return NumFailed == 0 ? 0 : 1;
+}
@@ -62,7 +62,7 @@ data.forEach(node => {
     <h2>${name}</h2>
     <p><strong>Category:</strong> ${category}</p>
     <p>${description}</p>
-    <img src="./svg/${image}" alt="${name}">
+    ${image ? `<img src="./svg/${image}" alt="${name}">` : ''}
     <h3>Inputs</h3>
     <table>
       <thead>